@@ -279,6 +279,58 @@ FLINT_DLL void fft_convolution_precache(mp_limb_t ** ii, mp_limb_t ** jj,
                slong depth, slong limbs, slong trunc, mp_limb_t ** t1,
 	                    mp_limb_t ** t2, mp_limb_t ** s1, mp_limb_t ** tt);
 
+FLINT_DLL void fft_pointwise_inverse_precache(mp_limb_t ** ii,
+               mp_limb_t ** jj, slong depth, slong limbs, slong trunc,
+      mp_limb_t ** t1, mp_limb_t ** t2, mp_limb_t ** s1, mp_limb_t ** tt);
+
+/***** Integer multiplication by a precomputed transform *****/
+
+typedef struct
+{
+   mp_limb_t ** jj;      /* transform of the fixed operand */
+   mp_size_t n1;         /* maximum length of the other operand */
+   mp_size_t n2;         /* length of the fixed operand */
+   mp_size_t j2;         /* number of coefficients of the fixed operand */
+   mp_size_t limbs;      /* coefficients are taken mod B^limbs + 1 */
+   flint_bitcnt_t depth;
+   flint_bitcnt_t bits;  /* bits of input per coefficient */
+} flint_mpn_mul_fft_precache_struct;
+
+typedef flint_mpn_mul_fft_precache_struct flint_mpn_mul_fft_precache_t[1];
+
+FLINT_DLL void flint_mpn_mul_fft_precache_init(
+                 flint_mpn_mul_fft_precache_t pre, mp_srcptr i2, mp_size_t n2,
+                                                                mp_size_t n1);
+
+FLINT_DLL void flint_mpn_mul_fft_precache_clear(
+                                         flint_mpn_mul_fft_precache_t pre);
+
+FLINT_DLL void flint_mpn_mul_fft_precache(mp_ptr r1, mp_srcptr i1,
+                     mp_size_t n1, const flint_mpn_mul_fft_precache_t pre);
+
+FLINT_DLL void flint_mpn_sqr_fft_precache(mp_ptr r1,
+                                    const flint_mpn_mul_fft_precache_t pre);
+
+typedef struct
+{
+   flint_mpn_mul_fft_precache_t mpn;
+   fmpz_t b;
+   int use_fft;          /* whether the transform of b was made */
+} fmpz_mul_fft_precache_struct;
+
+typedef fmpz_mul_fft_precache_struct fmpz_mul_fft_precache_t[1];
+
+FLINT_DLL void fmpz_mul_fft_precache_init(fmpz_mul_fft_precache_t pre,
+                                      const fmpz_t b, mp_size_t max_limbs);
+
+FLINT_DLL void fmpz_mul_fft_precache_clear(fmpz_mul_fft_precache_t pre);
+
+FLINT_DLL void fmpz_mul_fft_precache(fmpz_t f, const fmpz_t g,
+                                      const fmpz_mul_fft_precache_t pre);
+
+FLINT_DLL void fmpz_sqr_fft_precache(fmpz_t f,
+                                      const fmpz_mul_fft_precache_t pre);
+
 #ifdef __cplusplus
 }
 #endif
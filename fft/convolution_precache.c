@@ -57,8 +57,8 @@ void fft_precache(mp_limb_t ** jj, slong depth, slong limbs, slong trunc,
    }
 }
 
-void fft_convolution_precache(mp_limb_t ** ii, mp_limb_t ** jj, slong depth, 
-                              slong limbs, slong trunc, mp_limb_t ** t1, 
+void fft_pointwise_inverse_precache(mp_limb_t ** ii, mp_limb_t ** jj,
+              slong depth, slong limbs, slong trunc, mp_limb_t ** t1,
                           mp_limb_t ** t2, mp_limb_t ** s1, mp_limb_t ** tt)
 {
    slong n = (WORD(1)<<depth), j, s, t, u, trunc2;
@@ -69,34 +69,16 @@ void fft_convolution_precache(mp_limb_t ** ii, mp_limb_t ** jj, slong depth,
    {
       trunc = 2*((trunc + 1)/2);
       
-      fft_truncate_sqrt2(ii, n, w, t1, t2, s1, trunc);
-   
       for (j = 0; j < trunc; j++)
-      {
-         mpn_normmod_2expp1(ii[j], limbs);
-         
          fft_mulmod_2expp1(ii[j], ii[j], jj[j], n, w, *tt);
-      }
 
       ifft_truncate_sqrt2(ii, n, w, t1, t2, s1, trunc);
-
-      for (j = 0; j < trunc; j++)
-      {
-         mpn_div_2expmod_2expp1(ii[j], ii[j], limbs, depth + 2);
-         mpn_normmod_2expp1(ii[j], limbs);
-      }
    } else
    {
       trunc = 2*sqrt*((trunc + 2*sqrt - 1)/(2*sqrt));
       
-      fft_mfa_truncate_sqrt2(ii, n, w, t1, t2, s1, sqrt, trunc);
-   
       for (j = 0; j < 2*n; j++)
-      {
-         mpn_normmod_2expp1(ii[j], limbs);
-         
          fft_mulmod_2expp1(ii[j], ii[j], jj[j], n, w, *tt);
-      }
 
       trunc2 = (trunc - 2*n)/sqrt;
       
@@ -107,18 +89,25 @@ void fft_convolution_precache(mp_limb_t ** ii, mp_limb_t ** jj, slong depth,
          for (u = 0; u < sqrt; u++)
          {
             j = 2*n + t*sqrt + u;
-            mpn_normmod_2expp1(ii[j], limbs);
-         
             fft_mulmod_2expp1(ii[j], ii[j], jj[j], n, w, *tt);
          }
       }
 
       ifft_mfa_truncate_sqrt2(ii, n, w, t1, t2, s1, sqrt, trunc);
+   }
 
-      for (j = 0; j < trunc; j++)
-      {
-         mpn_div_2expmod_2expp1(ii[j], ii[j], limbs, depth + 2);
-         mpn_normmod_2expp1(ii[j], limbs);
-      }
+   for (j = 0; j < trunc; j++)
+   {
+      mpn_div_2expmod_2expp1(ii[j], ii[j], limbs, depth + 2);
+      mpn_normmod_2expp1(ii[j], limbs);
    }
 }
+
+void fft_convolution_precache(mp_limb_t ** ii, mp_limb_t ** jj, slong depth, 
+                              slong limbs, slong trunc, mp_limb_t ** t1, 
+                          mp_limb_t ** t2, mp_limb_t ** s1, mp_limb_t ** tt)
+{
+   fft_precache(ii, depth, limbs, trunc, t1, t2, s1);
+
+   fft_pointwise_inverse_precache(ii, jj, depth, limbs, trunc, t1, t2, s1, tt);
+}
@@ -0,0 +1,102 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fmpz.h"
+#include "fft.h"
+#include "gmpcompat.h"
+
+void fmpz_mul_fft_precache_init(fmpz_mul_fft_precache_t pre,
+                                       const fmpz_t b, mp_size_t max_limbs)
+{
+   fmpz_init_set(pre->b, b);
+
+   pre->use_fft = COEFF_IS_MPZ(*b) && max_limbs > 0;
+
+   if (pre->use_fft)
+   {
+      __mpz_struct * mb = COEFF_TO_PTR(*b);
+
+      flint_mpn_mul_fft_precache_init(pre->mpn, mb->_mp_d,
+                                        FLINT_ABS(mb->_mp_size), max_limbs);
+   }
+}
+
+void fmpz_mul_fft_precache_clear(fmpz_mul_fft_precache_t pre)
+{
+   if (pre->use_fft)
+      flint_mpn_mul_fft_precache_clear(pre->mpn);
+
+   fmpz_clear(pre->b);
+}
+
+/* set f to the n limbs at r with the given sign, f may not be small */
+static void _fmpz_set_limbs(fmpz_t f, mp_srcptr r, mp_size_t n, int neg)
+{
+   __mpz_struct * mf = _fmpz_promote(f);
+   mp_ptr d = FLINT_MPZ_REALLOC(mf, n);
+
+   flint_mpn_copyi(d, r, n);
+   while (n > 0 && d[n - 1] == 0)
+      n--;
+
+   mf->_mp_size = neg ? -n : n;
+   _fmpz_demote_val(f);
+}
+
+void fmpz_mul_fft_precache(fmpz_t f, const fmpz_t g,
+                                          const fmpz_mul_fft_precache_t pre)
+{
+   __mpz_struct * mg;
+   mp_size_t n1, n2;
+   mp_ptr r;
+
+   if (!pre->use_fft || !COEFF_IS_MPZ(*g) ||
+       FLINT_ABS(COEFF_TO_PTR(*g)->_mp_size) > pre->mpn->n1)
+   {
+      fmpz_mul(f, g, pre->b);
+      return;
+   }
+
+   mg = COEFF_TO_PTR(*g);
+   n1 = FLINT_ABS(mg->_mp_size);
+   n2 = pre->mpn->n2;
+
+   /* g may be aliased with f */
+   r = (mp_ptr) flint_malloc((n1 + n2)*sizeof(mp_limb_t));
+
+   flint_mpn_mul_fft_precache(r, mg->_mp_d, n1, pre->mpn);
+
+   _fmpz_set_limbs(f, r, n1 + n2,
+                   (mg->_mp_size < 0) ^ (COEFF_TO_PTR(*pre->b)->_mp_size < 0));
+
+   flint_free(r);
+}
+
+void fmpz_sqr_fft_precache(fmpz_t f, const fmpz_mul_fft_precache_t pre)
+{
+   mp_size_t n2;
+   mp_ptr r;
+
+   if (!pre->use_fft)
+   {
+      fmpz_mul(f, pre->b, pre->b);
+      return;
+   }
+
+   n2 = pre->mpn->n2;
+   r = (mp_ptr) flint_malloc(2*n2*sizeof(mp_limb_t));
+
+   flint_mpn_sqr_fft_precache(r, pre->mpn);
+
+   _fmpz_set_limbs(f, r, 2*n2, 0);
+
+   flint_free(r);
+}
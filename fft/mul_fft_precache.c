@@ -0,0 +1,226 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+#include "ulong_extras.h"
+#include "fft_tuning.h"
+
+static int fft_tuning_table[5][2] = FFT_TAB;
+
+/* choose depth and w as flint_mpn_mul_fft_main does for n1 x n2 limbs */
+static void _fft_mul_params(flint_bitcnt_t * depth_, flint_bitcnt_t * w_,
+                                                  mp_size_t n1, mp_size_t n2)
+{
+   mp_size_t off, depth = 6;
+   mp_size_t w = 1;
+   mp_size_t n = ((mp_size_t) 1 << depth);
+   flint_bitcnt_t bits = (n*w - (depth+1))/2;
+
+   flint_bitcnt_t bits1 = n1*FLINT_BITS;
+   flint_bitcnt_t bits2 = n2*FLINT_BITS;
+
+   mp_size_t j1 = (bits1 - 1)/bits + 1;
+   mp_size_t j2 = (bits2 - 1)/bits + 1;
+
+   while (j1 + j2 - 1 > 4*n) /* find initial n, w */
+   {
+      if (w == 1) w = 2;
+      else
+      {
+         depth++;
+         w = 1;
+         n *= 2;
+      }
+
+      bits = (n*w - (depth+1))/2;
+      j1 = (bits1 - 1)/bits + 1;
+      j2 = (bits2 - 1)/bits + 1;
+   }
+
+   if (depth < 11)
+   {
+      mp_size_t wadj = 1;
+
+      off = fft_tuning_table[depth - 6][w - 1]; /* adjust n and w */
+      depth -= off;
+      n = ((mp_size_t) 1 << depth);
+      w *= ((mp_size_t) 1 << (2*off));
+
+      if (depth < 6) wadj = ((mp_size_t) 1 << (6 - depth));
+
+      if (w > wadj)
+      {
+         do { /* see if a smaller w will work */
+            w -= wadj;
+            bits = (n*w - (depth+1))/2;
+            j1 = (bits1 - 1)/bits + 1;
+            j2 = (bits2 - 1)/bits + 1;
+         } while (j1 + j2 - 1 <= 4*n && w > wadj);
+         w += wadj;
+      }
+   } else
+   {
+      if (j1 + j2 - 1 <= 3*n)
+      {
+         depth--;
+         w *= 3;
+      }
+   }
+
+   *depth_ = depth;
+   *w_ = w;
+}
+
+/*
+   Allocate 4n coefficients of size limbs + 1 together with the temporary
+   space needed by the transforms for N threads.
+*/
+static mp_limb_t ** _fft_alloc(mp_size_t n, mp_size_t limbs,
+                   mp_limb_t *** t1, mp_limb_t *** t2, mp_limb_t *** s1,
+                                                           mp_limb_t *** tt)
+{
+   mp_size_t i, size = limbs + 1;
+   mp_limb_t ** ii, * ptr;
+   int N = flint_get_num_threads();
+
+   ii = (mp_limb_t **) flint_malloc((4*(n + n*size) + 5*size*N + 4*N)*
+                                                          sizeof(mp_limb_t));
+   for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size)
+      ii[i] = ptr;
+
+   *t1 = (mp_limb_t **) ptr;
+   *t2 = *t1 + N;
+   *s1 = *t2 + N;
+   *tt = *s1 + N;
+   ptr += 4*N;
+
+   (*t1)[0] = ptr;
+   (*t2)[0] = (*t1)[0] + size*N;
+   (*s1)[0] = (*t2)[0] + size*N;
+   (*tt)[0] = (*s1)[0] + size*N;
+
+   for (i = 1; i < N; i++)
+   {
+      (*t1)[i] = (*t1)[i - 1] + size;
+      (*t2)[i] = (*t2)[i - 1] + size;
+      (*s1)[i] = (*s1)[i - 1] + size;
+      (*tt)[i] = (*tt)[i - 1] + 2*size;
+   }
+
+   return ii;
+}
+
+void flint_mpn_mul_fft_precache_init(flint_mpn_mul_fft_precache_t pre,
+                               mp_srcptr i2, mp_size_t n2, mp_size_t n1)
+{
+   flint_bitcnt_t depth, w;
+   mp_size_t j, n, trunc;
+   mp_limb_t ** t1, ** t2, ** s1, ** tt, ** jj;
+
+   FLINT_ASSERT(n2 > 0);
+
+   /* the transform must also be large enough to square the fixed operand */
+   n1 = FLINT_MAX(n1, n2);
+
+   _fft_mul_params(&depth, &w, n1, n2);
+   n = ((mp_size_t) 1 << depth);
+
+   pre->limbs = (n*w)/FLINT_BITS;
+
+   /*
+      The pointwise products are done by fft_mulmod_2expp1, which needs
+      an adjusted number of limbs above the cutoff. Rounding up to a
+      multiple of n/FLINT_BITS keeps w an integer.
+   */
+   if (pre->limbs > FFT_MULMOD_2EXPP1_CUTOFF)
+   {
+      mp_size_t adj = FLINT_MAX(n/FLINT_BITS, 1);
+
+      pre->limbs = fft_adjust_limbs(pre->limbs);
+      pre->limbs = adj*((pre->limbs + adj - 1)/adj);
+      w = (pre->limbs*FLINT_BITS)/n;
+   }
+
+   pre->depth = depth;
+   pre->bits = (n*w - (depth + 1))/2;
+   pre->n1 = n1;
+   pre->n2 = n2;
+
+   jj = _fft_alloc(n, pre->limbs, &t1, &t2, &s1, &tt);
+
+   pre->j2 = fft_split_bits(jj, i2, n2, pre->bits, pre->limbs);
+   for (j = pre->j2; j < 4*n; j++)
+      flint_mpn_zero(jj[j], pre->limbs + 1);
+
+   trunc = (n1*FLINT_BITS - 1)/pre->bits + 1 + pre->j2 - 1;
+   if (trunc <= 2*n) trunc = 2*n + 1;
+
+   fft_precache(jj, depth, pre->limbs, trunc, t1, t2, s1);
+
+   pre->jj = jj;
+}
+
+void flint_mpn_mul_fft_precache_clear(flint_mpn_mul_fft_precache_t pre)
+{
+   flint_free(pre->jj);
+}
+
+void flint_mpn_mul_fft_precache(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                                    const flint_mpn_mul_fft_precache_t pre)
+{
+   mp_size_t j, j1, trunc, n = ((mp_size_t) 1 << pre->depth);
+   mp_limb_t ** ii, ** t1, ** t2, ** s1, ** tt;
+
+   FLINT_ASSERT(n1 > 0);
+   FLINT_ASSERT(n1 <= pre->n1);
+
+   ii = _fft_alloc(n, pre->limbs, &t1, &t2, &s1, &tt);
+
+   j1 = fft_split_bits(ii, i1, n1, pre->bits, pre->limbs);
+   for (j = j1; j < 4*n; j++)
+      flint_mpn_zero(ii[j], pre->limbs + 1);
+
+   /* only a prefix of the precomputed transform is used */
+   trunc = j1 + pre->j2 - 1;
+   if (trunc <= 2*n) trunc = 2*n + 1;
+
+   fft_convolution_precache(ii, pre->jj, pre->depth, pre->limbs, trunc,
+                                                             t1, t2, s1, tt);
+
+   flint_mpn_zero(r1, n1 + pre->n2);
+   fft_combine_bits(r1, ii, j1 + pre->j2 - 1, pre->bits, pre->limbs,
+                                                               n1 + pre->n2);
+   flint_free(ii);
+}
+
+void flint_mpn_sqr_fft_precache(mp_ptr r1,
+                                    const flint_mpn_mul_fft_precache_t pre)
+{
+   mp_size_t j, trunc, n = ((mp_size_t) 1 << pre->depth);
+   mp_limb_t ** ii, ** t1, ** t2, ** s1, ** tt;
+
+   ii = _fft_alloc(n, pre->limbs, &t1, &t2, &s1, &tt);
+
+   /* the transform of the operand is already known */
+   for (j = 0; j < 4*n; j++)
+      flint_mpn_copyi(ii[j], pre->jj[j], pre->limbs + 1);
+
+   trunc = 2*pre->j2 - 1;
+   if (trunc <= 2*n) trunc = 2*n + 1;
+
+   fft_pointwise_inverse_precache(ii, pre->jj, pre->depth, pre->limbs,
+                                                      trunc, t1, t2, s1, tt);
+
+   flint_mpn_zero(r1, 2*pre->n2);
+   fft_combine_bits(r1, ii, 2*pre->j2 - 1, pre->bits, pre->limbs,
+                                                                2*pre->n2);
+   flint_free(ii);
+}
@@ -0,0 +1,185 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "ulong_extras.h"
+#include "fft.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_fft_precache....");
+    fflush(stdout);
+
+    _flint_rand_init_gmp(state);
+
+    /* mpn operands */
+    for (iter = 0; iter < 30 * flint_test_multiplier(); iter++)
+    {
+        flint_mpn_mul_fft_precache_t pre;
+        mp_size_t n1, n2, max1, j;
+        mp_limb_t * i1, * i2, * r1, * r2;
+        slong k;
+
+        flint_set_num_threads(n_randint(state, 3) + 1);
+
+        if (n_randint(state, 10) == 0)
+        {
+            n2 = n_randint(state, 40000) + 1;
+            max1 = n_randint(state, 40000) + 1;
+        }
+        else
+        {
+            n2 = n_randint(state, 3000) + 1;
+            max1 = n_randint(state, 3000) + 1;
+        }
+
+        i1 = flint_malloc((FLINT_MAX(max1, n2) + n2)*sizeof(mp_limb_t));
+        i2 = flint_malloc(n2*sizeof(mp_limb_t));
+        r1 = flint_malloc(2*(FLINT_MAX(max1, n2) + n2)*sizeof(mp_limb_t));
+        r2 = r1 + FLINT_MAX(max1, n2) + n2;
+
+        flint_mpn_urandomb(i2, state->gmp_state, n2*FLINT_BITS);
+        if (n_randint(state, 2))
+            i2[n2 - 1] = -UWORD(1);
+        if (i2[n2 - 1] == 0)
+            i2[n2 - 1] = 1;
+
+        flint_mpn_mul_fft_precache_init(pre, i2, n2, max1);
+
+        for (k = 0; k < 3; k++)
+        {
+            n1 = n_randint(state, max1) + 1;
+
+            flint_mpn_urandomb(i1, state->gmp_state, n1*FLINT_BITS);
+            if (n_randint(state, 2))
+                i1[n1 - 1] = -UWORD(1);
+
+            if (n1 >= n2)
+                mpn_mul(r2, i1, n1, i2, n2);
+            else
+                mpn_mul(r2, i2, n2, i1, n1);
+
+            flint_mpn_mul_fft_precache(r1, i1, n1, pre);
+
+            for (j = 0; j < n1 + n2; j++)
+            {
+                if (r1[j] != r2[j])
+                {
+                    flint_printf("FAIL (mul):\n");
+                    flint_printf("n1 = %wd, n2 = %wd, max1 = %wd\n",
+                                                               n1, n2, max1);
+                    flint_printf("error in limb %wd, %wx != %wx\n",
+                                                            j, r1[j], r2[j]);
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+        }
+
+        mpn_sqr(r2, i2, n2);
+        flint_mpn_sqr_fft_precache(r1, pre);
+
+        for (j = 0; j < 2*n2; j++)
+        {
+            if (r1[j] != r2[j])
+            {
+                flint_printf("FAIL (sqr):\n");
+                flint_printf("n2 = %wd, max1 = %wd\n", n2, max1);
+                flint_printf("error in limb %wd, %wx != %wx\n",
+                                                            j, r1[j], r2[j]);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        flint_mpn_mul_fft_precache_clear(pre);
+
+        flint_free(i1);
+        flint_free(i2);
+        flint_free(r1);
+    }
+
+    /* fmpz operands */
+    for (iter = 0; iter < 100 * flint_test_multiplier(); iter++)
+    {
+        fmpz_mul_fft_precache_t pre;
+        fmpz_t a, b, c, d;
+        mp_size_t max_limbs;
+        slong k;
+
+        fmpz_init(a);
+        fmpz_init(b);
+        fmpz_init(c);
+        fmpz_init(d);
+
+        fmpz_randtest(b, state, n_randint(state, 20000) + 1);
+        max_limbs = n_randint(state, 300);
+
+        fmpz_mul_fft_precache_init(pre, b, max_limbs);
+
+        for (k = 0; k < 3; k++)
+        {
+            fmpz_randtest(a, state, n_randint(state, 20000) + 1);
+
+            fmpz_mul(c, a, b);
+            fmpz_mul_fft_precache(d, a, pre);
+
+            if (!fmpz_equal(c, d))
+            {
+                flint_printf("FAIL (fmpz mul):\n");
+                fmpz_print(a); flint_printf("\n\n");
+                fmpz_print(b); flint_printf("\n\n");
+                fflush(stdout);
+                flint_abort();
+            }
+
+            /* aliasing */
+            fmpz_mul_fft_precache(a, a, pre);
+
+            if (!fmpz_equal(a, c))
+            {
+                flint_printf("FAIL (fmpz aliasing):\n");
+                fmpz_print(b); flint_printf("\n\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        fmpz_mul(c, b, b);
+        fmpz_sqr_fft_precache(d, pre);
+
+        if (!fmpz_equal(c, d))
+        {
+            flint_printf("FAIL (fmpz sqr):\n");
+            fmpz_print(b); flint_printf("\n\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_mul_fft_precache_clear(pre);
+
+        fmpz_clear(a);
+        fmpz_clear(b);
+        fmpz_clear(c);
+        fmpz_clear(d);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -101,6 +101,41 @@ FLINT_DLL void __flint_set_memory_functions(void *(*alloc_func) (size_t),
      void *(*calloc_func) (size_t, size_t), void *(*realloc_func) (void *, size_t),
                                                               void (*free_func) (void *));
 
+/* bump pointer arenas */
+#define FLINT_ARENA_ALIGN 16
+
+typedef struct flint_arena_chunk_struct
+{
+   struct flint_arena_chunk_struct * next; /* older chunk */
+   char * end;
+} flint_arena_chunk_struct;
+
+typedef struct flint_arena_struct
+{
+   char * ptr;                        /* next free byte of the current chunk */
+   char * end;                        /* end of the current chunk */
+   flint_arena_chunk_struct * chunk;  /* current chunk */
+   flint_arena_chunk_struct * spare;  /* released chunks kept for reuse */
+   size_t chunk_size;                 /* minimum size of the next new chunk */
+   int registered;                    /* known to flint_free and friends */
+} flint_arena_struct;
+
+typedef flint_arena_struct flint_arena_t[1];
+
+typedef struct
+{
+   flint_arena_chunk_struct * chunk;
+   char * ptr;
+} flint_arena_mark_struct;
+
+typedef flint_arena_mark_struct flint_arena_mark_t[1];
+
+FLINT_DLL void flint_arena_init(flint_arena_t A, size_t chunk_size);
+FLINT_DLL void flint_arena_clear(flint_arena_t A);
+FLINT_DLL void * _flint_arena_alloc(flint_arena_t A, size_t size);
+FLINT_DLL void flint_arena_release(flint_arena_t A, const flint_arena_mark_t mark);
+FLINT_DLL flint_arena_struct * flint_arena_set_current(flint_arena_struct * A);
+
 #ifdef __GNUC__
 #define FLINT_NORETURN __attribute__ ((noreturn))
 #else
@@ -383,6 +418,27 @@ mp_limb_t FLINT_BIT_COUNT(mp_limb_t x)
          (xxx)[ixxx] = yyy; \
    } while (0)
 
+FLINT_INLINE
+void * flint_arena_alloc(flint_arena_t A, size_t size)
+{
+   void * ptr = A->ptr;
+
+   size = (size + FLINT_ARENA_ALIGN - 1) & ~((size_t) FLINT_ARENA_ALIGN - 1);
+
+   if (size > (size_t) (A->end - A->ptr))
+      return _flint_arena_alloc(A, size);
+
+   A->ptr += size;
+   return ptr;
+}
+
+FLINT_INLINE
+void flint_arena_mark(flint_arena_mark_t mark, const flint_arena_t A)
+{
+   mark->chunk = A->chunk;
+   mark->ptr = A->ptr;
+}
+
 /* common usage of flint_malloc */
 #define FLINT_ARRAY_ALLOC(n, T) (T *) flint_malloc((n)*sizeof(T))
 #define FLINT_ARRAY_REALLOC(p, n, T) (T *) flint_realloc(p, (n)*sizeof(T))
@@ -10,10 +10,18 @@
 */
 
 #include "fmpq_mat.h"
+#include "thread_support.h"
 
-int
-fmpq_mat_set_fmpz_mat_mod_fmpz(fmpq_mat_t X,
-                                    const fmpz_mat_t Xmod, const fmpz_t mod)
+/* minimum number of entries times limbs of the modulus to use threads */
+#define FMPQ_MAT_RECONSTRUCT_THREAD_CUTOFF 2000
+
+/*
+    Reconstructs the entries in rows r0, ..., r1 - 1, multiplying each
+    residue by the product of the denominators found so far in the range
+*/
+static int
+_fmpq_mat_set_fmpz_mat_mod_fmpz_rows(fmpq_mat_t X,
+                 const fmpz_mat_t Xmod, const fmpz_t mod, slong r0, slong r1)
 {
     fmpz_t num, den, t, u, d;
     slong i, j;
@@ -28,7 +36,7 @@ fmpq_mat_set_fmpz_mat_mod_fmpz(fmpq_mat_t X,
 
     fmpz_one(d);
 
-    for (i = 0; i < Xmod->r; i++)
+    for (i = r0; i < r1; i++)
     {
         for (j = 0; j < Xmod->c; j++)
         {
@@ -60,3 +68,78 @@ cleanup:
 
     return success;
 }
+
+typedef struct
+{
+    fmpq_mat_struct * X;
+    const fmpz_mat_struct * Xmod;
+    const fmpz * mod;
+    slong r0;
+    slong r1;
+    int success;
+}
+_reconstruct_arg_t;
+
+static void
+_reconstruct_worker(void * arg_ptr)
+{
+    _reconstruct_arg_t * arg = (_reconstruct_arg_t *) arg_ptr;
+
+    arg->success = _fmpq_mat_set_fmpz_mat_mod_fmpz_rows(arg->X, arg->Xmod,
+                                                 arg->mod, arg->r0, arg->r1);
+}
+
+int
+fmpq_mat_set_fmpz_mat_mod_fmpz(fmpq_mat_t X,
+                                    const fmpz_mat_t Xmod, const fmpz_t mod)
+{
+    thread_pool_handle * threads;
+    _reconstruct_arg_t * args;
+    slong i, num_threads;
+    int success = 1;
+
+    /* don't bother waking threads unless there are enough limbs to work on */
+    if (Xmod->r < 2 || flint_get_num_threads() == 1 || Xmod->r*Xmod->c
+                      *fmpz_size(mod) < FMPQ_MAT_RECONSTRUCT_THREAD_CUTOFF)
+    {
+        return _fmpq_mat_set_fmpz_mat_mod_fmpz_rows(X, Xmod, mod, 0, Xmod->r);
+    }
+
+    num_threads = flint_request_threads(&threads,
+                               FLINT_MIN(flint_get_num_threads(), Xmod->r));
+
+    if (num_threads == 0)
+    {
+        flint_give_back_threads(threads, num_threads);
+        return _fmpq_mat_set_fmpz_mat_mod_fmpz_rows(X, Xmod, mod, 0, Xmod->r);
+    }
+
+    args = flint_malloc((num_threads + 1)*sizeof(_reconstruct_arg_t));
+
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i].X = X;
+        args[i].Xmod = Xmod;
+        args[i].mod = mod;
+        args[i].r0 = (i*Xmod->r)/(num_threads + 1);
+        args[i].r1 = ((i + 1)*Xmod->r)/(num_threads + 1);
+    }
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                               _reconstruct_worker, &args[i]);
+
+    _reconstruct_worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+    flint_give_back_threads(threads, num_threads);
+
+    for (i = 0; i <= num_threads; i++)
+        success &= args[i].success;
+
+    flint_free(args);
+
+    return success;
+}
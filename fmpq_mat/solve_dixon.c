@@ -12,8 +12,6 @@
 
 #include "fmpq_mat.h"
 
-#define USE_SLOW_MULTIPLICATION 1
-
 int
 _fmpq_mat_check_solution_fmpz_mat(const fmpq_mat_t X, const fmpz_mat_t A, const fmpz_mat_t B);
 
@@ -24,12 +22,12 @@ _fmpq_mat_solve_dixon(fmpq_mat_t X,
                     const nmod_mat_t Ainv, mp_limb_t p,
                     const fmpz_t N, const fmpz_t D)
 {
-    fmpz_t bound, ppow;
-    fmpz_mat_t x, y, d, Ay;
-    fmpz_t prod;
+    fmpz_t bound, ppow, pnext;
+    fmpz_mat_t x, d;
     mp_limb_t * crt_primes;
     nmod_mat_t * A_mod;
-    nmod_mat_t Ay_mod, d_mod, y_mod;
+    nmod_mat_struct * Ay_mod;
+    fmpz_comb_t comb;
     slong i, j, n, nexti, cols, num_primes;
     int stabilised; /* has lifting stabilised */
 
@@ -38,11 +36,9 @@ _fmpq_mat_solve_dixon(fmpq_mat_t X,
 
     fmpz_init(bound);
     fmpz_init(ppow);
-    fmpz_init(prod);
+    fmpz_init(pnext);
 
     fmpz_mat_init(x, n, cols);
-    fmpz_mat_init(y, n, cols);
-    fmpz_mat_init(Ay, n, cols);
     fmpz_mat_init_set(d, B);
 
     /* Compute bound for the needed modulus. TODO: if one of N and D
@@ -59,14 +55,15 @@ _fmpq_mat_solve_dixon(fmpq_mat_t X,
     crt_primes = fmpz_mat_dixon_get_crt_primes(&num_primes, A, p);
     A_mod = (nmod_mat_t *) flint_malloc(sizeof(nmod_mat_t) * num_primes);
     for (j = 0; j < num_primes; j++)
-    {
         nmod_mat_init(A_mod[j], n, n, crt_primes[j]);
-        fmpz_mat_get_nmod_mat(A_mod[j], A);
-    }
+    fmpz_mat_multi_mod_ui(A_mod, num_primes, A);
 
-    nmod_mat_init(Ay_mod, n, cols, UWORD(1));
-    nmod_mat_init(d_mod, n, cols, p);
-    nmod_mat_init(y_mod, n, cols, p);
+    /* workspace for d = (d - Ay) / p, shared by all the lifting steps */
+    Ay_mod = (nmod_mat_struct *)
+                          flint_malloc(sizeof(nmod_mat_struct) * num_primes);
+    for (j = 0; j < num_primes; j++)
+        nmod_mat_init(Ay_mod + j, n, cols, crt_primes[j]);
+    fmpz_comb_init(comb, crt_primes, num_primes);
 
     fmpz_one(ppow);
 
@@ -75,20 +72,18 @@ _fmpq_mat_solve_dixon(fmpq_mat_t X,
 
     while (fmpz_cmp(ppow, bound) <= 0)
     {
-        /* y = A^(-1) * d  (mod p) */
-        fmpz_mat_get_nmod_mat(d_mod, d);
-        nmod_mat_mul(y_mod, Ainv, d_mod);
+        /* x = x + y * p^i where y = A^(-1) * d  (mod p), and
+           d = (d - Ay) / p unless p^(i+1) is large enough */
+        fmpz_mul_ui(pnext, ppow, p);
+        _fmpz_mat_dixon_step(x, d, ppow, Ainv, A_mod, Ay_mod, comb,
+                             num_primes, fmpz_cmp(pnext, bound) <= 0);
+        fmpz_swap(ppow, pnext);
 
-        /* x = x + y * p^i    [= A^(-1) * b mod p^(i+1)] */
-        fmpz_mat_scalar_addmul_nmod_mat_fmpz(x, y_mod, ppow);
-
-        /* ppow = p^(i+1) */
-        fmpz_mul_ui(ppow, ppow, p);
         if (fmpz_cmp(ppow, bound) > 0)
             break;
 
         stabilised = i == nexti;
-	    if (stabilised)
+        if (stabilised)
             nexti = (slong)(i*1.4) + 1; /* set iteration of next test */
 
         /* full matrix stabilisation check */
@@ -96,64 +91,37 @@ _fmpq_mat_solve_dixon(fmpq_mat_t X,
         {
             stabilised = fmpq_mat_set_fmpz_mat_mod_fmpz(X, x, ppow);
 
-	        if (stabilised)
+            if (stabilised)
             {
                 if (_fmpq_mat_check_solution_fmpz_mat(X, A, B))
                     goto dixon_done;
             }
         }
         i++;
-
-        /* d = (d - Ay) / p */
-#if USE_SLOW_MULTIPLICATION
-        fmpz_mat_set_nmod_mat_unsigned(y, y_mod);
-        fmpz_mat_mul(Ay, A, y);
-#else
-        for (j = 0; j < num_primes; j++)
-        {
-            _nmod_mat_set_mod(y_mod, crt_primes[j]);
-            _nmod_mat_set_mod(Ay_mod, crt_primes[j]);
-            nmod_mat_mul(Ay_mod, A_mod[j], y_mod);
-            if (j == 0)
-            {
-                fmpz_mat_set_nmod_mat(Ay, Ay_mod);
-                fmpz_set_ui(prod, crt_primes[0]);
-            }
-            else
-            {
-                fmpz_mat_CRT_ui(Ay, Ay, prod, Ay_mod, 1);
-                fmpz_mul_ui(prod, prod, crt_primes[j]);
-            }
-        }
-#endif
-
-        _nmod_mat_set_mod(y_mod, p);
-        fmpz_mat_sub(d, d, Ay);
-        fmpz_mat_scalar_divexact_ui(d, d, p);
     }
 
     fmpq_mat_set_fmpz_mat_mod_fmpz(X, x, ppow);
 
 dixon_done:
 
-    nmod_mat_clear(y_mod);
-    nmod_mat_clear(d_mod);
-    nmod_mat_clear(Ay_mod);
+    fmpz_comb_clear(comb);
 
     for (j = 0; j < num_primes; j++)
+    {
         nmod_mat_clear(A_mod[j]);
+        nmod_mat_clear(Ay_mod + j);
+    }
 
     flint_free(A_mod);
+    flint_free(Ay_mod);
     flint_free(crt_primes);
 
     fmpz_clear(bound);
     fmpz_clear(ppow);
-    fmpz_clear(prod);
+    fmpz_clear(pnext);
 
     fmpz_mat_clear(d);
     fmpz_mat_clear(x);
-    fmpz_mat_clear(y);
-    fmpz_mat_clear(Ay);
 }
 
 int
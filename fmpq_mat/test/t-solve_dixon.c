@@ -15,6 +15,7 @@
 #include "flint.h"
 #include "fmpq.h"
 #include "fmpq_mat.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -34,6 +35,8 @@ main(void)
         int success;
         slong n, m, bits;
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         n = n_randint(state, 10);
         m = n_randint(state, 10);
         bits = 1 + n_randint(state, 100);
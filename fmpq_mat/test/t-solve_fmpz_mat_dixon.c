@@ -16,6 +16,7 @@
 #include "flint.h"
 #include "fmpq.h"
 #include "fmpq_mat.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -36,6 +37,8 @@ main(void)
 
         slong n, m, bits;
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         n = n_randint(state, 40);
         m = n_randint(state, 40);
         bits = 1 + n_randint(state, 100);
@@ -62,9 +62,35 @@ typedef struct
 #if FLINT_USES_PTHREAD
    pthread_t thread;
 #endif
+   void * remote;  /* mpz's freed by other threads, for the owner to reuse */
+   void * pending; /* next block of the owner with such mpz's, if listed */
+   void * owner;   /* the list of such blocks of the owner */
+   void * next;    /* next block allocated by the same thread */
    void * address;
 } fmpz_block_header_s;
 
+/*
+   Whether an mpz freed by a thread other than the one which allocated it
+   goes back to that thread, as counted by the remote and reclaimed fields
+   below. Only the single version of fmpz does this, and it needs atomics.
+*/
+#if !FLINT_REENTRANT && !FLINT_USES_GC && FLINT_USES_PTHREAD && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+#define FMPZ_MPZ_REMOTE 1
+#else
+#define FMPZ_MPZ_REMOTE 0
+#endif
+
+typedef struct
+{
+   ulong news;      /* mpz's handed out by _fmpz_new_mpz */
+   ulong allocs;    /* mpz's newly taken from the heap */
+   ulong remote;    /* mpz's freed to a pool owned by another thread */
+   ulong reclaimed; /* mpz's taken back after a free by another thread */
+} fmpz_mpz_stats_struct;
+
+typedef fmpz_mpz_stats_struct fmpz_mpz_stats_t[1];
+
 /* maximum positive value a small coefficient can have */
 #define COEFF_MAX ((WORD(1) << (FLINT_BITS - 2)) - WORD(1))
 
@@ -81,6 +107,10 @@ FLINT_DLL void _fmpz_cleanup_mpz_content(void);
 
 FLINT_DLL void _fmpz_cleanup(void);
 
+FLINT_DLL void _fmpz_mpz_stats(fmpz_mpz_stats_t stats);
+
+FLINT_DLL void _fmpz_mpz_stats_reset(void);
+
 FLINT_DLL __mpz_struct * _fmpz_promote(fmpz_t f);
 
 FLINT_DLL __mpz_struct * _fmpz_promote_val(fmpz_t f);
@@ -789,6 +819,9 @@ FLINT_DLL void _fmpz_CRT_ui_precomp(fmpz_t out, const fmpz_t r1, const fmpz_t m1
 FLINT_DLL void fmpz_CRT_ui(fmpz_t out, const fmpz_t r1, const fmpz_t m1,
     ulong r2, ulong m2, int sign);
 
+FLINT_DLL void _fmpz_CRT(fmpz_t out, const fmpz_t r1, const fmpz_t m1,
+            fmpz_t r2, fmpz_t m2, const fmpz_t m1m2, fmpz_t c, int sign);
+
 FLINT_DLL void fmpz_CRT(fmpz_t out, const fmpz_t r1, const fmpz_t m1,
                                                fmpz_t r2, fmpz_t m2, int sign);
 
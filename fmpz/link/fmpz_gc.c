@@ -35,6 +35,8 @@ ulong mpz_alloc = 0;
 ulong mpz_free_num = 0;
 ulong mpz_free_alloc = 0;
 
+fmpz_mpz_stats_struct mpz_stats = {0, 0, 0, 0};
+
 #if FLINT_USES_PTHREAD
 void fmpz_lock_init()
 {
@@ -45,16 +47,24 @@ void fmpz_lock_init()
 __mpz_struct * _fmpz_new_mpz(void)
 {
     __mpz_struct * z = NULL;
+    flint_arena_struct * arena;
 
 #if FLINT_USES_PTHREAD
     pthread_once(&fmpz_initialised, fmpz_lock_init);
     pthread_mutex_lock(&fmpz_lock);
 #endif
 
+    /* the mpz's are cached beyond the lifetime of any arena */
+    arena = flint_arena_set_current(NULL);
+
+    mpz_stats.news++;
+
     if (mpz_free_num != 0)
         z = mpz_free_arr[--mpz_free_num];
     else
     {
+        mpz_stats.allocs++;
+
         z = flint_malloc(sizeof(__mpz_struct));
 
         if (mpz_num == mpz_alloc) /* store pointer to prevent gc cleanup */
@@ -67,6 +77,8 @@ __mpz_struct * _fmpz_new_mpz(void)
         mpz_init(z);
     }
 
+    flint_arena_set_current(arena);
+
 #if FLINT_USES_PTHREAD
     pthread_mutex_unlock(&fmpz_lock);
 #endif
@@ -87,8 +99,12 @@ void _fmpz_clear_mpz(fmpz f)
 
     if (mpz_free_num == mpz_free_alloc)
     {
+        flint_arena_struct * arena = flint_arena_set_current(NULL);
+
         mpz_free_alloc = FLINT_MAX(64, mpz_free_alloc * 2);
         mpz_free_arr = flint_realloc(mpz_free_arr, mpz_free_alloc * sizeof(__mpz_struct *));
+
+        flint_arena_set_current(arena);
     }
 
     mpz_free_arr[mpz_free_num++] = ptr;
@@ -127,6 +143,37 @@ void _fmpz_cleanup(void)
 #endif
 }
 
+void _fmpz_mpz_stats(fmpz_mpz_stats_t stats)
+{
+#if FLINT_USES_PTHREAD
+    pthread_once(&fmpz_initialised, fmpz_lock_init);
+    pthread_mutex_lock(&fmpz_lock);
+#endif
+
+    *stats = mpz_stats;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&fmpz_lock);
+#endif
+}
+
+void _fmpz_mpz_stats_reset(void)
+{
+#if FLINT_USES_PTHREAD
+    pthread_once(&fmpz_initialised, fmpz_lock_init);
+    pthread_mutex_lock(&fmpz_lock);
+#endif
+
+    mpz_stats.news = 0;
+    mpz_stats.allocs = 0;
+    mpz_stats.remote = 0;
+    mpz_stats.reclaimed = 0;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&fmpz_lock);
+#endif
+}
+
 __mpz_struct * _fmpz_promote(fmpz_t f)
 {
     if (!COEFF_IS_MPZ(*f)) /* f is small so promote it first */
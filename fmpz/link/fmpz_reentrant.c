@@ -14,25 +14,102 @@
 #include "flint.h"
 #include "fmpz.h"
 
+#if FLINT_USES_TLS
+
+/* Always free larger mpz's to avoid wasting too much heap space */
+#define FLINT_MPZ_MAX_CACHE_LIMBS 64
+
+/*
+   The number of freed mpz's each thread keeps for reuse. The mpz's are
+   individually allocated, so one freed by another thread simply lands in
+   the freeing thread's magazine and no locking is needed.
+*/
+#define MPZ_MAGAZINE_SIZE 256
+
+FLINT_TLS_PREFIX __mpz_struct * mpz_magazine[MPZ_MAGAZINE_SIZE];
+FLINT_TLS_PREFIX ulong mpz_magazine_num = 0;
+
+#endif
+
+/*
+   Without thread local storage there is no magazine, and the counters are
+   shared by all threads and updated without locking, so that they are only
+   indicative when several threads allocate.
+*/
+FLINT_TLS_PREFIX fmpz_mpz_stats_struct mpz_stats = {0, 0, 0, 0};
+
 __mpz_struct * _fmpz_new_mpz(void)
 {
-    __mpz_struct * mpz_ptr = (__mpz_struct *) flint_malloc(sizeof(__mpz_struct));
+    __mpz_struct * mpz_ptr;
+    flint_arena_struct * arena;
+
+    mpz_stats.news++;
+
+#if FLINT_USES_TLS
+    if (mpz_magazine_num != 0)
+        return mpz_magazine[--mpz_magazine_num];
+#endif
+
+    mpz_stats.allocs++;
+
+    /* the mpz may be cached beyond the lifetime of any arena */
+    arena = flint_arena_set_current(NULL);
+    mpz_ptr = (__mpz_struct *) flint_malloc(sizeof(__mpz_struct));
+    flint_arena_set_current(arena);
     mpz_init2(mpz_ptr, 2*FLINT_BITS);
     return mpz_ptr;
 }
 
 void _fmpz_clear_mpz(fmpz f)
 {
+#if FLINT_USES_TLS
+    __mpz_struct * ptr = COEFF_TO_PTR(f);
+
+    if (mpz_magazine_num < MPZ_MAGAZINE_SIZE)
+    {
+        if (ptr->_mp_alloc > FLINT_MPZ_MAX_CACHE_LIMBS)
+            mpz_realloc2(ptr, 2*FLINT_BITS);
+
+        mpz_magazine[mpz_magazine_num++] = ptr;
+        return;
+    }
+#endif
+
     mpz_clear(COEFF_TO_PTR(f));
     flint_free(COEFF_TO_PTR(f));  
 }
 
 void _fmpz_cleanup_mpz_content(void)
 {
+#if FLINT_USES_TLS
+    ulong i;
+
+    for (i = 0; i < mpz_magazine_num; i++)
+    {
+        mpz_clear(mpz_magazine[i]);
+        flint_free(mpz_magazine[i]);
+    }
+
+    mpz_magazine_num = 0;
+#endif
 }
 
 void _fmpz_cleanup(void)
 {
+    _fmpz_cleanup_mpz_content();
+}
+
+void _fmpz_mpz_stats(fmpz_mpz_stats_t stats)
+{
+    *stats = mpz_stats;
+}
+
+void _fmpz_mpz_stats_reset(void)
+{
+    mpz_stats.news = 0;
+    mpz_stats.allocs = 0;
+    mpz_stats.remote = 0;
+    mpz_stats.reclaimed = 0;
 }
 
 __mpz_struct * _fmpz_promote(fmpz_t f)
@@ -87,7 +164,13 @@ void _fmpz_demote_val(fmpz_t f)
 
 void _fmpz_init_readonly_mpz(fmpz_t f, const mpz_t z)
 {
-   __mpz_struct * mpz_ptr = (__mpz_struct *) flint_malloc(sizeof(__mpz_struct));
+   __mpz_struct * mpz_ptr;
+   flint_arena_struct * arena;
+
+    arena = flint_arena_set_current(NULL);
+    mpz_ptr = (__mpz_struct *) flint_malloc(sizeof(__mpz_struct));
+    flint_arena_set_current(arena);
+
     *f = PTR_TO_COEFF(mpz_ptr);
     *mpz_ptr = *z;
 }
@@ -35,10 +35,44 @@
 /* The number of new mpz's allocated at a time */
 #define MPZ_BLOCK 64
 
+/*
+   With atomics, an mpz freed by a thread other than the one owning its
+   block is pushed onto a lock-free list in the block header, and the block
+   onto a lock-free list of its owner, which takes such mpz's back when its
+   own free list runs dry. Once the owner has cleaned up, the lists of its
+   blocks are closed and such frees are counted instead.
+*/
+#define MPZ_REMOTE_CLOSED ((void *) 1)
+
+/* ends the list of pending blocks, so that a listed block has pending != NULL */
+#define MPZ_PENDING_END ((void *) 1)
+
+#if FMPZ_MPZ_REMOTE
+/*
+   The blocks of a thread with remote frees not yet taken back. This stays
+   allocated while any of the blocks does, so that another thread freeing an
+   mpz of such a block can always list it.
+*/
+typedef struct
+{
+    void * pending;
+    slong refs;     /* the blocks, plus one until the owner cleans up */
+}
+fmpz_block_owner_s;
+#endif
+
 FLINT_TLS_PREFIX __mpz_struct ** mpz_free_arr = NULL;
 FLINT_TLS_PREFIX ulong mpz_free_num = 0;
 FLINT_TLS_PREFIX ulong mpz_free_alloc = 0;
 
+#if FMPZ_MPZ_REMOTE
+/* the blocks allocated by this thread, linked through their headers */
+FLINT_TLS_PREFIX fmpz_block_header_s * mpz_blocks = NULL;
+FLINT_TLS_PREFIX fmpz_block_owner_s * mpz_owner = NULL;
+#endif
+
+FLINT_TLS_PREFIX fmpz_mpz_stats_struct mpz_stats = {0, 0, 0, 0};
+
 static slong flint_page_size;
 static slong flint_mpz_structs_per_block;
 static slong flint_page_mask;
@@ -63,62 +97,216 @@ void * flint_align_ptr(void * ptr, slong size)
     return (void *)((mask & (slong) ptr) + size);
 }
 
-__mpz_struct * _fmpz_new_mpz(void)
+static void _fmpz_push_free(__mpz_struct * z)
 {
-    if (mpz_free_num == 0) /* allocate more mpz's */
+    if (mpz_free_num >= mpz_free_alloc)
+    {
+        flint_arena_struct * arena = flint_arena_set_current(NULL);
+
+        mpz_free_alloc = FLINT_MAX(64, mpz_free_alloc * 2);
+        mpz_free_arr = flint_realloc(mpz_free_arr, mpz_free_alloc * sizeof(__mpz_struct *));
+
+        flint_arena_set_current(arena);
+    }
+
+    mpz_free_arr[mpz_free_num++] = z;
+}
+
+#if FMPZ_MPZ_REMOTE
+static void _fmpz_owner_release(fmpz_block_owner_s * owner)
+{
+    if (__atomic_sub_fetch(&(owner->refs), 1, __ATOMIC_ACQ_REL) == 0)
+        flint_free(owner);
+}
+#endif
+
+/* add n to the count of cleared mpz's of a block, freeing it when full */
+static void _fmpz_block_count(fmpz_block_header_s * header_ptr, int n)
+{
+    int new_count;
+
+#if (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)) && FLINT_USES_PTHREAD
+    new_count = __atomic_add_fetch(&(header_ptr->count), n, __ATOMIC_SEQ_CST);
+#elif defined(_MSC_VER) && FLINT_USES_PTHREAD
+    new_count = atomic_add_fetch(&(header_ptr->count), n);
+#else /* may be a very small leak with pthreads */
+    new_count = (header_ptr->count += n);
+#endif
+
+    if (new_count == flint_mpz_structs_per_block)
     {
-        void * aligned_ptr, * ptr;
+#if FMPZ_MPZ_REMOTE
+        _fmpz_owner_release((fmpz_block_owner_s *) header_ptr->owner);
+#endif
+        flint_free(header_ptr);
+    }
+}
 
-        slong i, j, num, block_size, skip;
+static void _fmpz_new_block(void)
+{
+    void * aligned_ptr, * ptr;
+    fmpz_block_header_s * header_ptr;
+    flint_arena_struct * arena;
 
-        flint_page_size = flint_get_page_size();
-        block_size = PAGES_PER_BLOCK*flint_page_size;
-        flint_page_mask = ~(flint_page_size - 1);
+    slong i, j, num, block_size, skip;
 
-        /* get new block */
-        ptr = flint_malloc(block_size + flint_page_size);
+    flint_page_size = flint_get_page_size();
+    block_size = PAGES_PER_BLOCK*flint_page_size;
+    flint_page_mask = ~(flint_page_size - 1);
 
-        /* align to page boundary */
-        aligned_ptr = flint_align_ptr(ptr, flint_page_size);
+    /* get new block, with room for the block header before the first page */
+    arena = flint_arena_set_current(NULL);
+    ptr = flint_malloc(block_size + flint_page_size + sizeof(fmpz_block_header_s));
+    flint_arena_set_current(arena);
 
-        /* set free count to zero and determine if this is the main thread */
-        ((fmpz_block_header_s *) ptr)->count = 0;
+    /* align to page boundary */
+    aligned_ptr = flint_align_ptr((char *) ptr + sizeof(fmpz_block_header_s),
+                                                             flint_page_size);
+
+    /* set free count to zero and determine if this is the main thread */
+    header_ptr = (fmpz_block_header_s *) ptr;
+    header_ptr->count = 0;
 #if FLINT_USES_PTHREAD
-        ((fmpz_block_header_s *) ptr)->thread = pthread_self();
+    header_ptr->thread = pthread_self();
+#endif
+    header_ptr->remote = NULL;
+    header_ptr->pending = NULL;
+#if FMPZ_MPZ_REMOTE
+    if (mpz_owner == NULL)
+    {
+        arena = flint_arena_set_current(NULL);
+        mpz_owner = (fmpz_block_owner_s *) flint_malloc(sizeof(fmpz_block_owner_s));
+        flint_arena_set_current(arena);
+
+        mpz_owner->pending = NULL;
+        mpz_owner->refs = 1;
+    }
+
+    __atomic_add_fetch(&(mpz_owner->refs), 1, __ATOMIC_RELAXED);
+    header_ptr->owner = mpz_owner;
+    header_ptr->next = mpz_blocks;
+    mpz_blocks = header_ptr;
+#else
+    header_ptr->owner = NULL;
+    header_ptr->next = NULL;
 #endif
-        /* how many __mpz_structs worth are dedicated to header, per page */
-        skip = (sizeof(fmpz_block_header_s) - 1)/sizeof(__mpz_struct) + 1;
 
-        /* total number of number of __mpz_structs worth per page */
-        num = flint_page_size/sizeof(__mpz_struct);
+    /* how many __mpz_structs worth are dedicated to header, per page */
+    skip = (sizeof(fmpz_block_header_s) - 1)/sizeof(__mpz_struct) + 1;
+
+    /* total number of number of __mpz_structs worth per page */
+    num = flint_page_size/sizeof(__mpz_struct);
+
+    flint_mpz_structs_per_block = PAGES_PER_BLOCK*(num - skip);
+    mpz_stats.allocs += flint_mpz_structs_per_block;
+
+    for (i = 0; i < PAGES_PER_BLOCK; i++)
+    {
+        __mpz_struct * page_ptr = (__mpz_struct *)((slong) aligned_ptr + i*flint_page_size);
+
+        /* set pointer in each page to start of entire block */
+        ((fmpz_block_header_s *) page_ptr)->address = ptr;
+
+        for (j = skip; j < num; j++)
+        {
+            mpz_init2(page_ptr + j, 2*FLINT_BITS);
+
+            /*
+               Cannot be lifted from loop due to possibility of
+               gc calling _fmpz_clear_mpz during call to mpz_init_2
+            */
+            _fmpz_push_free(page_ptr + j);
+        }
+    }
+}
+
+#if FMPZ_MPZ_REMOTE
+/* take back the mpz's which other threads freed into our blocks */
+static void _fmpz_reclaim_mpz(void)
+{
+    fmpz_block_header_s * header_ptr, * next;
+    __mpz_struct * z, * znext;
+
+    if (mpz_owner == NULL ||
+        __atomic_load_n(&(mpz_owner->pending), __ATOMIC_RELAXED) == NULL)
+        return;
 
-        flint_mpz_structs_per_block = PAGES_PER_BLOCK*(num - skip);
+    header_ptr = __atomic_exchange_n(&(mpz_owner->pending), NULL,
+                                                            __ATOMIC_ACQUIRE);
 
-        for (i = 0; i < PAGES_PER_BLOCK; i++)
+    for ( ; header_ptr != MPZ_PENDING_END; header_ptr = next)
+    {
+        next = header_ptr->pending;
+
+        /* unlist the block before emptying it, so that later frees list it again */
+        __atomic_store_n(&(header_ptr->pending), NULL, __ATOMIC_RELEASE);
+
+        z = __atomic_exchange_n(&(header_ptr->remote), NULL, __ATOMIC_ACQ_REL);
+
+        for ( ; z != NULL; z = znext)
         {
-            __mpz_struct * page_ptr = (__mpz_struct *)((slong) aligned_ptr + i*flint_page_size);
-
-            /* set pointer in each page to start of entire block */
-            ((fmpz_block_header_s *) page_ptr)->address = ptr;
-
-            for (j = skip; j < num; j++)
-            {
-                mpz_init2(page_ptr + j, 2*FLINT_BITS);
-
-                /*
-                   Cannot be lifted from loop due to possibility of
-                   gc calling _fmpz_clear_mpz during call to mpz_init_2
-                */
-                if (mpz_free_num >= mpz_free_alloc)
-                {
-                    mpz_free_alloc = FLINT_MAX(mpz_free_num + 1, mpz_free_alloc * 2);
-                    mpz_free_arr = flint_realloc(mpz_free_arr, mpz_free_alloc * sizeof(__mpz_struct *));
-                }
-
-                mpz_free_arr[mpz_free_num++] = page_ptr + j;
-            }
+            znext = (__mpz_struct *) z->_mp_d;
+            mpz_init2(z, 2*FLINT_BITS);
+            _fmpz_push_free(z);
+            mpz_stats.reclaimed++;
         }
     }
+}
+
+/*
+    Push a cleared mpz onto the remote list of its block, unless closed.
+    The block is listed with its owner first, while the mpz still keeps it
+    alive. If the owner unlists it between the two steps, the mpz waits for
+    the next one freed into the block, or for the owner to clean up.
+*/
+static int _fmpz_remote_push(fmpz_block_header_s * header_ptr, __mpz_struct * z)
+{
+    fmpz_block_owner_s * owner = (fmpz_block_owner_s *) header_ptr->owner;
+    void * head = __atomic_load_n(&(header_ptr->remote), __ATOMIC_RELAXED);
+    void * expected = NULL;
+
+    if (head == MPZ_REMOTE_CLOSED)
+        return 0;
+
+    if (__atomic_compare_exchange_n(&(header_ptr->pending), &expected,
+                  MPZ_PENDING_END, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+    {
+        void * list = __atomic_load_n(&(owner->pending), __ATOMIC_RELAXED);
+
+        do {
+            __atomic_store_n(&(header_ptr->pending),
+                   (list == NULL) ? MPZ_PENDING_END : list, __ATOMIC_RELAXED);
+        } while (!__atomic_compare_exchange_n(&(owner->pending), &list,
+                   (void *) header_ptr, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    }
+
+    do {
+        if (head == MPZ_REMOTE_CLOSED)
+            return 0;
+
+        /* the limbs are gone, so the limb pointer links the list */
+        z->_mp_d = (mp_ptr) head;
+    } while (!__atomic_compare_exchange_n(&(header_ptr->remote), &head, (void *) z,
+                                     1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    return 1;
+}
+#endif
+
+__mpz_struct * _fmpz_new_mpz(void)
+{
+    if (mpz_free_num == 0) /* allocate more mpz's */
+    {
+#if FMPZ_MPZ_REMOTE
+        _fmpz_reclaim_mpz();
+
+        /* if few came back, allocate anyway rather than return here soon */
+        if (mpz_free_num < MPZ_BLOCK)
+#endif
+            _fmpz_new_block();
+    }
+
+    mpz_stats.news++;
 
     return mpz_free_arr[--mpz_free_num];
 }
@@ -133,48 +321,68 @@ void _fmpz_clear_mpz(fmpz f)
     header_ptr = (fmpz_block_header_s *) header_ptr->address;
 
     /* clean up if this is left over from another thread */
-#if FLINT_USES_PTHREAD
+#if FMPZ_MPZ_REMOTE
+    if (!pthread_equal(header_ptr->thread, pthread_self()) ||
+        __atomic_load_n(&(header_ptr->remote), __ATOMIC_RELAXED) == MPZ_REMOTE_CLOSED)
+#elif FLINT_USES_PTHREAD
     if (header_ptr->count != 0 || !pthread_equal(header_ptr->thread, pthread_self()))
 #else
     if (header_ptr->count != 0)
 #endif
     {
-        int new_count;
-
         mpz_clear(ptr);
 
-#if (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)) && FLINT_USES_PTHREAD
-       new_count = __atomic_add_fetch(&(header_ptr->count), 1, __ATOMIC_SEQ_CST);
-#elif defined(_MSC_VER) && FLINT_USES_PTHREAD
-       new_count = atomic_add_fetch(&(header_ptr->count), 1);
-#else
-       new_count = ++header_ptr->count;
+#if FMPZ_MPZ_REMOTE
+        if (_fmpz_remote_push(header_ptr, ptr))
+        {
+            mpz_stats.remote++;
+            return;
+        }
 #endif
-        if (new_count == flint_mpz_structs_per_block)
 
-            flint_free(header_ptr);
+        _fmpz_block_count(header_ptr, 1);
     } else
     {
         if (ptr->_mp_alloc > FLINT_MPZ_MAX_CACHE_LIMBS)
             mpz_realloc2(ptr, 2*FLINT_BITS);
 
-        if (mpz_free_num == mpz_free_alloc)
-        {
-            mpz_free_alloc = FLINT_MAX(64, mpz_free_alloc * 2);
-            mpz_free_arr = flint_realloc(mpz_free_arr, mpz_free_alloc * sizeof(__mpz_struct *));
-        }
-
-        mpz_free_arr[mpz_free_num++] = ptr;
+        _fmpz_push_free(ptr);
     }
 }
 
 void _fmpz_cleanup_mpz_content(void)
 {
     ulong i;
+#if FMPZ_MPZ_REMOTE
+    fmpz_block_header_s * header_ptr, * next;
+    __mpz_struct * z;
+    int n;
+
+    /* close our blocks, so that later frees into them are counted */
+    for (header_ptr = mpz_blocks; header_ptr != NULL; header_ptr = next)
+    {
+        next = header_ptr->next;
+
+        z = __atomic_exchange_n(&(header_ptr->remote), MPZ_REMOTE_CLOSED,
+                                                            __ATOMIC_ACQ_REL);
+        for (n = 0; z != NULL; z = (__mpz_struct *) z->_mp_d)
+            n++;
+
+        if (n != 0)
+            _fmpz_block_count(header_ptr, n);
+    }
+
+    mpz_blocks = NULL;
+
+    if (mpz_owner != NULL)
+    {
+        _fmpz_owner_release(mpz_owner);
+        mpz_owner = NULL;
+    }
+#endif
 
     for (i = 0; i < mpz_free_num; i++)
     {
-       int new_count;
        fmpz_block_header_s * ptr;
 
        mpz_clear(mpz_free_arr[i]);
@@ -184,15 +392,7 @@ void _fmpz_cleanup_mpz_content(void)
 
        ptr = (fmpz_block_header_s *) ptr->address;
 
-#if (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)) && FLINT_USES_PTHREAD
-       new_count = __atomic_add_fetch(&(ptr->count), 1, __ATOMIC_SEQ_CST);
-#elif defined(_MSC_VER) && FLINT_USES_PTHREAD
-       new_count = atomic_add_fetch(&(ptr->count), 1);
-#else /* may be a very small leak with pthreads */
-       new_count = ++ptr->count;
-#endif
-       if (new_count == flint_mpz_structs_per_block)
-          flint_free(ptr);
+       _fmpz_block_count(ptr, 1);
     }
 
     mpz_free_num = mpz_free_alloc = 0;
@@ -205,6 +405,19 @@ void _fmpz_cleanup(void)
     mpz_free_arr = NULL;
 }
 
+void _fmpz_mpz_stats(fmpz_mpz_stats_t stats)
+{
+    *stats = mpz_stats;
+}
+
+void _fmpz_mpz_stats_reset(void)
+{
+    mpz_stats.news = 0;
+    mpz_stats.allocs = 0;
+    mpz_stats.remote = 0;
+    mpz_stats.reclaimed = 0;
+}
+
 __mpz_struct * _fmpz_promote(fmpz_t f)
 {
     if (!COEFF_IS_MPZ(*f)) /* f is small so promote it first */
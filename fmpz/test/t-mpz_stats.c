@@ -0,0 +1,249 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    fmpz * vec;
+    slong len;
+    slong shift;
+    fmpz_mpz_stats_struct stats;
+}
+worker_arg_struct;
+
+/* fill vec with large values, recording the stats of this thread */
+static void worker_fill(void * varg)
+{
+    worker_arg_struct * arg = (worker_arg_struct *) varg;
+    slong i;
+
+    _fmpz_mpz_stats_reset();
+
+    for (i = 0; i < arg->len; i++)
+    {
+        fmpz_set_ui(arg->vec + i, i + 1);
+        fmpz_mul_2exp(arg->vec + i, arg->vec + i, arg->shift);
+    }
+
+    _fmpz_mpz_stats(&arg->stats);
+}
+
+/* allocate until mpz's freed by another thread come back, or give up */
+static void worker_reclaim(void * varg)
+{
+    worker_arg_struct * arg = (worker_arg_struct *) varg;
+    fmpz * v = NULL;
+    slong i, n = 0, alloc = 0;
+
+    _fmpz_mpz_stats_reset();
+    _fmpz_mpz_stats(&arg->stats);
+
+    while (arg->stats.reclaimed == 0 && n < 1000000)
+    {
+        if (n == alloc)
+        {
+            alloc = FLINT_MAX(2*alloc, 1024);
+            v = flint_realloc(v, alloc*sizeof(fmpz));
+        }
+
+        v[n] = 0;
+        fmpz_set_ui(v + n, 1);
+        fmpz_mul_2exp(v + n, v + n, FLINT_BITS);
+        n++;
+
+        _fmpz_mpz_stats(&arg->stats);
+    }
+
+    for (i = 0; i < n; i++)
+        fmpz_clear(v + i);
+
+    flint_free(v);
+}
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mpz_stats....");
+    fflush(stdout);
+
+    /* counters on a single thread */
+    for (iter = 0; iter < 100 * flint_test_multiplier(); iter++)
+    {
+        fmpz_mpz_stats_t stats;
+        fmpz_t a;
+        slong i, n = n_randint(state, 1000) + 1;
+
+        fmpz_init(a);
+        _fmpz_mpz_stats_reset();
+
+        for (i = 0; i < n; i++)
+        {
+            fmpz_set_ui(a, 1);
+            fmpz_mul_2exp(a, a, n_randint(state, 200) + FLINT_BITS);
+            fmpz_zero(a);
+        }
+
+        _fmpz_mpz_stats(stats);
+
+        if (stats->news != n || stats->remote != 0 || stats->reclaimed != 0)
+        {
+            flint_printf("FAIL (single thread):\n");
+            flint_printf("n = %wd, news = %wu, allocs = %wu\n",
+                                               n, stats->news, stats->allocs);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_clear(a);
+    }
+
+    /* mpz's cleared and reused by a thread other than their owner */
+    for (iter = 0; iter < 10 * flint_test_multiplier(); iter++)
+    {
+        thread_pool_handle * handles;
+        slong num_handles, i, j, len;
+        worker_arg_struct arg;
+        fmpz_mpz_stats_t stats;
+        fmpz_t t;
+
+        flint_set_num_threads(2);
+        num_handles = flint_request_threads(&handles, 2);
+
+        len = n_randint(state, 5000) + 1;
+        arg.vec = _fmpz_vec_init(len);
+        arg.len = len;
+        fmpz_init(t);
+
+        for (j = 0; j < 3; j++)
+        {
+            arg.shift = n_randint(state, 300) + FLINT_BITS;
+
+            if (num_handles > 0)
+            {
+                thread_pool_wake(global_thread_pool, handles[0], 0,
+                                                           worker_fill, &arg);
+                thread_pool_wait(global_thread_pool, handles[0]);
+            }
+            else
+            {
+                worker_fill(&arg);
+            }
+
+            if (arg.stats.news < len || (FMPZ_MPZ_REMOTE && num_handles > 0 &&
+                         arg.stats.remote != (j == 0 ? 0 : (len + 1)/2)))
+            {
+                flint_printf("FAIL (worker stats):\n");
+                flint_printf("len = %wd, news = %wu, allocs = %wu, remote = %wu\n",
+                   len, arg.stats.news, arg.stats.allocs, arg.stats.remote);
+                fflush(stdout);
+                flint_abort();
+            }
+
+            for (i = 0; i < len; i++)
+            {
+                fmpz_set_ui(t, i + 1);
+                fmpz_mul_2exp(t, t, arg.shift);
+
+                if (!fmpz_equal(arg.vec + i, t))
+                {
+                    flint_printf("FAIL (value):\n");
+                    flint_printf("i = %wd, shift = %wd\n", i, arg.shift);
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+
+            /* free the worker's mpz's here and allocate some of our own */
+            _fmpz_mpz_stats_reset();
+
+            _fmpz_vec_zero(arg.vec, len);
+
+            _fmpz_mpz_stats(stats);
+
+            if (stats->remote != ((FMPZ_MPZ_REMOTE && num_handles > 0) ? len : 0))
+            {
+                flint_printf("FAIL (remote):\n");
+                flint_printf("len = %wd, remote = %wu\n", len, stats->remote);
+                fflush(stdout);
+                flint_abort();
+            }
+
+            for (i = 0; i < len; i += 2)
+            {
+                fmpz_set_ui(arg.vec + i, i + 1);
+                fmpz_mul_2exp(arg.vec + i, arg.vec + i, FLINT_BITS);
+            }
+        }
+
+        _fmpz_vec_clear(arg.vec, len);
+        fmpz_clear(t);
+
+        flint_give_back_threads(handles, num_handles);
+    }
+
+    /* mpz's freed by another thread are reused by their owner */
+    for (iter = 0; iter < 10 * flint_test_multiplier(); iter++)
+    {
+        thread_pool_handle * handles;
+        slong num_handles, len;
+        worker_arg_struct arg;
+        fmpz_mpz_stats_t stats;
+
+        flint_set_num_threads(2);
+        num_handles = flint_request_threads(&handles, 2);
+
+        if (!FMPZ_MPZ_REMOTE || num_handles == 0)
+        {
+            flint_give_back_threads(handles, num_handles);
+            continue;
+        }
+
+        /* at least one batch, so that no new block is needed to refill */
+        len = n_randint(state, 5000) + 64;
+        arg.vec = _fmpz_vec_init(len);
+        arg.len = len;
+        arg.shift = n_randint(state, 300) + FLINT_BITS;
+
+        thread_pool_wake(global_thread_pool, handles[0], 0, worker_fill, &arg);
+        thread_pool_wait(global_thread_pool, handles[0]);
+
+        _fmpz_mpz_stats_reset();
+        _fmpz_vec_zero(arg.vec, len);
+        _fmpz_mpz_stats(stats);
+
+        thread_pool_wake(global_thread_pool, handles[0], 0, worker_reclaim, &arg);
+        thread_pool_wait(global_thread_pool, handles[0]);
+
+        /* mpz's left over from the loop above may come back as well */
+        if (stats->remote != len || arg.stats.reclaimed < len ||
+                                                       arg.stats.allocs != 0)
+        {
+            flint_printf("FAIL (reclaim):\n");
+            flint_printf("len = %wd, remote = %wu, reclaimed = %wu, allocs = %wu\n",
+                  len, stats->remote, arg.stats.reclaimed, arg.stats.allocs);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        _fmpz_vec_clear(arg.vec, len);
+
+        flint_give_back_threads(handles, num_handles);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
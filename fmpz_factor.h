@@ -114,6 +114,9 @@ FLINT_DLL void fmpz_factor_divisor_sigma(fmpz_t res, const fmpz_factor_t fac, ul
 
 /* ECM Factoring functions ***************************************************/
 
+/* B2 from which stage II uses the polynomial continuation */
+#define FMPZ_FACTOR_ECM_FFT_CUTOFF 100000
+
 typedef struct ecm_s {
 
     mp_ptr t, u, v, w;  /* temp variables */
@@ -166,6 +169,9 @@ FLINT_DLL int fmpz_factor_ecm_stage_I(mp_ptr f, const mp_limb_t *prime_array,
 FLINT_DLL int fmpz_factor_ecm_stage_II(mp_ptr f, mp_limb_t B1, mp_limb_t B2,
                                        mp_limb_t P, mp_ptr n, ecm_t ecm_inf);
 
+FLINT_DLL int fmpz_factor_ecm_stage_II_FFT(mp_ptr f, mp_limb_t B1,
+                                 mp_limb_t B2, mp_ptr n, ecm_t ecm_inf);
+
 FLINT_DLL int fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1,
                         mp_limb_t B2, flint_rand_t state, const fmpz_t n_in);
 
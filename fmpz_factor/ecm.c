@@ -16,6 +16,7 @@
 #include "flint.h"
 #include "fmpz.h"
 #include "mpn_extras.h"
+#include "thread_support.h"
 
 static
 ulong n_ecm_primorial[] =
@@ -43,16 +44,178 @@ ulong n_ecm_primorial[] =
 #define num_n_ecm_primorials 9
 #endif
 
+typedef struct
+{
+    mp_srcptr n;
+    mp_srcptr ninv;
+    mp_limb_t n_size;
+    mp_limb_t normbits;
+    const mp_limb_t * prime_array;
+    mp_limb_t num;
+    mp_limb_t B1;
+    mp_limb_t B2;
+    mp_limb_t P;
+    int fft;
+    unsigned char * GCD_table;
+    unsigned char ** prime_table;
+    flint_rand_s * state;
+    const fmpz * nm8;
+    mp_limb_t curves;
+    mp_limb_t next_curve;
+    volatile int found;   /* set once any worker has a factor */
+    int ret;
+    mp_ptr fac;
+    mp_size_t fac_size;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+}
+_ecm_curves_t;
+
+/* Each worker tries curves until they are exhausted or some worker finds a
+   factor. The sigmas are drawn from the shared state in curve order, so a
+   single worker tries exactly the same curves as the serial code did. */
+static void
+_ecm_curves_worker(void * arg_ptr)
+{
+    _ecm_curves_t * arg = (_ecm_curves_t *) arg_ptr;
+    mp_limb_t n_size = arg->n_size, cy;
+    mp_ptr n = (mp_ptr) arg->n;
+    mp_ptr mpsig, f;
+    __mpz_struct * mpz_ptr;
+    ecm_t ecm_inf;
+    fmpz_t sig;
+    int ret, stage;
+
+    fmpz_factor_ecm_init(ecm_inf, n_size);
+    ecm_inf->normbits = arg->normbits;
+    flint_mpn_copyi(ecm_inf->ninv, arg->ninv, n_size);
+    ecm_inf->one[0] = UWORD(1) << arg->normbits;
+    ecm_inf->GCD_table = arg->GCD_table;
+    ecm_inf->prime_table = arg->prime_table;
+
+    mpsig = flint_malloc(n_size * sizeof(mp_limb_t));
+    f = flint_malloc(n_size * sizeof(mp_limb_t));
+    fmpz_init(sig);
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&arg->mutex);
+#endif
+        ret = !arg->found && arg->next_curve < arg->curves;
+        if (ret)
+        {
+            arg->next_curve++;
+            fmpz_randm(sig, arg->state, arg->nm8);
+        }
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&arg->mutex);
+#endif
+
+        if (!ret)
+            break;
+
+        fmpz_add_ui(sig, sig, 7);
+
+        mpn_zero(mpsig, n_size);
+
+        if ((!COEFF_IS_MPZ(*sig)))
+        {
+            mpsig[0] = fmpz_get_ui(sig);
+            if (ecm_inf->normbits)
+            {
+                cy = mpn_lshift(mpsig, mpsig, 1, ecm_inf->normbits);
+                if (cy)
+                   mpsig[1] = cy;
+            }
+        }
+        else
+        {
+            mpz_ptr = COEFF_TO_PTR(*sig);
+
+            if (ecm_inf->normbits)
+            {
+                cy = mpn_lshift(mpsig, mpz_ptr->_mp_d, mpz_ptr->_mp_size, ecm_inf->normbits);
+                if (cy)
+                    mpsig[mpz_ptr->_mp_size] = cy;
+            } else
+            {
+                flint_mpn_copyi(mpsig, mpz_ptr->_mp_d, mpz_ptr->_mp_size);
+            }
+        }
+
+        /************************ SELECT CURVE ************************/
+
+        stage = -1;
+        ret = fmpz_factor_ecm_select_curve(f, mpsig, n, ecm_inf);
+
+        /* ret == -1 means the curve is unsuitable, try the next one */
+        if (ret == 0)
+        {
+            /************************** STAGE I ***************************/
+
+            stage = 1;
+            ret = fmpz_factor_ecm_stage_I(f, arg->prime_array, arg->num,
+                                          arg->B1, n, ecm_inf);
+
+            /************************** STAGE II ***************************/
+
+            if (ret == 0 && !arg->found)
+            {
+                stage = 2;
+                if (arg->fft)
+                    ret = fmpz_factor_ecm_stage_II_FFT(f, arg->B1, arg->B2,
+                                                                n, ecm_inf);
+                else
+                    ret = fmpz_factor_ecm_stage_II(f, arg->B1, arg->B2, arg->P,
+                                                                n, ecm_inf);
+            }
+        }
+
+        if (ret > 0)
+        {
+            /* first worker to find a factor reports it, the others stop */
+#if FLINT_USES_PTHREAD
+            pthread_mutex_lock(&arg->mutex);
+#endif
+            if (!arg->found)
+            {
+                flint_mpn_copyi(arg->fac, f, ret);
+                arg->fac_size = ret;
+                arg->ret = stage;
+                arg->found = 1;
+            }
+#if FLINT_USES_PTHREAD
+            pthread_mutex_unlock(&arg->mutex);
+#endif
+            break;
+        }
+    }
+
+    fmpz_clear(sig);
+    flint_free(f);
+    flint_free(mpsig);
+
+    ecm_inf->GCD_table = NULL;
+    ecm_inf->prime_table = NULL;
+    fmpz_factor_ecm_clear(ecm_inf);
+}
+
 int
 fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
                 flint_rand_t state, const fmpz_t n_in)
 {
-    fmpz_t sig, nm8;
-    mp_limb_t P, num, maxP, mmin, mmax, mdiff, prod, maxj, n_size, cy;
-    int i, j, ret;
-    ecm_t ecm_inf;
+    fmpz_t nm8;
+    mp_limb_t P, num, maxP, mmin, mmax, mdiff, prod, maxj, n_size, normbits;
+    slong i, j, num_handles;
+    int ret, fft;
     __mpz_struct *fac, *mpz_ptr;
-    mp_ptr n, mpsig;
+    mp_ptr n, ninv;
+    unsigned char * GCD_table;
+    unsigned char ** prime_table;
+    thread_pool_handle * handles;
+    _ecm_curves_t arg;
 
     TMP_INIT;
 
@@ -66,37 +229,32 @@ fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
         return ret;
     }
 
-    fmpz_factor_ecm_init(ecm_inf, n_size);
-
     TMP_START;
 
     n      = TMP_ALLOC(n_size * sizeof(mp_limb_t));
-    mpsig  = TMP_ALLOC(n_size * sizeof(mp_limb_t));
+    ninv   = TMP_ALLOC(n_size * sizeof(mp_limb_t));
 
     if ((!COEFF_IS_MPZ(* n_in)))
     {
-        count_leading_zeros(ecm_inf->normbits, fmpz_get_ui(n_in));
+        count_leading_zeros(normbits, fmpz_get_ui(n_in));
         n[0] = fmpz_get_ui(n_in);
-        n[0] <<= ecm_inf->normbits;
+        n[0] <<= normbits;
     }
     else
     {
         mpz_ptr = COEFF_TO_PTR(* n_in);
-        count_leading_zeros(ecm_inf->normbits, mpz_ptr->_mp_d[n_size - 1]);
-        if (ecm_inf->normbits)
-           mpn_lshift(n, mpz_ptr->_mp_d, n_size, ecm_inf->normbits);
+        count_leading_zeros(normbits, mpz_ptr->_mp_d[n_size - 1]);
+        if (normbits)
+           mpn_lshift(n, mpz_ptr->_mp_d, n_size, normbits);
         else
            flint_mpn_copyi(n, mpz_ptr->_mp_d, n_size);
     }
 
-    flint_mpn_preinvn(ecm_inf->ninv, n, n_size);
-    ecm_inf->one[0] = UWORD(1) << ecm_inf->normbits;
+    flint_mpn_preinvn(ninv, n, n_size);
 
-    fmpz_init(sig);
     fmpz_init(nm8);
     fmpz_sub_ui(nm8, n_in, 8);
 
-    ret = 0;
     fac = _fmpz_promote(f);
     mpz_realloc(fac, fmpz_size(n_in));
 
@@ -127,153 +285,122 @@ fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
        flint_abort();
     }
     maxj = (P + 1)/2; 
-    mdiff = mmax - mmin + 1;
 
-    /* compute GCD_table */
+    /* for large B2 the polynomial continuation is used, which needs
+       neither table of primes */
+    fft = (B2 >= FMPZ_FACTOR_ECM_FFT_CUTOFF);
+    mdiff = fft ? 0 : mmax - mmin + 1;
+
+    /* compute GCD_table, shared read only by all the curves */
 
-    ecm_inf->GCD_table = flint_malloc(maxj + 1);
+    GCD_table = flint_malloc(maxj + 1);
 
     for (j = 1; j <= maxj; j += 2)
     {
         if ((j%2) && n_gcd(j, P) == 1)
-            ecm_inf->GCD_table[j] = 1;  
+            GCD_table[j] = 1;  
         else
-            ecm_inf->GCD_table[j] = 0;
+            GCD_table[j] = 0;
     }  
 
     /* compute prime table */
 
-    ecm_inf->prime_table = flint_malloc(mdiff * sizeof(unsigned char*));
+    prime_table = flint_malloc(FLINT_MAX(mdiff, 1) * sizeof(unsigned char*));
 
     for (i = 0; i < mdiff; i++)
-        ecm_inf->prime_table[i] = flint_malloc((maxj + 1) * sizeof(unsigned char));
+        prime_table[i] = flint_malloc((maxj + 1) * sizeof(unsigned char));
 
     for (i = 0; i < mdiff; i++)
     {
         for (j = 1; j <= maxj; j += 2)
         {
-            ecm_inf->prime_table[i][j] = 0;
+            prime_table[i][j] = 0;
 
             /* if (i + mmin)*P + j
                is prime, mark 1. Can be possibly prime
                only if gcd(j, P) = 1 */
 
-            if (ecm_inf->GCD_table[j] == 1)
+            if (GCD_table[j] == 1)
             {
                 prod = (i + mmin)*P + j;
                 if (n_is_prime(prod))
-                    ecm_inf->prime_table[i][j] = 1;
+                    prime_table[i][j] = 1;
 
                 prod = (i + mmin)*P - j;
                 if (n_is_prime(prod))
-                    ecm_inf->prime_table[i][j] = 1;
+                    prime_table[i][j] = 1;
             }
         }
     }
 
-
     /****************************** TRY "CURVES" *****************************/
 
-    for (j = 0; j < curves; j++)
-    {
-        fmpz_randm(sig, state, nm8);
-        fmpz_add_ui(sig, sig, 7);
-
-        mpn_zero(mpsig, ecm_inf->n_size);
-        
-        if ((!COEFF_IS_MPZ(*sig)))
-        {
-            mpsig[0] = fmpz_get_ui(sig);
-            if (ecm_inf->normbits)
-            {
-                cy = mpn_lshift(mpsig, mpsig, 1, ecm_inf->normbits);
-                if (cy)
-                   mpsig[1] = cy;
-            }
-        }
-        else
-        {
-            mpz_ptr = COEFF_TO_PTR(*sig);
-
-            if (ecm_inf->normbits)
-            {
-                cy = mpn_lshift(mpsig, mpz_ptr->_mp_d, mpz_ptr->_mp_size, ecm_inf->normbits);
-                if (cy)
-                    mpsig[mpz_ptr->_mp_size] = cy;
-            } else
-            {
-                flint_mpn_copyi(mpsig, mpz_ptr->_mp_d, mpz_ptr->_mp_size);
-            }
-        }
+    arg.n = n;
+    arg.ninv = ninv;
+    arg.n_size = n_size;
+    arg.normbits = normbits;
+    arg.prime_array = prime_array;
+    arg.num = num;
+    arg.B1 = B1;
+    arg.B2 = B2;
+    arg.P = P;
+    arg.fft = fft;
+    arg.GCD_table = GCD_table;
+    arg.prime_table = prime_table;
+    arg.state = state;
+    arg.nm8 = nm8;
+    arg.curves = curves;
+    arg.next_curve = 0;
+    arg.found = 0;
+    arg.ret = 0;
+    arg.fac = fac->_mp_d;
+    arg.fac_size = 0;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&arg.mutex, NULL);
+#endif
 
-        /************************ SELECT CURVE ************************/
+    /* the curves are independent, so run one stream of them per thread */
+    num_handles = flint_request_threads(&handles,
+                                   FLINT_MIN(flint_get_num_threads(), curves));
 
-        ret = fmpz_factor_ecm_select_curve(fac->_mp_d, mpsig, n, ecm_inf);
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                                   _ecm_curves_worker, &arg);
 
-        if (ret)
-        {
-            /* Found factor while selecting curve,
-               very very lucky :) */
+    _ecm_curves_worker(&arg);
 
-            if (ecm_inf->normbits)
-               mpn_rshift(fac->_mp_d, fac->_mp_d, ret, ecm_inf->normbits);
-            MPN_NORM(fac->_mp_d, ret);
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
 
-            fac->_mp_size = ret;
-            _fmpz_demote_val(f);    
-            ret = -1;
-            goto cleanup;
-        }
+    flint_give_back_threads(handles, num_handles);
 
-        if (ret != -1)
-        {
-
-            /************************** STAGE I ***************************/
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&arg.mutex);
+#endif
 
-            ret = fmpz_factor_ecm_stage_I(fac->_mp_d, prime_array, num, B1, n, ecm_inf);
+    ret = arg.ret;
 
-            if (ret)
-            {
-                /* Found factor after stage I */
-                if (ecm_inf->normbits)
-                   mpn_rshift(fac->_mp_d, fac->_mp_d, ret, ecm_inf->normbits);
-                MPN_NORM(fac->_mp_d, ret);
-
-                fac->_mp_size = ret;
-                _fmpz_demote_val(f);    
-                ret = 1;
-                goto cleanup;
-            }  
-            /************************** STAGE II ***************************/
+    if (ret != 0)
+    {
+        mp_size_t sz = arg.fac_size;
 
-            ret = fmpz_factor_ecm_stage_II(fac->_mp_d, B1, B2, P, n, ecm_inf);
+        if (normbits)
+           mpn_rshift(fac->_mp_d, fac->_mp_d, sz, normbits);
+        MPN_NORM(fac->_mp_d, sz);
 
-            if (ret)
-            {
-                /* Found factor after stage II */
-                if (ecm_inf->normbits)
-                   mpn_rshift(fac->_mp_d, fac->_mp_d, ret, ecm_inf->normbits);
-                MPN_NORM(fac->_mp_d, ret);
-                fac->_mp_size = ret;
-                _fmpz_demote_val(f);  
-                ret = 2;
-                goto cleanup;
-            }
-        }
+        fac->_mp_size = sz;
     }
+    else
+        fac->_mp_size = 0;
 
-    cleanup:
-
+    _fmpz_demote_val(f);
 
-    flint_free(ecm_inf->GCD_table);
+    flint_free(GCD_table);
     for (i = 0; i < mdiff; i++)
-        flint_free(ecm_inf->prime_table[i]);
-    flint_free(ecm_inf->prime_table);
-
-    fmpz_factor_ecm_clear(ecm_inf);
+        flint_free(prime_table[i]);
+    flint_free(prime_table);
    
     fmpz_clear(nm8);
-    fmpz_clear(sig);
 
     TMP_END;
 
@@ -0,0 +1,332 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mod_poly.h"
+#include "mpn_extras.h"
+
+/* Polynomial ("FFT") continuation for stage II of ECM.
+
+   With Q the point left by stage I and D a multiple of a primorial, every
+   prime q in (B1, B2] is i*D +/- j with gcd(j, D) = 1 and j < D/2. As only
+   x-coordinates are used, q*Q = 0 modulo p exactly when x(i*D*Q) = x(j*Q)
+   modulo p. So p divides the product over all i of F(x(i*D*Q)) where
+
+      F(X) = prod_j (X - x(j*Q)).
+
+   Rather than evaluating F at every giant step, the giant steps are taken
+   in blocks of deg(F), the polynomial with those roots is built with a
+   product tree and the product of these polynomials is accumulated modulo
+   F. A single multipoint evaluation at the roots of F then gives the same
+   product up to sign. The cost is quasi-linear in the number of baby and
+   giant steps instead of linear in the number of primes up to B2. */
+
+/* get the affine x-coordinate modulo N out of the shifted mpn
+   representation used by the ECM arithmetic */
+static void
+_ecm_fmpz_set_mpn(fmpz_t r, mp_srcptr x, mp_limb_t n_size, mp_limb_t normbits)
+{
+    fmpz_set_ui_array(r, x, n_size);
+    fmpz_fdiv_q_2exp(r, r, normbits);
+}
+
+/* write the factor g back in the shifted representation, returning
+   the number of limbs as the other stages do */
+static int
+_ecm_set_factor(mp_ptr f, const fmpz_t g, ecm_t ecm_inf)
+{
+    fmpz_t t;
+    mp_size_t sz;
+
+    fmpz_init(t);
+    fmpz_mul_2exp(t, g, ecm_inf->normbits);
+
+    sz = fmpz_size(t);
+    if (COEFF_IS_MPZ(*t))
+        flint_mpn_copyi(f, COEFF_TO_PTR(*t)->_mp_d, sz);
+    else
+        f[0] = fmpz_get_ui(t);
+
+    fmpz_clear(t);
+
+    return sz;
+}
+
+/* Set xs[i] to xs[i]/zs[i] modulo N using a single inversion. If some
+   zs[i] is not invertible, set g to a proper factor of N if one is exposed
+   (returning -1), or return 0 if every candidate is 0 modulo N. */
+static int
+_ecm_normalise(fmpz * xs, const fmpz * zs, slong len, const fmpz_t N,
+                                                                    fmpz_t g)
+{
+    fmpz * t;
+    fmpz_t inv, zinv;
+    slong i;
+    int ret = 1;
+
+    t = _fmpz_vec_init(len);
+    fmpz_init(inv);
+    fmpz_init(zinv);
+
+    fmpz_set(t + 0, zs + 0);
+    for (i = 1; i < len; i++)
+    {
+        fmpz_mul(t + i, t + i - 1, zs + i);
+        fmpz_mod(t + i, t + i, N);
+    }
+
+    if (!fmpz_invmod(inv, t + len - 1, N))
+    {
+        ret = 0;
+
+        fmpz_gcd(g, t + len - 1, N);
+        if (!fmpz_equal(g, N))
+        {
+            ret = -1;
+        }
+        else
+        {
+            for (i = 0; i < len; i++)
+            {
+                fmpz_gcd(g, zs + i, N);
+                if (!fmpz_is_one(g) && !fmpz_equal(g, N))
+                {
+                    ret = -1;
+                    break;
+                }
+            }
+        }
+
+        goto cleanup;
+    }
+
+    for (i = len - 1; i > 0; i--)
+    {
+        fmpz_mul(zinv, inv, t + i - 1);
+        fmpz_mul(inv, inv, zs + i);
+        fmpz_mod(inv, inv, N);
+        fmpz_mul(xs + i, xs + i, zinv);
+        fmpz_mod(xs + i, xs + i, N);
+    }
+
+    fmpz_mul(xs + 0, xs + 0, inv);
+    fmpz_mod(xs + 0, xs + 0, N);
+
+cleanup:
+
+    fmpz_clear(zinv);
+    fmpz_clear(inv);
+    _fmpz_vec_clear(t, len);
+
+    return ret;
+}
+
+static const mp_limb_t _ecm_fft_primorials[] = { 6, 30, 210, 2310 };
+
+int
+fmpz_factor_ecm_stage_II_FFT(mp_ptr f, mp_limb_t B1, mp_limb_t B2,
+                                                     mp_ptr n, ecm_t ecm_inf)
+{
+    mp_limb_t D, D0, P0, t, mmin, mmax, j, n_size = ecm_inf->n_size;
+    slong i, m, k, b, blen, num_baby, res;
+    mp_ptr Q0x2, Q0z2, Dx, Dz, Rx, Rz, Sx, Sz, tx, tz;
+    mp_ptr bx[3], bz[3];
+    fmpz * xs, * zs, * vals;
+    fmpz_mod_ctx_t ctx;
+    fmpz_mod_poly_t F, Finv, G, H;
+    fmpz_t N, g, acc;
+    int ret = 0;
+
+    TMP_INIT;
+
+    if (B2 <= B1)
+        return 0;
+
+    /* Choose D = P0*t so that the number of baby steps phi(D)/2, about
+       D/10, is around a quarter of the number of giant steps (B2 - B1)/D.
+       Building F and the final evaluation then cost about as much as the
+       blocks of giant steps. */
+    D0 = n_sqrt(10*(B2 - B1)/4);
+
+    for (i = 3; i > 0 && _ecm_fft_primorials[i] > D0; i--) ;
+    P0 = _ecm_fft_primorials[i];
+    t = FLINT_MAX(1, (D0 + P0/2)/P0);
+    D = P0*t;
+
+    mmin = FLINT_MAX(1, (B1 + D/2)/D);
+    mmax = (B2 + D/2)/D;
+    if (mmax < mmin)
+        mmax = mmin;
+
+    k = mmax - mmin + 1;
+
+    num_baby = 0;
+    for (j = 1; j < D/2 + 1; j += 2)
+        if (n_gcd(j, D) == 1)
+            num_baby++;
+
+    TMP_START;
+
+    Q0x2 = TMP_ALLOC(10*n_size*sizeof(mp_limb_t));
+    Q0z2 = Q0x2 + n_size;
+    Dx = Q0z2 + n_size;
+    Dz = Dx + n_size;
+    Rx = Dz + n_size;
+    Rz = Rx + n_size;
+    Sx = Rz + n_size;
+    Sz = Sx + n_size;
+    tx = Sz + n_size;
+    tz = tx + n_size;
+    bx[0] = TMP_ALLOC(6*n_size*sizeof(mp_limb_t));
+    bz[0] = bx[0] + n_size;
+    bx[1] = bz[0] + n_size;
+    bz[1] = bx[1] + n_size;
+    bx[2] = bz[1] + n_size;
+    bz[2] = bx[2] + n_size;
+
+    fmpz_init(N);
+    fmpz_init(g);
+    fmpz_init(acc);
+
+    _ecm_fmpz_set_mpn(N, n, n_size, ecm_inf->normbits);
+
+    xs = _fmpz_vec_init(num_baby + k);
+    zs = _fmpz_vec_init(num_baby + k);
+
+    /* baby steps j*Q for odd j < D/2 via (j + 2)Q = jQ + 2Q, keeping
+       those with gcd(j, D) = 1 */
+    mpn_zero(Q0x2, n_size);
+    mpn_zero(Q0z2, n_size);
+    fmpz_factor_ecm_double(Q0x2, Q0z2, ecm_inf->x, ecm_inf->z, n, ecm_inf);
+
+    flint_mpn_copyi(bx[0], ecm_inf->x, n_size);
+    flint_mpn_copyi(bz[0], ecm_inf->z, n_size);
+
+    m = 0;
+    for (j = 1, i = 0; j < D/2 + 1; j += 2, i++)
+    {
+        mp_ptr cx = bx[i % 3], cz = bz[i % 3];
+
+        if (j == 3)
+        {
+            fmpz_factor_ecm_add(cx, cz, Q0x2, Q0z2, bx[0], bz[0],
+                                                     bx[0], bz[0], n, ecm_inf);
+        }
+        else if (j > 3)
+        {
+            /* jQ = (j - 2)Q + 2Q, with difference (j - 4)Q */
+            fmpz_factor_ecm_add(cx, cz, bx[(i + 2) % 3], bz[(i + 2) % 3],
+                     Q0x2, Q0z2, bx[(i + 1) % 3], bz[(i + 1) % 3], n, ecm_inf);
+        }
+
+        if (n_gcd(j, D) == 1)
+        {
+            _ecm_fmpz_set_mpn(xs + m, cx, n_size, ecm_inf->normbits);
+            _ecm_fmpz_set_mpn(zs + m, cz, n_size, ecm_inf->normbits);
+            m++;
+        }
+    }
+
+    /* giant steps i*D*Q for mmin <= i <= mmax */
+    fmpz_factor_ecm_mul_montgomery_ladder(Dx, Dz, ecm_inf->x, ecm_inf->z,
+                                                             D, n, ecm_inf);
+    fmpz_factor_ecm_mul_montgomery_ladder(Rx, Rz, Dx, Dz, mmin, n, ecm_inf);
+    fmpz_factor_ecm_mul_montgomery_ladder(Sx, Sz, Dx, Dz, mmin + 1, n, ecm_inf);
+
+    for (i = 0; i < k; i++)
+    {
+        _ecm_fmpz_set_mpn(xs + m + i, Rx, n_size, ecm_inf->normbits);
+        _ecm_fmpz_set_mpn(zs + m + i, Rz, n_size, ecm_inf->normbits);
+
+        if (i + 1 < k)
+        {
+            /* (i + 2)D*Q = (i + 1)D*Q + D*Q, with difference i*D*Q */
+            fmpz_factor_ecm_add(tx, tz, Sx, Sz, Dx, Dz, Rx, Rz, n, ecm_inf);
+            flint_mpn_copyi(Rx, Sx, n_size);
+            flint_mpn_copyi(Rz, Sz, n_size);
+            flint_mpn_copyi(Sx, tx, n_size);
+            flint_mpn_copyi(Sz, tz, n_size);
+        }
+    }
+
+    /* pass to affine coordinates, any non invertible z exposes a factor */
+    res = _ecm_normalise(xs, zs, m + k, N, g);
+    if (res != 1)
+    {
+        if (res == -1)
+            ret = _ecm_set_factor(f, g, ecm_inf);
+        goto cleanup;
+    }
+
+    /* H = prod_i (X - x(i*D*Q)) mod F, accumulated a block of m giant
+       steps at a time, then the product of H over the roots of F */
+    fmpz_mod_ctx_init(ctx, N);
+    fmpz_mod_poly_init(F, ctx);
+    fmpz_mod_poly_init(Finv, ctx);
+    fmpz_mod_poly_init(G, ctx);
+    fmpz_mod_poly_init(H, ctx);
+
+    fmpz_mod_poly_product_roots_fmpz_vec(F, xs, m, ctx);
+    fmpz_mod_poly_reverse(Finv, F, m + 1, ctx);
+    fmpz_mod_poly_inv_series_newton(Finv, Finv, m + 1, ctx);
+
+    fmpz_mod_poly_one(H, ctx);
+    for (b = 0; b < k; b += m)
+    {
+        blen = FLINT_MIN(m, k - b);
+
+        fmpz_mod_poly_product_roots_fmpz_vec(G, xs + m + b, blen, ctx);
+
+        /* both monic of degree m, so this is G mod F */
+        if (blen == m)
+            fmpz_mod_poly_sub(G, G, F, ctx);
+
+        fmpz_mod_poly_mulmod_preinv(H, H, G, F, Finv, ctx);
+    }
+
+    vals = _fmpz_vec_init(m);
+    fmpz_mod_poly_evaluate_fmpz_vec_fast(vals, H, xs, m, ctx);
+
+    fmpz_one(acc);
+    for (i = 0; i < m; i++)
+    {
+        fmpz_mul(acc, acc, vals + i);
+        fmpz_mod(acc, acc, N);
+    }
+
+    _fmpz_vec_clear(vals, m);
+
+    fmpz_mod_poly_clear(H, ctx);
+    fmpz_mod_poly_clear(G, ctx);
+    fmpz_mod_poly_clear(Finv, ctx);
+    fmpz_mod_poly_clear(F, ctx);
+    fmpz_mod_ctx_clear(ctx);
+
+    fmpz_gcd(g, acc, N);
+
+    if (!fmpz_is_one(g) && !fmpz_equal(g, N))
+        ret = _ecm_set_factor(f, g, ecm_inf);
+
+cleanup:
+
+    _fmpz_vec_clear(xs, num_baby + k);
+    _fmpz_vec_clear(zs, num_baby + k);
+
+    fmpz_clear(acc);
+    fmpz_clear(g);
+    fmpz_clear(N);
+
+    TMP_END;
+
+    return ret;
+}
@@ -13,6 +13,7 @@
 #include "flint.h"
 #include "fmpz.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 int main(void)
 {
@@ -41,6 +42,8 @@ int main(void)
 
             fmpz_mul(primeprod, prime1, prime2);
 
+            flint_set_num_threads(n_randint(state, 5) + 1);
+
             k = fmpz_factor_ecm(fac, i << 2, 2000, 50000, state, primeprod);
 
             if (k == 0)
@@ -68,6 +71,43 @@ int main(void)
         abort();
     }
 
+    /* stage II with the polynomial continuation, B2 = B1^2 */
+    fails = 0;
+
+    for (i = 40; i <= 50; i += 5)
+    {
+        for (j = 0; j < flint_test_multiplier(); j++)
+        {
+            fmpz_set_ui(prime1, n_randprime(state, i, 1));
+            fmpz_set_ui(prime2, n_randprime(state, i, 1));
+
+            fmpz_mul(primeprod, prime1, prime2);
+
+            flint_set_num_threads(n_randint(state, 5) + 1);
+
+            k = fmpz_factor_ecm(fac, i, 500, 500*500, state, primeprod);
+
+            if (k == 0)
+                fails += 1;
+            else if (!fmpz_divisible(primeprod, fac) || fmpz_is_one(fac)
+                                          || fmpz_equal(fac, primeprod))
+            {
+                printf("FAIL : Wrong factor calculated (FFT stage II)\n");
+                printf("n : ");
+                fmpz_print(primeprod);
+                printf(" factor calculated : ");
+                fmpz_print(fac);
+                abort();
+            }
+        }
+    }
+
+    if (fails > flint_test_multiplier())
+    {
+        printf("FAIL : FFT stage II failed too many times (%d times)\n", fails);
+        abort();
+    }
+
     /* Tests for hangs and crashes, don't care about result */
 
 #if FLINT64
@@ -16,6 +16,7 @@
 #include "flint.h"
 #include "fmpz.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 void checkb(fmpz_t n, slong bits)
 {
@@ -184,6 +185,8 @@ int main(void)
 
        fmpz_factor_init(factors);
 
+       flint_set_num_threads(n_randint(state, 5) + 1);
+
        fmpz_factor_smooth(factors, n, 60, 1);
 
        if (factors->num < 3)
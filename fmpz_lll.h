@@ -41,6 +41,15 @@
 
 #define SIZE_RED_FAILURE_THRESH 5
 
+/*
+   Minimum number of scalar products times their length, or of row operations
+   times the row length, for the size reduction to use threads
+*/
+#define FMPZ_LLL_THREADED_CUTOFF 8192
+
+/* Minimum number of columns of a row handled by a thread in size reduction */
+#define FMPZ_LLL_THREADED_MIN_LEN 64
+
 typedef enum
 {
     GRAM,
@@ -98,6 +107,14 @@ FLINT_DLL int fmpz_lll_check_babai_heuristic_d(int kappa, fmpz_mat_t B, fmpz_mat
 
 FLINT_DLL int fmpz_lll_shift(const fmpz_mat_t B);
 
+FLINT_DLL void _fmpz_lll_compute_sp_d(d_mat_t appSP, slong kappa, slong j0,
+                  slong j1, const d_mat_t appB, const int * expo,
+                  const fmpz_mat_t B, slong n, int heuristic);
+
+FLINT_DLL void _fmpz_lll_size_reduce(fmpz_mat_t B, fmpz_mat_t U, slong kappa,
+       const slong * rows, const slong * x, const slong * exps, slong len,
+                                                                   slong n);
+
 FLINT_DLL int fmpz_lll_d(fmpz_mat_t B, fmpz_mat_t U, const fmpz_lll_t fl);
 
 FLINT_DLL int fmpz_lll_d_heuristic(fmpz_mat_t B, fmpz_mat_t U, const fmpz_lll_t fl);
@@ -160,6 +177,8 @@ FLINT_DLL void fmpz_lll(fmpz_mat_t B, fmpz_mat_t U, const fmpz_lll_t fl);
 
 FLINT_DLL int fmpz_lll_with_removal(fmpz_mat_t B, fmpz_mat_t U, const fmpz_t gs_B, const fmpz_lll_t fl);
 
+FLINT_DLL void fmpz_lll_blocked(fmpz_mat_t B, fmpz_mat_t U, slong block_size, const fmpz_lll_t fl);
+
 /* Modified ULLL  ************************************************************/
 
 FLINT_DLL void fmpz_lll_storjohann_ulll(fmpz_mat_t FM, slong new_size, const fmpz_lll_t fl);
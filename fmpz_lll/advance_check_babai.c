@@ -25,6 +25,10 @@
 #undef COMPUTE
 #endif
 
+#ifdef COMPUTE_RANGE
+#undef COMPUTE_RANGE
+#endif
+
 #ifdef TYPE
 #undef TYPE
 #endif
@@ -38,9 +42,12 @@ do {                                                        \
     d_mat_entry(G, I, J) =                                  \
             _d_vec_dot(appB->rows[I], appB->rows[J], C);    \
 } while (0)
+#define COMPUTE_RANGE(G, I, J0, J1, C)                              \
+    _fmpz_lll_compute_sp_d(G, I, J0, J1, appB, expo, B, C, 0)
 #define TYPE 2
 #include "babai.c"
 #undef FUNC_HEAD
 #undef LIMIT
 #undef COMPUTE
+#undef COMPUTE_RANGE
 #undef TYPE
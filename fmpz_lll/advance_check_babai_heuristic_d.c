@@ -25,6 +25,10 @@
 #undef COMPUTE
 #endif
 
+#ifdef COMPUTE_RANGE
+#undef COMPUTE_RANGE
+#endif
+
 #ifdef TYPE
 #undef TYPE
 #endif
@@ -39,9 +43,12 @@ do {                                                                \
             fmpz_lll_heuristic_dot(appB->rows[I], appB->rows[J], C, \
                                    B, I, J, expo[I] + expo[J]);     \
 } while (0)
+#define COMPUTE_RANGE(G, I, J0, J1, C)                              \
+    _fmpz_lll_compute_sp_d(G, I, J0, J1, appB, expo, B, C, 1)
 #define TYPE 2
 #include "babai.c"
 #undef FUNC_HEAD
 #undef LIMIT
 #undef COMPUTE
+#undef COMPUTE_RANGE
 #undef TYPE
@@ -13,7 +13,8 @@
 
 #include "fmpz_lll.h"
 
-#if defined(FUNC_HEAD) && defined(LIMIT) && defined(COMPUTE) && defined(TYPE)
+#if defined(FUNC_HEAD) && defined(LIMIT) && defined(COMPUTE) && \
+    defined(COMPUTE_RANGE) && defined(TYPE)
 #ifdef GM
 #undef GM
 #endif
@@ -24,12 +25,18 @@ FUNC_HEAD
     if (fl->rt == Z_BASIS && fl->gt == APPROX)
     {
         int i, j, k, test, aa, exponent, max_expo = INT_MAX;
-        slong xx;
+        slong xx, nred;
+        slong * red_rows, * red_x, * red_exp;
         double tmp, rtmp, halfplus, onedothalfplus;
         ulong loops;
 
         aa = (a > zeros) ? a : zeros + 1;
 
+        /* the row operations of a pass are only applied at its end */
+        red_rows = flint_malloc(3*FLINT_MAX(LIMIT, 1)*sizeof(slong));
+        red_x = red_rows + FLINT_MAX(LIMIT, 1);
+        red_exp = red_x + FLINT_MAX(LIMIT, 1);
+
         halfplus = (fl->eta + 0.5) / 2;
         onedothalfplus = 1.0 + halfplus;
 
@@ -38,11 +45,14 @@ FUNC_HEAD
         do
         {
             test = 0;
+            nred = 0;
 
             /* ************************************** */
             /* Step2: compute the GSO for stage kappa */
             /* ************************************** */
 
+            COMPUTE_RANGE(A->appSP, kappa, aa, LIMIT, n);
+
             for (j = aa; j < LIMIT; j++)
             {
                 if (d_is_nan(d_mat_entry(A->appSP, kappa, j)))
@@ -97,6 +107,7 @@ FUNC_HEAD
                 }
                 if (new_max_expo > max_expo - SIZE_RED_FAILURE_THRESH)
                 {
+                    flint_free(red_rows);
                     return -1;
                 }
                 max_expo = new_max_expo;
@@ -128,14 +139,9 @@ FUNC_HEAD
                                 d_mat_entry(mu, kappa, k) =
                                     d_mat_entry(mu, kappa, k) - tmp;
                             }
-                            _fmpz_vec_sub(B->rows[kappa], B->rows[kappa],
-                                          B->rows[j], n);
-                            if (U != NULL)
-                            {
-                                _fmpz_vec_sub(U->rows[kappa],
-                                              U->rows[kappa], U->rows[j],
-                                              U->c);
-                            }
+                            red_rows[nred] = j;
+                            red_x[nred] = 1;
+                            red_exp[nred++] = 0;
                         }
                         else    /* otherwise X is -1 */
                         {
@@ -145,14 +151,9 @@ FUNC_HEAD
                                 d_mat_entry(mu, kappa, k) =
                                     d_mat_entry(mu, kappa, k) + tmp;
                             }
-                            _fmpz_vec_add(B->rows[kappa], B->rows[kappa],
-                                          B->rows[j], n);
-                            if (U != NULL)
-                            {
-                                _fmpz_vec_add(U->rows[kappa],
-                                              U->rows[kappa], U->rows[j],
-                                              U->c);
-                            }
+                            red_rows[nred] = j;
+                            red_x[nred] = -1;
+                            red_exp[nred++] = 0;
                         }
                     }
                     else        /* we must have |X| >= 2 */
@@ -175,14 +176,9 @@ FUNC_HEAD
                             }
 
                             xx = (slong) tmp;
-                            _fmpz_vec_scalar_submul_si(B->rows[kappa],
-                                                       B->rows[j], n, xx);
-                            if (U != NULL)
-                            {
-                                _fmpz_vec_scalar_submul_si(U->rows[kappa],
-                                                           U->rows[j],
-                                                           U->c, xx);
-                            }
+                            red_rows[nred] = j;
+                            red_x[nred] = xx;
+                            red_exp[nred++] = 0;
                         }
                         else
                         {
@@ -200,15 +196,9 @@ FUNC_HEAD
                                 xx = xx << -exponent;
                                 exponent = 0;
 
-                                _fmpz_vec_scalar_submul_si(B->rows[kappa],
-                                                           B->rows[j], n, xx);
-                                if (U != NULL)
-                                {
-                                    _fmpz_vec_scalar_submul_si(U->rows
-                                                               [kappa],
-                                                               U->rows[j],
-                                                               U->c, xx);
-                                }
+                                red_rows[nred] = j;
+                                red_x[nred] = xx;
+                                red_exp[nred++] = 0;
 
                                 for (k = zeros + 1; k < j; k++)
                                 {
@@ -221,21 +211,9 @@ FUNC_HEAD
                             }
                             else
                             {
-                                _fmpz_vec_scalar_submul_si_2exp(B->rows
-                                                                [kappa],
-                                                                B->rows[j],
-                                                                n, xx,
-                                                                exponent);
-                                if (U != NULL)
-                                {
-                                    _fmpz_vec_scalar_submul_si_2exp(U->rows
-                                                                    [kappa],
-                                                                    U->rows
-                                                                    [j],
-                                                                    U->c,
-                                                                    xx,
-                                                                    exponent);
-                                }
+                                red_rows[nred] = j;
+                                red_x[nred] = xx;
+                                red_exp[nred++] = exponent;
 
                                 for (k = zeros + 1; k < j; k++)
                                 {
@@ -256,6 +234,9 @@ FUNC_HEAD
 
             if (test)           /* Anything happened? */
             {
+                _fmpz_lll_size_reduce(B, U, kappa, red_rows, red_x, red_exp,
+                                                                   nred, n);
+
                 expo[kappa] =
                     _fmpz_vec_get_d_vec_2exp(appB->rows[kappa],
                                              B->rows[kappa], n);
@@ -277,6 +258,8 @@ FUNC_HEAD
             loops++;
         } while (test);
 
+        flint_free(red_rows);
+
 #if TYPE == 1
         if (d_is_nan(d_mat_entry(A->appSP, kappa, kappa)))
         {
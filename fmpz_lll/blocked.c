@@ -0,0 +1,161 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fmpz_lll.h"
+#include "thread_support.h"
+
+/* LLL reduce rows r0, ..., r1 - 1 of B as a lattice of their own */
+static void
+_fmpz_lll_block(fmpz_mat_t B, fmpz_mat_t U, slong r0, slong r1,
+                                                        const fmpz_lll_t fl)
+{
+    fmpz_mat_t Bsub, Usub;
+    slong i;
+
+    fmpz_mat_init(Bsub, r1 - r0, B->c);
+    for (i = r0; i < r1; i++)
+        _fmpz_vec_swap(Bsub->rows[i - r0], B->rows[i], B->c);
+
+    if (U != NULL)
+    {
+        fmpz_mat_init(Usub, r1 - r0, U->c);
+        for (i = r0; i < r1; i++)
+            _fmpz_vec_swap(Usub->rows[i - r0], U->rows[i], U->c);
+    }
+
+    fmpz_lll(Bsub, (U != NULL) ? Usub : NULL, fl);
+
+    for (i = r0; i < r1; i++)
+        _fmpz_vec_swap(Bsub->rows[i - r0], B->rows[i], B->c);
+    fmpz_mat_clear(Bsub);
+
+    if (U != NULL)
+    {
+        for (i = r0; i < r1; i++)
+            _fmpz_vec_swap(Usub->rows[i - r0], U->rows[i], U->c);
+        fmpz_mat_clear(Usub);
+    }
+}
+
+typedef struct
+{
+    fmpz_mat_struct * B;
+    fmpz_mat_struct * U;
+    slong width;
+    slong num_blocks;
+    volatile slong * block;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+    const fmpz_lll_struct * fl;
+}
+_blocked_arg_t;
+
+static void
+_fmpz_lll_blocked_worker(void * arg_ptr)
+{
+    _blocked_arg_t * arg = (_blocked_arg_t *) arg_ptr;
+    slong i, r0, r1, r = arg->B->r, width = arg->width;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        i = *arg->block;
+        *arg->block = i + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (i >= arg->num_blocks)
+            return;
+
+        r0 = i*width;
+        r1 = FLINT_MIN(r0 + width, r);
+
+        _fmpz_lll_block(arg->B, arg->U, r0, r1, arg->fl);
+    }
+}
+
+void
+fmpz_lll_blocked(fmpz_mat_t B, fmpz_mat_t U, slong block_size,
+                                                        const fmpz_lll_t fl)
+{
+    thread_pool_handle * threads;
+    slong i, num_threads, width, block;
+    _blocked_arg_t * args;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    /* the rows of a Gram matrix cannot be reduced independently */
+    if (fl->rt == GRAM || block_size < 1 || B->r <= block_size)
+    {
+        fmpz_lll(B, U, fl);
+        return;
+    }
+
+    /*
+        Reduce blocks of block_size rows, then merge adjacent pairs of
+        reduced blocks and reduce them again, until the whole basis is
+        reduced. The blocks at each level are independent.
+    */
+    for (width = block_size; width < B->r; width *= 2)
+    {
+        slong num_blocks = (B->r + width - 1)/width;
+
+        /* a trailing block with one reduced half is already reduced */
+        if (width != block_size && B->r - (num_blocks - 1)*width <= width/2)
+            num_blocks--;
+
+        block = 0;
+
+        num_threads = flint_request_threads(&threads,
+                             FLINT_MIN(flint_get_num_threads(), num_blocks));
+
+        args = flint_malloc((num_threads + 1)*sizeof(_blocked_arg_t));
+
+        for (i = 0; i <= num_threads; i++)
+        {
+            args[i].B = B;
+            args[i].U = U;
+            args[i].width = width;
+            args[i].num_blocks = num_blocks;
+            args[i].block = &block;
+#if FLINT_USES_PTHREAD
+            args[i].mutex = &mutex;
+#endif
+            args[i].fl = fl;
+        }
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_init(&mutex, NULL);
+#endif
+
+        for (i = 0; i < num_threads; i++)
+            thread_pool_wake(global_thread_pool, threads[i], 0,
+                                          _fmpz_lll_blocked_worker, &args[i]);
+
+        _fmpz_lll_blocked_worker(&args[num_threads]);
+
+        for (i = 0; i < num_threads; i++)
+            thread_pool_wait(global_thread_pool, threads[i]);
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_destroy(&mutex);
+#endif
+
+        flint_give_back_threads(threads, num_threads);
+
+        flint_free(args);
+    }
+
+    fmpz_lll(B, U, fl);
+}
@@ -25,6 +25,10 @@
 #undef COMPUTE
 #endif
 
+#ifdef COMPUTE_RANGE
+#undef COMPUTE_RANGE
+#endif
+
 #ifdef TYPE
 #undef TYPE
 #endif
@@ -41,9 +45,12 @@ do {                                                                \
     else                                                            \
         d_mat_entry(G, I, J) = _d_vec_norm(appB->rows[I], C);       \
 } while (0)
+#define COMPUTE_RANGE(G, I, J0, J1, C)                              \
+    _fmpz_lll_compute_sp_d(G, I, J0, J1, appB, expo, B, C, 0)
 #define TYPE 1
 #include "babai.c"
 #undef FUNC_HEAD
 #undef LIMIT
 #undef COMPUTE
+#undef COMPUTE_RANGE
 #undef TYPE
@@ -0,0 +1,118 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fmpz_lll.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    d_mat_struct * appSP;
+    slong kappa;
+    slong j0;
+    slong j1;
+    const d_mat_struct * appB;
+    const int * expo;
+    const fmpz_mat_struct * B;
+    slong n;
+    int heuristic;
+    slong thread;
+    slong num_threads;
+}
+_compute_sp_arg_t;
+
+static void
+_fmpz_lll_compute_sp_d_worker(void * arg_ptr)
+{
+    _compute_sp_arg_t * arg = (_compute_sp_arg_t *) arg_ptr;
+    const d_mat_struct * appB = arg->appB;
+    slong j, kappa = arg->kappa;
+
+    for (j = arg->j0 + arg->thread; j < arg->j1; j += arg->num_threads)
+    {
+        if (!d_is_nan(d_mat_entry(arg->appSP, kappa, j)))
+            continue;
+
+        if (arg->heuristic)
+            d_mat_entry(arg->appSP, kappa, j) =
+                fmpz_lll_heuristic_dot(appB->rows[kappa], appB->rows[j],
+                     arg->n, arg->B, kappa, j, arg->expo[kappa] + arg->expo[j]);
+        else
+            d_mat_entry(arg->appSP, kappa, j) =
+                _d_vec_dot(appB->rows[kappa], appB->rows[j], arg->n);
+    }
+}
+
+void
+_fmpz_lll_compute_sp_d(d_mat_t appSP, slong kappa, slong j0, slong j1,
+                  const d_mat_t appB, const int * expo, const fmpz_mat_t B,
+                                                       slong n, int heuristic)
+{
+    thread_pool_handle * threads = NULL;
+    slong i, num_threads = 0;
+    _compute_sp_arg_t * args;
+
+    if (j1 <= j0)
+        return;
+
+    if ((j1 - j0)*n >= FMPZ_LLL_THREADED_CUTOFF)
+        num_threads = flint_request_threads(&threads,
+               FLINT_MIN(flint_get_num_threads(), j1 - j0));
+
+    if (num_threads == 0)
+    {
+        _compute_sp_arg_t arg;
+
+        arg.appSP = appSP;
+        arg.kappa = kappa;
+        arg.j0 = j0;
+        arg.j1 = j1;
+        arg.appB = appB;
+        arg.expo = expo;
+        arg.B = B;
+        arg.n = n;
+        arg.heuristic = heuristic;
+        arg.thread = 0;
+        arg.num_threads = 1;
+
+        _fmpz_lll_compute_sp_d_worker(&arg);
+
+        flint_give_back_threads(threads, num_threads);
+        return;
+    }
+
+    args = flint_malloc((num_threads + 1)*sizeof(_compute_sp_arg_t));
+
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i].appSP = appSP;
+        args[i].kappa = kappa;
+        args[i].j0 = j0;
+        args[i].j1 = j1;
+        args[i].appB = appB;
+        args[i].expo = expo;
+        args[i].B = B;
+        args[i].n = n;
+        args[i].heuristic = heuristic;
+        args[i].thread = i;
+        args[i].num_threads = num_threads + 1;
+    }
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                     _fmpz_lll_compute_sp_d_worker, &args[i]);
+
+    _fmpz_lll_compute_sp_d_worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+    flint_give_back_threads(threads, num_threads);
+
+    flint_free(args);
+}
@@ -0,0 +1,127 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fmpz_lll.h"
+#include "thread_support.h"
+
+/*
+    Sets row kappa of B (and U) to B[kappa] - sum_i x[i]*2^exps[i]*B[rows[i]].
+    The column range is split between threads, each of which applies all the
+    operations to its own part of the row.
+*/
+
+static void
+_fmpz_lll_size_reduce_cols(fmpz * v, fmpz ** R, const slong * rows,
+         const slong * x, const slong * exps, slong len, slong c0, slong c1)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+    {
+        const fmpz * w = R[rows[i]] + c0;
+
+        if (exps[i] != 0)
+            _fmpz_vec_scalar_submul_si_2exp(v + c0, w, c1 - c0, x[i], exps[i]);
+        else if (x[i] == 1)
+            _fmpz_vec_sub(v + c0, v + c0, w, c1 - c0);
+        else if (x[i] == -1)
+            _fmpz_vec_add(v + c0, v + c0, w, c1 - c0);
+        else
+            _fmpz_vec_scalar_submul_si(v + c0, w, c1 - c0, x[i]);
+    }
+}
+
+typedef struct
+{
+    fmpz_mat_struct * B;
+    fmpz_mat_struct * U;
+    slong kappa;
+    const slong * rows;
+    const slong * x;
+    const slong * exps;
+    slong len;
+    slong n;
+    slong thread;
+    slong num_threads;
+}
+_size_reduce_arg_t;
+
+static void
+_fmpz_lll_size_reduce_worker(void * arg_ptr)
+{
+    _size_reduce_arg_t * arg = (_size_reduce_arg_t *) arg_ptr;
+    slong t = arg->thread, nt = arg->num_threads;
+
+    _fmpz_lll_size_reduce_cols(arg->B->rows[arg->kappa], arg->B->rows,
+                            arg->rows, arg->x, arg->exps, arg->len,
+                            (arg->n*t)/nt, (arg->n*(t + 1))/nt);
+
+    if (arg->U != NULL)
+        _fmpz_lll_size_reduce_cols(arg->U->rows[arg->kappa], arg->U->rows,
+                            arg->rows, arg->x, arg->exps, arg->len,
+                            (arg->U->c*t)/nt, (arg->U->c*(t + 1))/nt);
+}
+
+void
+_fmpz_lll_size_reduce(fmpz_mat_t B, fmpz_mat_t U, slong kappa,
+       const slong * rows, const slong * x, const slong * exps, slong len,
+                                                                    slong n)
+{
+    thread_pool_handle * threads = NULL;
+    slong i, num_threads = 0;
+    _size_reduce_arg_t * args;
+
+    if (len == 0)
+        return;
+
+    if (len*n >= FMPZ_LLL_THREADED_CUTOFF)
+        num_threads = flint_request_threads(&threads,
+              FLINT_MIN(flint_get_num_threads(), n/FMPZ_LLL_THREADED_MIN_LEN));
+
+    if (num_threads == 0)
+    {
+        _fmpz_lll_size_reduce_cols(B->rows[kappa], B->rows, rows, x, exps,
+                                                                  len, 0, n);
+        if (U != NULL)
+            _fmpz_lll_size_reduce_cols(U->rows[kappa], U->rows, rows, x, exps,
+                                                               len, 0, U->c);
+
+        flint_give_back_threads(threads, num_threads);
+        return;
+    }
+
+    args = flint_malloc((num_threads + 1)*sizeof(_size_reduce_arg_t));
+
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i].B = B;
+        args[i].U = U;
+        args[i].kappa = kappa;
+        args[i].rows = rows;
+        args[i].x = x;
+        args[i].exps = exps;
+        args[i].len = len;
+        args[i].n = n;
+        args[i].thread = i;
+        args[i].num_threads = num_threads + 1;
+    }
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                      _fmpz_lll_size_reduce_worker, &args[i]);
+
+    _fmpz_lll_size_reduce_worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+    flint_give_back_threads(threads, num_threads);
+
+    flint_free(args);
+}
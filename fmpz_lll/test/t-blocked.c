@@ -0,0 +1,136 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_lll.h"
+#include "ulong_extras.h"
+#include "thread_support.h"
+
+int
+main(void)
+{
+    int i, result;
+    fmpz_mat_t mat, mat2, gmat, U;
+    fmpz_lll_t fl;
+    flint_bitcnt_t bits;
+
+    FLINT_TEST_INIT(state);
+
+    flint_printf("blocked....");
+    fflush(stdout);
+
+    for (i = 0; i < 5 * flint_test_multiplier(); i++)
+    {
+        slong r, c, j, k, block_size;
+        int with_U;
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        fmpz_lll_randtest(fl, state);
+        block_size = n_randint(state, 20) + 1;
+        with_U = n_randint(state, 2);
+
+        switch (n_randint(state, 10))
+        {
+            case 0:
+                /* large enough for the size reduction to use threads */
+                r = n_randint(state, 16) + 128;
+                c = r;
+                fmpz_mat_init(mat, r, c);
+                bits = n_randint(state, 20) + 1;
+                for (j = 0; j < r; j++)
+                {
+                    for (k = 0; k < j; k++)
+                        fmpz_randtest(fmpz_mat_entry(mat, j, k), state, bits);
+                    fmpz_setbit(fmpz_mat_entry(mat, j, j), bits);
+                }
+                break;
+            case 1:
+            case 2:
+            case 3:
+            case 4:
+                r = 2 * (n_randint(state, 20) + 1);
+                c = r;
+                fmpz_mat_init(mat, r, c);
+                bits = n_randint(state, 20) + 1;
+                fmpz_mat_randntrulike(mat, state, bits,
+                                                    n_randint(state, 200) + 1);
+                break;
+            default:
+                r = n_randint(state, 30) + 1;
+                c = r + 1;
+                fmpz_mat_init(mat, r, c);
+                bits = n_randint(state, 200) + 1;
+                fmpz_mat_randintrel(mat, state, bits);
+                break;
+        }
+
+        fmpz_mat_init(U, r, r);
+        fmpz_mat_one(U);
+        fmpz_mat_init_set(mat2, mat);
+
+        if (fl->rt == GRAM)
+        {
+            fmpz_mat_init(gmat, r, r);
+            fmpz_mat_gram(gmat, mat);
+            fmpz_mat_swap(mat, gmat);
+            fmpz_mat_clear(gmat);
+            fmpz_lll_blocked(mat, with_U ? U : NULL, block_size, fl);
+            result = fmpz_mat_is_reduced_gram(mat, fl->delta, fl->eta);
+        }
+        else
+        {
+            fmpz_lll_blocked(mat, with_U ? U : NULL, block_size, fl);
+            result = fmpz_mat_is_reduced(mat, fl->delta, fl->eta);
+        }
+
+        if (!result)
+        {
+            flint_printf("FAIL (not reduced):\n");
+            flint_printf("r = %wd, c = %wd, bits = %wu, block_size = %wd\n",
+                                                      r, c, bits, block_size);
+            flint_printf("delta = %g, eta = %g\n", fl->delta, fl->eta);
+            flint_printf("rep_type = %d\n", fl->rt);
+            flint_printf("gram_type = %d\n", fl->gt);
+            abort();
+        }
+
+        if (with_U)
+        {
+            fmpz_mat_mul(mat2, U, mat2);
+
+            if (fl->rt == GRAM)
+            {
+                fmpz_mat_init(gmat, r, r);
+                fmpz_mat_gram(gmat, mat2);
+                fmpz_mat_swap(mat2, gmat);
+                fmpz_mat_clear(gmat);
+            }
+
+            if (!fmpz_mat_equal(mat, mat2))
+            {
+                flint_printf("FAIL (transformation):\n");
+                fmpz_mat_print_pretty(mat);
+                fmpz_mat_print_pretty(mat2);
+                abort();
+            }
+        }
+
+        fmpz_mat_clear(U);
+        fmpz_mat_clear(mat2);
+        fmpz_mat_clear(mat);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
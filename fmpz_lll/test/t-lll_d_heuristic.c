@@ -16,6 +16,7 @@
 #include "fmpz.h"
 #include "fmpz_lll.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -41,6 +42,7 @@ main(void)
 
         fmpz_mat_init(mat, r, c);
         fmpz_lll_randtest(fl, state);
+        flint_set_num_threads(n_randint(state, 5) + 1);
 
         bits = n_randint(state, 20) + 1;
         q = n_randint(state, 200) + 1;
@@ -135,6 +137,7 @@ main(void)
 
         fmpz_mat_init(mat, r, c);
         fmpz_lll_randtest(fl, state);
+        flint_set_num_threads(n_randint(state, 5) + 1);
 
         bits = n_randint(state, 200) + 1;
 
@@ -233,6 +236,7 @@ main(void)
 
         fmpz_mat_init(mat, r, c);
         fmpz_lll_randtest(fl, state);
+        flint_set_num_threads(n_randint(state, 5) + 1);
 
         fmpz_mat_randajtai(mat, state, 0.5);
 
@@ -321,6 +325,7 @@ main(void)
 
         fmpz_mat_init(mat, r, c);
         fmpz_lll_randtest(fl, state);
+        flint_set_num_threads(n_randint(state, 5) + 1);
 
         bits = n_randint(state, 200) + 1;
         bits2 = n_randint(state, 5) + 1;
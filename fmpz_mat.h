@@ -539,6 +539,12 @@ FLINT_DLL mp_limb_t *
 fmpz_mat_dixon_get_crt_primes(slong * num_primes,
 		                              const fmpz_mat_t A, mp_limb_t p);
 
+FLINT_DLL void
+_fmpz_mat_dixon_step(fmpz_mat_t x, fmpz_mat_t d, const fmpz_t ppow,
+                     const nmod_mat_t Ainv, nmod_mat_t * const A_mod,
+                     nmod_mat_struct * Ay_mod, const fmpz_comb_t comb,
+                                                slong num_primes, int update);
+
 FLINT_DLL void
 _fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
 		  const fmpz_mat_t A, const fmpz_mat_t B,
@@ -17,6 +17,7 @@
 #include "fmpz_mat.h"
 #include "nmod_mat.h"
 #include "nmod_poly.h"
+#include "thread_support.h"
 
 #define CHARPOLY_M_LOG2E  1.44269504088896340736  /* log2(e) */
 
@@ -88,6 +89,40 @@ void _fmpz_mat_charpoly_small(fmpz * rop, const fmpz_mat_t op)
     }
 }
 
+typedef struct
+{
+    const fmpz_mat_struct * op;
+    mp_srcptr primes;
+    mp_ptr * polys;
+    slong i0;
+    slong i1;
+}
+_charpoly_modular_arg_t;
+
+static void
+_charpoly_modular_worker(void * arg_ptr)
+{
+    _charpoly_modular_arg_t * arg = (_charpoly_modular_arg_t *) arg_ptr;
+    const slong n = arg->op->r;
+    nmod_mat_t mat;
+    nmod_poly_t poly;
+    slong i;
+
+    for (i = arg->i0; i < arg->i1; i++)
+    {
+        nmod_mat_init(mat, n, n, arg->primes[i]);
+        nmod_poly_init(poly, arg->primes[i]);
+
+        fmpz_mat_get_nmod_mat(mat, arg->op);
+        nmod_mat_charpoly(poly, mat);
+
+        _nmod_vec_set(arg->polys[i], poly->coeffs, n + 1);
+
+        nmod_mat_clear(mat);
+        nmod_poly_clear(poly);
+    }
+}
+
 void _fmpz_mat_charpoly_modular(fmpz * rop, const fmpz_mat_t op)
 {
     const slong n = op->r;
@@ -107,16 +142,20 @@ void _fmpz_mat_charpoly_modular(fmpz * rop, const fmpz_mat_t op)
             See Lemma 4.1 in Dumas, Pernet, and Wan, "Efficient computation 
             of the characteristic polynomial", 2008.
          */
-        slong bound;
+        slong bound, num_primes, num_handles, i;
 
         slong pbits  = FLINT_BITS - 1;
         mp_limb_t p = (UWORD(1) << pbits);
+        mp_ptr primes;
+        mp_ptr * polys;
+        thread_pool_handle * handles;
+        _charpoly_modular_arg_t * args;
 
         fmpz_t m;
 
         /* Determine the bound in bits */
         {
-            slong i, j;
+            slong j;
             fmpz *ptr;
             double t;
 
@@ -140,29 +179,57 @@ void _fmpz_mat_charpoly_modular(fmpz * rop, const fmpz_mat_t op)
             bound = ceil( (n / 2.0) * (_log2(n) + 2.0 * t + 1.6669) );
         }
 
-        fmpz_init_set_ui(m, 1);
+        /* choose all the primes up front, the images are independent;
+           each prime contributes at least pbits - 1 bits to the modulus */
+        num_primes = (bound + pbits - 2)/(pbits - 1);
+        primes = _nmod_vec_init(num_primes);
+        polys = (mp_ptr *) flint_malloc(num_primes*sizeof(mp_ptr));
+        polys[0] = _nmod_vec_init(num_primes*(n + 1));
 
-        for ( ; fmpz_bits(m) < bound; )
+        for (i = 0; i < num_primes; i++)
         {
-            nmod_mat_t mat;
-            nmod_poly_t poly;
-
             p = n_nextprime(p, 0);
+            primes[i] = p;
+            polys[i] = polys[0] + i*(n + 1);
+        }
 
-            nmod_mat_init(mat, n, n, p);
-            nmod_poly_init(poly, p);
+        num_handles = flint_request_threads(&handles,
+                                 FLINT_MIN(flint_get_num_threads(), num_primes));
 
-            fmpz_mat_get_nmod_mat(mat, op);
-            nmod_mat_charpoly(poly, mat);
+        /* charpolys over Z/pZ, in parallel */
+        args = (_charpoly_modular_arg_t *)
+                 flint_malloc((num_handles + 1)*sizeof(_charpoly_modular_arg_t));
 
-            _fmpz_poly_CRT_ui(rop, rop, n + 1, m, poly->coeffs, n + 1, poly->mod.n, poly->mod.ninv, 1);
+        for (i = 0; i <= num_handles; i++)
+        {
+            args[i].op = op;
+            args[i].primes = primes;
+            args[i].polys = polys;
+            args[i].i0 = (num_primes*i)/(num_handles + 1);
+            args[i].i1 = (num_primes*(i + 1))/(num_handles + 1);
+        }
 
-            fmpz_mul_ui(m, m, p);
+        for (i = 0; i < num_handles; i++)
+            thread_pool_wake(global_thread_pool, handles[i], 0,
+                                        _charpoly_modular_worker, &args[i]);
 
-            nmod_mat_clear(mat);
-            nmod_poly_clear(poly);
-        }
+        _charpoly_modular_worker(&args[num_handles]);
+
+        for (i = 0; i < num_handles; i++)
+            thread_pool_wait(global_thread_pool, handles[i]);
+
+        /* recombine with a product tree, coefficients split across threads */
+        fmpz_init_set_ui(m, 1);
+
+        _fmpz_poly_multi_CRT_ui(rop, m, n + 1, polys, primes, num_primes,
+                                                  1, handles, num_handles);
+
+        flint_give_back_threads(handles, num_handles);
 
+        flint_free(args);
+        _nmod_vec_clear(polys[0]);
+        flint_free(polys);
+        _nmod_vec_clear(primes);
         fmpz_clear(m);
     }
 }
@@ -10,6 +10,7 @@
 */
 
 #include "fmpz_mat.h"
+#include "thread_support.h"
 
 /* Enable to exercise corner cases */
 #define DEBUG_USE_SMALL_PRIMES 0
@@ -29,15 +30,51 @@ next_good_prime(const fmpz_t d, mp_limb_t p)
     return p;
 }
 
+typedef struct
+{
+    const fmpz_mat_struct * A;
+    const fmpz * d;
+    const mp_limb_t * primes;
+    mp_ptr residues;
+    slong num_primes;
+    slong thread;
+    slong num_workers;
+    nmod_mat_struct * Amod;
+}
+_det_modular_arg_t;
+
+/* Compute det(A) / d modulo the primes with index congruent to thread */
+static void
+_det_modular_worker(void * arg_ptr)
+{
+    _det_modular_arg_t * arg = (_det_modular_arg_t *) arg_ptr;
+    nmod_mat_struct * Amod = arg->Amod;
+    mp_limb_t p, xmod;
+    slong i;
+
+    for (i = arg->thread; i < arg->num_primes; i += arg->num_workers)
+    {
+        p = arg->primes[i];
+        _nmod_mat_set_mod(Amod, p);
+        fmpz_mat_get_nmod_mat(Amod, arg->A);
+
+        xmod = _nmod_mat_det(Amod);
+        arg->residues[i] = n_mulmod2_preinv(xmod,
+            n_invmod(fmpz_fdiv_ui(arg->d, p), p), Amod->mod.n, Amod->mod.ninv);
+    }
+}
 
 void
 fmpz_mat_det_modular_given_divisor(fmpz_t det, const fmpz_mat_t A,
     const fmpz_t d, int proved)
 {
-    fmpz_t bound, prod, stable_prod, x, xnew;
-    mp_limb_t p, xmod;
-    nmod_mat_t Amod;
-    slong n = A->r;
+    fmpz_t bound, prod, stable_prod, x, xnew, bprod, bx;
+    mp_limb_t p;
+    mp_ptr primes, residues;
+    nmod_mat_struct * Amod;
+    _det_modular_arg_t * args;
+    thread_pool_handle * threads;
+    slong i, len, num_threads, num_workers, n = A->r;
 
     if (n == 0)
     {
@@ -56,13 +93,44 @@ fmpz_mat_det_modular_given_divisor(fmpz_t det, const fmpz_mat_t A,
     fmpz_init(stable_prod);
     fmpz_init(x);
     fmpz_init(xnew);
+    fmpz_init(bprod);
+    fmpz_init(bx);
 
     /* Bound x = det(A) / d */
     fmpz_mat_det_bound(bound, A);
     fmpz_mul_ui(bound, bound, UWORD(2));  /* accomodate sign */
     fmpz_cdiv_q(bound, bound, d);
 
-    nmod_mat_init(Amod, n, n, 2);
+    /*
+        The primes are taken in batches of one per worker. The determinants
+        modulo the primes of a batch are computed in parallel and combined
+        with a product tree before being added to x, so that the bound and
+        the stabilisation of x are checked once per batch.
+    */
+    num_threads = flint_request_threads(&threads,
+        FLINT_MIN(flint_get_num_threads(),
+                  fmpz_bits(bound)/NMOD_MAT_OPTIMAL_MODULUS_BITS + 1));
+    num_workers = num_threads + 1;
+
+    primes = flint_malloc(2*num_workers*sizeof(mp_limb_t));
+    residues = primes + num_workers;
+
+    Amod = flint_malloc(num_workers*sizeof(nmod_mat_struct));
+    args = flint_malloc(num_workers*sizeof(_det_modular_arg_t));
+
+    for (i = 0; i < num_workers; i++)
+    {
+        nmod_mat_init(Amod + i, n, n, 2);
+
+        args[i].A = A;
+        args[i].d = d;
+        args[i].primes = primes;
+        args[i].residues = residues;
+        args[i].thread = i;
+        args[i].num_workers = num_workers;
+        args[i].Amod = Amod + i;
+    }
+
     fmpz_zero(x);
     fmpz_one(prod);
 
@@ -75,39 +143,80 @@ fmpz_mat_det_modular_given_divisor(fmpz_t det, const fmpz_mat_t A,
     /* Compute x = det(A) / d */
     while (fmpz_cmp(prod, bound) <= 0)
     {
-        p = next_good_prime(d, p);
-        _nmod_mat_set_mod(Amod, p);
-        fmpz_mat_get_nmod_mat(Amod, A);
+        /* choose a batch of primes, no more than are needed for the bound */
+        fmpz_one(bprod);
+        fmpz_set(xnew, prod);
+        for (len = 0; len < num_workers && fmpz_cmp(xnew, bound) <= 0; len++)
+        {
+            p = next_good_prime(d, p);
+            primes[len] = p;
+            fmpz_mul_ui(bprod, bprod, p);
+            fmpz_mul_ui(xnew, xnew, p);
+        }
 
-        /* Compute x = det(A) / d mod p */
-        xmod = _nmod_mat_det(Amod);
-        xmod = n_mulmod2_preinv(xmod,
-            n_invmod(fmpz_fdiv_ui(d, p), p), Amod->mod.n, Amod->mod.ninv);
+        /* Compute x = det(A) / d mod p for each p in the batch */
+        for (i = 0; i < num_workers; i++)
+            args[i].num_primes = len;
+
+        for (i = 0; i < FLINT_MIN(num_threads, len - 1); i++)
+            thread_pool_wake(global_thread_pool, threads[i], 0,
+                                                 _det_modular_worker, &args[i]);
+
+        _det_modular_worker(&args[FLINT_MIN(num_threads, len - 1)]);
+
+        for (i = 0; i < FLINT_MIN(num_threads, len - 1); i++)
+            thread_pool_wait(global_thread_pool, threads[i]);
+
+        if (len == 1)
+        {
+            fmpz_CRT_ui(xnew, x, prod, residues[0], primes[0], 1);
+        }
+        else
+        {
+            fmpz_comb_t comb;
+            fmpz_comb_temp_t comb_temp;
 
-        fmpz_CRT_ui(xnew, x, prod, xmod, p, 1);
+            fmpz_comb_init(comb, primes, len);
+            fmpz_comb_temp_init(comb_temp, comb);
+            fmpz_multi_CRT_ui(bx, residues, comb, comb_temp, 0);
+            fmpz_comb_temp_clear(comb_temp);
+            fmpz_comb_clear(comb);
+
+            fmpz_CRT(xnew, x, prod, bx, bprod, 1);
+        }
 
         if (fmpz_equal(xnew, x))
         {
-            fmpz_mul_ui(stable_prod, stable_prod, p);
+            fmpz_mul(stable_prod, stable_prod, bprod);
             if (!proved && fmpz_bits(stable_prod) > 100)
                 break;
         }
         else
         {
-            fmpz_set_ui(stable_prod, p);
+            fmpz_set(stable_prod, bprod);
         }
 
-        fmpz_mul_ui(prod, prod, p);
+        fmpz_mul(prod, prod, bprod);
         fmpz_set(x, xnew);
     }
 
     /* det(A) = x * d */
     fmpz_mul(det, x, d);
 
-    nmod_mat_clear(Amod);
+    flint_give_back_threads(threads, num_threads);
+
+    for (i = 0; i < num_workers; i++)
+        nmod_mat_clear(Amod + i);
+
+    flint_free(args);
+    flint_free(Amod);
+    flint_free(primes);
+
     fmpz_clear(bound);
     fmpz_clear(prod);
     fmpz_clear(stable_prod);
     fmpz_clear(x);
     fmpz_clear(xnew);
+    fmpz_clear(bprod);
+    fmpz_clear(bx);
 }
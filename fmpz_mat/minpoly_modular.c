@@ -18,6 +18,7 @@
 #include "fmpz_mat.h"
 #include "nmod_mat.h"
 #include "nmod_poly.h"
+#include "thread_support.h"
 
 #define MINPOLY_M_LOG2E  1.44269504088896340736  /* log2(e) */
 
@@ -108,6 +109,48 @@ void _fmpz_mat_bound_ovals_of_cassini(fmpz_t b, const fmpz_mat_t op)
    fmpz_clear(q);
 }
 
+typedef struct
+{
+    const fmpz_mat_struct * op;
+    mp_srcptr primes;
+    mp_ptr * polys;
+    slong * lens;
+    ulong * gens;
+    slong i0;
+    slong i1;
+}
+_minpoly_modular_arg_t;
+
+static void
+_minpoly_modular_worker(void * arg_ptr)
+{
+    _minpoly_modular_arg_t * arg = (_minpoly_modular_arg_t *) arg_ptr;
+    const slong n = arg->op->r;
+    nmod_mat_t mat;
+    nmod_poly_t poly;
+    ulong * P;
+    slong i, j;
+
+    for (i = arg->i0; i < arg->i1; i++)
+    {
+        nmod_mat_init(mat, n, n, arg->primes[i]);
+        nmod_poly_init(poly, arg->primes[i]);
+
+        P = arg->gens + i*n;
+        for (j = 0; j < n; j++)
+           P[j] = 0;
+
+        fmpz_mat_get_nmod_mat(mat, arg->op);
+        nmod_mat_minpoly_with_gens(poly, mat, P);
+
+        arg->lens[i] = poly->length;
+        _nmod_vec_set(arg->polys[i], poly->coeffs, poly->length);
+
+        nmod_mat_clear(mat);
+        nmod_poly_clear(poly);
+    }
+}
+
 slong _fmpz_mat_minpoly_modular(fmpz * rop, const fmpz_mat_t op)
 {
     const slong n = op->r;
@@ -132,9 +175,14 @@ slong _fmpz_mat_minpoly_modular(fmpz * rop, const fmpz_mat_t op)
         slong bound;
         double b1, b2, b3, bb;
 
-        slong pbits  = FLINT_BITS - 1, i, j;
+        slong pbits  = FLINT_BITS - 1, i, j, batch, num_handles;
         mp_limb_t p = (UWORD(1) << pbits);
         ulong * P, * Q;
+        mp_ptr primes, sel_primes;
+        mp_ptr * polys, * sel_polys;
+        slong * lens;
+        thread_pool_handle * handles;
+        _minpoly_modular_arg_t * args;
 
         fmpz_mat_t v1, v2, v3;
         fmpz * rold;
@@ -170,13 +218,40 @@ slong _fmpz_mat_minpoly_modular(fmpz * rop, const fmpz_mat_t op)
             fmpz_clear(b);
         }
 
-        P = (ulong *) flint_calloc(n, sizeof(ulong));
+        num_handles = flint_request_threads(&handles, flint_get_num_threads());
+
+        /* one prime per thread in each batch */
+        batch = num_handles + 1;
+
+        primes = _nmod_vec_init(2*batch);
+        sel_primes = primes + batch;
+        polys = (mp_ptr *) flint_malloc(2*batch*sizeof(mp_ptr));
+        sel_polys = polys + batch;
+        polys[0] = _nmod_vec_init(batch*(n + 1));
+        for (i = 1; i < batch; i++)
+            polys[i] = polys[0] + i*(n + 1);
+        lens = (slong *) flint_malloc(batch*sizeof(slong));
+        P = (ulong *) flint_calloc(batch*n, sizeof(ulong));
         Q = (ulong *) flint_calloc(n, sizeof(ulong));
         rold = (fmpz *) _fmpz_vec_init(n + 1);
         fmpz_mat_init(v1, n, 1);
         fmpz_mat_init(v2, n, 1);
         fmpz_mat_init(v3, n, 1);
 
+        args = (_minpoly_modular_arg_t *)
+                  flint_malloc((num_handles + 1)*sizeof(_minpoly_modular_arg_t));
+
+        for (i = 0; i <= num_handles; i++)
+        {
+            args[i].op = op;
+            args[i].primes = primes;
+            args[i].polys = polys;
+            args[i].lens = lens;
+            args[i].gens = P;
+            args[i].i0 = i;
+            args[i].i1 = i + 1;
+        }
+
         fmpz_init_set_ui(m, 1);
 
         oldlen = 0;
@@ -184,28 +259,33 @@ slong _fmpz_mat_minpoly_modular(fmpz * rop, const fmpz_mat_t op)
 
         for ( ; fmpz_bits(m) <= bound; )
         {
-            nmod_mat_t mat;
-            nmod_poly_t poly;
-            
-            p = n_nextprime(p, 0);
+            slong num_sel;
 
-            nmod_mat_init(mat, n, n, p);
-            nmod_poly_init(poly, p);
+            for (i = 0; i < batch; i++)
+            {
+                p = n_nextprime(p, 0);
+                primes[i] = p;
+            }
 
-            for (i = 0; i < n; i++)
-               P[i] = 0;
+            /* minpolys over Z/pZ, in parallel */
+            for (i = 0; i < num_handles; i++)
+                thread_pool_wake(global_thread_pool, handles[i], 0,
+                                           _minpoly_modular_worker, &args[i]);
 
-            fmpz_mat_get_nmod_mat(mat, op);
-            nmod_mat_minpoly_with_gens(poly, mat, P);
+            _minpoly_modular_worker(&args[num_handles]);
 
-            len = poly->length;
+            for (i = 0; i < num_handles; i++)
+                thread_pool_wait(global_thread_pool, handles[i]);
+
+            len = lens[0];
+            for (i = 1; i < batch; i++)
+                len = FLINT_MAX(len, lens[i]);
 
             if (oldlen != 0 && len > oldlen)
             {
                /* all previous primes were bad, discard */
                            
                fmpz_one(m);
-               oldlen = len;
 
                for (i = 0; i < n + 1; i++)
                   fmpz_zero(rop + i);
@@ -214,21 +294,32 @@ slong _fmpz_mat_minpoly_modular(fmpz * rop, const fmpz_mat_t op)
                   Q[i] = 0;
             } else if (len < oldlen)
             {
-               /* this prime was bad, skip */
+               /* this batch was bad, skip */
+
+               len = oldlen;
 
-               nmod_mat_clear(mat);
-               nmod_poly_clear(poly);
-            
                continue;   
             }
 
-            for (i = 0; i < n; i++)
-               Q[i] |= P[i];
+            oldlen = len;
 
-            _fmpz_poly_CRT_ui(rop, rop, n + 1, m, poly->coeffs, 
-                              poly->length, poly->mod.n, poly->mod.ninv, 1);
+            /* primes giving a shorter minpoly are bad, skip them */
+            num_sel = 0;
+            for (i = 0; i < batch; i++)
+            {
+                if (lens[i] == len)
+                {
+                    for (j = 0; j < n; j++)
+                        Q[j] |= P[i*n + j];
+
+                    sel_primes[num_sel] = primes[i];
+                    sel_polys[num_sel] = polys[i];
+                    num_sel++;
+                }
+            }
 
-            fmpz_mul_ui(m, m, p);
+            _fmpz_poly_multi_CRT_ui(rop, m, len, sel_polys, sel_primes,
+                                              num_sel, 1, handles, num_handles);
 
             /* check if stabilised */
             for (i = 0; i < len; i++)
@@ -277,24 +368,24 @@ slong _fmpz_mat_minpoly_modular(fmpz * rop, const fmpz_mat_t op)
 
                /* if f(A)v = 0 for all generators v, we are done */
                if (i == n)
-               {
-                  nmod_mat_clear(mat);
-                  nmod_poly_clear(poly);
                   break;
-               }
             }
-
-            nmod_mat_clear(mat);
-            nmod_poly_clear(poly);
         }
 
+        flint_give_back_threads(handles, num_handles);
+
+        flint_free(args);
+        flint_free(lens);
+        _nmod_vec_clear(polys[0]);
+        flint_free(polys);
+        _nmod_vec_clear(primes);
         flint_free(P);
         flint_free(Q);
         fmpz_mat_clear(v2);
         fmpz_mat_clear(v1);
         fmpz_mat_clear(v3);
         fmpz_clear(m);
-        _fmpz_vec_clear(rold, n);
+        _fmpz_vec_clear(rold, n + 1);
     }
 
     return len;
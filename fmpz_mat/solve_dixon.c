@@ -10,6 +10,7 @@
 */
 
 #include "fmpz_mat.h"
+#include "thread_support.h"
 
 mp_limb_t
 fmpz_mat_find_good_prime_and_invert(nmod_mat_t Ainv,
@@ -47,8 +48,6 @@ fmpz_mat_find_good_prime_and_invert(nmod_mat_t Ainv,
    primes are >= p. This allows reusing y_mod as the right-hand
    side without reducing it. */
 
-#define USE_SLOW_MULTIPLICATION 0
-
 mp_limb_t * fmpz_mat_dixon_get_crt_primes(slong * num_primes, const fmpz_mat_t A, mp_limb_t p)
 {
     fmpz_t bound, prod;
@@ -86,6 +85,191 @@ mp_limb_t * fmpz_mat_dixon_get_crt_primes(slong * num_primes, const fmpz_mat_t A
     return primes;
 }
 
+/*
+    One step of Dixon lifting, shared between threads. Each of the n rows
+    of d, x and of the products is handled by one thread, and the product
+    A*y modulo each of the primes is split by rows.
+*/
+
+typedef struct
+{
+    fmpz_mat_struct * x;
+    fmpz_mat_struct * d;
+    const fmpz * ppow;
+    const nmod_mat_struct * Ainv;
+    nmod_mat_t * A_mod;
+    nmod_mat_struct * Ay_mod;
+    nmod_mat_struct * d_mod;
+    nmod_mat_struct * y_mod;
+    slong num_primes;
+    const fmpz_comb_struct * comb;
+    slong r0;
+    slong r1;
+    int phase;
+}
+_dixon_step_arg_t;
+
+static void
+_dixon_mul_rows(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B,
+                                                            slong r0, slong r1)
+{
+    nmod_mat_t Cw, Aw;
+
+    if (r0 == 0 && r1 == A->r)
+    {
+        nmod_mat_mul(C, A, B);
+        return;
+    }
+
+    if (r0 >= r1)
+        return;
+
+    nmod_mat_window_init(Cw, C, r0, 0, r1, C->c);
+    nmod_mat_window_init(Aw, A, r0, 0, r1, A->c);
+    nmod_mat_mul(Cw, Aw, B);
+    nmod_mat_window_clear(Cw);
+    nmod_mat_window_clear(Aw);
+}
+
+static void
+_dixon_step_worker(void * arg_ptr)
+{
+    _dixon_step_arg_t * arg = (_dixon_step_arg_t *) arg_ptr;
+    mp_limb_t p = arg->Ainv->mod.n;
+    slong i, j, k, cols = arg->d->c;
+
+    if (arg->phase == 0)
+    {
+        /* d_mod = d mod p */
+        for (i = arg->r0; i < arg->r1; i++)
+            for (j = 0; j < cols; j++)
+                nmod_mat_entry(arg->d_mod, i, j) =
+                          fmpz_fdiv_ui(fmpz_mat_entry(arg->d, i, j), p);
+    }
+    else if (arg->phase == 1)
+    {
+        /* y = A^(-1) * d  (mod p) */
+        _dixon_mul_rows(arg->y_mod, arg->Ainv, arg->d_mod, arg->r0, arg->r1);
+    }
+    else if (arg->phase == 2)
+    {
+        /* A*y modulo each prime; all primes are >= p so y is reduced */
+        for (k = 0; k < arg->num_primes; k++)
+        {
+            nmod_mat_struct y = *arg->y_mod;
+
+            y.mod = arg->A_mod[k]->mod;
+            _dixon_mul_rows(arg->Ay_mod + k, arg->A_mod[k], &y,
+                                                             arg->r0, arg->r1);
+        }
+    }
+    else if (arg->phase == 3)
+    {
+        /* x = x + y * p^i */
+        for (i = arg->r0; i < arg->r1; i++)
+            for (j = 0; j < cols; j++)
+                fmpz_addmul_ui(fmpz_mat_entry(arg->x, i, j), arg->ppow,
+                                            nmod_mat_entry(arg->y_mod, i, j));
+    }
+    else
+    {
+        /* x = x + y * p^i and d = (d - Ay) / p */
+        fmpz_comb_temp_t temp;
+        mp_ptr r;
+        fmpz_t t;
+
+        fmpz_comb_temp_init(temp, arg->comb);
+        r = _nmod_vec_init(arg->num_primes);
+        fmpz_init(t);
+
+        for (i = arg->r0; i < arg->r1; i++)
+        {
+            for (j = 0; j < cols; j++)
+            {
+                fmpz * dij = fmpz_mat_entry(arg->d, i, j);
+
+                fmpz_addmul_ui(fmpz_mat_entry(arg->x, i, j), arg->ppow,
+                                            nmod_mat_entry(arg->y_mod, i, j));
+
+                for (k = 0; k < arg->num_primes; k++)
+                    r[k] = nmod_mat_entry(arg->Ay_mod + k, i, j);
+
+                fmpz_multi_CRT_ui(t, r, arg->comb, temp, 1);
+                fmpz_sub(dij, dij, t);
+                fmpz_divexact_ui(dij, dij, p);
+            }
+        }
+
+        fmpz_clear(t);
+        _nmod_vec_clear(r);
+        fmpz_comb_temp_clear(temp);
+    }
+}
+
+void
+_fmpz_mat_dixon_step(fmpz_mat_t x, fmpz_mat_t d, const fmpz_t ppow,
+                     const nmod_mat_t Ainv, nmod_mat_t * const A_mod,
+                     nmod_mat_struct * Ay_mod, const fmpz_comb_t comb,
+                                               slong num_primes, int update)
+{
+    thread_pool_handle * threads;
+    slong i, j, n, cols, num_threads;
+    _dixon_step_arg_t * args;
+    nmod_mat_t d_mod, y_mod;
+
+    n = d->r;
+    cols = d->c;
+
+    nmod_mat_init(d_mod, n, cols, Ainv->mod.n);
+    nmod_mat_init(y_mod, n, cols, Ainv->mod.n);
+
+    num_threads = flint_request_threads(&threads,
+                          FLINT_MIN(flint_get_num_threads(), (n + 15)/16));
+
+    args = flint_malloc((num_threads + 1)*sizeof(_dixon_step_arg_t));
+
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i].x = x;
+        args[i].d = d;
+        args[i].ppow = ppow;
+        args[i].Ainv = Ainv;
+        args[i].A_mod = A_mod;
+        args[i].Ay_mod = Ay_mod;
+        args[i].d_mod = d_mod;
+        args[i].y_mod = y_mod;
+        args[i].num_primes = num_primes;
+        args[i].comb = comb;
+        args[i].r0 = (i*n)/(num_threads + 1);
+        args[i].r1 = ((i + 1)*n)/(num_threads + 1);
+    }
+
+    /* without the update of d, x is updated on its own */
+    for (j = 0; j < 4; j++)
+    {
+        if (j == 2 && !update)
+            j = 3;
+
+        for (i = 0; i <= num_threads; i++)
+            args[i].phase = (j == 3 && update) ? 4 : j;
+
+        for (i = 0; i < num_threads; i++)
+            thread_pool_wake(global_thread_pool, threads[i], 0,
+                                                _dixon_step_worker, &args[i]);
+
+        _dixon_step_worker(&args[num_threads]);
+
+        for (i = 0; i < num_threads; i++)
+            thread_pool_wait(global_thread_pool, threads[i]);
+    }
+
+    flint_give_back_threads(threads, num_threads);
+
+    flint_free(args);
+
+    nmod_mat_clear(d_mod);
+    nmod_mat_clear(y_mod);
+}
 
 void
 _fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
@@ -93,12 +277,12 @@ _fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
                     const nmod_mat_t Ainv, mp_limb_t p,
                     const fmpz_t N, const fmpz_t D)
 {
-    fmpz_t bound, ppow;
-    fmpz_mat_t x, d, y, Ay;
-    fmpz_t prod;
+    fmpz_t bound, ppow, pnext;
+    fmpz_mat_t x, d;
     mp_limb_t * crt_primes;
     nmod_mat_t * A_mod;
-    nmod_mat_t Ay_mod, d_mod, y_mod;
+    nmod_mat_struct * Ay_mod;
+    fmpz_comb_t comb;
     slong i, n, cols, num_primes;
 
     n = A->r;
@@ -106,11 +290,9 @@ _fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
 
     fmpz_init(bound);
     fmpz_init(ppow);
-    fmpz_init(prod);
+    fmpz_init(pnext);
 
     fmpz_mat_init(x, n, cols);
-    fmpz_mat_init(y, n, cols);
-    fmpz_mat_init(Ay, n, cols);
     fmpz_mat_init_set(d, B);
 
     /* Compute bound for the needed modulus. TODO: if one of N and D
@@ -127,80 +309,49 @@ _fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
     crt_primes = fmpz_mat_dixon_get_crt_primes(&num_primes, A, p);
     A_mod = (nmod_mat_t *) flint_malloc(sizeof(nmod_mat_t) * num_primes);
     for (i = 0; i < num_primes; i++)
-    {
         nmod_mat_init(A_mod[i], n, n, crt_primes[i]);
-        fmpz_mat_get_nmod_mat(A_mod[i], A);
-    }
+    fmpz_mat_multi_mod_ui(A_mod, num_primes, A);
 
-    nmod_mat_init(Ay_mod, n, cols, UWORD(1));
-    nmod_mat_init(d_mod, n, cols, p);
-    nmod_mat_init(y_mod, n, cols, p);
+    /* workspace for d = (d - Ay) / p, shared by all the lifting steps */
+    Ay_mod = (nmod_mat_struct *)
+                          flint_malloc(sizeof(nmod_mat_struct) * num_primes);
+    for (i = 0; i < num_primes; i++)
+        nmod_mat_init(Ay_mod + i, n, cols, crt_primes[i]);
+    fmpz_comb_init(comb, crt_primes, num_primes);
 
     fmpz_one(ppow);
 
     while (fmpz_cmp(ppow, bound) <= 0)
     {
-        /* y = A^(-1) * d  (mod p) */
-        fmpz_mat_get_nmod_mat(d_mod, d);
-        nmod_mat_mul(y_mod, Ainv, d_mod);
-
-        /* x = x + y * p^i    [= A^(-1) * b mod p^(i+1)] */
-        fmpz_mat_scalar_addmul_nmod_mat_fmpz(x, y_mod, ppow);
-
-        /* ppow = p^(i+1) */
-        fmpz_mul_ui(ppow, ppow, p);
-        if (fmpz_cmp(ppow, bound) > 0)
-            break;
-
-        /* d = (d - Ay) / p */
-#if USE_SLOW_MULTIPLICATION
-        fmpz_mat_set_nmod_mat_unsigned(y, y_mod);
-        fmpz_mat_mul(Ay, A, y);
-#else
-        for (i = 0; i < num_primes; i++)
-        {
-            _nmod_mat_set_mod(y_mod, crt_primes[i]);
-            _nmod_mat_set_mod(Ay_mod, crt_primes[i]);
-            nmod_mat_mul(Ay_mod, A_mod[i], y_mod);
-            if (i == 0)
-            {
-                fmpz_mat_set_nmod_mat(Ay, Ay_mod);
-                fmpz_set_ui(prod, crt_primes[0]);
-            }
-            else
-            {
-                fmpz_mat_CRT_ui(Ay, Ay, prod, Ay_mod, 1);
-                fmpz_mul_ui(prod, prod, crt_primes[i]);
-            }
-        }
-#endif
-
-        _nmod_mat_set_mod(y_mod, p);
-        fmpz_mat_sub(d, d, Ay);
-        fmpz_mat_scalar_divexact_ui(d, d, p);
+        /* x = x + y * p^i where y = A^(-1) * d  (mod p), and
+           d = (d - Ay) / p unless p^(i+1) is large enough */
+        fmpz_mul_ui(pnext, ppow, p);
+        _fmpz_mat_dixon_step(x, d, ppow, Ainv, A_mod, Ay_mod, comb,
+                             num_primes, fmpz_cmp(pnext, bound) <= 0);
+        fmpz_swap(ppow, pnext);
     }
 
     fmpz_set(mod, ppow);
     fmpz_mat_set(X, x);
 
-    nmod_mat_clear(y_mod);
-    nmod_mat_clear(d_mod);
-    nmod_mat_clear(Ay_mod);
+    fmpz_comb_clear(comb);
 
     for (i = 0; i < num_primes; i++)
+    {
         nmod_mat_clear(A_mod[i]);
+        nmod_mat_clear(Ay_mod + i);
+    }
 
     flint_free(A_mod);
+    flint_free(Ay_mod);
     flint_free(crt_primes);
 
     fmpz_clear(bound);
     fmpz_clear(ppow);
-    fmpz_clear(prod);
+    fmpz_clear(pnext);
 
     fmpz_mat_clear(x);
-    fmpz_mat_clear(y);
     fmpz_mat_clear(d);
-    fmpz_mat_clear(Ay);
 }
 
 int
@@ -17,6 +17,7 @@
 #include "fmpz.h"
 #include "fmpz_mat.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -113,6 +114,39 @@ main(void)
         fmpz_poly_clear(g);
     }
 
+    /* modular algorithm against Berkowitz, with threads */
+    for (rep = 0; rep < 100 * flint_test_multiplier(); rep++)
+    {
+        fmpz_mat_t A;
+        fmpz_poly_t f, g;
+
+        m = n_randint(state, 15);
+
+        fmpz_mat_init(A, m, m);
+        fmpz_poly_init(f);
+        fmpz_poly_init(g);
+
+        fmpz_mat_randtest(A, state, 1 + n_randint(state, 100));
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        fmpz_mat_charpoly_modular(f, A);
+        fmpz_mat_charpoly_berkowitz(g, A);
+
+        if (!fmpz_poly_equal(f, g))
+        {
+            flint_printf("FAIL: charpoly_modular(A) != charpoly_berkowitz(A).\n");
+            flint_printf("Matrix A:\n"), fmpz_mat_print(A), flint_printf("\n");
+            flint_printf("cp_modular(A) = "), fmpz_poly_print_pretty(f, "X"), flint_printf("\n");
+            flint_printf("cp_berkowitz(A) = "), fmpz_poly_print_pretty(g, "X"), flint_printf("\n");
+            abort();
+        }
+
+        fmpz_mat_clear(A);
+        fmpz_poly_clear(f);
+        fmpz_poly_clear(g);
+    }
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
@@ -17,6 +17,7 @@
 #include "fmpz_vec.h"
 #include "fmpz_mat.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 
 int
@@ -35,6 +36,9 @@ main(void)
     for (i = 0; i < 1000 * flint_test_multiplier(); i++)
     {
         int proved = n_randlimb(state) % 2;
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         m = n_randint(state, 10);
 
         fmpz_mat_init(A, m, m);
@@ -17,6 +17,7 @@
 #include "fmpz.h"
 #include "fmpz_mat.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -33,7 +34,7 @@ main(void)
         fmpz_mat_t A;
         fmpz_poly_t f, g, q, r;
 
-        m = n_randint(state, 4);
+        m = n_randint(state, 8);
         n = m;
 
         fmpz_init(c);
@@ -61,6 +62,8 @@ main(void)
            fmpz_mat_similarity(A, n_randint(state, m), c);
         }
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         fmpz_mat_minpoly(f, A);
         fmpz_mat_charpoly(g, A);
 
@@ -89,7 +92,7 @@ main(void)
         fmpz_mat_t A, B;
         fmpz_poly_t f, g;
 
-        m = n_randint(state, 4);
+        m = n_randint(state, 8);
         n = m;
 
         fmpz_init(c);
@@ -118,6 +121,8 @@ main(void)
            fmpz_mat_similarity(B, n_randint(state, m), c);
         }
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         fmpz_mat_minpoly(f, A);
         fmpz_mat_minpoly(g, B);
 
@@ -17,6 +17,7 @@
 #include "fmpz_vec.h"
 #include "fmpz_mat.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -33,6 +34,8 @@ main(void)
 
     for (i = 0; i < 100 * flint_test_multiplier(); i++)
     {
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         m = n_randint(state, 20);
         n = n_randint(state, 20);
 
@@ -474,6 +474,14 @@ FLINT_DLL void fmpz_mod_poly_mullow(fmpz_mod_poly_t res,
                     const fmpz_mod_poly_t poly1, const fmpz_mod_poly_t poly2,
                                             slong n, const fmpz_mod_ctx_t ctx);
 
+FLINT_DLL void _fmpz_mod_poly_mulmid(fmpz *res, const fmpz *poly1, slong len1, 
+                                      const fmpz *poly2, slong len2, 
+                                      const fmpz_t p);
+
+FLINT_DLL void fmpz_mod_poly_mulmid(fmpz_mod_poly_t res, 
+                    const fmpz_mod_poly_t poly1, const fmpz_mod_poly_t poly2,
+                                                     const fmpz_mod_ctx_t ctx);
+
 FLINT_DLL void _fmpz_mod_poly_sqr(fmpz *res, const fmpz *poly, slong len,
                                                                const fmpz_t p);
 
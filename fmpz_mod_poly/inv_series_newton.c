@@ -56,7 +56,8 @@ _fmpz_mod_poly_inv_series_newton(fmpz * Qinv, const fmpz * Q, slong n,
             m = n;
             n = a[i];
 
-            _fmpz_mod_poly_mullow(W, Q, n, Qinv, m, p, n);
+            /* the low m coefficients of Q*Qinv are known to be 1, 0, ... */
+            _fmpz_mod_poly_mulmid(W + m - 1, Q, n, Qinv, m, p);
             _fmpz_mod_poly_mullow(Qinv + m, Qinv, m, W + m, n - m, p, n - m);
             _fmpz_mod_poly_neg(Qinv + m, Qinv + m, n - m, p);
         }
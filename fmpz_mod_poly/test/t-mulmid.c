@@ -0,0 +1,126 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mod_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, result;
+    fmpz_mod_ctx_t ctx;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mulmid....");
+    fflush(stdout);
+
+    fmpz_mod_ctx_init_ui(ctx, 2);
+
+    /* Compare with the middle of the product of a and b */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        fmpz_t p;
+        fmpz_mod_poly_t a, b, c;
+        slong len;
+
+        fmpz_init(p);
+        fmpz_randtest_unsigned(p, state, 2 * FLINT_BITS);
+        fmpz_add_ui(p, p, 2);
+        fmpz_mod_ctx_set_modulus(ctx, p);
+
+        fmpz_mod_poly_init(a, ctx);
+        fmpz_mod_poly_init(b, ctx);
+        fmpz_mod_poly_init(c, ctx);
+        len = n_randint(state, 10) == 0 ? n_randint(state, 500) :
+                                          n_randint(state, 50);
+        fmpz_mod_poly_randtest(b, state, len, ctx);
+        fmpz_mod_poly_randtest(c, state, n_randint(state, b->length + 1), ctx);
+
+        fmpz_mod_poly_mulmid(a, b, c, ctx);
+        if (c->length != 0)
+        {
+            len = b->length;
+            fmpz_mod_poly_mul(b, b, c, ctx);
+            fmpz_mod_poly_truncate(b, len, ctx);
+            fmpz_mod_poly_shift_right(b, b, c->length - 1, ctx);
+        }
+        else
+            fmpz_mod_poly_zero(b, ctx);
+
+        result = (fmpz_mod_poly_equal(a, b, ctx));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            fmpz_mod_poly_print(a, ctx), flint_printf("\n\n");
+            fmpz_mod_poly_print(b, ctx), flint_printf("\n\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_mod_poly_clear(a, ctx);
+        fmpz_mod_poly_clear(b, ctx);
+        fmpz_mod_poly_clear(c, ctx);
+        fmpz_clear(p);
+    }
+
+    /* Check aliasing */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        fmpz_t p;
+        fmpz_mod_poly_t a, b, c;
+
+        fmpz_init(p);
+        fmpz_randtest_unsigned(p, state, 2 * FLINT_BITS);
+        fmpz_add_ui(p, p, 2);
+        fmpz_mod_ctx_set_modulus(ctx, p);
+
+        fmpz_mod_poly_init(a, ctx);
+        fmpz_mod_poly_init(b, ctx);
+        fmpz_mod_poly_init(c, ctx);
+        fmpz_mod_poly_randtest(b, state, n_randint(state, 50), ctx);
+        fmpz_mod_poly_randtest(c, state, n_randint(state, b->length + 1), ctx);
+
+        fmpz_mod_poly_mulmid(a, b, c, ctx);
+        if (n_randint(state, 2))
+        {
+            fmpz_mod_poly_mulmid(b, b, c, ctx);
+            result = (fmpz_mod_poly_equal(a, b, ctx));
+        }
+        else
+        {
+            fmpz_mod_poly_mulmid(c, b, c, ctx);
+            result = (fmpz_mod_poly_equal(a, c, ctx));
+        }
+
+        if (!result)
+        {
+            flint_printf("FAIL (aliasing):\n");
+            fmpz_mod_poly_print(a, ctx), flint_printf("\n\n");
+            fmpz_mod_poly_print(b, ctx), flint_printf("\n\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_mod_poly_clear(a, ctx);
+        fmpz_mod_poly_clear(b, ctx);
+        fmpz_mod_poly_clear(c, ctx);
+        fmpz_clear(p);
+    }
+
+    fmpz_mod_ctx_clear(ctx);
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
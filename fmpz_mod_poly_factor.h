@@ -128,6 +128,11 @@ FLINT_DLL void fmpz_mod_poly_factor_equal_deg_with_frob(
 FLINT_DLL void fmpz_mod_poly_factor_equal_deg(fmpz_mod_poly_factor_t factors,
                  const fmpz_mod_poly_t pol, slong d, const fmpz_mod_ctx_t ctx);
 
+FLINT_DLL void fmpz_mod_poly_factor_equal_deg_threaded_with_frob(
+                  fmpz_mod_poly_factor_t factors,
+                  const fmpz_mod_poly_factor_t polys,
+                  const fmpz_mod_poly_t frob, const fmpz_mod_ctx_t ctx);
+
 FLINT_DLL void fmpz_mod_poly_factor_distinct_deg_with_frob(
                     fmpz_mod_poly_factor_t res,  const fmpz_mod_poly_t poly,
                     const fmpz_mod_poly_t polyinv, const fmpz_mod_poly_t frob,
@@ -0,0 +1,262 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fmpz_mod_poly.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    fmpz_mod_poly_struct * f;
+    fmpz_mod_poly_struct * g;
+    fmpz_mod_poly_factor_struct * fac;
+    const slong * d;
+    const fmpz_mod_poly_struct * frob;
+    const fmpz_mod_ctx_struct * ctx;
+    slong num;
+    int split;
+    volatile slong * index;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_equal_deg_arg_t;
+
+/*
+    Either factor f[i] completely into fac[i], or split it once into
+    f[i]*g[i] with fmpz_mod_poly_factor_equal_deg_prob
+*/
+static void
+_equal_deg_worker(void * arg_ptr)
+{
+    _equal_deg_arg_t * arg = (_equal_deg_arg_t *) arg_ptr;
+    const fmpz_mod_ctx_struct * ctx = arg->ctx;
+    fmpz_mod_poly_t q;
+    flint_rand_t state;
+    slong i;
+
+    fmpz_mod_poly_init(q, ctx);
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        i = *arg->index;
+        *arg->index = i + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (i >= arg->num)
+            break;
+
+        if (!arg->split)
+        {
+            fmpz_mod_poly_rem(q, arg->frob, arg->f + i, ctx);
+            fmpz_mod_poly_factor_equal_deg_with_frob(arg->fac + i, arg->f + i,
+                                                         arg->d[i], q, ctx);
+            continue;
+        }
+
+        flint_randinit(state);
+        while (!fmpz_mod_poly_factor_equal_deg_prob(q, state, arg->f + i,
+                                                       arg->d[i], ctx)) {};
+        flint_randclear(state);
+
+        fmpz_mod_poly_div(arg->g + i, arg->f + i, q, ctx);
+        fmpz_mod_poly_swap(arg->f + i, q, ctx);
+    }
+
+    fmpz_mod_poly_clear(q, ctx);
+}
+
+static void
+_equal_deg_run(_equal_deg_arg_t * args, slong num,
+                                 thread_pool_handle * threads, slong num_threads)
+{
+    slong i, index = 0;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    num_threads = FLINT_MIN(num_threads, num - 1);
+
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i] = args[0];
+        args[i].num = num;
+        args[i].index = &index;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                                 _equal_deg_worker, &args[i]);
+
+    _equal_deg_worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+}
+
+void
+fmpz_mod_poly_factor_equal_deg_threaded_with_frob(
+    fmpz_mod_poly_factor_t factors,
+    const fmpz_mod_poly_factor_t polys,
+    const fmpz_mod_poly_t frob,
+    const fmpz_mod_ctx_t ctx)
+{
+    fmpz_mod_poly_struct * f, * g;
+    fmpz_mod_poly_factor_struct * fac, * ef;
+    slong * d, * b, * gd, * gb;
+    slong i, k, len, alloc, num = polys->num, num_threads;
+    thread_pool_handle * threads;
+    _equal_deg_arg_t * args;
+
+    factors->num = 0;
+
+    if (num < 1)
+        return;
+
+    num_threads = flint_request_threads(&threads, flint_get_num_threads());
+
+    /*
+        Every pending polynomial is split once per round until there are
+        at least as many of them as threads, then each is factored fully
+        by one thread. In a splitting round there are at most num_threads
+        pending polynomials, which give at most twice as many.
+    */
+    alloc = FLINT_MAX(num, 2*num_threads);
+
+    f = FLINT_ARRAY_ALLOC(2*alloc, fmpz_mod_poly_struct);
+    g = f + alloc;
+    ef = FLINT_ARRAY_ALLOC(num + alloc, fmpz_mod_poly_factor_struct);
+    fac = ef + alloc;
+    d = FLINT_ARRAY_ALLOC(4*alloc, slong);
+    b = d + alloc;
+    gd = b + alloc;
+    gb = gd + alloc;
+    args = FLINT_ARRAY_ALLOC(num_threads + 1, _equal_deg_arg_t);
+
+    for (i = 0; i < alloc; i++)
+    {
+        fmpz_mod_poly_init(f + i, ctx);
+        fmpz_mod_poly_init(g + i, ctx);
+        fmpz_mod_poly_factor_init(ef + i, ctx);
+    }
+
+    for (i = 0; i < num; i++)
+        fmpz_mod_poly_factor_init(fac + i, ctx);
+
+    len = 0;
+    for (i = 0; i < num; i++)
+    {
+        if (fmpz_mod_poly_degree(polys->poly + i, ctx) == polys->exp[i])
+        {
+            fmpz_mod_poly_factor_insert(fac + i, polys->poly + i, 1, ctx);
+        }
+        else
+        {
+            fmpz_mod_poly_set(f + len, polys->poly + i, ctx);
+            d[len] = polys->exp[i];
+            b[len] = i;
+            len++;
+        }
+    }
+
+    while (len > 0)
+    {
+        args[0].f = f;
+        args[0].g = g;
+        args[0].fac = ef;
+        args[0].d = d;
+        args[0].frob = frob;
+        args[0].ctx = ctx;
+        args[0].split = (len <= num_threads);
+
+        _equal_deg_run(args, len, threads, num_threads);
+
+        if (!args[0].split)
+        {
+            for (i = 0; i < len; i++)
+                fmpz_mod_poly_factor_concat(fac + b[i], ef + i, ctx);
+
+            break;
+        }
+
+        for (i = 0; i < len; i++)
+        {
+            gd[i] = d[i];
+            gb[i] = b[i];
+        }
+
+        k = 0;
+        for (i = 0; i < len; i++)
+        {
+            if (fmpz_mod_poly_degree(f + i, ctx) == d[i])
+            {
+                fmpz_mod_poly_factor_insert(fac + b[i], f + i, 1, ctx);
+            }
+            else
+            {
+                fmpz_mod_poly_swap(f + k, f + i, ctx);
+                d[k] = d[i];
+                b[k] = b[i];
+                k++;
+            }
+        }
+
+        for (i = 0; i < len; i++)
+        {
+            if (fmpz_mod_poly_degree(g + i, ctx) == gd[i])
+            {
+                fmpz_mod_poly_factor_insert(fac + gb[i], g + i, 1, ctx);
+            }
+            else
+            {
+                fmpz_mod_poly_swap(f + k, g + i, ctx);
+                d[k] = gd[i];
+                b[k] = gb[i];
+                k++;
+            }
+        }
+
+        len = k;
+    }
+
+    for (i = 0; i < num; i++)
+    {
+        fmpz_mod_poly_factor_concat(factors, fac + i, ctx);
+        fmpz_mod_poly_factor_clear(fac + i, ctx);
+    }
+
+    for (i = 0; i < alloc; i++)
+    {
+        fmpz_mod_poly_clear(f + i, ctx);
+        fmpz_mod_poly_clear(g + i, ctx);
+        fmpz_mod_poly_factor_clear(ef + i, ctx);
+    }
+
+    flint_give_back_threads(threads, num_threads);
+
+    flint_free(args);
+    flint_free(d);
+    flint_free(ef);
+    flint_free(f);
+}
@@ -59,6 +59,20 @@ fmpz_mod_poly_factor_kaltofen_shoup(fmpz_mod_poly_factor_t res,
         else
             fmpz_mod_poly_factor_distinct_deg_with_frob(DD, f, t, DDxp, ctx);
 
+        if (num_threads > 1 && (DD->num > 1 || f->length > 64))
+        {
+            fmpz_mod_poly_factor_equal_deg_threaded_with_frob(ED, DD, DDxp, ctx);
+            fmpz_mod_poly_factor_fit_length(res, res->num + ED->num, ctx);
+            for (k = 0; k < ED->num; k++)
+            {
+                fmpz_mod_poly_swap(res->poly + res->num, ED->poly + k, ctx);
+                res->exp[res->num] = SF->exp[i];
+                res->num++;
+            }
+
+            continue;
+        }
+
         for (j = 0; j < DD->num; j++)
         {
             fmpz_mod_poly_divrem(t, EDxp, DDxp, DD->poly + j, ctx);
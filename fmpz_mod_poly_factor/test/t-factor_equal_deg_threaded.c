@@ -0,0 +1,143 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include "fmpz_mod_poly.h"
+#include "ulong_extras.h"
+#include "flint.h"
+#include "thread_support.h"
+
+#define MAX_DEG 9
+
+int main(void)
+{
+    int iter;
+    fmpz_mod_ctx_t ctx;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("factor_equal_deg_threaded....");
+    fflush(stdout);
+
+    fmpz_mod_ctx_init_ui(ctx, 2);
+
+    for (iter = 0; iter < 50 * flint_test_multiplier(); iter++)
+    {
+        fmpz_mod_poly_t poly1, poly, q, r, finv, frob, product;
+        fmpz_mod_poly_factor_t dist_deg, res;
+        fmpz_t modulus;
+        slong i, j, length, num;
+
+        fmpz_init(modulus);
+        if (n_randint(state, 4) == 0)
+            fmpz_randprime(modulus, state, n_randint(state, 100) + 2, 0);
+        else
+            fmpz_set_ui(modulus, n_randtest_prime(state, 0));
+        fmpz_mod_ctx_set_modulus(ctx, modulus);
+
+        flint_set_num_threads(1 + n_randint(state, 5));
+
+        fmpz_mod_poly_init(poly1, ctx);
+        fmpz_mod_poly_init(poly, ctx);
+        fmpz_mod_poly_init(q, ctx);
+        fmpz_mod_poly_init(r, ctx);
+        fmpz_mod_poly_init(finv, ctx);
+        fmpz_mod_poly_init(frob, ctx);
+        fmpz_mod_poly_init(product, ctx);
+
+        fmpz_mod_poly_one(poly1, ctx);
+
+        num = n_randint(state, 12) + 1;
+
+        for (i = 0; i < num; i++)
+        {
+            do
+            {
+                length = n_randint(state, MAX_DEG) + 2;
+                fmpz_mod_poly_randtest(poly, state, length, ctx);
+                if (poly->length)
+                {
+                    fmpz_mod_poly_make_monic(poly, poly, ctx);
+                    fmpz_mod_poly_divrem(q, r, poly1, poly, ctx);
+                }
+            }
+            while ((poly->length < 2) ||
+                   (!fmpz_mod_poly_is_irreducible(poly, ctx)) ||
+                   (r->length == 0));
+
+            fmpz_mod_poly_mul(poly1, poly1, poly, ctx);
+        }
+
+        fmpz_mod_poly_reverse(finv, poly1, poly1->length, ctx);
+        fmpz_mod_poly_inv_series_newton(finv, finv, poly1->length, ctx);
+        fmpz_mod_poly_powmod_x_fmpz_preinv(frob, modulus, poly1, finv, ctx);
+
+        fmpz_mod_poly_factor_init(dist_deg, ctx);
+        fmpz_mod_poly_factor_init(res, ctx);
+        fmpz_mod_poly_factor_distinct_deg_with_frob(dist_deg, poly1, finv,
+                                                                    frob, ctx);
+        fmpz_mod_poly_factor_equal_deg_threaded_with_frob(res, dist_deg,
+                                                                    frob, ctx);
+
+        if (res->num != num)
+        {
+            flint_printf("FAIL: wrong number of factors\n");
+            flint_printf("%wd != %wd\n", res->num, num);
+            flint_abort();
+        }
+
+        fmpz_mod_poly_one(product, ctx);
+        for (i = 0; i < res->num; i++)
+        {
+            fmpz_mod_poly_mul(product, product, res->poly + i, ctx);
+
+            for (j = 0; j < dist_deg->num; j++)
+            {
+                fmpz_mod_poly_divrem(q, r, dist_deg->poly + j, res->poly + i,
+                                                                         ctx);
+                if (r->length == 0)
+                    break;
+            }
+
+            if (j == dist_deg->num || res->exp[i] != 1 ||
+                fmpz_mod_poly_degree(res->poly + i, ctx) != dist_deg->exp[j] ||
+                !fmpz_mod_poly_is_irreducible(res->poly + i, ctx))
+            {
+                flint_printf("FAIL: bad factor\n");
+                fmpz_mod_poly_print(res->poly + i, ctx); flint_printf("\n");
+                flint_abort();
+            }
+        }
+
+        if (!fmpz_mod_poly_equal(poly1, product, ctx))
+        {
+            flint_printf("FAIL: product of factors does not equal the original polynomial\n");
+            flint_printf("poly:\n"); fmpz_mod_poly_print(poly1, ctx); flint_printf("\n");
+            flint_printf("product:\n"); fmpz_mod_poly_print(product, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        fmpz_clear(modulus);
+        fmpz_mod_poly_clear(product, ctx);
+        fmpz_mod_poly_clear(q, ctx);
+        fmpz_mod_poly_clear(r, ctx);
+        fmpz_mod_poly_clear(finv, ctx);
+        fmpz_mod_poly_clear(frob, ctx);
+        fmpz_mod_poly_clear(poly1, ctx);
+        fmpz_mod_poly_clear(poly, ctx);
+        fmpz_mod_poly_factor_clear(dist_deg, ctx);
+        fmpz_mod_poly_factor_clear(res, ctx);
+    }
+
+    fmpz_mod_ctx_clear(ctx);
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -16,6 +16,7 @@
 #include <stdlib.h>
 #include "fmpz_mod_poly.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -37,6 +38,8 @@ main(void)
         slong i, j, length, num;
         slong exp[6];
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         fmpz_init_set_ui(modulus, n_randtest_prime(state, 0));
         fmpz_mod_ctx_set_modulus(ctx, modulus);
 
@@ -379,12 +379,14 @@ typedef struct {
     fmpz_mpoly_struct * q;
     fmpz_mpoly_univar_struct * U;
     fmpz_mpoly_geobucket_struct * G;
-    fmpz_mpoly_struct * qt;
     fmpz_mpoly_struct * newt;
     fmpz_mpolyv_struct * delta_coeffs;
     fmpz_poly_pfrac_t uni_pfrac;
     fmpz_poly_t uni_a;
     fmpz_poly_struct * uni_c;
+    fmpz_mpoly_struct * prods;
+    const fmpz_mpoly_struct ** prod_ops;
+    slong prods_alloc;
 } fmpz_mpoly_pfrac_struct;
 
 typedef fmpz_mpoly_pfrac_struct fmpz_mpoly_pfrac_t[1];
@@ -399,6 +401,15 @@ FLINT_DLL void fmpz_mpoly_pfrac_clear(fmpz_mpoly_pfrac_t I,
 FLINT_DLL int fmpz_mpoly_pfrac(slong l, fmpz_mpoly_t t, const slong * degs,
                              fmpz_mpoly_pfrac_t I, const fmpz_mpoly_ctx_t ctx);
 
+FLINT_DLL void _fmpz_mpoly_vec_mul_threaded_pool(fmpz_mpoly_struct * A,
+       const fmpz_mpoly_struct * const * B, const fmpz_mpoly_struct * const * C,
+                                       slong n, const fmpz_mpoly_ctx_t ctx,
+                        const thread_pool_handle * handles, slong num_handles);
+
+FLINT_DLL void _fmpz_mpoly_vec_mul_threaded(fmpz_mpoly_struct * A,
+       const fmpz_mpoly_struct * const * B, const fmpz_mpoly_struct * const * C,
+                                       slong n, const fmpz_mpoly_ctx_t ctx);
+
 FLINT_DLL int fmpz_mpoly_hlift(slong m, fmpz_mpoly_struct * f, slong r,
                 const fmpz * alpha, const fmpz_mpoly_t A, const slong * degs,
                                                    const fmpz_mpoly_ctx_t ctx);
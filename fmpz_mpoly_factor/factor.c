@@ -13,6 +13,7 @@
 #include "fmpq_poly.h"
 #include "fmpz_mod_mpoly.h"
 #include "nmod_mpoly_factor.h"
+#include "thread_pool.h"
 
 
 /* A has degree 2 wrt gen(0) */
@@ -410,6 +411,131 @@ static int _refine_content_factors(
     return 1;
 }
 
+static int _factor_irred(fmpz_mpolyv_t Af, fmpz_mpoly_t A,
+                          const fmpz_mpoly_ctx_t Actx, unsigned int algo);
+
+typedef struct
+{
+    fmpz_mpolyv_struct * v;
+    fmpz_mpoly_struct * polys;
+    int * success;
+    slong num;
+    const fmpz_mpoly_ctx_struct * ctx;
+    unsigned int algo;
+    volatile slong * index;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_factor_irred_arg_struct;
+
+static void _factor_irred_worker(void * varg)
+{
+    _factor_irred_arg_struct * arg = (_factor_irred_arg_struct *) varg;
+    slong i;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        i = *arg->index;
+        *arg->index = i + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (i >= arg->num)
+            return;
+
+        arg->success[i] = _factor_irred(arg->v + i, arg->polys + i,
+                                                         arg->ctx, arg->algo);
+    }
+}
+
+/*
+    v[i] = factorization of polys[i] as in _factor_irred for 0 <= i < num.
+    The factorizations are independent and are shared among the threads.
+*/
+static int _factor_irred_vec(
+    fmpz_mpolyv_struct * v,
+    fmpz_mpoly_struct * polys,
+    slong num,
+    const fmpz_mpoly_ctx_t ctx,
+    unsigned int algo)
+{
+    int success;
+    int * succ;
+    slong i, index, num_handles;
+    thread_pool_handle * handles;
+    _factor_irred_arg_struct * args;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    num_handles = flint_request_threads(&handles, num);
+
+    if (num_handles < 1)
+    {
+        flint_give_back_threads(handles, num_handles);
+
+        for (i = 0; i < num; i++)
+        {
+            if (!_factor_irred(v + i, polys + i, ctx, algo))
+                return 0;
+        }
+
+        return 1;
+    }
+
+    succ = FLINT_ARRAY_ALLOC(num, int);
+    args = FLINT_ARRAY_ALLOC(num_handles + 1, _factor_irred_arg_struct);
+
+    index = 0;
+    for (i = 0; i <= num_handles; i++)
+    {
+        args[i].v = v;
+        args[i].polys = polys;
+        args[i].success = succ;
+        args[i].num = num;
+        args[i].ctx = ctx;
+        args[i].algo = algo;
+        args[i].index = &index;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                              _factor_irred_worker, &args[i]);
+
+    _factor_irred_worker(&args[num_handles]);
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    flint_give_back_threads(handles, num_handles);
+
+    success = 1;
+    for (i = 0; i < num; i++)
+        success = success && succ[i];
+
+    flint_free(args);
+    flint_free(succ);
+
+    return success;
+}
+
+
 /*
     A is primitive w.r.t to any variable appearing in A.
     A is squarefree with positive lead coeff.
@@ -477,6 +603,7 @@ static int _factor_irred(
         fmpz_mpoly_univar_t U;
         fmpz_mpoly_t t;
         fmpz_mpolyv_t Lf, tf, sf;
+        fmpz_mpolyv_struct * sff = NULL;
 
         fmpz_mpoly_ctx_init(Lctx, M->mvars, ORD_LEX);
         fmpz_mpoly_init(L, Lctx);
@@ -508,16 +635,22 @@ static int _factor_irred(
             if (!success)
                 goto cleanup_more;
 
+            sff = FLINT_ARRAY_ALLOC(sf->length, fmpz_mpolyv_struct);
+            for (i = 0; i < sf->length; i++)
+                fmpz_mpolyv_init(sff + i, Lctx);
+
+            success = _factor_irred_vec(sff, sf->coeffs, sf->length,
+                                                                  Lctx, algo);
+            if (!success)
+                goto cleanup_more;
+
             Lf->length = 0;
             for (i = 0; i < sf->length; i++)
             {
-                success = _factor_irred(tf, sf->coeffs + i, Lctx, algo);
-                if (!success)
-                    goto cleanup_more;
-
-                fmpz_mpolyv_fit_length(Lf, Lf->length + tf->length, Lctx);
-                for (j = 0; j < tf->length; j++)
-                    fmpz_mpoly_swap(Lf->coeffs + Lf->length++, tf->coeffs + j, Lctx);
+                fmpz_mpolyv_fit_length(Lf, Lf->length + sff[i].length, Lctx);
+                for (j = 0; j < sff[i].length; j++)
+                    fmpz_mpoly_swap(Lf->coeffs + Lf->length++,
+                                                     sff[i].coeffs + j, Lctx);
             }
         }
         else
@@ -527,6 +660,13 @@ static int _factor_irred(
 
     cleanup_more:
 
+        if (sff != NULL)
+        {
+            for (i = 0; i < sf->length; i++)
+                fmpz_mpolyv_clear(sff + i, Lctx);
+            flint_free(sff);
+        }
+
         fmpz_mpoly_clear(t, Lctx);
         fmpz_mpoly_univar_clear(U, Lctx);
         fmpz_mpolyv_clear(tf, Lctx);
@@ -584,36 +724,38 @@ int fmpz_mpoly_factor_irred(
     unsigned int algo)
 {
     int success;
-    slong i, j;
-    fmpz_mpolyv_t t;
+    slong i, j, n = f->num;
+    fmpz_mpolyv_struct * t;
     fmpz_mpoly_factor_t g;
 
-    fmpz_mpolyv_init(t, ctx);
+    t = FLINT_ARRAY_ALLOC(n, fmpz_mpolyv_struct);
+    for (j = 0; j < n; j++)
+        fmpz_mpolyv_init(t + j, ctx);
     fmpz_mpoly_factor_init(g, ctx);
 
+    success = _factor_irred_vec(t, f->poly, n, ctx, algo);
+    if (!success)
+        goto cleanup;
+
     fmpz_swap(g->constant, f->constant);
     g->num = 0;
-    for (j = 0; j < f->num; j++)
+    for (j = 0; j < n; j++)
     {
-        success = _factor_irred(t, f->poly + j, ctx, algo);
-        if (!success)
-            goto cleanup;
-
-        fmpz_mpoly_factor_fit_length(g, g->num + t->length, ctx);
-        for (i = 0; i < t->length; i++)
+        fmpz_mpoly_factor_fit_length(g, g->num + t[j].length, ctx);
+        for (i = 0; i < t[j].length; i++)
         {
             fmpz_set(g->exp + g->num, f->exp + j);
-            fmpz_mpoly_swap(g->poly + g->num, t->coeffs + i, ctx);
+            fmpz_mpoly_swap(g->poly + g->num, t[j].coeffs + i, ctx);
             g->num++;
         }
     }
     fmpz_mpoly_factor_swap(f, g, ctx);
 
-    success = 1;
-
 cleanup:
 
-    fmpz_mpolyv_clear(t, ctx);
+    for (j = 0; j < n; j++)
+        fmpz_mpolyv_clear(t + j, ctx);
+    flint_free(t);
     fmpz_mpoly_factor_clear(g, ctx);
 
     return success;
@@ -634,35 +776,47 @@ static int _compressed_content_to_irred(
     int success;
     slong j, k;
     fmpz_mpoly_factor_t h;
-    fmpz_mpolyv_t v;
+    fmpz_mpolyv_struct * v = NULL;
 
     fmpz_mpoly_factor_init(h, ctx);
-    fmpz_mpolyv_init(v, ctx);
 
     success = _fmpz_mpoly_factor_squarefree(h, f, e, ctx);
     if (!success)
         goto cleanup;
 
+    v = FLINT_ARRAY_ALLOC(h->num, fmpz_mpolyv_struct);
     for (j = 0; j < h->num; j++)
-    {
-        success = h->num > 1 ? _factor_irred(v, h->poly + j, ctx, algo) :
-                           _factor_irred_compressed(v, h->poly + j, ctx, algo);
-        if (!success)
-            goto cleanup;
+        fmpz_mpolyv_init(v + j, ctx);
+
+    /* the squarefree factors are independent */
+    if (h->num == 1)
+        success = _factor_irred_compressed(v + 0, h->poly + 0, ctx, algo);
+    else
+        success = _factor_irred_vec(v, h->poly, h->num, ctx, algo);
+    if (!success)
+        goto cleanup;
 
-        fmpz_mpoly_factor_fit_length(g, g->num + v->length, ctx);
-        for (k = 0; k < v->length; k++)
+    for (j = 0; j < h->num; j++)
+    {
+        fmpz_mpoly_factor_fit_length(g, g->num + v[j].length, ctx);
+        for (k = 0; k < v[j].length; k++)
         {
             fmpz_set(g->exp + g->num, h->exp + j);
-            fmpz_mpoly_swap(g->poly + g->num, v->coeffs + k, ctx);
+            fmpz_mpoly_swap(g->poly + g->num, v[j].coeffs + k, ctx);
             g->num++;
         }
     }
 
 cleanup:
 
+    if (v != NULL)
+    {
+        for (j = 0; j < h->num; j++)
+            fmpz_mpolyv_clear(v + j, ctx);
+        flint_free(v);
+    }
+
     fmpz_mpoly_factor_clear(h, ctx);
-    fmpz_mpolyv_clear(v, ctx);
 
     return success;
 }
@@ -10,6 +10,172 @@
 */
 
 #include "fmpz_mpoly_factor.h"
+#include "thread_pool.h"
+
+
+/*
+    Set Aevals[i] = A(x0, ..., xi, alpha[i], ..., alpha[n-1]) and factor the
+    univariate image Aevals[0]. Return 0 if a degree drops under evaluation.
+*/
+static int _wang_screen_alpha(
+    fmpz_mpoly_struct * Aevals,
+    fmpz_poly_factor_t Aufac,
+    const fmpz_mpoly_t A,
+    const fmpz * alpha,
+    const slong * degs,
+    const fmpz_mpoly_ctx_t ctx)
+{
+    int success;
+    const slong n = ctx->minfo->nvars - 1;
+    slong i, j;
+    slong * tdegs;
+    fmpz_poly_t Au;
+
+    tdegs = FLINT_ARRAY_ALLOC(n + 1, slong);
+    fmpz_poly_init(Au);
+
+    /* ensure degrees do not drop under evaluation */
+    for (i = n - 1; i >= 0; i--)
+    {
+        fmpz_mpoly_evaluate_one_fmpz(Aevals + i,
+                       i == n - 1 ? A : Aevals + i + 1, i + 1, alpha + i, ctx);
+        fmpz_mpoly_degrees_si(tdegs, Aevals + i, ctx);
+        for (j = 0; j <= i; j++)
+        {
+            if (tdegs[j] != degs[j])
+            {
+                success = 0;
+                goto cleanup;
+            }
+        }
+    }
+
+    FLINT_ASSERT(fmpz_mpoly_is_fmpz_poly(Aevals + 0, 0, ctx));
+    success = fmpz_mpoly_get_fmpz_poly(Au, Aevals + 0, 0, ctx);
+    FLINT_ASSERT(success);
+    fmpz_poly_factor(Aufac, Au);
+
+cleanup:
+
+    flint_free(tdegs);
+    fmpz_poly_clear(Au);
+
+    return success;
+}
+
+typedef struct
+{
+    fmpz_mpoly_struct * Aevals;
+    fmpz_poly_factor_struct * Aufacs;
+    int * screened;
+    const fmpz_mpoly_struct * A;
+    const fmpz * alphas;
+    const slong * degs;
+    const fmpz_mpoly_ctx_struct * ctx;
+    slong num;
+    volatile slong * index;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_wang_screen_arg_struct;
+
+static void _wang_screen_worker(void * varg)
+{
+    _wang_screen_arg_struct * arg = (_wang_screen_arg_struct *) varg;
+    const slong n = arg->ctx->minfo->nvars - 1;
+    slong i;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        i = *arg->index;
+        *arg->index = i + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (i >= arg->num)
+            return;
+
+        arg->screened[i] = _wang_screen_alpha(arg->Aevals + i*n,
+                                arg->Aufacs + i, arg->A, arg->alphas + i*n,
+                                                         arg->degs, arg->ctx);
+    }
+}
+
+/*
+    Screen the evaluation points alphas[i*n, (i+1)*n) for 0 <= i < num.
+    The points are independent and are shared among the threads.
+*/
+static void _wang_screen_alphas(
+    int * screened,
+    fmpz_mpoly_struct * Aevals,
+    fmpz_poly_factor_struct * Aufacs,
+    const fmpz_mpoly_t A,
+    const fmpz * alphas,
+    slong num,
+    const slong * degs,
+    const fmpz_mpoly_ctx_t ctx)
+{
+    slong i, index, num_handles;
+    thread_pool_handle * handles;
+    _wang_screen_arg_struct * args;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    if (num < 2)
+    {
+        if (num > 0)
+            screened[0] = _wang_screen_alpha(Aevals, Aufacs, A, alphas,
+                                                                   degs, ctx);
+        return;
+    }
+
+    num_handles = flint_request_threads(&handles, num);
+    args = FLINT_ARRAY_ALLOC(num_handles + 1, _wang_screen_arg_struct);
+
+    index = 0;
+    for (i = 0; i <= num_handles; i++)
+    {
+        args[i].Aevals = Aevals;
+        args[i].Aufacs = Aufacs;
+        args[i].screened = screened;
+        args[i].A = A;
+        args[i].alphas = alphas;
+        args[i].degs = degs;
+        args[i].ctx = ctx;
+        args[i].num = num;
+        args[i].index = &index;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                               _wang_screen_worker, &args[i]);
+
+    _wang_screen_worker(&args[num_handles]);
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    flint_give_back_threads(handles, num_handles);
+
+    flint_free(args);
+}
 
 
 int fmpz_mpoly_factor_irred_wang(
@@ -26,15 +192,16 @@ int fmpz_mpoly_factor_irred_wang(
     int success, kfails = 0;
     const slong n = ctx->minfo->nvars - 1;
     slong i, j, k, r;
-    fmpz * alpha;
+    fmpz * alpha, * alphas;
     slong alpha_modulus, alpha_count;
-    fmpz_mpoly_struct * Aevals;
+    slong num_alphas, alpha_idx, alpha_len;
+    fmpz_mpoly_struct * Aevals, * Aevalss;
     slong * degs, * tdegs;
     fmpz_mpolyv_t tfac;
     fmpz_mpoly_t t, Acopy;
     fmpz_mpoly_struct * newA;
-    fmpz_poly_t Au;
-    fmpz_poly_factor_t Aufac;
+    fmpz_poly_factor_struct * Aufac, * Aufacs;
+    int * screened;
     fmpz_mpoly_t m, mpow;
     fmpz_mpolyv_t new_lcs, lc_divs;
     fmpz_t q;
@@ -53,15 +220,23 @@ int fmpz_mpoly_factor_irred_wang(
     fmpz_mpolyv_init(new_lcs, ctx);
     fmpz_mpolyv_init(lc_divs, ctx);
 
-    fmpz_poly_factor_init(Aufac);
-    fmpz_poly_init(Au);
+    /*
+        With shifts allowed the evaluation points are screened in batches,
+        one point per thread. The points are drawn in the same order as
+        they are tried, so the result does not depend on the batch size.
+    */
+    num_alphas = allow_shift ? flint_get_num_threads() : 1;
 
     degs  = (slong *) flint_malloc(2*(n + 1)*sizeof(slong));
     tdegs = degs + (n + 1);
-    alpha = _fmpz_vec_init(n);
-    Aevals    = (fmpz_mpoly_struct *) flint_malloc(n*sizeof(fmpz_mpoly_struct));
-    for (i = 0; i < n; i++)
-        fmpz_mpoly_init(Aevals + i, ctx);
+    alphas = _fmpz_vec_init(num_alphas*n);
+    Aevalss = FLINT_ARRAY_ALLOC(num_alphas*n, fmpz_mpoly_struct);
+    for (i = 0; i < num_alphas*n; i++)
+        fmpz_mpoly_init(Aevalss + i, ctx);
+    Aufacs = FLINT_ARRAY_ALLOC(num_alphas, fmpz_poly_factor_struct);
+    for (i = 0; i < num_alphas; i++)
+        fmpz_poly_factor_init(Aufacs + i);
+    screened = FLINT_ARRAY_ALLOC(num_alphas, int);
 
     fmpz_mpolyv_init(tfac, ctx);
     fmpz_mpoly_init(t, ctx);
@@ -72,32 +247,49 @@ int fmpz_mpoly_factor_irred_wang(
 
     alpha_count = 0;
     alpha_modulus = 1;
-    goto got_alpha;
+    alpha_len = 1;
+    alpha_idx = 0;
+    goto screen_alphas;
 
 next_alpha:
 
+    alpha_idx++;
+    if (alpha_idx < alpha_len)
+        goto got_alpha;
+
     if (!allow_shift)
     {
         success = 0;
         goto cleanup;
     }
 
-    alpha_count++;
-    if (alpha_count >= alpha_modulus)
+    alpha_len = 0;
+    while (alpha_len < num_alphas && alpha_modulus/1024 <= ctx->minfo->nvars)
     {
-        alpha_count = 0;
-        alpha_modulus++;
-        if (alpha_modulus/1024 > ctx->minfo->nvars)
+        alpha_count++;
+        if (alpha_count >= alpha_modulus)
         {
-            success = 0;
-            goto cleanup;
+            alpha_count = 0;
+            alpha_modulus++;
+            if (alpha_modulus/1024 > ctx->minfo->nvars)
+                break;
         }
+
+        alpha = alphas + alpha_len*n;
+        for (i = 0; i < n; i++)
+            fmpz_set_si(alpha + i, n_urandint(state, alpha_modulus) - alpha_modulus/2);
+        alpha_len++;
     }
 
-    for (i = 0; i < n; i++)
-        fmpz_set_si(alpha + i, n_urandint(state, alpha_modulus) - alpha_modulus/2);
+    if (alpha_len < 1)
+    {
+        success = 0;
+        goto cleanup;
+    }
 
-got_alpha:
+    alpha_idx = 0;
+
+screen_alphas:
 
 #if FLINT_WANT_ASSERT
     fmpz_mpoly_degrees_si(tdegs, A, ctx);
@@ -105,24 +297,20 @@ got_alpha:
         FLINT_ASSERT(degs[i] == tdegs[i]);
 #endif
 
-    /* ensure degrees do not drop under evaluation */
-    for (i = n - 1; i >= 0; i--)
-    {
-        fmpz_mpoly_evaluate_one_fmpz(Aevals + i,
-                       i == n - 1 ? A : Aevals + i + 1, i + 1, alpha + i, ctx);
-        fmpz_mpoly_degrees_si(tdegs, Aevals + i, ctx);
-        for (j = 0; j <= i; j++)
-        {
-            if (tdegs[j] != degs[j])
-                goto next_alpha;
-        }
-    }
+    _wang_screen_alphas(screened, Aevalss, Aufacs, A, alphas, alpha_len,
+                                                                   degs, ctx);
+
+got_alpha:
+
+    alpha = alphas + alpha_idx*n;
+    Aevals = Aevalss + alpha_idx*n;
+    Aufac = Aufacs + alpha_idx;
+
+    /* degrees must not drop under evaluation */
+    if (!screened[alpha_idx])
+        goto next_alpha;
 
     /* make sure our univar is squarefree */
-    FLINT_ASSERT(fmpz_mpoly_is_fmpz_poly(Aevals + 0, 0, ctx));
-    success = fmpz_mpoly_get_fmpz_poly(Au, Aevals + 0, 0, ctx);
-    FLINT_ASSERT(success);
-    fmpz_poly_factor(Aufac, Au);
     r = Aufac->num;
 
     zassenhaus_prune_start_add_factors(zas);
@@ -298,13 +486,16 @@ cleanup:
     fmpz_mpolyv_clear(new_lcs, ctx);
     fmpz_mpolyv_clear(lc_divs, ctx);
 
-    fmpz_poly_factor_clear(Aufac);
-        
-    _fmpz_vec_clear(alpha, n);
+    for (i = 0; i < num_alphas; i++)
+        fmpz_poly_factor_clear(Aufacs + i);
+    flint_free(Aufacs);
+    flint_free(screened);
 
-    for (i = 0; i < n; i++)
-        fmpz_mpoly_clear(Aevals + i, ctx);
-    flint_free(Aevals);
+    _fmpz_vec_clear(alphas, num_alphas*n);
+
+    for (i = 0; i < num_alphas*n; i++)
+        fmpz_mpoly_clear(Aevalss + i, ctx);
+    flint_free(Aevalss);
 
     flint_free(degs); /* and tdegs */
     fmpz_mpolyv_clear(tfac, ctx);
@@ -314,8 +505,6 @@ cleanup:
     fmpz_mpoly_clear(m, ctx);
     fmpz_mpoly_clear(mpow, ctx);
 
-    fmpz_poly_clear(Au);
-
 #if FLINT_WANT_ASSERT
     if (success)
     {
@@ -11,6 +11,7 @@
 
 #include "fmpz_mpoly_factor.h"
 #include "nmod_mpoly_factor.h"
+#include "thread_pool.h"
 
 
 static void nmod_mpoly_get_eval_helper2(
@@ -291,6 +292,124 @@ static int _fmpz_mpoly_modpk_update_zip(
 }
 
 
+typedef struct
+{
+    fmpz * pk;
+    fmpz_mpoly_struct * B;
+    const fmpz_mpoly_ctx_struct * ctx;
+    n_polyun_struct * Z;
+    const n_polyun_struct * H;
+    const n_polyun_struct * M;
+    const nmod_mpoly_ctx_struct * ctxp;
+    int * success;
+    slong r;
+    volatile slong * index;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_update_zip_arg_struct;
+
+static void _update_zip_worker(void * varg)
+{
+    _update_zip_arg_struct * arg = (_update_zip_arg_struct *) varg;
+    slong i;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        i = *arg->index;
+        *arg->index = i + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (i >= arg->r)
+            return;
+
+        arg->success[i] = _fmpz_mpoly_modpk_update_zip(arg->pk, arg->B + i,
+                       arg->ctx, arg->Z + i, arg->H + i, arg->M + i, arg->ctxp);
+    }
+}
+
+/*
+    _fmpz_mpoly_modpk_update_zip on each B[i]: the vandermonde solves of the
+    factors are independent and are shared among the threads.
+*/
+static int _fmpz_mpoly_modpk_update_zips(
+    fmpz_t pk,
+    fmpz_mpoly_struct * B,
+    slong r,
+    const fmpz_mpoly_ctx_t ctx,
+    n_polyun_struct * Z,
+    const n_polyun_struct * H,
+    const n_polyun_struct * M,
+    const nmod_mpoly_ctx_t ctxp)
+{
+    int success;
+    int * succ;
+    slong i, index, num_handles;
+    thread_pool_handle * handles;
+    _update_zip_arg_struct * args;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    num_handles = flint_request_threads(&handles, r);
+
+    succ = FLINT_ARRAY_ALLOC(r, int);
+    args = FLINT_ARRAY_ALLOC(num_handles + 1, _update_zip_arg_struct);
+
+    index = 0;
+    for (i = 0; i <= num_handles; i++)
+    {
+        args[i].pk = pk;
+        args[i].B = B;
+        args[i].ctx = ctx;
+        args[i].Z = Z;
+        args[i].H = H;
+        args[i].M = M;
+        args[i].ctxp = ctxp;
+        args[i].success = succ;
+        args[i].r = r;
+        args[i].index = &index;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                                _update_zip_worker, &args[i]);
+
+    _update_zip_worker(&args[num_handles]);
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    flint_give_back_threads(handles, num_handles);
+
+    success = 1;
+    for (i = 0; i < r; i++)
+        success = FLINT_MIN(success, succ[i]);
+
+    flint_free(args);
+    flint_free(succ);
+
+    return success;
+}
+
+
 static void _nmod_mpoly_set_fmpz_mpoly(
     nmod_mpoly_t Ap,
     const nmod_mpoly_ctx_t ctxp,
@@ -593,15 +712,11 @@ next_zip_image:
     if (cur_zip_image < req_zip_images)
         goto next_zip_image;
 
-    for (i = 0; i < r; i++)
+    success = _fmpz_mpoly_modpk_update_zips(pk, B, r, ctx, Z, H, M, ctxp);
+    if (success < 1)
     {
-        success = _fmpz_mpoly_modpk_update_zip(pk, B + i, ctx,
-                                                    Z + i, H + i, M + i, ctxp);
-        if (success < 1)
-        {
-            success = 0;
-            goto cleanup;
-        }
+        success = 0;
+        goto cleanup;
     }
 
     goto next_power;
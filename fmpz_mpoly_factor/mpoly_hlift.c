@@ -26,7 +26,8 @@ static int _hlift_quartic2(
     fmpz_mpoly_t Aq, t, t2, t3, xalpha;
     fmpz_mpoly_univar_t Au;
     fmpz_mpoly_geobucket_t G;
-    fmpz_mpoly_struct betas[2], * deltas;
+    fmpz_mpoly_struct betas[2], * deltas, * T;
+    const fmpz_mpoly_struct ** Tops;
     fmpz_mpoly_pfrac_t I;
     fmpz_mpolyv_struct B[2];
     slong tdeg;
@@ -35,6 +36,11 @@ static int _hlift_quartic2(
     FLINT_ASSERT(r == 2);
     r = 2;
 
+    T = FLINT_ARRAY_ALLOC(degs[m] + 1, fmpz_mpoly_struct);
+    Tops = FLINT_ARRAY_ALLOC(2*(degs[m] + 1), const fmpz_mpoly_struct *);
+    for (i = 0; i <= degs[m]; i++)
+        fmpz_mpoly_init(T + i, ctx);
+
     fmpz_mpoly_init(t, ctx);
     fmpz_mpoly_init(t2, ctx);
     fmpz_mpoly_init(t3, ctx);
@@ -118,9 +124,12 @@ static int _hlift_quartic2(
 
         for (i = 0; i <= j; i++)
         {
-            fmpz_mpoly_mul(t, B[0].coeffs + i, B[1].coeffs + j - i, ctx);
-            fmpz_mpoly_geobucket_sub(G, t, ctx);
+            Tops[i] = B[0].coeffs + i;
+            Tops[degs[m] + 1 + i] = B[1].coeffs + j - i;
         }
+        _fmpz_mpoly_vec_mul_threaded(T, Tops, Tops + degs[m] + 1, j + 1, ctx);
+        for (i = 0; i <= j; i++)
+            fmpz_mpoly_geobucket_sub(G, T + i, ctx);
         fmpz_mpoly_geobucket_empty(t, G, ctx);
 
         if (fmpz_mpoly_is_zero(t, ctx))
@@ -164,6 +173,11 @@ cleanup:
         fmpz_mpolyv_clear(B + i, ctx);
     }
 
+    for (i = 0; i <= degs[m]; i++)
+        fmpz_mpoly_clear(T + i, ctx);
+    flint_free(T);
+    flint_free(Tops);
+
     fmpz_mpoly_clear(t, ctx);
     fmpz_mpoly_clear(t2, ctx);
     fmpz_mpoly_clear(t3, ctx);
@@ -190,7 +204,8 @@ static int _hlift_quartic(
     fmpz_mpoly_t Aq, t, t1, t2, t3, xalpha;
     fmpz_mpoly_univar_t Au;
     fmpz_mpoly_geobucket_t G;
-    fmpz_mpoly_struct * betas, * deltas;
+    fmpz_mpoly_struct * betas, * deltas, * T;
+    const fmpz_mpoly_struct ** Tops;
     fmpz_mpoly_pfrac_t I;
     fmpz_mpolyv_struct * B, * U;
     slong tdeg;
@@ -201,6 +216,11 @@ static int _hlift_quartic(
     B = FLINT_ARRAY_ALLOC(2*r, fmpz_mpolyv_struct);
     U = B + r;
 
+    T = FLINT_ARRAY_ALLOC(degs[m] + 1, fmpz_mpoly_struct);
+    Tops = FLINT_ARRAY_ALLOC(2*(degs[m] + 1), const fmpz_mpoly_struct *);
+    for (i = 0; i <= degs[m]; i++)
+        fmpz_mpoly_init(T + i, ctx);
+
     fmpz_mpoly_init(t, ctx);
     fmpz_mpoly_init(t1, ctx);
     fmpz_mpoly_init(t2, ctx);
@@ -274,24 +294,19 @@ static int _hlift_quartic(
 
     for (j = 1; j <= degs[m]; j++)
     {
-        k = r - 2;
-
-        G->length = 0;
-        for (i = 0; i <= j; i++)
+        for (k = r - 2; k >= 1; k--)
         {
-            fmpz_mpoly_mul(t1, B[k].coeffs + i, B[k + 1].coeffs + j - i, ctx);
-            fmpz_mpoly_geobucket_add(G, t1, ctx);
-        }
-        fmpz_mpoly_geobucket_empty(U[k].coeffs + j, G, ctx);
-
-        for (k--; k >= 1; k--)
-        {
-            G->length = 0;
             for (i = 0; i <= j; i++)
             {
-                fmpz_mpoly_mul(t1, B[k].coeffs + i, U[k + 1].coeffs + j - i, ctx);
-                fmpz_mpoly_geobucket_add(G, t1, ctx);
+                Tops[i] = B[k].coeffs + i;
+                Tops[degs[m] + 1 + i] = (k == r - 2 ? B[k + 1].coeffs :
+                                                  U[k + 1].coeffs) + j - i;
             }
+            _fmpz_mpoly_vec_mul_threaded(T, Tops, Tops + degs[m] + 1,
+                                                                  j + 1, ctx);
+            G->length = 0;
+            for (i = 0; i <= j; i++)
+                fmpz_mpoly_geobucket_add(G, T + i, ctx);
             fmpz_mpoly_geobucket_empty(U[k].coeffs + j, G, ctx);
         }
 
@@ -316,9 +331,12 @@ static int _hlift_quartic(
 
         for (i = 0; i <= j; i++)
         {
-            fmpz_mpoly_mul(t, B[0].coeffs + i, U[1].coeffs + j - i, ctx);
-            fmpz_mpoly_geobucket_sub(G, t, ctx);
+            Tops[i] = B[0].coeffs + i;
+            Tops[degs[m] + 1 + i] = U[1].coeffs + j - i;
         }
+        _fmpz_mpoly_vec_mul_threaded(T, Tops, Tops + degs[m] + 1, j + 1, ctx);
+        for (i = 0; i <= j; i++)
+            fmpz_mpoly_geobucket_sub(G, T + i, ctx);
         fmpz_mpoly_geobucket_empty(t, G, ctx);
 
         if (fmpz_mpoly_is_zero(t, ctx))
@@ -381,6 +399,11 @@ cleanup:
 
     flint_free(B);
 
+    for (i = 0; i <= degs[m]; i++)
+        fmpz_mpoly_clear(T + i, ctx);
+    flint_free(T);
+    flint_free(Tops);
+
     fmpz_mpoly_clear(t, ctx);
     fmpz_mpoly_clear(t1, ctx);
     fmpz_mpoly_clear(t2, ctx);
@@ -406,12 +429,18 @@ static int _hlift_quintic(
     int success;
     slong i, j;
     fmpz_mpoly_t e, t, pow, xalpha, q;
-    fmpz_mpoly_struct * betas, * deltas;
+    fmpz_mpoly_struct * betas, * deltas, * T;
+    const fmpz_mpoly_struct ** Tops;
     fmpz_mpoly_pfrac_t I;
     flint_bitcnt_t bits = A->bits;
 
     FLINT_ASSERT(r > 1);
 
+    T = FLINT_ARRAY_ALLOC(r, fmpz_mpoly_struct);
+    Tops = FLINT_ARRAY_ALLOC(2*r, const fmpz_mpoly_struct *);
+    for (i = 0; i < r; i++)
+        fmpz_mpoly_init(T + i, ctx);
+
     fmpz_mpoly_init(e, ctx);
     fmpz_mpoly_init(t, ctx);
     fmpz_mpoly_init(pow, ctx);
@@ -463,9 +492,12 @@ static int _hlift_quintic(
 
         for (i = 0; i < r; i++)
         {
-            fmpz_mpoly_mul(t, deltas + i, pow, ctx);
-            fmpz_mpoly_add(f + i, f + i, t, ctx);
+            Tops[i] = deltas + i;
+            Tops[r + i] = pow;
         }
+        _fmpz_mpoly_vec_mul_threaded(T, Tops, Tops + r, r, ctx);
+        for (i = 0; i < r; i++)
+            fmpz_mpoly_add(f + i, f + i, T + i, ctx);
 
         fmpz_mpoly_mul(t, f + 0, f + 1, ctx);
         for (i = 2; i < r; i++)
@@ -491,9 +523,12 @@ cleanup:
             fmpz_mpoly_repack_bits_inplace(f + i, bits, ctx);
 
         fmpz_mpoly_clear(betas + i, ctx);
+        fmpz_mpoly_clear(T + i, ctx);
     }
 
     flint_free(betas);
+    flint_free(T);
+    flint_free(Tops);
 
     return success;
 }
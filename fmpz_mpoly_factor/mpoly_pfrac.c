@@ -10,6 +10,60 @@
 */
 
 #include "fmpz_mpoly_factor.h"
+#include "thread_pool.h"
+
+
+typedef struct
+{
+    fmpz_mpoly_pfrac_struct * I;
+    const fmpz_mpoly_ctx_struct * ctx;
+    volatile slong * index;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_prod_mbetas_arg_struct;
+
+/* set the products of all but one of the betas at each level */
+static void _prod_mbetas_worker(void * varg)
+{
+    _prod_mbetas_arg_struct * arg = (_prod_mbetas_arg_struct *) varg;
+    fmpz_mpoly_pfrac_struct * I = arg->I;
+    const fmpz_mpoly_ctx_struct * ctx = arg->ctx;
+    slong i, j, k, ij;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        ij = *arg->index;
+        *arg->index = ij + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (ij >= (I->w + 1)*I->r)
+            return;
+
+        i = ij/I->r;
+        j = ij%I->r;
+
+        fmpz_mpoly_one(I->prod_mbetas + i*I->r + j, ctx);
+        for (k = 0; k < I->r; k++)
+        {
+            if (k == j)
+                continue;
+            fmpz_mpoly_mul(I->prod_mbetas + i*I->r + j,
+                        I->prod_mbetas + i*I->r + j, I->mbetas + i*I->r + k, ctx);
+        }
+        if (i > 0)
+        {
+            fmpz_mpoly_to_mpolyv(I->prod_mbetas_coeffs + i*I->r + j,
+                              I->prod_mbetas + i*I->r + j, I->xalpha + i, ctx);
+        }
+    }
+}
 
 
 int fmpz_mpoly_pfrac_init(
@@ -22,7 +76,13 @@ int fmpz_mpoly_pfrac_init(
     const fmpz_mpoly_ctx_t ctx)
 {
     slong success = 1;
-    slong i, j, k;
+    slong i, j, index;
+    _prod_mbetas_arg_struct * args;
+    thread_pool_handle * handles;
+    slong num_handles;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
 
     FLINT_ASSERT(bits <= FLINT_BITS);
 
@@ -38,7 +98,6 @@ int fmpz_mpoly_pfrac_init(
     I->q = FLINT_ARRAY_ALLOC(w + 1, fmpz_mpoly_struct);
     I->U = FLINT_ARRAY_ALLOC(w + 1, fmpz_mpoly_univar_struct);
     I->G = FLINT_ARRAY_ALLOC(w + 1, fmpz_mpoly_geobucket_struct);
-    I->qt = FLINT_ARRAY_ALLOC(w + 1, fmpz_mpoly_struct);
     I->newt = FLINT_ARRAY_ALLOC(w + 1, fmpz_mpoly_struct);
     I->delta_coeffs = FLINT_ARRAY_ALLOC((w + 1)*r, fmpz_mpolyv_struct);
 
@@ -48,7 +107,6 @@ int fmpz_mpoly_pfrac_init(
         fmpz_mpoly_init(I->q + i, ctx);
         fmpz_mpoly_univar_init(I->U + i, ctx);
         fmpz_mpoly_geobucket_init(I->G + i, ctx);
-        fmpz_mpoly_init(I->qt + i, ctx);
         fmpz_mpoly_init(I->newt + i, ctx);
         for (j = 0; j < r; j++)
         {
@@ -81,29 +139,53 @@ int fmpz_mpoly_pfrac_init(
         }
     }
 
+    I->prods = NULL;
+    I->prod_ops = NULL;
+    I->prods_alloc = 0;
+
     /* set product of betas */
-    for (i = w; i >= 0; i--)
+    for (i = 0; i < (w + 1)*r; i++)
     {
-        for (j = 0; j < r; j++)
-        {
-            fmpz_mpoly_init(I->prod_mbetas + i*r + j, ctx);
-            fmpz_mpoly_one(I->prod_mbetas + i*r + j, ctx);
-            for (k = 0; k < r; k++)
-            {
-                if (k == j)
-                    continue;
-                fmpz_mpoly_mul(I->prod_mbetas + i*r + j,
-                           I->prod_mbetas + i*r + j, I->mbetas + i*r + k, ctx);
-            }
-            fmpz_mpolyv_init(I->prod_mbetas_coeffs + i*r + j, ctx);
-            if (i > 0)
-            {
-                fmpz_mpoly_to_mpolyv(I->prod_mbetas_coeffs + i*r + j,
-                                 I->prod_mbetas + i*r + j, I->xalpha + i, ctx);
-            }
-        }        
+        fmpz_mpoly_init(I->prod_mbetas + i, ctx);
+        fmpz_mpolyv_init(I->prod_mbetas_coeffs + i, ctx);
     }
 
+    num_handles = flint_request_threads(&handles, (w + 1)*r);
+
+    args = FLINT_ARRAY_ALLOC(num_handles + 1, _prod_mbetas_arg_struct);
+
+    index = 0;
+    for (i = 0; i <= num_handles; i++)
+    {
+        args[i].I = I;
+        args[i].ctx = ctx;
+        args[i].index = &index;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                               _prod_mbetas_worker, &args[i]);
+
+    _prod_mbetas_worker(&args[num_handles]);
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    flint_free(args);
+
+    flint_give_back_threads(handles, num_handles);
+
     fmpz_poly_pfrac_init(I->uni_pfrac);
     fmpz_poly_init(I->uni_a);
     I->uni_c = FLINT_ARRAY_ALLOC(r, fmpz_poly_struct);
@@ -137,7 +219,6 @@ void fmpz_mpoly_pfrac_clear(
         fmpz_mpoly_clear(I->q + i, ctx);
         fmpz_mpoly_univar_clear(I->U + i, ctx);
         fmpz_mpoly_geobucket_clear(I->G + i, ctx);
-        fmpz_mpoly_clear(I->qt + i, ctx);
         fmpz_mpoly_clear(I->newt + i, ctx);
         for (j = 0; j < I->r; j++)
             fmpz_mpolyv_clear(I->delta_coeffs + i*I->r + j, ctx);
@@ -146,7 +227,6 @@ void fmpz_mpoly_pfrac_clear(
     flint_free(I->q);
     flint_free(I->U);
     flint_free(I->G);
-    flint_free(I->qt);
     flint_free(I->newt);
     flint_free(I->delta_coeffs);
 
@@ -171,6 +251,32 @@ void fmpz_mpoly_pfrac_clear(
     for (j = 0; j < I->r; j++)
         fmpz_poly_clear(I->uni_c + j);
     flint_free(I->uni_c);
+
+    for (i = 0; i < I->prods_alloc; i++)
+        fmpz_mpoly_clear(I->prods + i, ctx);
+    flint_free(I->prods);
+    flint_free(I->prod_ops);
+}
+
+
+static void _fmpz_mpoly_pfrac_fit_prods(
+    fmpz_mpoly_pfrac_t I,
+    slong n,
+    const fmpz_mpoly_ctx_t ctx)
+{
+    slong i;
+
+    if (n <= I->prods_alloc)
+        return;
+
+    n = FLINT_MAX(n, 2*I->prods_alloc);
+
+    I->prods = FLINT_ARRAY_REALLOC(I->prods, n, fmpz_mpoly_struct);
+    I->prod_ops = FLINT_ARRAY_REALLOC(I->prod_ops, 2*n, const fmpz_mpoly_struct *);
+    for (i = I->prods_alloc; i < n; i++)
+        fmpz_mpoly_init(I->prods + i, ctx);
+
+    I->prods_alloc = n;
 }
 
 
@@ -182,11 +288,10 @@ int fmpz_mpoly_pfrac(
     const fmpz_mpoly_ctx_t ctx)
 {
     int success, use_U;
-    slong i, j, k, Ui;
+    slong i, j, k, Ui, nprods;
     fmpz_mpoly_struct * deltas = I->deltas + l*I->r;
     fmpz_mpoly_struct * newdeltas = I->deltas + (l - 1)*I->r;
     fmpz_mpoly_struct * q = I->q + l;
-    fmpz_mpoly_struct * qt = I->qt + l;
     fmpz_mpoly_struct * newt = I->newt + l;
     fmpz_mpolyv_struct * delta_coeffs = I->delta_coeffs + l*I->r;
     fmpz_mpoly_geobucket_struct * G = I->G + l;
@@ -239,6 +344,9 @@ int fmpz_mpoly_pfrac(
             fmpz_mpoly_geobucket_set(G, newt, ctx);
         }
 
+        /* the products are independent and are done together */
+        _fmpz_mpoly_pfrac_fit_prods(I, k*I->r, ctx);
+        nprods = 0;
         for (j = 0; j < k; j++)
         for (i = 0; i < I->r; i++)
         {
@@ -247,11 +355,18 @@ int fmpz_mpoly_pfrac(
             if (k - j >= I->prod_mbetas_coeffs[l*I->r + i].length)
                 continue;
 
-            fmpz_mpoly_mul(qt, delta_coeffs[i].coeffs + j,
-                        I->prod_mbetas_coeffs[l*I->r + i].coeffs + k - j, ctx);
-            fmpz_mpoly_geobucket_sub(G, qt, ctx);
+            I->prod_ops[nprods] = delta_coeffs[i].coeffs + j;
+            I->prod_ops[I->prods_alloc + nprods] =
+                              I->prod_mbetas_coeffs[l*I->r + i].coeffs + k - j;
+            nprods++;
         }
 
+        _fmpz_mpoly_vec_mul_threaded(I->prods, I->prod_ops,
+                                 I->prod_ops + I->prods_alloc, nprods, ctx);
+
+        for (i = 0; i < nprods; i++)
+            fmpz_mpoly_geobucket_sub(G, I->prods + i, ctx);
+
         fmpz_mpoly_geobucket_empty(newt, G, ctx);
 
         if (fmpz_mpoly_is_zero(newt, ctx))
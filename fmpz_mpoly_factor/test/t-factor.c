@@ -117,6 +117,8 @@ main(void)
 
         fmpz_mpoly_ctx_init_rand(ctx, state, 8);
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         fmpz_mpoly_init(a, ctx);
         fmpz_mpoly_init(t, ctx);
 
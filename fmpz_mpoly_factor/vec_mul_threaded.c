@@ -0,0 +1,137 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fmpz_mpoly_factor.h"
+#include "thread_pool.h"
+
+typedef struct
+{
+    fmpz_mpoly_struct * A;
+    const fmpz_mpoly_struct * const * B;
+    const fmpz_mpoly_struct * const * C;
+    slong n;
+    const fmpz_mpoly_ctx_struct * ctx;
+    volatile slong * index;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_vec_mul_arg_struct;
+
+static void _vec_mul_worker(void * varg)
+{
+    _vec_mul_arg_struct * arg = (_vec_mul_arg_struct *) varg;
+    slong i;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        i = *arg->index;
+        *arg->index = i + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (i >= arg->n)
+            return;
+
+        fmpz_mpoly_mul(arg->A + i, arg->B[i], arg->C[i], arg->ctx);
+    }
+}
+
+/*
+    A[i] = B[i]*C[i] for 0 <= i < n. The products are independent and are
+    spread over the handles unless there is too little work to share.
+*/
+void _fmpz_mpoly_vec_mul_threaded_pool(
+    fmpz_mpoly_struct * A,
+    const fmpz_mpoly_struct * const * B,
+    const fmpz_mpoly_struct * const * C,
+    slong n,
+    const fmpz_mpoly_ctx_t ctx,
+    const thread_pool_handle * handles,
+    slong num_handles)
+{
+    slong i, index, work;
+    _vec_mul_arg_struct * args;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    work = 0;
+    for (i = 0; i < n && num_handles > 0; i++)
+        work += B[i]->length*C[i]->length;
+
+    num_handles = FLINT_MIN(num_handles, n - 1);
+
+    if (num_handles < 1 || work < 8192)
+    {
+        for (i = 0; i < n; i++)
+            fmpz_mpoly_mul(A + i, B[i], C[i], ctx);
+        return;
+    }
+
+    args = FLINT_ARRAY_ALLOC(num_handles + 1, _vec_mul_arg_struct);
+
+    index = 0;
+    for (i = 0; i <= num_handles; i++)
+    {
+        args[i].A = A;
+        args[i].B = B;
+        args[i].C = C;
+        args[i].n = n;
+        args[i].ctx = ctx;
+        args[i].index = &index;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                                   _vec_mul_worker, &args[i]);
+
+    _vec_mul_worker(&args[num_handles]);
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    flint_free(args);
+}
+
+/*
+    The same with threads requested for this call only, so that they are
+    free again for the multiplications and divisions between such calls.
+*/
+void _fmpz_mpoly_vec_mul_threaded(
+    fmpz_mpoly_struct * A,
+    const fmpz_mpoly_struct * const * B,
+    const fmpz_mpoly_struct * const * C,
+    slong n,
+    const fmpz_mpoly_ctx_t ctx)
+{
+    thread_pool_handle * handles;
+    slong num_handles;
+
+    num_handles = flint_request_threads(&handles, n);
+
+    _fmpz_mpoly_vec_mul_threaded_pool(A, B, C, n, ctx, handles, num_handles);
+
+    flint_give_back_threads(handles, num_handles);
+}
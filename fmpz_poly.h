@@ -458,6 +458,24 @@ FLINT_DLL void _fmpz_poly_mulmid_classical(fmpz * res, const fmpz * poly1,
 FLINT_DLL void fmpz_poly_mulmid_classical(fmpz_poly_t res, 
                           const fmpz_poly_t poly1, const fmpz_poly_t poly2);
 
+FLINT_DLL void _fmpz_poly_mulmid_KS(fmpz * res, const fmpz * poly1, 
+                                  slong len1, const fmpz * poly2, slong len2);
+
+FLINT_DLL void fmpz_poly_mulmid_KS(fmpz_poly_t res, 
+                          const fmpz_poly_t poly1, const fmpz_poly_t poly2);
+
+FLINT_DLL void _fmpz_poly_mulmid_SS(fmpz * res, const fmpz * poly1, 
+                                  slong len1, const fmpz * poly2, slong len2);
+
+FLINT_DLL void fmpz_poly_mulmid_SS(fmpz_poly_t res, 
+                          const fmpz_poly_t poly1, const fmpz_poly_t poly2);
+
+FLINT_DLL void _fmpz_poly_mulmid(fmpz * res, const fmpz * poly1, 
+                                  slong len1, const fmpz * poly2, slong len2);
+
+FLINT_DLL void fmpz_poly_mulmid(fmpz_poly_t res, 
+                          const fmpz_poly_t poly1, const fmpz_poly_t poly2);
+
 FLINT_DLL void fmpz_poly_mul_karatsuba(fmpz_poly_t res, 
                           const fmpz_poly_t poly1, const fmpz_poly_t poly2);
 
@@ -672,6 +690,10 @@ FLINT_DLL void _fmpz_poly_resultant_euclidean(fmpz_t res, const fmpz * poly1, sl
 FLINT_DLL void fmpz_poly_resultant_euclidean(fmpz_t res, const fmpz_poly_t poly1, 
                                                       const fmpz_poly_t poly2);
 
+FLINT_DLL void _fmpz_poly_multi_resultant_ui(mp_ptr res, mp_srcptr primes,
+                         slong num_primes, const fmpz * A, slong len1,
+                                              const fmpz * B, slong len2);
+
 FLINT_DLL void _fmpz_poly_resultant_modular(fmpz_t res, const fmpz * poly1, slong len1, 
                                                const fmpz * poly2, slong len2);
 
@@ -1234,6 +1256,11 @@ FLINT_DLL void fmpz_poly_CRT_ui(fmpz_poly_t res, const fmpz_poly_t poly1,
                                      const fmpz_t m1, const nmod_poly_t poly2,
                                         int sign);
 
+FLINT_DLL void _fmpz_poly_multi_CRT_ui(fmpz * res, fmpz_t m, slong len,
+                       mp_ptr const * polys, mp_srcptr primes,
+                       slong num_primes, int sign,
+                       const thread_pool_handle * handles, slong num_handles);
+
 
 /* Products *****************************************************************/
 
@@ -15,7 +15,66 @@
 #include "fmpz_vec.h"
 #include "fmpz_poly.h"
 #include "mpn_extras.h"
+#include "thread_support.h"
 
+typedef struct
+{
+    const fmpz * A;
+    slong len1;
+    const fmpz * B;
+    slong len2;
+    const fmpz * g;
+    int g_pm1;
+    mp_srcptr primes;
+    mp_ptr * h;
+    slong * hlens;
+    slong i0;
+    slong i1;
+}
+_gcd_modular_arg_t;
+
+/* gcds modulo primes[i0], ..., primes[i1 - 1], scaled to have leading
+   coefficient g (or 1 if g = +-1) */
+static void
+_gcd_modular_worker(void * arg_ptr)
+{
+    _gcd_modular_arg_t * arg = (_gcd_modular_arg_t *) arg_ptr;
+    mp_ptr a, b, h;
+    mp_limb_t h_inv, g_mod;
+    nmod_t mod;
+    slong i, hlen;
+
+    a = _nmod_vec_init(arg->len1);
+    b = _nmod_vec_init(arg->len2);
+
+    for (i = arg->i0; i < arg->i1; i++)
+    {
+        nmod_init(&mod, arg->primes[i]);
+        h = arg->h[i];
+
+        /* reduce polynomials modulo p */
+        _fmpz_vec_get_nmod_vec(a, arg->A, arg->len1, mod);
+        _fmpz_vec_get_nmod_vec(b, arg->B, arg->len2, mod);
+
+        /* compute gcd over Z/pZ */
+        hlen = _nmod_poly_gcd(h, a, arg->len1, b, arg->len2, mod);
+        arg->hlens[i] = hlen;
+
+        /* scale new polynomial mod p appropriately */
+        if (arg->g_pm1)
+            _nmod_poly_make_monic(h, h, hlen, mod);
+        else
+        {
+            h_inv = n_invmod(h[hlen - 1], mod.n);
+            g_mod = fmpz_fdiv_ui(arg->g, mod.n);
+            h_inv = n_mulmod2_preinv(h_inv, g_mod, mod.n, mod.ninv);
+            _nmod_vec_scalar_mul_nmod(h, h, hlen, h_inv, mod);
+        }
+    }
+
+    _nmod_vec_clear(a);
+    _nmod_vec_clear(b);
+}
 
 void _fmpz_poly_gcd_modular(fmpz * res, const fmpz * poly1, slong len1, 
                                         const fmpz * poly2, slong len2)
@@ -23,11 +82,14 @@ void _fmpz_poly_gcd_modular(fmpz * res, const fmpz * poly1, slong len1,
     flint_bitcnt_t bits1, bits2, nb1, nb2, bits_small, pbits, curr_bits = 0, new_bits;   
     fmpz_t ac, bc, hc, d, g, l, eval_A, eval_B, eval_GCD, modulus;
     fmpz * A, * B, * Q, * lead_A, * lead_B;
-    mp_ptr a, b, h;
-    mp_limb_t p, h_inv, g_mod;
-    nmod_t mod;
-    slong i, n, n0, unlucky, hlen, bound;
-    int g_pm1;
+    mp_ptr primes, good_primes;
+    mp_ptr * h, * good_h;
+    mp_limb_t p;
+    slong i, n, n0, unlucky, hlen, bound, batch, num_good, num_handles;
+    slong * hlens;
+    thread_pool_handle * handles;
+    _gcd_modular_arg_t * args;
+    int g_pm1, restart;
 
     fmpz_init(ac);
     fmpz_init(bc);
@@ -126,10 +188,34 @@ void _fmpz_poly_gcd_modular(fmpz * res, const fmpz * poly1, slong len1,
 
     Q = _fmpz_vec_init(len1);
 
-    /* make space for polynomials mod p */
-    a = _nmod_vec_init(len1);
-    b = _nmod_vec_init(len2);
-    h = _nmod_vec_init(len2);
+    /* one prime per thread in each batch */
+    num_handles = flint_request_threads(&handles, flint_get_num_threads());
+    batch = num_handles + 1;
+
+    primes = _nmod_vec_init(2*batch);
+    good_primes = primes + batch;
+    hlens = (slong *) flint_malloc(batch*sizeof(slong));
+    h = (mp_ptr *) flint_malloc(2*batch*sizeof(mp_ptr));
+    good_h = h + batch;
+    for (i = 0; i < batch; i++)
+        h[i] = _nmod_vec_init(len2);
+
+    args = (_gcd_modular_arg_t *)
+                          flint_malloc(batch*sizeof(_gcd_modular_arg_t));
+    for (i = 0; i < batch; i++)
+    {
+        args[i].A = A;
+        args[i].len1 = len1;
+        args[i].B = B;
+        args[i].len2 = len2;
+        args[i].g = g;
+        args[i].g_pm1 = g_pm1;
+        args[i].primes = primes;
+        args[i].h = h;
+        args[i].hlens = hlens;
+        args[i].i0 = i;
+        args[i].i1 = i + 1;
+    }
 
     /* zero entire output */
     _fmpz_vec_zero(res, len2);
@@ -145,21 +231,29 @@ void _fmpz_poly_gcd_modular(fmpz * res, const fmpz * poly1, slong len1,
 
     for (;;)
     {
-        /* get new prime and initialise modulus */
-        p = n_nextprime(p, 0);
-        if (fmpz_fdiv_ui(l, p) == 0)
+        /* get a batch of primes not dividing the leading coefficients */
+        for (i = 0; i < batch; )
         {
-            unlucky += pbits;
-            continue;
+            p = n_nextprime(p, 0);
+            if (fmpz_fdiv_ui(l, p) == 0)
+            {
+                unlucky += pbits;
+                continue;
+            }
+            primes[i++] = p;
         }
-        nmod_init(&mod, p);
 
-        /* reduce polynomials modulo p */
-        _fmpz_vec_get_nmod_vec(a, A, len1, mod);
-        _fmpz_vec_get_nmod_vec(b, B, len2, mod);
+        /* compute the gcds over Z/pZ in parallel */
+        for (i = 0; i < num_handles; i++)
+            thread_pool_wake(global_thread_pool, handles[i], 0,
+                                            _gcd_modular_worker, &args[i]);
+        _gcd_modular_worker(&args[num_handles]);
+        for (i = 0; i < num_handles; i++)
+            thread_pool_wait(global_thread_pool, handles[i]);
 
-        /* compute gcd over Z/pZ */
-        hlen = _nmod_poly_gcd(h, a, len1, b, len2, mod);
+        hlen = hlens[0];
+        for (i = 1; i < batch; i++)
+            hlen = FLINT_MIN(hlen, hlens[i]);
 
         if (hlen == 1) /* gcd is 1 */
         {
@@ -168,80 +262,56 @@ void _fmpz_poly_gcd_modular(fmpz * res, const fmpz * poly1, slong len1,
             break; 
         }
 
-        if (hlen > n + 1) /* discard this prime */
+        if (hlen > n + 1) /* discard the whole batch */
         {
-            unlucky += pbits;
+            unlucky += batch*pbits;
             continue;
         }
 
-        /* scale new polynomial mod p appropriately */
-        if (g_pm1) _nmod_poly_make_monic(h, h, hlen, mod);
-        else
+        /* primes giving a gcd of too high degree are unlucky */
+        for (i = 0, num_good = 0; i < batch; i++)
         {
-            h_inv = n_invmod(h[hlen - 1], mod.n);
-            g_mod = fmpz_fdiv_ui(g, mod.n);
-            h_inv = n_mulmod2_preinv(h_inv, g_mod, mod.n, mod.ninv);
-            _nmod_vec_scalar_mul_nmod(h, h, hlen, h_inv, mod);
+            if (hlens[i] > hlen)
+            {
+                unlucky += pbits;
+                continue;
+            }
+            good_primes[num_good] = primes[i];
+            good_h[num_good++] = h[i];
         }
 
-        if (hlen <= n) /* we have a new bound on size of result */
+        restart = (hlen <= n);
+        if (restart) /* we have a new bound on size of result */
         {
             unlucky += fmpz_bits(modulus);
-            _fmpz_vec_set_nmod_vec(res, h, hlen, mod);
+            fmpz_one(modulus);
             _fmpz_vec_zero(res + hlen, len2 - hlen);
-
-            if (g_pm1)
-            {
-                /* are we done? */
-                if (_fmpz_poly_divides(Q, B, len2, res, hlen) &&
-                    _fmpz_poly_divides(Q, A, len1, res, hlen))
-                break;
-            }
-            else
-            {
-                if (pbits + unlucky >= bound) /* if we reach the bound with one prime */
-                { 
-                    _fmpz_vec_content(hc, res, hlen);
-
-                   /* divide by content */
-                   _fmpz_vec_scalar_divexact_fmpz(res, res, hlen, hc);
-                   break;
-                }
-
-                if (pbits >= bits_small) /* if one prime is already big enough to check */
-                {
-                    /* divide by content */
-                    _fmpz_vec_content(hc, res, hlen);
-
-                    /* correct sign of leading term */
-                    if (fmpz_sgn(res + hlen - 1) < 0)
-                        fmpz_neg(hc, hc);
-
-                    _fmpz_vec_scalar_divexact_fmpz(res, res, hlen, hc);
-
-                    /* are we done? */
-                    if (_fmpz_poly_divides(Q, B, len2, res, hlen) &&
-                        _fmpz_poly_divides(Q, A, len1, res, hlen))
-                        break;
-
-                    /* no, so multiply by content again */
-                    _fmpz_vec_scalar_mul_fmpz(res, res, hlen, hc);
-                }
-            }
-
-            curr_bits = FLINT_ABS(_fmpz_vec_max_bits(res, hlen));
-            fmpz_set_ui(modulus, p);
-            n = hlen - 1; /* if we reach this we have a new bound on length of result */
-            continue;
+            n = hlen - 1;
+            curr_bits = 0;
         }
 
-        _fmpz_poly_CRT_ui(res, res, hlen, modulus, h, hlen, mod.n, mod.ninv, 1);
-        fmpz_mul_ui(modulus, modulus, mod.n);
+        /* product tree CRT of the batch into the accumulated images */
+        _fmpz_poly_multi_CRT_ui(res, modulus, hlen, good_h, good_primes,
+                                          num_good, 1, handles, num_handles);
 
         new_bits = _fmpz_vec_max_bits(res, hlen);
         new_bits = FLINT_ABS(new_bits);
 
-        if (new_bits == curr_bits || fmpz_bits(modulus) >= bits_small)
+        if (fmpz_bits(modulus) + unlucky >= bound)
+        {
+            if (!g_pm1)
+            {
+                _fmpz_vec_content(hc, res, hlen);
+
+                /* divide by content */
+                _fmpz_vec_scalar_divexact_fmpz(res, res, hlen, hc);
+            }
+
+            break;
+        }
+
+        if ((restart && g_pm1) || new_bits == curr_bits ||
+                                  fmpz_bits(modulus) >= bits_small)
         {
             if (!g_pm1)
             {
@@ -255,9 +325,6 @@ void _fmpz_poly_gcd_modular(fmpz * res, const fmpz * poly1, slong len1,
                 _fmpz_vec_scalar_divexact_fmpz(res, res, hlen, hc);      
             }
 
-            if (fmpz_bits(modulus) + unlucky >= bound)
-                break;
-
             /* are we done? */
             if (_fmpz_poly_divides(Q, B, len2, res, hlen) &&
                 _fmpz_poly_divides(Q, A, len1, res, hlen))
@@ -273,15 +340,20 @@ void _fmpz_poly_gcd_modular(fmpz * res, const fmpz * poly1, slong len1,
         curr_bits = new_bits;
     }
 
+    flint_give_back_threads(handles, num_handles);
+
+    for (i = 0; i < batch; i++)
+        _nmod_vec_clear(h[i]);
+    flint_free(h);
+    flint_free(hlens);
+    flint_free(args);
+    _nmod_vec_clear(primes);
+
     fmpz_clear(modulus);
     fmpz_clear(g); 
     fmpz_clear(l); 
     fmpz_clear(hc);
 
-    _nmod_vec_clear(a);
-    _nmod_vec_clear(b);
-    _nmod_vec_clear(h); 
-
     /* finally multiply by content */
     _fmpz_vec_scalar_mul_fmpz(res, res, hlen, d);
 
@@ -14,11 +14,105 @@
 #include "flint.h"
 #include "fmpz.h"
 #include "fmpz_poly.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    slong * link;
+    fmpz_poly_t * v;
+    fmpz_poly_t * w;
+    fmpz_poly_struct * f;
+    slong j;
+    slong inv;
+    const fmpz * p0;
+    const fmpz * p1;
+    thread_pool_handle * threads;
+    slong num_threads;
+}
+_hensel_lift_tree_arg_t;
+
+static void _hensel_lift_tree_worker(void * arg_ptr);
+
+/*
+    As fmpz_poly_hensel_lift_tree_recursive, but once a node is lifted, its
+    two subtrees are independent: one of them is given to a thread together
+    with half of the remaining threads.
+*/
+static void
+_hensel_lift_tree_threaded(slong * link, fmpz_poly_t * v, fmpz_poly_t * w,
+             fmpz_poly_t f, slong j, slong inv, const fmpz_t p0,
+             const fmpz_t p1, thread_pool_handle * threads, slong num_threads)
+{
+    _hensel_lift_tree_arg_t arg;
+    slong n1;
+
+    if (j < 0)
+        return;
+
+    if (num_threads < 1 || (link[j] < 0 && link[j + 1] < 0))
+    {
+        fmpz_poly_hensel_lift_tree_recursive(link, v, w, f, j, inv, p0, p1);
+        return;
+    }
+
+    if (inv == 1)
+        fmpz_poly_hensel_lift(v[j], v[j + 1], w[j], w[j + 1], f,
+                              v[j], v[j + 1], w[j], w[j + 1],
+                              p0, p1);
+    else if (inv == -1)
+        fmpz_poly_hensel_lift_only_inverse(w[j], w[j+1],
+                             v[j], v[j+1], w[j], w[j+1], p0, p1);
+    else
+        fmpz_poly_hensel_lift_without_inverse(v[j], v[j+1], f,
+                                              v[j], v[j+1], w[j], w[j+1],
+                                              p0, p1);
+
+    if (link[j] < 0 || link[j + 1] < 0)
+    {
+        slong k = (link[j] < 0) ? j + 1 : j;
+
+        _hensel_lift_tree_threaded(link, v, w, v[k], link[k], inv, p0, p1,
+                                                        threads, num_threads);
+        return;
+    }
+
+    n1 = (num_threads - 1)/2;
+
+    arg.link = link;
+    arg.v = v;
+    arg.w = w;
+    arg.f = v[j];
+    arg.j = link[j];
+    arg.inv = inv;
+    arg.p0 = p0;
+    arg.p1 = p1;
+    arg.threads = threads + 1;
+    arg.num_threads = n1;
+
+    thread_pool_wake(global_thread_pool, threads[0], 0,
+                                            _hensel_lift_tree_worker, &arg);
+
+    _hensel_lift_tree_threaded(link, v, w, v[j + 1], link[j + 1], inv, p0, p1,
+                                threads + 1 + n1, num_threads - 1 - n1);
+
+    thread_pool_wait(global_thread_pool, threads[0]);
+}
+
+static void
+_hensel_lift_tree_worker(void * arg_ptr)
+{
+    _hensel_lift_tree_arg_t * arg = (_hensel_lift_tree_arg_t *) arg_ptr;
+
+    _hensel_lift_tree_threaded(arg->link, arg->v, arg->w, arg->f, arg->j,
+                     arg->inv, arg->p0, arg->p1, arg->threads, arg->num_threads);
+}
 
 void fmpz_poly_hensel_lift_tree(slong *link, fmpz_poly_t *v, fmpz_poly_t *w, 
     fmpz_poly_t f, slong r, const fmpz_t p, slong e0, slong e1, slong inv)
 {
     fmpz_t p0, p1;
+    thread_pool_handle * threads;
+    slong num_threads;
 
     fmpz_init(p0);
     fmpz_init(p1);
@@ -26,9 +120,14 @@ void fmpz_poly_hensel_lift_tree(slong *link, fmpz_poly_t *v, fmpz_poly_t *w,
     fmpz_pow_ui(p0, p, e0);
     fmpz_pow_ui(p1, p, e1 - e0);
 
-    fmpz_poly_hensel_lift_tree_recursive(link, v, w, f, 2*r - 4, inv, p0, p1);
+    num_threads = flint_request_threads(&threads, FLINT_MIN(r - 1,
+                                                     flint_get_num_threads()));
+
+    _hensel_lift_tree_threaded(link, v, w, f, 2*r - 4, inv, p0, p1,
+                                                        threads, num_threads);
+
+    flint_give_back_threads(threads, num_threads);
 
     fmpz_clear(p0);
     fmpz_clear(p1);
 }
-
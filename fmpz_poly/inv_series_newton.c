@@ -51,7 +51,13 @@ _fmpz_poly_inv_series_newton(fmpz * Qinv, const fmpz * Q, slong Qlen, slong n)
             Qnlen = FLINT_MIN(Qlen, n);
             Wlen = FLINT_MIN(Qnlen + m - 1, n);
             W2len = Wlen - m;
-            MULLOW(W, Q, Qnlen, Qinv, m, Wlen);
+
+            /* the low m coefficients of Q*Qinv are known to be 1, 0, ... */
+            if (Qnlen == n)
+                _fmpz_poly_mulmid(W + m - 1, Q, n, Qinv, m);
+            else
+                MULLOW(W, Q, Qnlen, Qinv, m, Wlen);
+
             MULLOW(Qinv + m, Qinv, m, W + m, W2len, n - m);
             _fmpz_vec_neg(Qinv + m, Qinv + m, n - m);
         }
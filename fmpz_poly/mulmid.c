@@ -0,0 +1,100 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_poly.h"
+
+void
+_fmpz_poly_mulmid(fmpz * res, const fmpz * poly1, slong len1,
+                              const fmpz * poly2, slong len2)
+{
+    mp_size_t limbs1, limbs2;
+    slong bits1, bits2, m = len1 - len2 + 1;
+
+    if (len2 == 1)
+    {
+        _fmpz_vec_scalar_mul_fmpz(res, poly1, len1, poly2);
+        return;
+    }
+
+    if (FLINT_MIN(len2, m) < 7)
+    {
+        _fmpz_poly_mulmid_classical(res, poly1, len1, poly2, len2);
+        return;
+    }
+
+    bits1 = _fmpz_vec_max_bits(poly1, len1);
+    bits2 = _fmpz_vec_max_bits(poly2, len2);
+    bits1 = FLINT_ABS(bits1);
+    bits2 = FLINT_ABS(bits2);
+
+    limbs1 = (bits1 + FLINT_BITS - 1) / FLINT_BITS;
+    limbs2 = (bits2 + FLINT_BITS - 1) / FLINT_BITS;
+
+    if (len1 < 16 && (limbs1 > 12 || limbs2 > 12))
+        _fmpz_poly_mulmid_classical(res, poly1, len1, poly2, len2);
+    else if (limbs1 + limbs2 <= 8)
+        _fmpz_poly_mulmid_KS(res, poly1, len1, poly2, len2);
+    else if ((limbs1 + limbs2)/2048 > len1 + len2)
+        _fmpz_poly_mulmid_KS(res, poly1, len1, poly2, len2);
+    else if ((limbs1 + limbs2)*FLINT_BITS*4 < len1 + len2)
+        _fmpz_poly_mulmid_KS(res, poly1, len1, poly2, len2);
+    else if (FLINT_CLOG2(len1) < FLINT_CLOG2(len1 + len2 - 1))
+        _fmpz_poly_mulmid_SS(res, poly1, len1, poly2, len2);
+    else
+    {
+        /*
+            The cyclic transform would be no shorter than the truncated
+            one used for the full product.
+        */
+        fmpz * t = _fmpz_vec_init(len1);
+
+        _fmpz_poly_mullow_SS(t, poly1, len1, poly2, len2, len1);
+        _fmpz_vec_swap(res, t + len2 - 1, m);
+        _fmpz_vec_clear(t, len1);
+    }
+}
+
+void
+fmpz_poly_mulmid(fmpz_poly_t res,
+                 const fmpz_poly_t poly1, const fmpz_poly_t poly2)
+{
+    slong len_out;
+
+    if (poly1->length == 0 || poly2->length == 0)
+    {
+        fmpz_poly_zero(res);
+        return;
+    }
+
+    len_out = poly1->length - poly2->length + 1;
+
+    if (res == poly1 || res == poly2)
+    {
+        fmpz_poly_t temp;
+        fmpz_poly_init2(temp, len_out);
+        _fmpz_poly_mulmid(temp->coeffs, poly1->coeffs, poly1->length,
+                                        poly2->coeffs, poly2->length);
+        fmpz_poly_swap(res, temp);
+        fmpz_poly_clear(temp);
+    }
+    else
+    {
+        fmpz_poly_fit_length(res, len_out);
+        _fmpz_poly_mulmid(res->coeffs, poly1->coeffs, poly1->length,
+                                       poly2->coeffs, poly2->length);
+    }
+
+    _fmpz_poly_set_length(res, len_out);
+    _fmpz_poly_normalise(res);
+}
@@ -0,0 +1,165 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_poly.h"
+#include "fft.h"
+#include "fft_tuning.h"
+
+/*
+    As for _nmod_poly_mulmid_KS, the packed product is only needed modulo
+    2^N + 1 with N >= (len1 + 1)*bits, a residue of at least 2^(N - 1)
+    standing for a negative value. Two extra bits per coefficient make the
+    low digits sum to less than 2^(s - 1) in absolute value, s being
+    (len2 - 1)*bits, so that the middle digits are those of the rounded
+    quotient by 2^s even when the coefficients are signed.
+*/
+void
+_fmpz_poly_mulmid_KS(fmpz * res, const fmpz * poly1, slong len1,
+                                 const fmpz * poly2, slong len2)
+{
+    int neg1, neg2;
+    slong m = len1 - len2 + 1, top1, top2;
+    slong limbs1, limbs2, limbs, tlimbs, off, cnt;
+    slong bits1, bits2, bits;
+    flint_bitcnt_t s;
+    mp_ptr arr1, arr2, arr3, tt, mid;
+    slong sign = 0;
+
+    for (top1 = len1 - 1; top1 >= 0 && fmpz_is_zero(poly1 + top1); top1--) ;
+    for (top2 = len2 - 1; top2 >= 0 && fmpz_is_zero(poly2 + top2); top2--) ;
+
+    if (top1 < 0 || top2 < 0)
+    {
+        _fmpz_vec_zero(res, m);
+        return;
+    }
+
+    neg1 = (fmpz_sgn(poly1 + top1) > 0) ? 0 : -1;
+    neg2 = (fmpz_sgn(poly2 + top2) > 0) ? 0 : -1;
+
+    bits1 = _fmpz_vec_max_bits(poly1, len1);
+    if (bits1 < 0)
+    {
+        sign = 1;
+        bits1 = -bits1;
+    }
+
+    bits2 = _fmpz_vec_max_bits(poly2, len2);
+    if (bits2 < 0)
+    {
+        sign = 1;
+        bits2 = -bits2;
+    }
+
+    bits = bits1 + bits2 + FLINT_BIT_COUNT(len2) + sign + 1;
+
+    limbs1 = (bits*len1 - 1)/FLINT_BITS + 1;
+    limbs2 = (bits*len2 - 1)/FLINT_BITS + 1;
+    limbs = (bits*(len1 + 1) - 1)/FLINT_BITS + 1;
+
+    if (limbs <= FFT_MULMOD_2EXPP1_CUTOFF)
+    {
+        /* the full product is no more expensive */
+        tlimbs = limbs1 + limbs2;
+        arr1 = (mp_ptr) flint_calloc(limbs1 + limbs2 + tlimbs,
+                                                           sizeof(mp_limb_t));
+        arr2 = arr1 + limbs1;
+        arr3 = arr2 + limbs2;
+
+        _fmpz_poly_bit_pack(arr1, poly1, len1, bits, neg1);
+        _fmpz_poly_bit_pack(arr2, poly2, len2, bits, neg2);
+
+        mpn_mul(arr3, arr1, limbs1, arr2, limbs2);
+    }
+    else
+    {
+        limbs = fft_adjust_limbs(limbs);
+        tlimbs = limbs;
+        arr1 = (mp_ptr) flint_calloc(5*(limbs + 1), sizeof(mp_limb_t));
+        arr2 = arr1 + limbs + 1;
+        arr3 = arr2 + limbs + 1;
+        tt = arr3 + limbs + 1;
+
+        _fmpz_poly_bit_pack(arr1, poly1, len1, bits, neg1);
+        _fmpz_poly_bit_pack(arr2, poly2, len2, bits, neg2);
+
+        fft_mulmod_2expp1(arr3, arr1, arr2, limbs, FLINT_BITS, tt);
+        mpn_normmod_2expp1(arr3, limbs);
+
+        /* residues of at least 2^(N - 1) stand for negative values */
+        if (arr3[limbs] != 0 || (arr3[limbs - 1] >> (FLINT_BITS - 1)) != 0)
+            mpn_sub_1(arr3, arr3, limbs + 1, 1);
+    }
+
+    s = (len2 - 1)*bits;
+    if (s != 0)
+        mpn_add_1(arr3 + (s - 1)/FLINT_BITS, arr3 + (s - 1)/FLINT_BITS,
+                      tlimbs - (s - 1)/FLINT_BITS,
+                      UWORD(1) << ((s - 1) % FLINT_BITS));
+
+    off = s/FLINT_BITS;
+    cnt = limbs1 - off;
+
+    if (s % FLINT_BITS != 0)
+    {
+        mid = (mp_ptr) flint_malloc(cnt*sizeof(mp_limb_t));
+        mpn_rshift(mid, arr3 + off, cnt, s % FLINT_BITS);
+    }
+    else
+        mid = arr3 + off;
+
+    if (sign)
+        _fmpz_poly_bit_unpack(res, m, mid, bits, neg1 ^ neg2);
+    else
+        _fmpz_poly_bit_unpack_unsigned(res, m, mid, bits);
+
+    if (s % FLINT_BITS != 0)
+        flint_free(mid);
+
+    flint_free(arr1);
+}
+
+void
+fmpz_poly_mulmid_KS(fmpz_poly_t res,
+                    const fmpz_poly_t poly1, const fmpz_poly_t poly2)
+{
+    slong len_out;
+
+    if (poly1->length == 0 || poly2->length == 0)
+    {
+        fmpz_poly_zero(res);
+        return;
+    }
+
+    len_out = poly1->length - poly2->length + 1;
+
+    if (res == poly1 || res == poly2)
+    {
+        fmpz_poly_t temp;
+        fmpz_poly_init2(temp, len_out);
+        _fmpz_poly_mulmid_KS(temp->coeffs, poly1->coeffs, poly1->length,
+                                           poly2->coeffs, poly2->length);
+        fmpz_poly_swap(res, temp);
+        fmpz_poly_clear(temp);
+    }
+    else
+    {
+        fmpz_poly_fit_length(res, len_out);
+        _fmpz_poly_mulmid_KS(res->coeffs, poly1->coeffs, poly1->length,
+                                          poly2->coeffs, poly2->length);
+    }
+
+    _fmpz_poly_set_length(res, len_out);
+    _fmpz_poly_normalise(res);
+}
@@ -0,0 +1,141 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_poly.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    fmpz * res;
+    const fmpz * m;
+    const fmpz * Q;
+    const fmpz * mQ;
+    const fmpz * c;
+    mp_ptr const * polys;
+    const fmpz_comb_struct * comb;
+    slong num_primes;
+    slong i0;
+    slong i1;
+    int sign;
+}
+_multi_CRT_ui_arg_t;
+
+static void
+_multi_CRT_ui_worker(void * arg_ptr)
+{
+    _multi_CRT_ui_arg_t * arg = (_multi_CRT_ui_arg_t *) arg_ptr;
+    fmpz_comb_temp_t comb_temp;
+    fmpz_t x;
+    mp_ptr r;
+    slong i, j;
+    int fresh = fmpz_is_one(arg->m);
+
+    fmpz_init(x);
+    r = (mp_ptr) flint_malloc(arg->num_primes*sizeof(mp_limb_t));
+    fmpz_comb_temp_init(comb_temp, arg->comb);
+
+    for (i = arg->i0; i < arg->i1; i++)
+    {
+        for (j = 0; j < arg->num_primes; j++)
+            r[j] = arg->polys[j][i];
+
+        if (fresh)
+        {
+            fmpz_multi_CRT_ui(arg->res + i, r, arg->comb, comb_temp, arg->sign);
+        }
+        else
+        {
+            fmpz_multi_CRT_ui(x, r, arg->comb, comb_temp, 0);
+            _fmpz_CRT(arg->res + i, arg->res + i, arg->m, x,
+                      (fmpz *) arg->Q, arg->mQ, (fmpz *) arg->c, arg->sign);
+        }
+    }
+
+    fmpz_comb_temp_clear(comb_temp);
+    flint_free(r);
+    fmpz_clear(x);
+}
+
+void
+_fmpz_poly_multi_CRT_ui(fmpz * res, fmpz_t m, slong len,
+                        mp_ptr const * polys, mp_srcptr primes,
+                        slong num_primes, int sign,
+                        const thread_pool_handle * handles, slong num_handles)
+{
+    _multi_CRT_ui_arg_t * args;
+    fmpz_comb_t comb;
+    fmpz_t Q, mQ, c;
+    slong i;
+
+    fmpz_init(Q);
+    fmpz_init(mQ);
+    fmpz_init(c);
+
+    fmpz_one(Q);
+    for (i = 0; i < num_primes; i++)
+        fmpz_mul_ui(Q, Q, primes[i]);
+
+    fmpz_mul(mQ, m, Q);
+
+    if (!fmpz_is_one(m))
+    {
+        fmpz_mod(c, m, Q);
+        if (!fmpz_invmod(c, c, Q))
+        {
+            flint_printf("Exception (_fmpz_poly_multi_CRT_ui). "
+                         "m not invertible modulo the primes.\n");
+            flint_abort();
+        }
+    }
+
+    /* the product tree is shared read only, only the temporaries are per thread */
+    fmpz_comb_init(comb, primes, num_primes);
+
+    /* don't bother waking threads for only a few coefficients each */
+    num_handles = FLINT_MIN(num_handles, len/8);
+
+    args = (_multi_CRT_ui_arg_t *)
+                  flint_malloc((num_handles + 1)*sizeof(_multi_CRT_ui_arg_t));
+
+    for (i = 0; i <= num_handles; i++)
+    {
+        args[i].res = res;
+        args[i].m = m;
+        args[i].Q = Q;
+        args[i].mQ = mQ;
+        args[i].c = c;
+        args[i].polys = polys;
+        args[i].comb = comb;
+        args[i].num_primes = num_primes;
+        args[i].i0 = (len*i)/(num_handles + 1);
+        args[i].i1 = (len*(i + 1))/(num_handles + 1);
+        args[i].sign = sign;
+    }
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                             _multi_CRT_ui_worker, &args[i]);
+
+    _multi_CRT_ui_worker(&args[num_handles]);
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+    fmpz_swap(m, mQ);
+
+    flint_free(args);
+    fmpz_comb_clear(comb);
+    fmpz_clear(Q);
+    fmpz_clear(mQ);
+    fmpz_clear(c);
+}
@@ -15,6 +15,88 @@
 #include "fmpz_vec.h"
 #include "fmpz_poly.h"
 #include "mpn_extras.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    const fmpz * A;
+    slong len1;
+    const fmpz * B;
+    slong len2;
+    mp_srcptr primes;
+    mp_ptr res;
+    slong i0;
+    slong i1;
+}
+_resultant_modular_arg_t;
+
+static void
+_resultant_modular_worker(void * arg_ptr)
+{
+    _resultant_modular_arg_t * arg = (_resultant_modular_arg_t *) arg_ptr;
+    mp_ptr a, b;
+    nmod_t mod;
+    slong i;
+
+    a = _nmod_vec_init(arg->len1);
+    b = _nmod_vec_init(arg->len2);
+
+    for (i = arg->i0; i < arg->i1; i++)
+    {
+        nmod_init(&mod, arg->primes[i]);
+
+        /* reduce polynomials modulo p */
+        _fmpz_vec_get_nmod_vec(a, arg->A, arg->len1, mod);
+        _fmpz_vec_get_nmod_vec(b, arg->B, arg->len2, mod);
+
+        /* compute resultant over Z/pZ */
+        arg->res[i] = _nmod_poly_resultant(a, arg->len1, b, arg->len2, mod);
+    }
+
+    _nmod_vec_clear(a);
+    _nmod_vec_clear(b);
+}
+
+void
+_fmpz_poly_multi_resultant_ui(mp_ptr res, mp_srcptr primes, slong num_primes,
+                              const fmpz * A, slong len1,
+                              const fmpz * B, slong len2)
+{
+    _resultant_modular_arg_t * args;
+    thread_pool_handle * handles;
+    slong i, num_handles;
+
+    num_handles = flint_request_threads(&handles,
+                             FLINT_MIN(flint_get_num_threads(), num_primes));
+
+    args = (_resultant_modular_arg_t *)
+                 flint_malloc((num_handles + 1)*sizeof(_resultant_modular_arg_t));
+
+    for (i = 0; i <= num_handles; i++)
+    {
+        args[i].A = A;
+        args[i].len1 = len1;
+        args[i].B = B;
+        args[i].len2 = len2;
+        args[i].primes = primes;
+        args[i].res = res;
+        args[i].i0 = (num_primes*i)/(num_handles + 1);
+        args[i].i1 = (num_primes*(i + 1))/(num_handles + 1);
+    }
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                       _resultant_modular_worker, &args[i]);
+
+    _resultant_modular_worker(&args[num_handles]);
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+    flint_give_back_threads(handles, num_handles);
+
+    flint_free(args);
+}
 
 
 void _fmpz_poly_resultant_modular(fmpz_t res, const fmpz * poly1, slong len1, 
@@ -24,11 +106,10 @@ void _fmpz_poly_resultant_modular(fmpz_t res, const fmpz * poly1, slong len1,
     slong i, num_primes;
     fmpz_comb_t comb;
     fmpz_comb_temp_t comb_temp;
-    fmpz_t ac, bc, l, modulus;
+    fmpz_t ac, bc, l;
     fmpz * A, * B, * lead_A, * lead_B;
-    mp_ptr a, b, rarr, parr;
+    mp_ptr rarr, parr;
     mp_limb_t p;
-    nmod_t mod;
     
     /* special case, one of the polys is a constant */
     if (len2 == 1) /* if len1 == 1 then so does len2 */
@@ -77,45 +158,29 @@ void _fmpz_poly_resultant_modular(fmpz_t res, const fmpz * poly1, slong len1,
     parr = _nmod_vec_init(num_primes);
     rarr = _nmod_vec_init(num_primes);
 
-    fmpz_init(modulus);
-    fmpz_set_ui(modulus, 1);
     fmpz_zero(res);
 
-    /* make space for polynomials mod p */
-    a = _nmod_vec_init(len1);
-    b = _nmod_vec_init(len2);
-    
+    /* primes not dividing the leading coefficients */
     for (i = 0; curr_bits < bound; )
     {
-        /* get new prime and initialise modulus */
         p = n_nextprime(p, 0);
         if (fmpz_fdiv_ui(l, p) == 0)
             continue;
-        
-        curr_bits += pbits;
-
-        nmod_init(&mod, p);
 
-        /* reduce polynomials modulo p */
-        _fmpz_vec_get_nmod_vec(a, A, len1, mod);
-        _fmpz_vec_get_nmod_vec(b, B, len2, mod);
-
-        /* compute resultant over Z/pZ */
-        parr[i] = p;
-        rarr[i++] = _nmod_poly_resultant(a, len1, b, len2, mod);
+        curr_bits += pbits;
+        parr[i++] = p;
     }
 
+    /* resultants over Z/pZ, in parallel */
+    _fmpz_poly_multi_resultant_ui(rarr, parr, num_primes, A, len1, B, len2);
+
     fmpz_comb_init(comb, parr, num_primes);
     fmpz_comb_temp_init(comb_temp, comb);
     
     fmpz_multi_CRT_ui(res, rarr, comb, comb_temp, 1);
         
-    fmpz_clear(modulus);
     fmpz_comb_temp_clear(comb_temp);
     fmpz_comb_clear(comb);
-        
-    _nmod_vec_clear(a);
-    _nmod_vec_clear(b);
 
     _nmod_vec_clear(parr);
     _nmod_vec_clear(rarr);
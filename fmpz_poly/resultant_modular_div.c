@@ -26,11 +26,10 @@ void _fmpz_poly_resultant_modular_div(fmpz_t res,
     slong i, num_primes;
     fmpz_comb_t comb;
     fmpz_comb_temp_t comb_temp;
-    fmpz_t ac, bc, l, modulus, div, la, lb;
+    fmpz_t ac, bc, l, div, la, lb;
     fmpz * A, * B, * lead_A, * lead_B;
-    mp_ptr a, b, rarr, parr;
+    mp_ptr rarr, parr, darr;
     mp_limb_t p, d;
-    nmod_t mod;
 
     if (fmpz_is_zero(divisor))
     {
@@ -105,14 +104,8 @@ void _fmpz_poly_resultant_modular_div(fmpz_t res,
     lead_B = B + len2 - 1;
     fmpz_mul(l, lead_A, lead_B);
 
-    fmpz_init(modulus);
-    fmpz_set_ui(modulus, 1);
     fmpz_zero(res);
 
-    /* make space for polynomials mod p */
-    a = _nmod_vec_init(len1);
-    b = _nmod_vec_init(len2);
-
     pbits = FLINT_BITS - 1;
     p = (UWORD(1)<<pbits);
 
@@ -123,8 +116,9 @@ void _fmpz_poly_resultant_modular_div(fmpz_t res,
 
     parr = _nmod_vec_init(num_primes);
     rarr = _nmod_vec_init(num_primes);
+    darr = _nmod_vec_init(num_primes);
 
-    
+    /* primes not dividing the leading coefficients or the divisor */
     for(i=0; i< num_primes; )
     {
         /* get new prime and initialise modulus */
@@ -135,32 +129,27 @@ void _fmpz_poly_resultant_modular_div(fmpz_t res,
         d = fmpz_fdiv_ui(div, p);
         if (d==0)
             continue;
-        d = n_invmod(d, p);
-
-        nmod_init(&mod, p);
-
-        /* reduce polynomials modulo p */
-        _fmpz_vec_get_nmod_vec(a, A, len1, mod);
-        _fmpz_vec_get_nmod_vec(b, B, len2, mod);
 
-        /* compute resultant over Z/pZ */
-        rarr[i] = _nmod_poly_resultant(a, len1, b, len2, mod);
-        rarr[i] = n_mulmod2_preinv(rarr[i], d, mod.n, mod.ninv);
+        darr[i] = n_invmod(d, p);
         parr[i++] = p;
     }
 
+    /* resultants over Z/pZ, in parallel */
+    _fmpz_poly_multi_resultant_ui(rarr, parr, num_primes, A, len1, B, len2);
+
+    for (i = 0; i < num_primes; i++)
+        rarr[i] = n_mulmod2_preinv(rarr[i], darr[i], parr[i],
+                                               n_preinvert_limb(parr[i]));
+
     fmpz_comb_init(comb, parr, num_primes);
     fmpz_comb_temp_init(comb_temp, comb);
     
     fmpz_multi_CRT_ui(res, rarr, comb, comb_temp, 1);
         
-    fmpz_clear(modulus);
     fmpz_comb_temp_clear(comb_temp);
     fmpz_comb_clear(comb);
-        
-    _nmod_vec_clear(a);
-    _nmod_vec_clear(b);
 
+    _nmod_vec_clear(darr);
     _nmod_vec_clear(parr);
     _nmod_vec_clear(rarr);
     
@@ -80,6 +80,7 @@ main(void)
         fmpz_poly_resultant_modular(b, g, h);
         fmpz_mul(c, a, b);
         fmpz_poly_mul(p, f, g);
+        flint_set_num_threads(1 + n_randint(state, 4));
         fmpz_poly_resultant_modular(d, p, h);
 
         result = (fmpz_equal(c, d));
@@ -103,6 +103,7 @@ main(void)
         fmpz_mul(c, a, b);
         fmpz_poly_mul(p, f, g);
         nbits = (slong)fmpz_bits(a) + 1; /* for sign */
+        flint_set_num_threads(1 + n_randint(state, 4));
         fmpz_poly_resultant_modular_div(d, p, h, b, nbits);
 
         result = (fmpz_equal(a, d));
@@ -50,6 +50,7 @@ main(void)
             fmpz_poly_gcd_modular(d, f, g);
         } while (d->length != 1);
 
+        flint_set_num_threads(1 + n_randint(state, 4));
         fmpz_poly_xgcd_modular(r, s, t, f, g);
         fmpz_poly_mul(s, s, f);
         fmpz_poly_mul(t, t, g);
@@ -97,6 +98,7 @@ main(void)
             fmpz_poly_gcd_modular(d, f, g);
         } while (d->length != 1);
 
+        flint_set_num_threads(1 + n_randint(state, 4));
         fmpz_poly_xgcd_modular(r, s, t, f, g);
         fmpz_poly_mul(s, s, f);
         fmpz_poly_mul(t, t, g);
@@ -144,6 +146,7 @@ main(void)
             fmpz_poly_gcd_modular(d, f, g);
         } while (d->length != 1);
         
+        flint_set_num_threads(1 + n_randint(state, 4));
         fmpz_poly_xgcd_modular(r, s, t, f, g);
         fmpz_poly_xgcd_modular(r, f, t, f, g);
         
@@ -185,6 +188,7 @@ main(void)
             fmpz_poly_gcd_modular(d, f, g);
         } while (d->length != 1);
         
+        flint_set_num_threads(1 + n_randint(state, 4));
         fmpz_poly_xgcd_modular(r, s, t, f, g);
         fmpz_poly_xgcd_modular(r, g, t, f, g);
         
@@ -226,6 +230,7 @@ main(void)
             fmpz_poly_gcd_modular(d, f, g);
         } while (d->length != 1);
         
+        flint_set_num_threads(1 + n_randint(state, 4));
         fmpz_poly_xgcd_modular(r, s, t, f, g);
         fmpz_poly_xgcd_modular(r, s, f, f, g);
         
@@ -267,6 +272,7 @@ main(void)
             fmpz_poly_gcd_modular(d, f, g);
         } while (d->length != 1);
         
+        flint_set_num_threads(1 + n_randint(state, 4));
         fmpz_poly_xgcd_modular(r, s, t, f, g);
         fmpz_poly_xgcd_modular(r, s, g, f, g);
         
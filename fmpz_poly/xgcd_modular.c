@@ -16,30 +16,41 @@
 #include "fmpz_vec.h"
 #include "fmpz_poly.h"
 #include "mpn_extras.h"
+#include "thread_support.h"
 
-void _fmpz_poly_xgcd_modular(fmpz_t r, fmpz * s, fmpz * t, 
-                             const fmpz * poly1, slong len1, 
-                             const fmpz * poly2, slong len2)
+typedef struct
 {
-    mp_ptr G, S, T, A, B, T1, T2;
-    fmpz_t prod;
-    int stabilised = 0, first;
-    mp_limb_t p;
-    flint_bitcnt_t s_bits = 0, t_bits = 0;
-
-    /* Compute resultant of input polys */
-    _fmpz_poly_resultant(r, poly1, len1, poly2, len2);
-
-    if (fmpz_is_zero(r)) 
-        return;
-
-    fmpz_init(prod);
-    fmpz_one(prod);
-
-    _fmpz_vec_zero(s, len2);
-    _fmpz_vec_zero(t, len1);
+    const fmpz * poly1;
+    slong len1;
+    const fmpz * poly2;
+    slong len2;
+    const fmpz * r;
+    const fmpz * s;
+    const fmpz * t;
+    mp_srcptr primes;
+    mp_ptr * S;
+    mp_ptr * T;
+    int * ok;
+    int verify;
+    slong i0;
+    slong i1;
+}
+_xgcd_modular_arg_t;
 
-    p = (UWORD(1) << (FLINT_BITS - 1));
+/*
+    Either computes the images S, T of the cofactors modulo each prime,
+    or, if verify is set, checks whether the current s and t are already
+    correct modulo each prime.
+*/
+static void
+_xgcd_modular_worker(void * arg_ptr)
+{
+    _xgcd_modular_arg_t * arg = (_xgcd_modular_arg_t *) arg_ptr;
+    slong len1 = arg->len1, len2 = arg->len2;
+    mp_ptr G, S, T, A, B, T1, T2;
+    mp_limb_t R;
+    nmod_t mod;
+    slong i;
 
     G = _nmod_vec_init(4 * len1 + 5 * len2 - 2);
     S = G + len2;
@@ -49,39 +60,24 @@ void _fmpz_poly_xgcd_modular(fmpz_t r, fmpz * s, fmpz * t,
     T1 = B + len2;
     T2 = T1 + (len1 + len2 - 1);
 
-    _nmod_vec_zero(S, len2 + len1); /* S = T = 0 */
-
-    first = 1;
-
-    for (;;) 
+    for (i = arg->i0; i < arg->i1; i++)
     {
-        mp_limb_t R;
-        nmod_t mod;
-
-        /* Get next prime */
-        p = n_nextprime(p, 0);
+        nmod_init(&mod, arg->primes[i]);
 
         /* Resultant mod p */
-        R = fmpz_fdiv_ui(r, p);
-
-        /* If p divides resultant or either leading coeff, discard p */
-        if ((fmpz_fdiv_ui(poly1 + len1 - 1, p) == WORD(0)) || 
-            (fmpz_fdiv_ui(poly2 + len2 - 1, p) == WORD(0)) || (R == 0))
-            continue;
-
-        nmod_init(&mod, p);
+        R = fmpz_fdiv_ui(arg->r, mod.n);
 
         /* Reduce polynomials modulo p */
-        _fmpz_vec_get_nmod_vec(A, poly1, len1, mod);
-        _fmpz_vec_get_nmod_vec(B, poly2, len2, mod);
+        _fmpz_vec_get_nmod_vec(A, arg->poly1, len1, mod);
+        _fmpz_vec_get_nmod_vec(B, arg->poly2, len2, mod);
 
-        if (stabilised) /* CRT has stabilised, probably don't need more xgcds */
+        if (arg->verify)
         {
             slong tlen;
 
             /* Multiply out A*S + B*T to see if it is R mod p */
-            _fmpz_vec_get_nmod_vec(S, s, len2, mod);
-            _fmpz_vec_get_nmod_vec(T, t, len1, mod);
+            _fmpz_vec_get_nmod_vec(S, arg->s, len2, mod);
+            _fmpz_vec_get_nmod_vec(T, arg->t, len1, mod);
 
             _nmod_poly_mul(T1, A, len1, S, len2, mod); 
             _nmod_poly_mul(T2, T, len1, B, len2, mod);
@@ -89,42 +85,149 @@ void _fmpz_poly_xgcd_modular(fmpz_t r, fmpz * s, fmpz * t,
             tlen = len1 + len2 - 1;
             FMPZ_VEC_NORM(T1, tlen);
 
-            if (tlen == 1 && T1[0] == R) /* It is, so this prime is good */
-                fmpz_mul_ui(prod, prod, p);
-            else
-                stabilised = 0; /* It's not, keep going with xgcds */   
+            arg->ok[i] = (tlen == 1 && T1[0] == R);
         }
-
-        if (!stabilised) /* Need to keep computing xgcds mod p */
+        else
         {
             mp_limb_t RGinv;
 
-            /* Compute xgcd mod p */
-            _nmod_poly_xgcd(G, S, T, A, len1, B, len2, mod);
+            /* Compute xgcd mod p, which may not set the top coefficients */
+            _nmod_vec_zero(arg->S[i], len2);
+            _nmod_vec_zero(arg->T[i], len1);
+            _nmod_poly_xgcd(G, arg->S[i], arg->T[i], A, len1, B, len2, mod);
             RGinv = n_invmod(G[0], mod.n);
             RGinv = n_mulmod2_preinv(RGinv, R, mod.n, mod.ninv);
 
             /* Scale appropriately */
-            _nmod_vec_scalar_mul_nmod(S, S, len2, RGinv, mod);
-            _nmod_vec_scalar_mul_nmod(T, T, len1, RGinv, mod);
+            _nmod_vec_scalar_mul_nmod(arg->S[i], arg->S[i], len2, RGinv, mod);
+            _nmod_vec_scalar_mul_nmod(arg->T[i], arg->T[i], len1, RGinv, mod);
+        }
+    }
+
+    _nmod_vec_clear(G);
+}
 
-            if (first) /* First time around set s and t to S and T */
+void _fmpz_poly_xgcd_modular(fmpz_t r, fmpz * s, fmpz * t, 
+                             const fmpz * poly1, slong len1, 
+                             const fmpz * poly2, slong len2)
+{
+    mp_ptr primes;
+    mp_ptr * S, * T;
+    int * ok;
+    fmpz_t prod, prod2;
+    int stabilised = 0, first;
+    mp_limb_t p;
+    flint_bitcnt_t s_bits = 0, t_bits = 0;
+    slong i, batch, num_handles;
+    thread_pool_handle * handles;
+    _xgcd_modular_arg_t * args;
+
+    /* Compute resultant of input polys */
+    _fmpz_poly_resultant(r, poly1, len1, poly2, len2);
+
+    if (fmpz_is_zero(r)) 
+        return;
+
+    fmpz_init(prod);
+    fmpz_init(prod2);
+    fmpz_one(prod);
+
+    _fmpz_vec_zero(s, len2);
+    _fmpz_vec_zero(t, len1);
+
+    p = (UWORD(1) << (FLINT_BITS - 1));
+
+    /* one prime per thread in each batch */
+    num_handles = flint_request_threads(&handles, flint_get_num_threads());
+    batch = num_handles + 1;
+
+    primes = _nmod_vec_init(batch);
+    ok = (int *) flint_malloc(batch*sizeof(int));
+    S = (mp_ptr *) flint_malloc(2*batch*sizeof(mp_ptr));
+    T = S + batch;
+    for (i = 0; i < batch; i++)
+    {
+        S[i] = _nmod_vec_init(len2);
+        T[i] = _nmod_vec_init(len1);
+    }
+
+    args = (_xgcd_modular_arg_t *)
+                          flint_malloc(batch*sizeof(_xgcd_modular_arg_t));
+    for (i = 0; i < batch; i++)
+    {
+        args[i].poly1 = poly1;
+        args[i].len1 = len1;
+        args[i].poly2 = poly2;
+        args[i].len2 = len2;
+        args[i].r = r;
+        args[i].s = s;
+        args[i].t = t;
+        args[i].primes = primes;
+        args[i].S = S;
+        args[i].T = T;
+        args[i].ok = ok;
+        args[i].i0 = i;
+        args[i].i1 = i + 1;
+    }
+
+    first = 1;
+
+    for (;;) 
+    {
+        /* Get next batch of primes */
+        for (i = 0; i < batch; )
+        {
+            p = n_nextprime(p, 0);
+
+            /* If p divides resultant or either leading coeff, discard p */
+            if ((fmpz_fdiv_ui(poly1 + len1 - 1, p) == WORD(0)) || 
+                (fmpz_fdiv_ui(poly2 + len2 - 1, p) == WORD(0)) ||
+                (fmpz_fdiv_ui(r, p) == WORD(0)))
+                continue;
+
+            primes[i++] = p;
+        }
+
+        /* CRT has stabilised, probably don't need more xgcds */
+        for (i = 0; i < batch; i++)
+            args[i].verify = stabilised;
+
+        for (i = 0; i < num_handles; i++)
+            thread_pool_wake(global_thread_pool, handles[i], 0,
+                                           _xgcd_modular_worker, &args[i]);
+        _xgcd_modular_worker(&args[num_handles]);
+        for (i = 0; i < num_handles; i++)
+            thread_pool_wait(global_thread_pool, handles[i]);
+
+        if (stabilised)
+        {
+            /* Primes passing the check are good, any failure means we
+               need to keep computing xgcds */
+            for (i = 0; i < batch; i++)
             {
-                _fmpz_vec_set_nmod_vec(s, S, len2, mod);
-                _fmpz_vec_set_nmod_vec(t, T, len1, mod);
-                fmpz_set_ui(prod, p);
+                if (ok[i])
+                    fmpz_mul_ui(prod, prod, primes[i]);
+                else
+                    stabilised = 0;
+            }
+        }
+        else
+        {
+            fmpz_set(prod2, prod);
+            _fmpz_poly_multi_CRT_ui(s, prod2, len2, S, primes, batch, 1,
+                                                       handles, num_handles);
+            _fmpz_poly_multi_CRT_ui(t, prod, len1, T, primes, batch, 1,
+                                                       handles, num_handles);
 
-                stabilised = 1; /* Optimise the case where one prime is enough */
+            if (first) /* Optimise the case where one batch is enough */
+            {
+                stabilised = 1;
                 first = 0;
             }
-            else /* Otherwise do CRT */
+            else
             {
                 flint_bitcnt_t new_s_bits, new_t_bits;
 
-                _fmpz_poly_CRT_ui(s, s, len2, prod, S, len2, mod.n, mod.ninv, 1);
-                _fmpz_poly_CRT_ui(t, t, len1, prod, T, len1, mod.n, mod.ninv, 1);
-                fmpz_mul_ui(prod, prod, p);
-
                 /* Check to see if CRT has stabilised */
                 new_s_bits = FLINT_ABS(_fmpz_vec_max_bits(s, len2));
                 new_t_bits = FLINT_ABS(_fmpz_vec_max_bits(t, len1));
@@ -154,8 +257,20 @@ void _fmpz_poly_xgcd_modular(fmpz_t r, fmpz * s, fmpz * t,
         }
     }
 
-    _nmod_vec_clear(G);
+    flint_give_back_threads(handles, num_handles);
+
+    for (i = 0; i < batch; i++)
+    {
+        _nmod_vec_clear(S[i]);
+        _nmod_vec_clear(T[i]);
+    }
+    flint_free(S);
+    flint_free(ok);
+    flint_free(args);
+    _nmod_vec_clear(primes);
+
     fmpz_clear(prod);
+    fmpz_clear(prod2);
 }
 
 void
@@ -18,6 +18,94 @@
 #include "fmpz_mat.h"
 
 #include "fmpz_mod_poly.h"
+#include "thread_support.h"
+
+typedef struct
+{
+   fmpz_mat_struct * res;
+   const fmpz_poly_struct * f;
+   const fmpz_poly_struct * fac;
+   const fmpz * P;
+   slong lo_n;
+   slong hi_n;
+   slong r;
+   volatile slong * index;
+#if FLINT_USES_PTHREAD
+   pthread_mutex_t * mutex;
+#endif
+}
+_CLD_arg_t;
+
+/* fill in the rows of the lifted factors fetched from a shared counter */
+static void
+_CLD_rows_worker(void * arg_ptr)
+{
+   _CLD_arg_t * arg = (_CLD_arg_t *) arg_ptr;
+   fmpz_mat_struct * res = arg->res;
+   const fmpz_poly_struct * f = arg->f;
+   slong i, zeroes, len, lo_n = arg->lo_n, hi_n = arg->hi_n;
+   fmpz_poly_t gd, gcld, temp;
+   fmpz_poly_t trunc_f, trunc_fac; /* don't initialise trunc_f, trunc_fac */
+
+   fmpz_poly_init(gd);
+   fmpz_poly_init(gcld);
+   fmpz_poly_init(temp);
+
+   if (hi_n > 0)
+      fmpz_poly_attach_shift(trunc_f, f, f->length - hi_n);
+
+   while (1)
+   {
+#if FLINT_USES_PTHREAD
+      pthread_mutex_lock(arg->mutex);
+#endif
+      i = *arg->index;
+      *arg->index = i + 1;
+#if FLINT_USES_PTHREAD
+      pthread_mutex_unlock(arg->mutex);
+#endif
+
+      if (i >= arg->r)
+         break;
+
+      if (lo_n > 0)
+      {
+         zeroes = 0;
+         while (fmpz_is_zero(arg->fac[i].coeffs + zeroes))
+            zeroes++;
+
+         fmpz_poly_attach_truncate(trunc_fac, arg->fac + i, lo_n + zeroes + 1);
+         fmpz_poly_derivative(gd, trunc_fac);
+         fmpz_poly_mullow(gcld, f, gd, lo_n + zeroes);
+         fmpz_poly_divlow_smodp(res->rows[i], gcld, trunc_fac, arg->P, lo_n);
+      }
+
+      if (hi_n > 0)
+      {
+         len = arg->fac[i].length - hi_n - 1;
+
+         if (len < 0)
+         {
+            fmpz_poly_shift_left(temp, arg->fac + i, -len);
+            fmpz_poly_derivative(gd, temp);
+            fmpz_poly_mulhigh_n(gcld, trunc_f, gd, hi_n);
+            fmpz_poly_divhigh_smodp(res->rows[i] + lo_n, gcld, temp, arg->P, hi_n);
+         } else
+         {
+            fmpz_poly_attach_shift(trunc_fac, arg->fac + i, len);
+            fmpz_poly_derivative(gd, trunc_fac);
+            fmpz_poly_mulhigh_n(gcld, trunc_f, gd, hi_n);
+            fmpz_poly_divhigh_smodp(res->rows[i] + lo_n, gcld, trunc_fac, arg->P, hi_n);
+         }
+      }
+   }
+
+   /* do not clear trunc_fac */
+   /* do not clear trunc_f */
+   fmpz_poly_clear(gd);
+   fmpz_poly_clear(gcld);
+   fmpz_poly_clear(temp);
+}
 
 slong _fmpz_poly_factor_CLD_mat(fmpz_mat_t res, const fmpz_poly_t f,
                               fmpz_poly_factor_t lifted_fac, fmpz_t P, ulong k)
@@ -30,10 +118,8 @@ slong _fmpz_poly_factor_CLD_mat(fmpz_mat_t res, const fmpz_poly_t f,
       initialised to be of size (r + 1, 2k).
    */
 
-   slong i, zeroes, bound, lo_n, hi_n, r = lifted_fac->num;
+   slong i, bound, lo_n, hi_n, r = lifted_fac->num;
    slong bit_r = FLINT_MAX(r, 20);
-   fmpz_poly_t gd, gcld, temp;
-   fmpz_poly_t trunc_f, trunc_fac; /* don't initialise trunc_f, trunc_fac */
    fmpz_t t;
 
    /* insert CLD bounds in last row of matrix */
@@ -70,54 +156,57 @@ slong _fmpz_poly_factor_CLD_mat(fmpz_mat_t res, const fmpz_poly_t f,
 
    fmpz_clear(t);
 
-   /* now insert data into matrix */
+   /* now insert data into matrix, the rows of the factors in parallel */
 
-   fmpz_poly_init(gd);
-   fmpz_poly_init(gcld);
-   /* do not initialise trunc_f */
-   /* do not initialise trunc_fac */
-
-   if (lo_n > 0)
+   if (lo_n > 0 || hi_n > 0)
    {
-      for (i = 0; i < r; i++)
-      {
-         zeroes = 0;
-         while (fmpz_is_zero(lifted_fac->p[i].coeffs + zeroes))
-            zeroes++;
+      slong num_threads, index = 0;
+      thread_pool_handle * threads;
+      _CLD_arg_t * args;
+#if FLINT_USES_PTHREAD
+      pthread_mutex_t mutex;
+#endif
 
-         fmpz_poly_attach_truncate(trunc_fac, lifted_fac->p + i, lo_n + zeroes + 1);
-         fmpz_poly_derivative(gd, trunc_fac);
-         fmpz_poly_mullow(gcld, f, gd, lo_n + zeroes);
-         fmpz_poly_divlow_smodp(res->rows[i], gcld, trunc_fac, P, lo_n);
-      }      
-   }
+      num_threads = flint_request_threads(&threads,
+                                       FLINT_MIN(r, flint_get_num_threads()));
 
-   if (hi_n > 0)
-   {
-      fmpz_poly_init(temp);
+      args = (_CLD_arg_t *) flint_malloc((num_threads + 1)*sizeof(_CLD_arg_t));
 
-      fmpz_poly_attach_shift(trunc_f, f, f->length - hi_n);
-      
-      for (i = 0; i < r; i++)
+      for (i = 0; i <= num_threads; i++)
       {
-         slong len = lifted_fac->p[i].length - hi_n - 1;
-
-         if (len < 0)
-         {
-            fmpz_poly_shift_left(temp, lifted_fac->p + i, -len);
-            fmpz_poly_derivative(gd, temp);
-            fmpz_poly_mulhigh_n(gcld, trunc_f, gd, hi_n);
-            fmpz_poly_divhigh_smodp(res->rows[i] + lo_n, gcld, temp, P, hi_n);
-         } else
-         {
-            fmpz_poly_attach_shift(trunc_fac, lifted_fac->p + i, len);
-            fmpz_poly_derivative(gd, trunc_fac);
-            fmpz_poly_mulhigh_n(gcld, trunc_f, gd, hi_n);
-            fmpz_poly_divhigh_smodp(res->rows[i] + lo_n, gcld, trunc_fac, P, hi_n);
-         }
+         args[i].res = res;
+         args[i].f = f;
+         args[i].fac = lifted_fac->p;
+         args[i].P = P;
+         args[i].lo_n = lo_n;
+         args[i].hi_n = hi_n;
+         args[i].r = r;
+         args[i].index = &index;
+#if FLINT_USES_PTHREAD
+         args[i].mutex = &mutex;
+#endif
       }
 
-      fmpz_poly_clear(temp);      
+#if FLINT_USES_PTHREAD
+      pthread_mutex_init(&mutex, NULL);
+#endif
+
+      for (i = 0; i < num_threads; i++)
+         thread_pool_wake(global_thread_pool, threads[i], 0,
+                                                 _CLD_rows_worker, &args[i]);
+
+      _CLD_rows_worker(&args[num_threads]);
+
+      for (i = 0; i < num_threads; i++)
+         thread_pool_wait(global_thread_pool, threads[i]);
+
+#if FLINT_USES_PTHREAD
+      pthread_mutex_destroy(&mutex);
+#endif
+
+      flint_give_back_threads(threads, num_threads);
+
+      flint_free(args);
    }
 
    if (hi_n > 0)
@@ -127,11 +216,6 @@ slong _fmpz_poly_factor_CLD_mat(fmpz_mat_t res, const fmpz_poly_t f,
          fmpz_set(res->rows[r] + lo_n + i, res->rows[r] + 2*k - hi_n + i);
    }
 
-   /* do not clear trunc_fac */
-   /* do not clear trunc_f */
-   fmpz_poly_clear(gd);
-   fmpz_poly_clear(gcld);
-
    return lo_n + hi_n;
 }
 
@@ -12,6 +12,7 @@
 
 #include <stdlib.h>
 #include "fmpz_poly.h"
+#include "thread_support.h"
 
 #define TRACE_ZASSENHAUS 0
 
@@ -87,6 +88,20 @@ void fmpz_poly_factor_mignotte(fmpz_t B, const fmpz_poly_t f)
     _fmpz_poly_factor_mignotte(B, f->coeffs, f->length - 1);
 }
 
+typedef struct
+{
+    nmod_poly_factor_struct * fac;
+    const nmod_poly_struct * poly;
+}
+_factor_arg_t;
+
+static void _factor_worker(void * arg_ptr)
+{
+    _factor_arg_t * arg = (_factor_arg_t *) arg_ptr;
+
+    nmod_poly_factor(arg->fac, arg->poly);
+}
+
 void _fmpz_poly_factor_zassenhaus(fmpz_poly_factor_t final_fac, 
                slong exp, const fmpz_poly_t f, slong cutoff, int use_van_hoeij)
 {
@@ -110,21 +125,25 @@ void _fmpz_poly_factor_zassenhaus(fmpz_poly_factor_t final_fac,
     }
     else
     {
-        slong i, j;
+        slong i, j, num_threads;
         slong r = lenF;
         mp_limb_t p = 2;
-        nmod_poly_t d, g, t;
+        nmod_poly_t d, g;
+        nmod_poly_struct t[3];
         nmod_poly_factor_t fac;
+        nmod_poly_factor_struct temp_fac[3];
+        thread_pool_handle * threads;
+        _factor_arg_t args[3];
         zassenhaus_prune_t Z;
 
         zassenhaus_prune_init(Z);
         nmod_poly_factor_init(fac);
-        nmod_poly_init_preinv(t, 1, 0);
         nmod_poly_init_preinv(d, 1, 0);
         nmod_poly_init_preinv(g, 1, 0);
 
         zassenhaus_prune_set_degree(Z, lenF - 1);
 
+        /* find the first three primes for which f stays squarefree */
         for (i = 0; i < 3; i++)
         {
             for ( ; ; p = n_nextprime(p, 0))
@@ -134,42 +153,64 @@ void _fmpz_poly_factor_zassenhaus(fmpz_poly_factor_t final_fac,
                 nmod_init(&mod, p);
                 d->mod = mod;
                 g->mod = mod;
-                t->mod = mod;
+                nmod_poly_init_mod(t + i, mod);
 
-                fmpz_poly_get_nmod_poly(t, f);
-                if (t->length == lenF && t->coeffs[0] != 0)
+                fmpz_poly_get_nmod_poly(t + i, f);
+                if (t[i].length == lenF && t[i].coeffs[0] != 0)
                 {
-                    nmod_poly_derivative(d, t);
-                    nmod_poly_gcd(g, t, d);
+                    nmod_poly_derivative(d, t + i);
+                    nmod_poly_gcd(g, t + i, d);
 
                     if (nmod_poly_is_one(g))
-                    {
-                        nmod_poly_factor_t temp_fac;
-
-                        nmod_poly_factor_init(temp_fac);
-                        nmod_poly_factor(temp_fac, t);
-
-                        zassenhaus_prune_start_add_factors(Z);
-                        for (j = 0; j < temp_fac->num; j++)
-                            zassenhaus_prune_add_factor(Z,
-                                  temp_fac->p[j].length - 1, temp_fac->exp[j]);
-                        zassenhaus_prune_end_add_factors(Z);
-
-                        if (temp_fac->num <= r)
-                        {
-                            r = temp_fac->num;
-                            nmod_poly_factor_set(fac, temp_fac);
-                        }
-                        nmod_poly_factor_clear(temp_fac);
                         break;
-                    }
                 }
+
+                nmod_poly_clear(t + i);
             }
             p = n_nextprime(p, 0);
         }
         nmod_poly_clear(d);
         nmod_poly_clear(g);
-        nmod_poly_clear(t);
+
+        /* factor f modulo the three primes concurrently */
+        num_threads = flint_request_threads(&threads, 3);
+
+        for (i = 0; i < 3; i++)
+        {
+            nmod_poly_factor_init(temp_fac + i);
+            args[i].fac = temp_fac + i;
+            args[i].poly = t + i;
+        }
+
+        for (i = 0; i < num_threads; i++)
+            thread_pool_wake(global_thread_pool, threads[i], 0,
+                                                   _factor_worker, &args[i]);
+
+        for (i = num_threads; i < 3; i++)
+            _factor_worker(&args[i]);
+
+        for (i = 0; i < num_threads; i++)
+            thread_pool_wait(global_thread_pool, threads[i]);
+
+        flint_give_back_threads(threads, num_threads);
+
+        for (i = 0; i < 3; i++)
+        {
+            zassenhaus_prune_start_add_factors(Z);
+            for (j = 0; j < temp_fac[i].num; j++)
+                zassenhaus_prune_add_factor(Z,
+                          temp_fac[i].p[j].length - 1, temp_fac[i].exp[j]);
+            zassenhaus_prune_end_add_factors(Z);
+
+            if (temp_fac[i].num <= r)
+            {
+                r = temp_fac[i].num;
+                nmod_poly_factor_set(fac, temp_fac + i);
+            }
+
+            nmod_poly_factor_clear(temp_fac + i);
+            nmod_poly_clear(t + i);
+        }
 
         p = (fac->p + 0)->mod.n;
             
@@ -14,6 +14,7 @@
 
 #include <stdlib.h>
 #include "fmpz_poly.h"
+#include "thread_support.h"
 
 
 static void _fmpz_poly_product(
@@ -79,6 +80,220 @@ static void _fmpz_poly_product(
 }
 
 
+typedef struct
+{
+    fmpz_poly_struct * tryme;
+    fmpz_poly_struct * Q;
+    int * divides;
+    const slong * subsets;
+    slong len;
+    const fmpz_poly_struct * fac;
+    const fmpz_poly_struct * f;
+    const fmpz * P;
+    slong num;
+    volatile slong * index;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_recombination_arg_t;
+
+/* try the subsets of a batch fetched from a shared counter */
+static void _recombination_worker(void * arg_ptr)
+{
+    _recombination_arg_t * arg = (_recombination_arg_t *) arg_ptr;
+    slong i, len = arg->len;
+    fmpz_poly_struct ** stack;
+    fmpz_poly_struct * tmp;
+
+    stack = (fmpz_poly_struct **) flint_malloc(len*sizeof(fmpz_poly_struct *));
+    tmp = (fmpz_poly_struct *) flint_malloc(len*sizeof(fmpz_poly_struct));
+    for (i = 0; i < len; i++)
+        fmpz_poly_init(tmp + i);
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        i = *arg->index;
+        *arg->index = i + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (i >= arg->num)
+            break;
+
+        _fmpz_poly_product(arg->tryme + i, arg->fac, arg->subsets + i*len,
+                            len, arg->P, fmpz_poly_lead(arg->f), stack, tmp);
+        fmpz_poly_primitive_part(arg->tryme + i, arg->tryme + i);
+        arg->divides[i] = fmpz_poly_divides(arg->Q + i, arg->f,
+                                                            arg->tryme + i);
+    }
+
+    for (i = 0; i < len; i++)
+        fmpz_poly_clear(tmp + i);
+    flint_free(tmp);
+    flint_free(stack);
+}
+
+/*
+    Same search as the serial versions below, but the candidate subsets
+    are tried in batches, each batch in parallel. The results of a batch
+    are examined in order and the batch is discarded after the first
+    factor found, so that the factors and their order are the same as
+    with one thread.
+*/
+static void _fmpz_poly_factor_zassenhaus_recombination_threaded(
+    fmpz_poly_factor_t final_fac,
+    const fmpz_poly_factor_t lifted_fac,
+    const fmpz_poly_t F,
+    const fmpz_t P,
+    slong exp,
+    const zassenhaus_prune_struct * Z,
+    thread_pool_handle * threads,
+    slong num_threads)
+{
+    const slong r = lifted_fac->num;
+    const slong batch = 4*(num_threads + 1);
+    slong * subset, * subsets;
+    slong i, c, k, len, nb, total, index;
+    int more, * divides;
+    fmpz_poly_t Fcopy;
+    fmpz_poly_struct * tryme, * Q;
+    fmpz_poly_struct * f;
+    _recombination_arg_t * args;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    subset = (slong *) flint_malloc(r*sizeof(slong));
+    for (k = 0; k < r; k++)
+        subset[k] = k;
+
+    subsets = (slong *) flint_malloc(batch*r*sizeof(slong));
+    divides = (int *) flint_malloc(batch*sizeof(int));
+
+    tryme = (fmpz_poly_struct *) flint_malloc(2*batch*sizeof(fmpz_poly_struct));
+    Q = tryme + batch;
+    for (i = 0; i < 2*batch; i++)
+        fmpz_poly_init(tryme + i);
+
+    args = (_recombination_arg_t *) flint_malloc((num_threads + 1)*
+                                                sizeof(_recombination_arg_t));
+
+    fmpz_poly_init(Fcopy);
+
+    f = (fmpz_poly_struct *) F;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    len = r;
+    for (k = 1; k <= len/2; k++)
+    {
+        zassenhaus_subset_first(subset, len, k);
+        more = 1;
+
+        while (more)
+        {
+            /* subset is always the next candidate not yet tried */
+            nb = 0;
+            while (more && nb < batch)
+            {
+                total = 0;
+                if (Z != NULL)
+                {
+                    for (i = 0; i < len; i++)
+                        if (subset[i] >= 0)
+                            total += fmpz_poly_degree(lifted_fac->p + subset[i]);
+                }
+
+                if (Z == NULL || zassenhaus_prune_degree_is_possible(Z, total))
+                {
+                    for (i = 0; i < len; i++)
+                        subsets[nb*len + i] = subset[i];
+                    nb++;
+                }
+
+                more = zassenhaus_subset_next(subset, len);
+            }
+
+            if (nb == 0)
+                break;
+
+            index = 0;
+            for (i = 0; i <= num_threads; i++)
+            {
+                args[i].tryme = tryme;
+                args[i].Q = Q;
+                args[i].divides = divides;
+                args[i].subsets = subsets;
+                args[i].len = len;
+                args[i].fac = lifted_fac->p;
+                args[i].f = f;
+                args[i].P = P;
+                args[i].num = nb;
+                args[i].index = &index;
+#if FLINT_USES_PTHREAD
+                args[i].mutex = &mutex;
+#endif
+            }
+
+            for (i = 0; i < num_threads && i < nb - 1; i++)
+                thread_pool_wake(global_thread_pool, threads[i], 0,
+                                              _recombination_worker, &args[i]);
+
+            _recombination_worker(&args[num_threads]);
+
+            for (i = 0; i < num_threads && i < nb - 1; i++)
+                thread_pool_wait(global_thread_pool, threads[i]);
+
+            for (c = 0; c < nb; c++)
+            {
+                if (!divides[c])
+                    continue;
+
+                fmpz_poly_factor_insert(final_fac, tryme + c, exp);
+                f = Fcopy;  /* make sure f is writeable */
+                fmpz_poly_swap(f, Q + c);
+
+                for (i = 0; i < len; i++)
+                    subset[i] = subsets[c*len + i];
+                len -= k;
+                more = zassenhaus_subset_next_disjoint(subset, len + k);
+                break;
+            }
+        }
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    if (fmpz_poly_degree(f) > 0)
+    {
+        fmpz_poly_factor_insert(final_fac, f, exp);
+    }
+    else
+    {
+        FLINT_ASSERT(fmpz_poly_is_one(f));
+    }
+
+    fmpz_poly_clear(Fcopy);
+
+    for (i = 0; i < 2*batch; i++)
+        fmpz_poly_clear(tryme + i);
+    flint_free(tryme);
+
+    flint_free(args);
+    flint_free(divides);
+    flint_free(subsets);
+    flint_free(subset);
+}
+
 void fmpz_poly_factor_zassenhaus_recombination(
     fmpz_poly_factor_t final_fac,
 	const fmpz_poly_factor_t lifted_fac,
@@ -93,6 +308,20 @@ void fmpz_poly_factor_zassenhaus_recombination(
     fmpz_poly_struct * tmp;
     fmpz_poly_struct ** stack;
     fmpz_poly_struct * f;
+    thread_pool_handle * threads;
+    slong num_threads;
+
+    num_threads = flint_request_threads(&threads, flint_get_num_threads());
+
+    if (num_threads > 0 && r > 3)
+    {
+        _fmpz_poly_factor_zassenhaus_recombination_threaded(final_fac,
+                             lifted_fac, F, P, exp, NULL, threads, num_threads);
+        flint_give_back_threads(threads, num_threads);
+        return;
+    }
+
+    flint_give_back_threads(threads, num_threads);
 
     subset = (slong *) flint_malloc(r*sizeof(slong));
     for (k = 0; k < r; k++)
@@ -174,6 +403,20 @@ void fmpz_poly_factor_zassenhaus_recombination_with_prune(
     fmpz_poly_struct * tmp;
     fmpz_poly_struct ** stack;
     fmpz_poly_struct * f;
+    thread_pool_handle * threads;
+    slong num_threads;
+
+    num_threads = flint_request_threads(&threads, flint_get_num_threads());
+
+    if (num_threads > 0 && r > 3)
+    {
+        _fmpz_poly_factor_zassenhaus_recombination_threaded(final_fac,
+                             lifted_fac, F, P, exp, Z, threads, num_threads);
+        flint_give_back_threads(threads, num_threads);
+        return;
+    }
+
+    flint_give_back_threads(threads, num_threads);
 
     subset = (slong *) flint_malloc(r*sizeof(slong));
     for (k = 0; k < r; k++)
@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include "flint.h"
 #include "fmpz_poly.h"
+#include "thread_support.h"
 
 #define LONG_FAC_TEST 0 /* run an extra long test */
 #define TEST_HARD 0 /* test hard polynomials */
@@ -102,6 +103,8 @@ main(void)
         slong j, k, n = n_randint(state, 10*FAC_MULT);
         slong facs1 = 0, facs2 = 0;
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         fmpz_init(c);
         fmpz_poly_init(f);
         fmpz_poly_init(g);
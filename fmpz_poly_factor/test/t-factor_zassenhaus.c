@@ -13,6 +13,7 @@
 #include <stdlib.h>
 #include "flint.h"
 #include "fmpz_poly.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -31,6 +32,8 @@ main(void)
         slong j, k, n = n_randint(state, 7) + 1;
         slong facs1 = 0, facs2 = 0;
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         fmpz_init(c);
         fmpz_poly_init(f);
         fmpz_poly_init(g);
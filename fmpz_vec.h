@@ -144,12 +144,30 @@ FLINT_DLL void _fmpz_vec_neg(fmpz * vec1, const fmpz * vec2, slong len2);
 FLINT_DLL void _fmpz_vec_scalar_abs(fmpz * vec1, 
                                                 const fmpz * vec2, slong len2);
 
+FLINT_DLL void _fmpz_vec_set_words(fmpz * vec, slong len);
+
 /*  Comparison  **************************************************************/
 
 FLINT_DLL int _fmpz_vec_equal(const fmpz * vec1, const fmpz * vec2, slong len);
 
 FLINT_DLL int _fmpz_vec_is_zero(const fmpz * vec, slong len);
 
+/* Vector kernels work on blocks of this many entries at a time, taking a
+   fast path on the blocks in which no entry is an mpz. */
+#define FMPZ_VEC_SMALL_BLOCK 64
+
+FMPZ_VEC_INLINE
+int _fmpz_vec_is_small(const fmpz * vec, slong len)
+{
+    slong i;
+    int big = 0;
+
+    for (i = 0; i < len; i++)
+        big |= COEFF_IS_MPZ(vec[i]);
+
+    return !big;
+}
+
 FLINT_DLL void _fmpz_vec_max(fmpz * vec1, const fmpz * vec2, const fmpz * vec3,
                                                                      slong len);
 FLINT_DLL void _fmpz_vec_max_inplace(fmpz * vec1, const fmpz * vec2, slong len);
@@ -16,9 +16,42 @@
 void
 _fmpz_vec_dot(fmpz_t res, const fmpz * vec1, const fmpz * vec2, slong len2)
 {
-    slong i;
+    slong i, j, n;
+    mp_limb_t s0, s1, s2, hi, lo;
+    int small = 0;
 
     fmpz_zero(res);
-    for (i = 0; i < len2; i++)
-        fmpz_addmul(res, vec1 + i, vec2 + i);
+    s0 = s1 = s2 = 0;
+
+    for (i = 0; i < len2; i += n)
+    {
+        n = FLINT_MIN(len2 - i, FMPZ_VEC_SMALL_BLOCK);
+
+        if (_fmpz_vec_is_small(vec1 + i, n) && _fmpz_vec_is_small(vec2 + i, n))
+        {
+            /* the products have at most 2*FLINT_BITS - 3 bits */
+            for (j = i; j < i + n; j++)
+            {
+                smul_ppmm(hi, lo, vec1[j], vec2[j]);
+                add_sssaaaaaa(s2, s1, s0, s2, s1, s0,
+                                                  FLINT_SIGN_EXT(hi), hi, lo);
+            }
+
+            small = 1;
+        }
+        else
+        {
+            for (j = i; j < i + n; j++)
+                fmpz_addmul(res, vec1 + j, vec2 + j);
+        }
+    }
+
+    if (small)
+    {
+        fmpz_t t;
+        fmpz_init(t);
+        fmpz_set_signed_uiuiui(t, s2, s1, s0);
+        fmpz_add(res, res, t);
+        fmpz_clear(t);
+    }
 }
@@ -17,34 +17,42 @@
 slong
 _fmpz_vec_max_bits(const fmpz * vec, slong len)
 {
-    slong i, sign, max_limbs;
-    mp_limb_t max_limb;
+    slong i, j, n, sign, max_limbs;
+    mp_limb_t max_limb, mask, neg;
     mp_size_t limbs;
+    int big;
 
     sign = 1;
     max_limb = 0;
+    neg = 0;
 
-    for (i = 0; i < len; i++)
+    /* branch free on the blocks in which no entry is an mpz */
+    for (i = 0; i < len; i += n)
     {
-        fmpz c = vec[i];
+        n = FLINT_MIN(len - i, FMPZ_VEC_SMALL_BLOCK);
 
-        if (c >= 0)
-        {
-            if (c > COEFF_MAX)
-                goto bignum;
-            max_limb |= c;
-        }
-        else
+        big = 0;
+        mask = 0;
+        for (j = i; j < i + n; j++)
         {
-            if (c < COEFF_MIN)
-                goto bignum;
-            max_limb |= -c;
-            sign = -1;
+            big |= COEFF_IS_MPZ(vec[j]);
+            mask |= FLINT_ABS(vec[j]);
+            neg |= vec[j];
         }
+
+        if (big)
+            break;
+
+        max_limb |= mask;
     }
-    return sign * FLINT_BIT_COUNT(max_limb);
 
-bignum:
+    if ((slong) neg < 0)
+        sign = -1;
+
+    if (i >= len)
+        return sign * FLINT_BIT_COUNT(max_limb);
+
+    /* the small entries of the block are dominated by the mpz */
     max_limbs = 1;
 
     for ( ; i < len; i++)
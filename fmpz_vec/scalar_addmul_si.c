@@ -17,12 +17,41 @@
 void
 _fmpz_vec_scalar_addmul_si(fmpz * vec1, const fmpz * vec2, slong len2, slong c)
 {
-    slong i;
-
-    if (c >= 0)
-        for (i = 0; i < len2; i++)
-            fmpz_addmul_ui(vec1 + i, vec2 + i, c);
-    else
-        for (i = 0; i < len2; i++)
-            fmpz_submul_ui(vec1 + i, vec2 + i, -c);
+    slong i, j, n;
+    flint_bitcnt_t cbits = FLINT_BIT_COUNT(FLINT_ABS(c));
+    ulong mask;
+    int big;
+
+    for (i = 0; i < len2; i += n)
+    {
+        n = FLINT_MIN(len2 - i, FMPZ_VEC_SMALL_BLOCK);
+
+        mask = 0;
+        big = 0;
+        for (j = i; j < i + n; j++)
+        {
+            big |= COEFF_IS_MPZ(vec1[j]) | COEFF_IS_MPZ(vec2[j]);
+            mask |= FLINT_ABS(vec2[j]);
+        }
+
+        /* the products are less than 2^(FLINT_BITS - 2) in absolute value,
+           so adding them to small entries cannot overflow a word */
+        if (!big && FLINT_BIT_COUNT(mask) + cbits <= FLINT_BITS - 2)
+        {
+            for (j = i; j < i + n; j++)
+                vec1[j] += vec2[j] * c;
+
+            _fmpz_vec_set_words(vec1 + i, n);
+        }
+        else if (c >= 0)
+        {
+            for (j = i; j < i + n; j++)
+                fmpz_addmul_ui(vec1 + j, vec2 + j, c);
+        }
+        else
+        {
+            for (j = i; j < i + n; j++)
+                fmpz_submul_ui(vec1 + j, vec2 + j, -c);
+        }
+    }
 }
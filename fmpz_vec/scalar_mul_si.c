@@ -17,7 +17,36 @@
 void
 _fmpz_vec_scalar_mul_si(fmpz * vec1, const fmpz * vec2, slong len2, slong c)
 {
-    slong i;
-    for (i = 0; i < len2; i++)
-        fmpz_mul_si(vec1 + i, vec2 + i, c);
+    slong i, j, n;
+    flint_bitcnt_t cbits = FLINT_BIT_COUNT(FLINT_ABS(c));
+    ulong mask;
+    int big;
+
+    for (i = 0; i < len2; i += n)
+    {
+        n = FLINT_MIN(len2 - i, FMPZ_VEC_SMALL_BLOCK);
+
+        mask = 0;
+        big = 0;
+        for (j = i; j < i + n; j++)
+        {
+            big |= COEFF_IS_MPZ(vec2[j]);
+            mask |= FLINT_ABS(vec2[j]);
+        }
+
+        /* the products fit in a word if the block is small enough */
+        if (!big && FLINT_BIT_COUNT(mask) + cbits <= FLINT_BITS - 1 &&
+            _fmpz_vec_is_small(vec1 + i, n))
+        {
+            for (j = i; j < i + n; j++)
+                vec1[j] = vec2[j] * c;
+
+            _fmpz_vec_set_words(vec1 + i, n);
+        }
+        else
+        {
+            for (j = i; j < i + n; j++)
+                fmpz_mul_si(vec1 + j, vec2 + j, c);
+        }
+    }
 }
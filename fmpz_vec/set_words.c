@@ -0,0 +1,38 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+void
+_fmpz_vec_set_words(fmpz * vec, slong len)
+{
+    slong i, c;
+    int over = 0;
+
+    for (i = 0; i < len; i++)
+        over |= ((ulong) vec[i] - (ulong) COEFF_MIN >
+                                            (ulong) (COEFF_MAX - COEFF_MIN));
+
+    if (!over)
+        return;
+
+    for (i = 0; i < len; i++)
+    {
+        c = vec[i];
+
+        if (c < COEFF_MIN || c > COEFF_MAX)
+        {
+            vec[i] = WORD(0);
+            fmpz_set_si(vec + i, c);
+        }
+    }
+}
@@ -17,7 +17,25 @@
 void
 _fmpz_vec_sub(fmpz * res, const fmpz * vec1, const fmpz * vec2, slong len2)
 {
-    slong i;
-    for (i = 0; i < len2; i++)
-        fmpz_sub(res + i, vec1 + i, vec2 + i);
+    slong i, j, n;
+
+    for (i = 0; i < len2; i += n)
+    {
+        n = FLINT_MIN(len2 - i, FMPZ_VEC_SMALL_BLOCK);
+
+        if (_fmpz_vec_is_small(vec1 + i, n) &&
+            _fmpz_vec_is_small(vec2 + i, n) && _fmpz_vec_is_small(res + i, n))
+        {
+            /* cannot overflow a word, out of range entries are fixed up */
+            for (j = i; j < i + n; j++)
+                res[j] = vec1[j] - vec2[j];
+
+            _fmpz_vec_set_words(res + i, n);
+        }
+        else
+        {
+            for (j = i; j < i + n; j++)
+                fmpz_sub(res + j, vec1 + j, vec2 + j);
+        }
+    }
 }
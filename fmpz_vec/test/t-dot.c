@@ -89,6 +89,41 @@ main(void)
         fmpz_clear(res2);
     }
 
+    /* Compare with fmpz_addmul on vectors of mostly small entries */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        fmpz *a, *b;
+        fmpz_t res1, res2;
+        slong j, len = n_randint(state, 300);
+
+        a = _fmpz_vec_init(len);
+        b = _fmpz_vec_init(len);
+        fmpz_init(res1);
+        fmpz_init(res2);
+        _fmpz_vec_randtest(a, state, len, FLINT_BITS - 2);
+        _fmpz_vec_randtest(b, state, len, FLINT_BITS - 2);
+        if (len > 0 && n_randint(state, 4) == 0)
+            fmpz_randtest(a + n_randint(state, len), state, 200);
+
+        _fmpz_vec_dot(res1, a, b, len);
+        for (j = 0; j < len; j++)
+            fmpz_addmul(res2, a + j, b + j);
+
+        result = fmpz_equal(res1, res2);
+        if (!result)
+        {
+            flint_printf("FAIL (small entries):\n");
+            fmpz_print(res1), flint_printf("\n\n");
+            fmpz_print(res2), flint_printf("\n\n");
+            abort();
+        }
+
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(b, len);
+        fmpz_clear(res1);
+        fmpz_clear(res2);
+    }
+
     FLINT_TEST_CLEANUP(state);
 
     flint_printf("PASS\n");
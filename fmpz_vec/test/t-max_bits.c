@@ -53,6 +53,33 @@ main(void)
         _fmpz_vec_clear(a, len);
     }
 
+    /* Check long vectors with an occasional mpz */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        fmpz *a;
+        slong len, bits2, bits3;
+
+        len = n_randint(state, 300);
+
+        a = _fmpz_vec_init(len);
+        _fmpz_vec_randtest(a, state, len, n_randint(state, FLINT_BITS - 1));
+        if (len > 0 && n_randint(state, 2) == 0)
+            fmpz_randtest(a + n_randint(state, len), state, 200);
+
+        bits2 = _fmpz_vec_max_bits(a, len);
+        bits3 = _fmpz_vec_max_bits_ref(a, len);
+
+        result = (bits2 == bits3);
+        if (!result)
+        {
+            flint_printf("FAIL (long vectors):\n");
+            flint_printf("bits2 = %wd bits3 = %wd\n", bits2, bits3);
+            abort();
+        }
+
+        _fmpz_vec_clear(a, len);
+    }
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
@@ -69,6 +69,48 @@ main(void)
         _fmpz_vec_clear(d, len);
     }
 
+    /* Compare with fmpz_mul_si and fmpz_add on mostly small entries */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        fmpz *a, *b, *c;
+        fmpz_t t;
+        slong j, len = n_randint(state, 300);
+        slong n = z_randtest(state);
+
+        a = _fmpz_vec_init(len);
+        b = _fmpz_vec_init(len);
+        c = _fmpz_vec_init(len);
+        fmpz_init(t);
+        _fmpz_vec_randtest(a, state, len, n_randint(state, FLINT_BITS - 1));
+        _fmpz_vec_randtest(b, state, len, FLINT_BITS - 2);
+        if (len > 0 && n_randint(state, 4) == 0)
+            fmpz_randtest(a + n_randint(state, len), state, 200);
+        if (len > 0 && n_randint(state, 4) == 0)
+            fmpz_randtest(b + n_randint(state, len), state, 200);
+        _fmpz_vec_set(c, b, len);
+
+        _fmpz_vec_scalar_addmul_si(b, a, len, n);
+        for (j = 0; j < len; j++)
+        {
+            fmpz_mul_si(t, a + j, n);
+            fmpz_add(c + j, c + j, t);
+        }
+
+        result = (_fmpz_vec_equal(b, c, len));
+        if (!result)
+        {
+            flint_printf("FAIL (small entries):\n");
+            _fmpz_vec_print(b, len), flint_printf("\n\n");
+            _fmpz_vec_print(c, len), flint_printf("\n\n");
+            abort();
+        }
+
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(b, len);
+        _fmpz_vec_clear(c, len);
+        fmpz_clear(t);
+    }
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
@@ -0,0 +1,71 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "ulong_extras.h"
+#include "long_extras.h"
+
+int
+main(void)
+{
+    int i, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("set_words....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        fmpz *a, *b;
+        slong j, len = n_randint(state, 100);
+        slong * w;
+
+        a = _fmpz_vec_init(len);
+        b = _fmpz_vec_init(len);
+        w = flint_malloc(len*sizeof(slong));
+
+        for (j = 0; j < len; j++)
+        {
+            w[j] = z_randtest(state);
+            if (n_randint(state, 2))
+                w[j] >>= 2;
+        }
+
+        for (j = 0; j < len; j++)
+        {
+            a[j] = w[j];
+            fmpz_set_si(b + j, w[j]);
+        }
+
+        _fmpz_vec_set_words(a, len);
+
+        result = (_fmpz_vec_equal(a, b, len));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            _fmpz_vec_print(a, len), flint_printf("\n\n");
+            _fmpz_vec_print(b, len), flint_printf("\n\n");
+            abort();
+        }
+
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(b, len);
+        flint_free(w);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
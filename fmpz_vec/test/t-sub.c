@@ -117,6 +117,41 @@ main(void)
         _fmpz_vec_clear(d, len);
     }
 
+    /* Compare with fmpz_sub on vectors of mostly small entries */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        fmpz *a, *b, *c, *d;
+        slong j, len = n_randint(state, 300);
+
+        a = _fmpz_vec_init(len);
+        b = _fmpz_vec_init(len);
+        c = _fmpz_vec_init(len);
+        d = _fmpz_vec_init(len);
+        _fmpz_vec_randtest(a, state, len, FLINT_BITS - 2);
+        _fmpz_vec_randtest(b, state, len, FLINT_BITS - 2);
+        if (len > 0 && n_randint(state, 4) == 0)
+            fmpz_randtest(a + n_randint(state, len), state, 200);
+        if (n_randint(state, 4) == 0)
+            _fmpz_vec_randtest(c, state, len, 200);
+
+        _fmpz_vec_sub(c, a, b, len);
+        for (j = 0; j < len; j++)
+            fmpz_sub(d + j, a + j, b + j);
+
+        result = (_fmpz_vec_equal(c, d, len));
+        if (!result)
+        {
+            flint_printf("FAIL (small entries):\n");
+            _fmpz_vec_print(c, len), flint_printf("\n\n");
+            _fmpz_vec_print(d, len), flint_printf("\n\n");
+            abort();
+        }
+
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(b, len);
+        _fmpz_vec_clear(c, len);
+        _fmpz_vec_clear(d, len);
+    }
 
     FLINT_TEST_CLEANUP(state);
     
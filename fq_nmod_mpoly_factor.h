@@ -423,12 +423,14 @@ typedef struct {
     fq_nmod_mpoly_struct * xalpha;
     fq_nmod_mpoly_struct * q;
     fq_nmod_mpoly_geobucket_struct * G;
-    fq_nmod_mpoly_struct * qt;
     fq_nmod_mpoly_struct * newt;
     fq_nmod_mpolyv_struct * delta_coeffs;
     fq_nmod_mpoly_t T;
     fq_nmod_mpoly_t Q;
     fq_nmod_mpoly_t R;
+    fq_nmod_mpoly_struct * prods;
+    const fq_nmod_mpoly_struct ** prod_ops;
+    slong prods_alloc;
 } fq_nmod_mpoly_pfrac_struct;
 
 typedef fq_nmod_mpoly_pfrac_struct fq_nmod_mpoly_pfrac_t[1];
@@ -453,6 +455,22 @@ FLINT_DLL int fq_nmod_mpoly_pfrac(
     fq_nmod_mpoly_pfrac_t I,
     const fq_nmod_mpoly_ctx_t ctx);
 
+FLINT_DLL void _fq_nmod_mpoly_vec_mul_threaded_pool(
+    fq_nmod_mpoly_struct * A,
+    const fq_nmod_mpoly_struct * const * B,
+    const fq_nmod_mpoly_struct * const * C,
+    slong n,
+    const fq_nmod_mpoly_ctx_t ctx,
+    const thread_pool_handle * handles,
+    slong num_handles);
+
+FLINT_DLL void _fq_nmod_mpoly_vec_mul_threaded(
+    fq_nmod_mpoly_struct * A,
+    const fq_nmod_mpoly_struct * const * B,
+    const fq_nmod_mpoly_struct * const * C,
+    slong n,
+    const fq_nmod_mpoly_ctx_t ctx);
+
 FLINT_DLL int fq_nmod_mpoly_hlift(
     slong m,
     fq_nmod_mpoly_struct * f, /* length r */
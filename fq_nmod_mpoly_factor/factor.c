@@ -11,6 +11,7 @@
 
 #include "fq_nmod_mpoly_factor.h"
 #include "long_extras.h"
+#include "thread_pool.h"
 
 
 static slong _deflate(
@@ -652,6 +653,131 @@ cleanup:
     return 1;
 }
 
+static int _factor_irred(fq_nmod_mpolyv_t Af, fq_nmod_mpoly_t A,
+                          const fq_nmod_mpoly_ctx_t Actx, unsigned int algo);
+
+typedef struct
+{
+    fq_nmod_mpolyv_struct * v;
+    fq_nmod_mpoly_struct * polys;
+    int * success;
+    slong num;
+    const fq_nmod_mpoly_ctx_struct * ctx;
+    unsigned int algo;
+    volatile slong * index;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_factor_irred_arg_struct;
+
+static void _factor_irred_worker(void * varg)
+{
+    _factor_irred_arg_struct * arg = (_factor_irred_arg_struct *) varg;
+    slong i;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        i = *arg->index;
+        *arg->index = i + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (i >= arg->num)
+            return;
+
+        arg->success[i] = _factor_irred(arg->v + i, arg->polys + i,
+                                                         arg->ctx, arg->algo);
+    }
+}
+
+/*
+    v[i] = factorization of polys[i] as in _factor_irred for 0 <= i < num.
+    The factorizations are independent and are shared among the threads.
+*/
+static int _factor_irred_vec(
+    fq_nmod_mpolyv_struct * v,
+    fq_nmod_mpoly_struct * polys,
+    slong num,
+    const fq_nmod_mpoly_ctx_t ctx,
+    unsigned int algo)
+{
+    int success;
+    int * succ;
+    slong i, index, num_handles;
+    thread_pool_handle * handles;
+    _factor_irred_arg_struct * args;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    num_handles = flint_request_threads(&handles, num);
+
+    if (num_handles < 1)
+    {
+        flint_give_back_threads(handles, num_handles);
+
+        for (i = 0; i < num; i++)
+        {
+            if (!_factor_irred(v + i, polys + i, ctx, algo))
+                return 0;
+        }
+
+        return 1;
+    }
+
+    succ = FLINT_ARRAY_ALLOC(num, int);
+    args = FLINT_ARRAY_ALLOC(num_handles + 1, _factor_irred_arg_struct);
+
+    index = 0;
+    for (i = 0; i <= num_handles; i++)
+    {
+        args[i].v = v;
+        args[i].polys = polys;
+        args[i].success = succ;
+        args[i].num = num;
+        args[i].ctx = ctx;
+        args[i].algo = algo;
+        args[i].index = &index;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                              _factor_irred_worker, &args[i]);
+
+    _factor_irred_worker(&args[num_handles]);
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    flint_give_back_threads(handles, num_handles);
+
+    success = 1;
+    for (i = 0; i < num; i++)
+        success = success && succ[i];
+
+    flint_free(args);
+    flint_free(succ);
+
+    return success;
+}
+
+
 /*
     A is sep.
 
@@ -714,12 +840,11 @@ static int _factor_irred(
     else
     {
         fq_nmod_mpoly_ctx_t Lctx;
-        fq_nmod_mpolyv_t Lf, Lft, Lfs;
+        fq_nmod_mpolyv_t Lf, Lft;
 
         fq_nmod_mpoly_ctx_init(Lctx, M->mvars, ORD_LEX, Actx->fqctx);
         fq_nmod_mpolyv_init(Lf, Lctx);
         fq_nmod_mpolyv_init(Lft, Lctx);
-        fq_nmod_mpolyv_init(Lfs, Lctx);
 
         fq_nmod_mpolyv_fit_length(Lft, 1, Lctx);
         Lft->length = 1;
@@ -733,21 +858,32 @@ static int _factor_irred(
         }
         else
         {
-            success = 1;
+            fq_nmod_mpolyv_struct * Lfv;
+
+            Lfv = FLINT_ARRAY_ALLOC(Lft->length, fq_nmod_mpolyv_struct);
+            for (i = 0; i < Lft->length; i++)
+                fq_nmod_mpolyv_init(Lfv + i, Lctx);
+
+            success = _factor_irred_vec(Lfv, Lft->coeffs, Lft->length,
+                                                                  Lctx, algo);
             Lf->length = 0;
             for (i = 0; i < Lft->length; i++)
             {
-                success = _factor_irred(Lfs, Lft->coeffs + i, Lctx, algo);
-                if (!success)
-                    break;
-
-                fq_nmod_mpolyv_fit_length(Lf, Lf->length + Lfs->length, Lctx);
-                for (j = 0; j < Lfs->length; j++)
+                if (success)
                 {
-                    fq_nmod_mpoly_swap(Lf->coeffs + Lf->length, Lfs->coeffs + j, Lctx);
-                    Lf->length++;
+                    fq_nmod_mpolyv_fit_length(Lf, Lf->length + Lfv[i].length, Lctx);
+                    for (j = 0; j < Lfv[i].length; j++)
+                    {
+                        fq_nmod_mpoly_swap(Lf->coeffs + Lf->length,
+                                                      Lfv[i].coeffs + j, Lctx);
+                        Lf->length++;
+                    }
                 }
+
+                fq_nmod_mpolyv_clear(Lfv + i, Lctx);
             }
+
+            flint_free(Lfv);
         }
 
         if (success)
@@ -763,7 +899,6 @@ static int _factor_irred(
 
         fq_nmod_mpolyv_clear(Lf, Lctx);
         fq_nmod_mpolyv_clear(Lft, Lctx);
-        fq_nmod_mpolyv_clear(Lfs, Lctx);
         fq_nmod_mpoly_ctx_clear(Lctx);
     }
 
@@ -800,36 +935,38 @@ int fq_nmod_mpoly_factor_irred(
     unsigned int algo)
 {
     int success;
-    slong i, j;
-    fq_nmod_mpolyv_t t;
+    slong i, j, n = f->num;
+    fq_nmod_mpolyv_struct * t;
     fq_nmod_mpoly_factor_t g;
 
-    fq_nmod_mpolyv_init(t, ctx);
+    t = FLINT_ARRAY_ALLOC(n, fq_nmod_mpolyv_struct);
+    for (j = 0; j < n; j++)
+        fq_nmod_mpolyv_init(t + j, ctx);
     fq_nmod_mpoly_factor_init(g, ctx);
 
+    success = _factor_irred_vec(t, f->poly, n, ctx, algo);
+    if (!success)
+        goto cleanup;
+
     fq_nmod_set(g->constant, f->constant, ctx->fqctx);
     g->num = 0;
-    for (j = 0; j < f->num; j++)
+    for (j = 0; j < n; j++)
     {
-        success = _factor_irred(t, f->poly + j, ctx, algo);
-        if (!success)
-            goto cleanup;
-
-        fq_nmod_mpoly_factor_fit_length(g, g->num + t->length, ctx);
-        for (i = 0; i < t->length; i++)
+        fq_nmod_mpoly_factor_fit_length(g, g->num + t[j].length, ctx);
+        for (i = 0; i < t[j].length; i++)
         {
             fmpz_set(g->exp + g->num, f->exp + j);
-            fq_nmod_mpoly_swap(g->poly + g->num, t->coeffs + i, ctx);
+            fq_nmod_mpoly_swap(g->poly + g->num, t[j].coeffs + i, ctx);
             g->num++;
         }
     }
     fq_nmod_mpoly_factor_swap(f, g, ctx);
 
-    success = 1;
-
 cleanup:
 
-    fq_nmod_mpolyv_clear(t, ctx);
+    for (j = 0; j < n; j++)
+        fq_nmod_mpolyv_clear(t + j, ctx);
+    flint_free(t);
     fq_nmod_mpoly_factor_clear(g, ctx);
 
     return success;
@@ -850,35 +987,47 @@ static int _compressed_content_to_irred(
     int success;
     slong j, k;
     fq_nmod_mpoly_factor_t h;
-    fq_nmod_mpolyv_t v;
+    fq_nmod_mpolyv_struct * v = NULL;
 
     fq_nmod_mpoly_factor_init(h, ctx);
-    fq_nmod_mpolyv_init(v, ctx);
 
     success = _fq_nmod_mpoly_factor_separable(h, f, ctx, 1);
     if (!success)
         goto cleanup;
 
+    v = FLINT_ARRAY_ALLOC(h->num, fq_nmod_mpolyv_struct);
     for (j = 0; j < h->num; j++)
-    {
-        success = h->num > 1 ? _factor_irred(v, h->poly + j, ctx, algo) :
-                           _factor_irred_compressed(v, h->poly + j, ctx, algo);
-        if (!success)
-            goto cleanup;
+        fq_nmod_mpolyv_init(v + j, ctx);
+
+    /* the separable factors are independent */
+    if (h->num == 1)
+        success = _factor_irred_compressed(v + 0, h->poly + 0, ctx, algo);
+    else
+        success = _factor_irred_vec(v, h->poly, h->num, ctx, algo);
+    if (!success)
+        goto cleanup;
 
-        fq_nmod_mpoly_factor_fit_length(g, g->num + v->length, ctx);
-        for (k = 0; k < v->length; k++)
+    for (j = 0; j < h->num; j++)
+    {
+        fq_nmod_mpoly_factor_fit_length(g, g->num + v[j].length, ctx);
+        for (k = 0; k < v[j].length; k++)
         {
             fmpz_mul(g->exp + g->num, h->exp + j, e);
-            fq_nmod_mpoly_swap(g->poly + g->num, v->coeffs + k, ctx);
+            fq_nmod_mpoly_swap(g->poly + g->num, v[j].coeffs + k, ctx);
             g->num++;
         }
     }
 
 cleanup:
 
+    if (v != NULL)
+    {
+        for (j = 0; j < h->num; j++)
+            fq_nmod_mpolyv_clear(v + j, ctx);
+        flint_free(v);
+    }
+
     fq_nmod_mpoly_factor_clear(h, ctx);
-    fq_nmod_mpolyv_clear(v, ctx);
 
     return success;
 }
@@ -11,6 +11,7 @@
 
 #include "nmod_mpoly_factor.h"
 #include "fq_nmod_mpoly_factor.h"
+#include "thread_pool.h"
 
 
 static void _sort_and_delete_duplicates(
@@ -1012,7 +1013,87 @@ static int fq_nmod_mpoly_from_zipp(
     return 1;
 }
 
-/* bit counts of all degrees should be < FLINT_BITS/3 */
+typedef struct
+{
+    slong r;
+    n_polyun_struct * BBeval;
+    n_polyu_struct * Aeval;
+    n_polyu_struct * Beval;
+    const fq_nmod_struct * alpha;
+    slong degs0;
+    const fq_nmod_ctx_struct * fqctx;
+    n_poly_bpoly_stack_struct * St;
+    int success;
+}
+_zip_image_arg_struct;
+
+/* lift one zip image */
+static void _zip_image_worker(void * varg)
+{
+    _zip_image_arg_struct * arg = (_zip_image_arg_struct *) varg;
+
+    arg->success = n_fq_polyu3_hlift(arg->r, arg->BBeval, arg->Aeval,
+                     arg->Beval, arg->alpha, arg->degs0, arg->fqctx, arg->St);
+}
+
+
+typedef struct
+{
+    fq_nmod_mpoly_struct * B;
+    const n_polyun_struct * Z;
+    fq_nmod_mpolyu_struct * H;
+    const ulong * Bdegs;
+    slong r;
+    slong yvar;
+    int betas_in_fp;
+    const fq_nmod_mpoly_ctx_struct * ctx;
+    n_polyun_struct * M;
+    n_poly_bpoly_stack_struct * St;
+    int * success;
+    volatile slong * index;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_from_zip_arg_struct;
+
+/* recover the factors from their zip images, each with its own temps */
+static void _from_zip_worker(void * varg)
+{
+    _from_zip_arg_struct * arg = (_from_zip_arg_struct *) varg;
+    slong i;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        i = *arg->index;
+        *arg->index = i + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (i >= arg->r)
+            return;
+
+        arg->success[i] = arg->betas_in_fp ?
+            fq_nmod_mpoly_from_zipp(arg->B + i, arg->Z + i, arg->H + i,
+                             arg->Bdegs[i], arg->yvar, arg->ctx, arg->M) :
+            fq_nmod_mpoly_from_zip(arg->B + i, arg->Z + i, arg->H + i,
+                             arg->Bdegs[i], arg->yvar, arg->ctx, arg->M,
+                                                       arg->St->poly_stack);
+    }
+}
+
+
+/*
+    bit counts of all degrees should be < FLINT_BITS/3
+
+    As in nmod_mpoly_hlift_zippel, the zip images are evaluated in batches of
+    one per thread and added in order, and threads are only held while a
+    batch is lifted or the factors are recovered.
+*/
 int fq_nmod_mpoly_hlift_zippel(
     slong m,
     fq_nmod_mpoly_struct * B,
@@ -1024,19 +1105,27 @@ int fq_nmod_mpoly_hlift_zippel(
     flint_rand_t state)
 {
     int success, betas_in_fp;
-    slong i;
+    slong i, s;
     slong zip_fails_remaining;
     slong req_zip_images, cur_zip_image;
+    slong num_slots, num_handles, index;
     fq_nmod_mpolyu_struct * H;
-    n_polyun_struct M[1], Aeh[1], * Beh, * BBeval, * Z;
-    n_polyu_struct Aeval[1], * Beval;
+    n_polyun_struct * M, Aeh[1], * Beh, * BBeval, * Z;
+    n_polyu_struct * Aeval, * Beval;
     fq_nmod_struct * beta;
     n_poly_struct * caches;
     flint_bitcnt_t bits = A->bits;
     fq_nmod_mpoly_t T1, T2;
-    n_poly_bpoly_stack_t St;
+    n_poly_bpoly_stack_struct * St;
     ulong * Bdegs;
+    int * zip_success;
+    thread_pool_handle * handles;
+    _zip_image_arg_struct * image_args;
+    _from_zip_arg_struct * zip_args;
     const slong degs0 = degs[0];
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
 
     FLINT_ASSERT(m > 2);
     FLINT_ASSERT(r > 1);
@@ -1071,9 +1160,6 @@ int fq_nmod_mpoly_hlift_zippel(
     }
 #endif
 
-    n_poly_stack_init(St->poly_stack);
-    n_bpoly_stack_init(St->bpoly_stack);
-
     beta = FLINT_ARRAY_ALLOC(ctx->minfo->nvars, fq_nmod_struct);
     for (i = 0; i < ctx->minfo->nvars; i++)
         fq_nmod_init(beta + i, ctx->fqctx);
@@ -1083,23 +1169,42 @@ int fq_nmod_mpoly_hlift_zippel(
     for (i = 0; i < 3*ctx->minfo->nvars; i++)
         n_poly_init(caches + i);
 
+    /* at most this many images are lifted at once */
+    num_slots = flint_get_num_threads();
+
     Bdegs = FLINT_ARRAY_ALLOC(r, ulong);
     H = FLINT_ARRAY_ALLOC(r, fq_nmod_mpolyu_struct);
     Beh = FLINT_ARRAY_ALLOC(r, n_polyun_struct);
-    Beval = FLINT_ARRAY_ALLOC(r, n_polyu_struct);
-    BBeval = FLINT_ARRAY_ALLOC(r, n_polyun_struct);
     Z = FLINT_ARRAY_ALLOC(r, n_polyun_struct);
+    zip_success = FLINT_ARRAY_ALLOC(r, int);
+
+    /* one slot of evaluations and stacks for each thread */
+    St = FLINT_ARRAY_ALLOC(num_slots, n_poly_bpoly_stack_struct);
+    M = FLINT_ARRAY_ALLOC(num_slots, n_polyun_struct);
+    Aeval = FLINT_ARRAY_ALLOC(num_slots, n_polyu_struct);
+    Beval = FLINT_ARRAY_ALLOC(num_slots*r, n_polyu_struct);
+    BBeval = FLINT_ARRAY_ALLOC(num_slots*r, n_polyun_struct);
+    image_args = FLINT_ARRAY_ALLOC(num_slots, _zip_image_arg_struct);
+    zip_args = FLINT_ARRAY_ALLOC(num_slots, _from_zip_arg_struct);
 
     n_polyun_init(Aeh);
-    n_polyu_init(Aeval);
-    n_polyun_init(M);
+    for (s = 0; s < num_slots; s++)
+    {
+        n_poly_stack_init(St[s].poly_stack);
+        n_bpoly_stack_init(St[s].bpoly_stack);
+        n_polyun_init(M + s);
+        n_polyu_init(Aeval + s);
+    }
     for (i = 0; i < r; i++)
     {
         fq_nmod_mpolyu_init(H + i, bits, ctx);
         n_polyun_init(Beh + i);
+        n_polyun_init(Z + i);
+    }
+    for (i = 0; i < num_slots*r; i++)
+    {
         n_polyu_init(Beval + i);
         n_polyun_init(BBeval + i);
-        n_polyun_init(Z + i);
     }
 
     /* init done */
@@ -1155,24 +1260,53 @@ choose_betas:
         Z[i].length = 0;
     }
 
-    for (cur_zip_image = 0; cur_zip_image < req_zip_images; cur_zip_image++)
+    cur_zip_image = 0;
+
+next_zip_image:
+
+    /* the threads are only held while this batch is lifted */
+    num_handles = flint_request_threads(&handles,
+                          FLINT_MIN(num_slots, req_zip_images - cur_zip_image));
+
+    for (s = 0; s <= num_handles; s++)
     {
         if (betas_in_fp)
         {
-            fq_nmod_polyu_evalp_step(Aeval, Aeh, ctx->fqctx);
+            fq_nmod_polyu_evalp_step(Aeval + s, Aeh, ctx->fqctx);
             for (i = 0; i < r; i++)
-                fq_nmod_polyu_evalp_step(Beval + i, Beh + i, ctx->fqctx);
+                fq_nmod_polyu_evalp_step(Beval + s*r + i, Beh + i, ctx->fqctx);
         }
         else
         {
-            fq_nmod_polyu_eval_step(Aeval, Aeh, ctx->fqctx);
+            fq_nmod_polyu_eval_step(Aeval + s, Aeh, ctx->fqctx);
             for (i = 0; i < r; i++)
-                fq_nmod_polyu_eval_step(Beval + i, Beh + i, ctx->fqctx);
+                fq_nmod_polyu_eval_step(Beval + s*r + i, Beh + i, ctx->fqctx);
         }
 
-        success = n_fq_polyu3_hlift(r, BBeval, Aeval, Beval,
-                                         alpha + m - 1, degs0, ctx->fqctx, St);
-        if (success < 1)
+        image_args[s].r = r;
+        image_args[s].BBeval = BBeval + s*r;
+        image_args[s].Aeval = Aeval + s;
+        image_args[s].Beval = Beval + s*r;
+        image_args[s].alpha = alpha + m - 1;
+        image_args[s].degs0 = degs0;
+        image_args[s].fqctx = ctx->fqctx;
+        image_args[s].St = St + s;
+    }
+
+    for (s = 0; s < num_handles; s++)
+        thread_pool_wake(global_thread_pool, handles[s], 0,
+                                          _zip_image_worker, &image_args[s]);
+
+    _zip_image_worker(&image_args[num_handles]);
+
+    for (s = 0; s < num_handles; s++)
+        thread_pool_wait(global_thread_pool, handles[s]);
+
+    flint_give_back_threads(handles, num_handles);
+
+    for (s = 0; s <= num_handles; s++)
+    {
+        if (image_args[s].success < 1)
         {
             if (--zip_fails_remaining >= 0)
                 goto choose_betas;
@@ -1183,19 +1317,60 @@ choose_betas:
 
         for (i = 0; i < r; i++)
         {
-            fq_nmod_polyu3_add_zip_limit1(Z + i, BBeval + i, Bdegs[i],
+            fq_nmod_polyu3_add_zip_limit1(Z + i, BBeval + s*r + i, Bdegs[i],
                                     cur_zip_image, req_zip_images, ctx->fqctx);
         }
+
+        cur_zip_image++;
     }
 
-    for (i = 0; i < r; i++)
+    if (cur_zip_image < req_zip_images)
+        goto next_zip_image;
+
+    num_handles = flint_request_threads(&handles, FLINT_MIN(num_slots, r));
+
+    index = 0;
+    for (s = 0; s <= num_handles; s++)
     {
-        success = betas_in_fp ?
-             fq_nmod_mpoly_from_zipp(B + i, Z + i, H + i, Bdegs[i], m, ctx, M) :
-             fq_nmod_mpoly_from_zip(B + i, Z + i, H + i, Bdegs[i], m,
-                                                       ctx, M, St->poly_stack);
+        zip_args[s].B = B;
+        zip_args[s].Z = Z;
+        zip_args[s].H = H;
+        zip_args[s].Bdegs = Bdegs;
+        zip_args[s].r = r;
+        zip_args[s].yvar = m;
+        zip_args[s].betas_in_fp = betas_in_fp;
+        zip_args[s].ctx = ctx;
+        zip_args[s].M = M + s;
+        zip_args[s].St = St + s;
+        zip_args[s].success = zip_success;
+        zip_args[s].index = &index;
+#if FLINT_USES_PTHREAD
+        zip_args[s].mutex = &mutex;
+#endif
+    }
 
-        if (success < 1)
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (s = 0; s < num_handles; s++)
+        thread_pool_wake(global_thread_pool, handles[s], 0,
+                                              _from_zip_worker, &zip_args[s]);
+
+    _from_zip_worker(&zip_args[num_handles]);
+
+    for (s = 0; s < num_handles; s++)
+        thread_pool_wait(global_thread_pool, handles[s]);
+
+    flint_give_back_threads(handles, num_handles);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    for (i = 0; i < r; i++)
+    {
+        if (zip_success[i] < 1)
         {
             success = 0;
             goto cleanup;
@@ -1219,15 +1394,23 @@ choose_betas:
 cleanup:
 
     n_polyun_clear(Aeh);
-    n_polyu_clear(Aeval);
-    n_polyun_clear(M);
+    for (s = 0; s < num_slots; s++)
+    {
+        n_poly_stack_clear(St[s].poly_stack);
+        n_bpoly_stack_clear(St[s].bpoly_stack);
+        n_polyun_clear(M + s);
+        n_polyu_clear(Aeval + s);
+    }
     for (i = 0; i < r; i++)
     {
         fq_nmod_mpolyu_clear(H + i, ctx);
         n_polyun_clear(Beh + i);
+        n_polyun_clear(Z + i);
+    }
+    for (i = 0; i < num_slots*r; i++)
+    {
         n_polyu_clear(Beval + i);
         n_polyun_clear(BBeval + i);
-        n_polyun_clear(Z + i);
     }
 
     for (i = 0; i < ctx->minfo->nvars; i++)
@@ -1241,12 +1424,15 @@ cleanup:
     flint_free(Bdegs);
     flint_free(H);
     flint_free(Beh);
+    flint_free(Z);
+    flint_free(zip_success);
+    flint_free(St);
+    flint_free(M);
+    flint_free(Aeval);
     flint_free(Beval);
     flint_free(BBeval);
-    flint_free(Z);
-
-    n_poly_stack_clear(St->poly_stack);
-    n_bpoly_stack_clear(St->bpoly_stack);
+    flint_free(image_args);
+    flint_free(zip_args);
 
     return success;
 }
@@ -25,7 +25,8 @@ static int _hlift_quartic2(
     slong i, j;
     fq_nmod_mpoly_t Aq, t, t2, t3, xalpha;
     fq_nmod_mpoly_geobucket_t G;
-    fq_nmod_mpoly_struct betas[2], * deltas;
+    fq_nmod_mpoly_struct betas[2], * deltas, * T;
+    const fq_nmod_mpoly_struct ** Tops;
     fq_nmod_mpoly_pfrac_t I;
     fq_nmod_mpolyv_struct B[2];
     slong tdeg;
@@ -34,6 +35,11 @@ static int _hlift_quartic2(
     FLINT_ASSERT(r == 2);
     r = 2;
 
+    T = FLINT_ARRAY_ALLOC(degs[m] + 1, fq_nmod_mpoly_struct);
+    Tops = FLINT_ARRAY_ALLOC(2*(degs[m] + 1), const fq_nmod_mpoly_struct *);
+    for (i = 0; i <= degs[m]; i++)
+        fq_nmod_mpoly_init(T + i, ctx);
+
     fq_nmod_mpoly_init(t, ctx);
     fq_nmod_mpoly_init(t2, ctx);
     fq_nmod_mpoly_init(t3, ctx);
@@ -79,9 +85,13 @@ static int _hlift_quartic2(
 
         for (i = 0; i <= j; i++)
         {
-            fq_nmod_mpoly_mul(t, B[0].coeffs + i, B[1].coeffs + j - i, ctx);
-            fq_nmod_mpoly_geobucket_sub(G, t, ctx);
+            Tops[i] = B[0].coeffs + i;
+            Tops[degs[m] + 1 + i] = B[1].coeffs + j - i;
         }
+        _fq_nmod_mpoly_vec_mul_threaded(T, Tops, Tops + degs[m] + 1,
+                                                                  j + 1, ctx);
+        for (i = 0; i <= j; i++)
+            fq_nmod_mpoly_geobucket_sub(G, T + i, ctx);
         fq_nmod_mpoly_geobucket_empty(t, G, ctx);
 
         if (fq_nmod_mpoly_is_zero(t, ctx))
@@ -125,6 +135,11 @@ cleanup:
         fq_nmod_mpolyv_clear(B + i, ctx);
     }
 
+    for (i = 0; i <= degs[m]; i++)
+        fq_nmod_mpoly_clear(T + i, ctx);
+    flint_free(T);
+    flint_free(Tops);
+
     fq_nmod_mpoly_clear(t, ctx);
     fq_nmod_mpoly_clear(t2, ctx);
     fq_nmod_mpoly_clear(t3, ctx);
@@ -148,7 +163,8 @@ static int _hlift_quartic(
     int success;
     slong i, j, k;
     fq_nmod_mpoly_t Aq, t, t1, t2, t3, xalpha;
-    fq_nmod_mpoly_struct * betas, * deltas;
+    fq_nmod_mpoly_struct * betas, * deltas, * T;
+    const fq_nmod_mpoly_struct ** Tops;
     fq_nmod_mpoly_pfrac_t I;
     fq_nmod_mpolyv_struct * B, * U;
     slong tdeg;
@@ -160,6 +176,11 @@ static int _hlift_quartic(
     B = FLINT_ARRAY_ALLOC(2*r, fq_nmod_mpolyv_struct);
     U = B + r;
 
+    T = FLINT_ARRAY_ALLOC(degs[m] + 1, fq_nmod_mpoly_struct);
+    Tops = FLINT_ARRAY_ALLOC(2*(degs[m] + 1), const fq_nmod_mpoly_struct *);
+    for (i = 0; i <= degs[m]; i++)
+        fq_nmod_mpoly_init(T + i, ctx);
+
     fq_nmod_mpoly_init(t, ctx);
     fq_nmod_mpoly_init(t1, ctx);
     fq_nmod_mpoly_init(t2, ctx);
@@ -207,30 +228,33 @@ static int _hlift_quartic(
 
     for (j = 1; j <= degs[m]; j++)
     {
-        k = r - 2;
-        fq_nmod_mpoly_zero(U[k].coeffs + j, ctx);
-        for (i = 0; i <= j; i++)
+        for (k = r - 2; k >= 1; k--)
         {
-            fq_nmod_mpoly_mul(t1, B[k].coeffs + i, B[k + 1].coeffs + j - i, ctx);
-            fq_nmod_mpoly_add(U[k].coeffs + j, U[k].coeffs + j, t1, ctx);
-
-        }
-        for (k--; k >= 1; k--)
-        {
-            fq_nmod_mpoly_zero(U[k].coeffs + j, ctx);
             for (i = 0; i <= j; i++)
             {
-                fq_nmod_mpoly_mul(t1, B[k].coeffs + i, U[k + 1].coeffs + j - i, ctx);
-                fq_nmod_mpoly_add(U[k].coeffs + j, U[k].coeffs + j, t1, ctx);
+                Tops[i] = B[k].coeffs + i;
+                Tops[degs[m] + 1 + i] = (k == r - 2 ? B[k + 1].coeffs :
+                                                  U[k + 1].coeffs) + j - i;
             }
+            _fq_nmod_mpoly_vec_mul_threaded(T, Tops, Tops + degs[m] + 1,
+                                                                  j + 1, ctx);
+            fq_nmod_mpoly_zero(U[k].coeffs + j, ctx);
+            for (i = 0; i <= j; i++)
+                fq_nmod_mpoly_add(U[k].coeffs + j, U[k].coeffs + j, T + i, ctx);
         }
 
         fq_nmod_mpoly_divrem(t2, t, Aq, xalpha, ctx);
         fq_nmod_mpoly_swap(Aq, t2, ctx);
         for (i = 0; i <= j; i++)
         {
-            fq_nmod_mpoly_mul(t2, B[0].coeffs + i, U[1].coeffs + j - i, ctx);
-            fq_nmod_mpoly_sub(t3, t, t2, ctx);
+            Tops[i] = B[0].coeffs + i;
+            Tops[degs[m] + 1 + i] = U[1].coeffs + j - i;
+        }
+        _fq_nmod_mpoly_vec_mul_threaded(T, Tops, Tops + degs[m] + 1,
+                                                                  j + 1, ctx);
+        for (i = 0; i <= j; i++)
+        {
+            fq_nmod_mpoly_sub(t3, t, T + i, ctx);
             fq_nmod_mpoly_swap(t, t3, ctx);
         }
 
@@ -292,7 +316,12 @@ cleanup:
         fq_nmod_mpolyv_clear(U + i, ctx);
     }
     flint_free(B);
-    
+
+    for (i = 0; i <= degs[m]; i++)
+        fq_nmod_mpoly_clear(T + i, ctx);
+    flint_free(T);
+    flint_free(Tops);
+
     fq_nmod_mpoly_clear(t, ctx);
     fq_nmod_mpoly_clear(t1, ctx);
     fq_nmod_mpoly_clear(t2, ctx);
@@ -316,12 +345,18 @@ static int _hlift_quintic(
     int success;
     slong i, j;
     fq_nmod_mpoly_t e, t, pow, xalpha, q;
-    fq_nmod_mpoly_struct * betas, * deltas;
+    fq_nmod_mpoly_struct * betas, * deltas, * T;
+    const fq_nmod_mpoly_struct ** Tops;
     fq_nmod_mpoly_pfrac_t I;
     flint_bitcnt_t bits = A->bits;
 
     FLINT_ASSERT(r > 1);
 
+    T = FLINT_ARRAY_ALLOC(r, fq_nmod_mpoly_struct);
+    Tops = FLINT_ARRAY_ALLOC(2*r, const fq_nmod_mpoly_struct *);
+    for (i = 0; i < r; i++)
+        fq_nmod_mpoly_init(T + i, ctx);
+
     fq_nmod_mpoly_init(e, ctx);
     fq_nmod_mpoly_init(t, ctx);
     fq_nmod_mpoly_init(pow, ctx);
@@ -373,9 +408,12 @@ static int _hlift_quintic(
 
         for (i = 0; i < r; i++)
         {
-            fq_nmod_mpoly_mul(t, deltas + i, pow, ctx);
-            fq_nmod_mpoly_add(f + i, f + i, t, ctx);
+            Tops[i] = deltas + i;
+            Tops[r + i] = pow;
         }
+        _fq_nmod_mpoly_vec_mul_threaded(T, Tops, Tops + r, r, ctx);
+        for (i = 0; i < r; i++)
+            fq_nmod_mpoly_add(f + i, f + i, T + i, ctx);
 
         fq_nmod_mpoly_mul(t, f + 0, f + 1, ctx);
         for (i = 2; i < r; i++)
@@ -401,9 +439,12 @@ cleanup:
             fq_nmod_mpoly_repack_bits_inplace(f + i, bits, ctx);
 
         fq_nmod_mpoly_clear(betas + i, ctx);
+        fq_nmod_mpoly_clear(T + i, ctx);
     }
 
     flint_free(betas);
+    flint_free(T);
+    flint_free(Tops);
 
     return success;
 }
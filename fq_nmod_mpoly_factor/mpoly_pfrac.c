@@ -10,6 +10,60 @@
 */
 
 #include "fq_nmod_mpoly_factor.h"
+#include "thread_pool.h"
+
+
+typedef struct
+{
+    fq_nmod_mpoly_pfrac_struct * I;
+    const fq_nmod_mpoly_ctx_struct * ctx;
+    volatile slong * index;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_prod_mbetas_arg_struct;
+
+/* set the products of all but one of the betas at each level */
+static void _prod_mbetas_worker(void * varg)
+{
+    _prod_mbetas_arg_struct * arg = (_prod_mbetas_arg_struct *) varg;
+    fq_nmod_mpoly_pfrac_struct * I = arg->I;
+    const fq_nmod_mpoly_ctx_struct * ctx = arg->ctx;
+    slong i, j, k, ij;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        ij = *arg->index;
+        *arg->index = ij + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (ij >= (I->w + 1)*I->r)
+            return;
+
+        i = ij/I->r;
+        j = ij%I->r;
+
+        fq_nmod_mpoly_one(I->prod_mbetas + i*I->r + j, ctx);
+        for (k = 0; k < I->r; k++)
+        {
+            if (k == j)
+                continue;
+            fq_nmod_mpoly_mul(I->prod_mbetas + i*I->r + j,
+                        I->prod_mbetas + i*I->r + j, I->mbetas + i*I->r + k, ctx);
+        }
+        if (i > 0)
+        {
+            fq_nmod_mpoly_to_mpolyv(I->prod_mbetas_coeffs + i*I->r + j,
+                              I->prod_mbetas + i*I->r + j, I->xalpha + i, ctx);
+        }
+    }
+}
 
 
 int fq_nmod_mpoly_pfrac_init(
@@ -22,7 +76,13 @@ int fq_nmod_mpoly_pfrac_init(
     const fq_nmod_mpoly_ctx_t ctx)
 {
     slong success = 1;
-    slong i, j, k;
+    slong i, j, k, index;
+    _prod_mbetas_arg_struct * args;
+    thread_pool_handle * handles;
+    slong num_handles;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
     fq_nmod_poly_t p;
     fq_nmod_poly_t G, S, pq;
 
@@ -41,7 +101,6 @@ int fq_nmod_mpoly_pfrac_init(
     I->xalpha = FLINT_ARRAY_ALLOC(w + 1, fq_nmod_mpoly_struct);
     I->q = FLINT_ARRAY_ALLOC(w + 1, fq_nmod_mpoly_struct);
     I->G = FLINT_ARRAY_ALLOC(w + 1, fq_nmod_mpoly_geobucket_struct);
-    I->qt = FLINT_ARRAY_ALLOC(w + 1, fq_nmod_mpoly_struct);
     I->newt = FLINT_ARRAY_ALLOC(w + 1, fq_nmod_mpoly_struct);
     I->delta_coeffs = FLINT_ARRAY_ALLOC((w + 1)*r, fq_nmod_mpolyv_struct);
 
@@ -50,7 +109,6 @@ int fq_nmod_mpoly_pfrac_init(
         fq_nmod_mpoly_init(I->xalpha + i, ctx);
         fq_nmod_mpoly_init(I->q + i, ctx);
         fq_nmod_mpoly_geobucket_init(I->G + i, ctx);
-        fq_nmod_mpoly_init(I->qt + i, ctx);
         fq_nmod_mpoly_init(I->newt + i, ctx);
         for (j = 0; j < r; j++)
         {
@@ -98,29 +156,53 @@ int fq_nmod_mpoly_pfrac_init(
         }
     }
 
+    I->prods = NULL;
+    I->prod_ops = NULL;
+    I->prods_alloc = 0;
+
     /* set product of betas */
-    for (i = w; i >= 0; i--)
+    for (i = 0; i < (w + 1)*r; i++)
     {
-        for (j = 0; j < r; j++)
-        {
-            fq_nmod_mpoly_init(I->prod_mbetas + i*r + j, ctx);
-            fq_nmod_mpoly_one(I->prod_mbetas + i*r + j, ctx);
-            for (k = 0; k < r; k++)
-            {
-                if (k == j)
-                    continue;
-                fq_nmod_mpoly_mul(I->prod_mbetas + i*r + j,
-                           I->prod_mbetas + i*r + j, I->mbetas + i*r + k, ctx);
-            }
-            fq_nmod_mpolyv_init(I->prod_mbetas_coeffs + i*r + j, ctx);
-            if (i > 0)
-            {
-                fq_nmod_mpoly_to_mpolyv(I->prod_mbetas_coeffs + i*r + j,
-                                 I->prod_mbetas + i*r + j, I->xalpha + i, ctx);
-            }
-        }        
+        fq_nmod_mpoly_init(I->prod_mbetas + i, ctx);
+        fq_nmod_mpolyv_init(I->prod_mbetas_coeffs + i, ctx);
+    }
+
+    num_handles = flint_request_threads(&handles, (w + 1)*r);
+
+    args = FLINT_ARRAY_ALLOC(num_handles + 1, _prod_mbetas_arg_struct);
+
+    index = 0;
+    for (i = 0; i <= num_handles; i++)
+    {
+        args[i].I = I;
+        args[i].ctx = ctx;
+        args[i].index = &index;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
     }
 
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                               _prod_mbetas_worker, &args[i]);
+
+    _prod_mbetas_worker(&args[num_handles]);
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    flint_free(args);
+
+    flint_give_back_threads(handles, num_handles);
+
     for (j = 0; j < r; j++)
         fq_nmod_poly_init(I->inv_prod_dbetas + j, ctx->fqctx);
 
@@ -190,7 +272,6 @@ void fq_nmod_mpoly_pfrac_clear(
         fq_nmod_mpoly_clear(I->xalpha + i, ctx);
         fq_nmod_mpoly_clear(I->q + i, ctx);
         fq_nmod_mpoly_geobucket_clear(I->G + i, ctx);
-        fq_nmod_mpoly_clear(I->qt + i, ctx);
         fq_nmod_mpoly_clear(I->newt + i, ctx);
         for (j = 0; j < I->r; j++)
             fq_nmod_mpolyv_clear(I->delta_coeffs + i*I->r + j, ctx);
@@ -199,7 +280,6 @@ void fq_nmod_mpoly_pfrac_clear(
     flint_free(I->xalpha);
     flint_free(I->q);
     flint_free(I->G);
-    flint_free(I->qt);
     flint_free(I->newt);
     flint_free(I->delta_coeffs);
 
@@ -233,6 +313,33 @@ void fq_nmod_mpoly_pfrac_clear(
     fq_nmod_mpoly_clear(I->T, ctx);
     fq_nmod_mpoly_clear(I->Q, ctx);
     fq_nmod_mpoly_clear(I->R, ctx);
+
+    for (i = 0; i < I->prods_alloc; i++)
+        fq_nmod_mpoly_clear(I->prods + i, ctx);
+    flint_free(I->prods);
+    flint_free(I->prod_ops);
+}
+
+
+static void _fq_nmod_mpoly_pfrac_fit_prods(
+    fq_nmod_mpoly_pfrac_t I,
+    slong n,
+    const fq_nmod_mpoly_ctx_t ctx)
+{
+    slong i;
+
+    if (n <= I->prods_alloc)
+        return;
+
+    n = FLINT_MAX(n, 2*I->prods_alloc);
+
+    I->prods = FLINT_ARRAY_REALLOC(I->prods, n, fq_nmod_mpoly_struct);
+    I->prod_ops = FLINT_ARRAY_REALLOC(I->prod_ops, 2*n,
+                                                  const fq_nmod_mpoly_struct *);
+    for (i = I->prods_alloc; i < n; i++)
+        fq_nmod_mpoly_init(I->prods + i, ctx);
+
+    I->prods_alloc = n;
 }
 
 
@@ -243,12 +350,11 @@ int fq_nmod_mpoly_pfrac(
     fq_nmod_mpoly_pfrac_t I,
     const fq_nmod_mpoly_ctx_t ctx)
 {
-    slong i, j, k;
+    slong i, j, k, nprods;
     int success;
     fq_nmod_mpoly_struct * deltas = I->deltas + l*I->r;
     fq_nmod_mpoly_struct * newdeltas = I->deltas + (l - 1)*I->r;
     fq_nmod_mpoly_struct * q = I->q + l;
-    fq_nmod_mpoly_struct * qt = I->qt + l;
     fq_nmod_mpoly_struct * newt = I->newt + l;
     fq_nmod_mpolyv_struct * delta_coeffs = I->delta_coeffs + l*I->r;
     fq_nmod_mpoly_geobucket_struct * G = I->G + l;
@@ -278,6 +384,9 @@ int fq_nmod_mpoly_pfrac(
         fq_nmod_mpoly_swap(t, q, ctx);
         fq_nmod_mpoly_geobucket_set(G, newt, ctx);
 
+        /* the products are independent and are done together */
+        _fq_nmod_mpoly_pfrac_fit_prods(I, k*I->r, ctx);
+        nprods = 0;
         for (j = 0; j < k; j++)
         for (i = 0; i < I->r; i++)
         {
@@ -286,11 +395,18 @@ int fq_nmod_mpoly_pfrac(
             if (k - j >= I->prod_mbetas_coeffs[l*I->r + i].length)
                 continue;
 
-            fq_nmod_mpoly_mul(qt, delta_coeffs[i].coeffs + j,
-                        I->prod_mbetas_coeffs[l*I->r + i].coeffs + k - j, ctx);
-            fq_nmod_mpoly_geobucket_sub(G, qt, ctx);
+            I->prod_ops[nprods] = delta_coeffs[i].coeffs + j;
+            I->prod_ops[I->prods_alloc + nprods] =
+                              I->prod_mbetas_coeffs[l*I->r + i].coeffs + k - j;
+            nprods++;
         }
 
+        _fq_nmod_mpoly_vec_mul_threaded(I->prods, I->prod_ops,
+                                 I->prod_ops + I->prods_alloc, nprods, ctx);
+
+        for (i = 0; i < nprods; i++)
+            fq_nmod_mpoly_geobucket_sub(G, I->prods + i, ctx);
+
         fq_nmod_mpoly_geobucket_empty(newt, G, ctx);
 
         if (fq_nmod_mpoly_is_zero(newt, ctx))
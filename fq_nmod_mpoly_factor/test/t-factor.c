@@ -92,6 +92,9 @@ main(void)
         ulong expbound, powbound, pow;
 
         fq_nmod_mpoly_ctx_init_rand(ctx, state, 7, FLINT_BITS, 4);
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         fq_nmod_mpoly_init(a, ctx);
         fq_nmod_mpoly_init(t, ctx);
 
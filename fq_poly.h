@@ -24,6 +24,7 @@
 
 #include "fq.h"
 #include "fq_mat.h"
+#include "thread_support.h"
 
 #define FQ_POLY_DIVREM_DIVCONQUER_CUTOFF  16
 #define FQ_COMPOSE_MOD_LENH_CUTOFF 6
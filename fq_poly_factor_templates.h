@@ -90,6 +90,12 @@ FLINT_DLL void TEMPLATE(T, poly_factor_distinct_deg)(TEMPLATE(T, poly_factor_t)
                                       slong * const *degs,
                                       const TEMPLATE(T, ctx_t) ctx);
 
+FLINT_DLL void TEMPLATE(T, poly_factor_distinct_deg_threaded)(
+                                      TEMPLATE(T, poly_factor_t) res,
+                                      const TEMPLATE(T, poly_t) poly,
+                                      slong * const *degs,
+                                      const TEMPLATE(T, ctx_t) ctx);
+
 FLINT_DLL int TEMPLATE(T, poly_factor_equal_deg_prob)(TEMPLATE(T, poly_t) factor,
                                         flint_rand_t state,
                                         const TEMPLATE(T, poly_t) pol, slong d,
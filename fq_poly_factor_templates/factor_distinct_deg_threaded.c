@@ -0,0 +1,356 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#ifdef T
+
+#include "templates.h"
+
+#include <math.h>
+#if FLINT_USES_PTHREAD
+#include <pthread.h>
+#endif
+#include "thread_support.h"
+
+typedef struct
+{
+    TEMPLATE(T, poly_struct) * I;
+    TEMPLATE(T, poly_factor_struct) * fac;
+    const TEMPLATE(T, poly_struct) * H;
+    const TEMPLATE(T, poly_struct) * h;
+    const TEMPLATE(T, poly_struct) * v;
+    const TEMPLATE(T, poly_struct) * vinv;
+    const TEMPLATE(T, ctx_struct) * ctx;
+    slong l;
+    slong deg;
+    slong j1;
+    volatile slong * j;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_distinct_deg_arg_t;
+
+static slong
+_distinct_deg_next(_distinct_deg_arg_t * arg)
+{
+    slong j;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(arg->mutex);
+#endif
+    j = *arg->j;
+    *arg->j = j + 1;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(arg->mutex);
+#endif
+    return j;
+}
+
+/*
+    I[j] = prod (H[j] - h[i]) mod v over the degrees l*(j + 1) - i which
+    are at most deg/2, where deg is the degree of the part of v left
+*/
+static void
+_interval_poly_worker(void * arg_ptr)
+{
+    _distinct_deg_arg_t * arg = (_distinct_deg_arg_t *) arg_ptr;
+    const TEMPLATE(T, ctx_struct) * ctx = arg->ctx;
+    TEMPLATE(T, poly_t) tmp;
+    slong i, j, l = arg->l;
+
+    TEMPLATE(T, poly_init) (tmp, ctx);
+
+    while ((j = _distinct_deg_next(arg)) < arg->j1)
+    {
+        TEMPLATE(T, poly_one) (arg->I + j, ctx);
+
+        for (i = l - 1; i >= 0 && 2*(l*(j + 1) - i) <= arg->deg; i--)
+        {
+            TEMPLATE(T, poly_sub) (tmp, arg->H + j, arg->h + i, ctx);
+            TEMPLATE(T, poly_mulmod_preinv) (arg->I + j, tmp, arg->I + j,
+                                                    arg->v, arg->vinv, ctx);
+        }
+    }
+
+    TEMPLATE(T, poly_clear) (tmp, ctx);
+}
+
+/*
+    Split F_j = I[j] into the products of its factors of each degree,
+    stored in fac[j] with the degree in place of the exponent
+*/
+static void
+_fine_ddf_worker(void * arg_ptr)
+{
+    _distinct_deg_arg_t * arg = (_distinct_deg_arg_t *) arg_ptr;
+    const TEMPLATE(T, ctx_struct) * ctx = arg->ctx;
+    TEMPLATE(T, poly_t) f, g, tmp;
+    slong i, j, l = arg->l;
+
+    TEMPLATE(T, poly_init) (f, ctx);
+    TEMPLATE(T, poly_init) (g, ctx);
+    TEMPLATE(T, poly_init) (tmp, ctx);
+
+    while ((j = _distinct_deg_next(arg)) < arg->j1)
+    {
+        if (arg->I[j].length - 1 > (j + 1)*l || j == 0)
+        {
+            TEMPLATE(T, poly_set) (g, arg->I + j, ctx);
+
+            for (i = l - 1; i >= 0 && g->length > 1; i--)
+            {
+                TEMPLATE(T, poly_sub) (tmp, arg->H + j, arg->h + i, ctx);
+                TEMPLATE(T, poly_gcd) (f, g, tmp, ctx);
+
+                if (f->length > 1)
+                {
+                    TEMPLATE(T, poly_make_monic) (f, f, ctx);
+                    TEMPLATE(T, poly_factor_insert) (arg->fac + j, f,
+                                                      l*(j + 1) - i, ctx);
+                    TEMPLATE(T, poly_remove) (g, f, ctx);
+                }
+            }
+        }
+        else if (arg->I[j].length > 1)
+        {
+            TEMPLATE(T, poly_make_monic) (arg->I + j, arg->I + j, ctx);
+            TEMPLATE(T, poly_factor_insert) (arg->fac + j, arg->I + j,
+                                             arg->I[j].length - 1, ctx);
+        }
+    }
+
+    TEMPLATE(T, poly_clear) (f, ctx);
+    TEMPLATE(T, poly_clear) (g, ctx);
+    TEMPLATE(T, poly_clear) (tmp, ctx);
+}
+
+static void
+_distinct_deg_run(void (* worker)(void *), _distinct_deg_arg_t * args,
+                  slong j0, slong j1, thread_pool_handle * threads,
+                  slong num_threads)
+{
+    slong i, shared_j = j0;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    if (j1 <= j0)
+        return;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    num_threads = FLINT_MIN(num_threads, j1 - j0 - 1);
+
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i].j1 = j1;
+        args[i].j = &shared_j;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
+    }
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0, worker, &args[i]);
+
+    worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+}
+
+/*
+    Given H[0], computes H[c], ..., H[c + cnt - 1] with H[a + b + 1] being
+    the composition of H[a] with H[b]
+*/
+static void
+_distinct_deg_powers(TEMPLATE(T, poly_struct) * H, slong c, slong num,
+                    const TEMPLATE(T, poly_t) v, const TEMPLATE(T, poly_t) vinv,
+                    const TEMPLATE(T, ctx_t) ctx,
+                    thread_pool_handle * threads, slong num_threads)
+{
+    slong cnt;
+
+    while (c < num)
+    {
+        cnt = FLINT_MIN(c, num - c);
+
+        TEMPLATE(T, poly_compose_mod_brent_kung_vec_preinv_threaded_pool)
+            (H + c, H, cnt, cnt, H + c - 1, v, vinv, ctx,
+                                                      threads, num_threads);
+        c += cnt;
+    }
+}
+
+void
+TEMPLATE(T, poly_factor_distinct_deg_threaded) (
+                                       TEMPLATE(T, poly_factor_t) res,
+                                       const TEMPLATE(T, poly_t) poly,
+                                       slong * const *degs,
+                                       const TEMPLATE(T, ctx_t) ctx)
+{
+    TEMPLATE(T, poly_t) s, v, vinv;
+    TEMPLATE(T, poly_struct) * h, * H, * I;
+    TEMPLATE(T, poly_factor_struct) * fac;
+    _distinct_deg_arg_t * args;
+    thread_pool_handle * threads;
+    fmpz_t q;
+    slong i, j, k, l, m, n, j0, j1, jmax, index, num_threads;
+    double beta;
+
+    n = TEMPLATE(T, poly_degree) (poly, ctx);
+
+    TEMPLATE(T, poly_init) (v, ctx);
+    TEMPLATE(T, poly_make_monic) (v, poly, ctx);
+
+    if (n == 1)
+    {
+        TEMPLATE(T, poly_factor_insert) (res, v, 1, ctx);
+        (*degs)[0] = 1;
+        TEMPLATE(T, poly_clear) (v, ctx);
+        return;
+    }
+
+    beta = 0.5 * (1. - (log(2) / log(n)));
+    l = ceil(pow(n, beta));
+    m = ceil(0.5 * n / l);
+
+    fmpz_init(q);
+    TEMPLATE(T, ctx_order) (q, ctx);
+
+    TEMPLATE(T, poly_init) (s, ctx);
+    TEMPLATE(T, poly_init) (vinv, ctx);
+
+    h = flint_malloc((2*m + l + 1) * sizeof(TEMPLATE(T, poly_struct)));
+    H = h + (l + 1);
+    I = H + m;
+    for (i = 0; i < 2*m + l + 1; i++)
+        TEMPLATE(T, poly_init) (h + i, ctx);
+
+    fac = flint_malloc(m * sizeof(TEMPLATE(T, poly_factor_struct)));
+    for (j = 0; j < m; j++)
+        TEMPLATE(T, poly_factor_init) (fac + j, ctx);
+
+    num_threads = flint_request_threads(&threads, flint_get_num_threads());
+
+    args = flint_malloc((num_threads + 1) * sizeof(_distinct_deg_arg_t));
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i].I = I;
+        args[i].fac = fac;
+        args[i].H = H;
+        args[i].h = h;
+        args[i].v = v;
+        args[i].vinv = vinv;
+        args[i].ctx = ctx;
+        args[i].l = l;
+    }
+
+    TEMPLATE(T, poly_reverse) (vinv, v, v->length, ctx);
+    TEMPLATE(T, poly_inv_series_newton) (vinv, vinv, v->length, ctx);
+
+    /* compute baby steps: h[i] = x^{q^i} mod v */
+    TEMPLATE(T, poly_gen) (h + 0, ctx);
+    TEMPLATE(T, poly_powmod_fmpz_sliding_preinv) (h + 1, h + 0, q, 0, v,
+                                                                vinv, ctx);
+
+    if (TEMPLATE(CAP_T, POLY_ITERATED_FROBENIUS_CUTOFF) (ctx, v->length))
+    {
+        _distinct_deg_powers(h + 1, 1, l, v, vinv, ctx, threads, num_threads);
+    }
+    else
+    {
+        for (i = 2; i < l + 1; i++)
+            TEMPLATE(T, poly_powmod_fmpz_sliding_preinv) (h + i, h + i - 1,
+                                                      q, 0, v, vinv, ctx);
+    }
+
+    /*
+        compute coarse distinct-degree factorisation, working on batches
+        of one giant step H[j] = x^{q^(l(j + 1))} mod v per thread
+    */
+    index = 0;
+    TEMPLATE(T, poly_set) (s, v, ctx);
+    TEMPLATE(T, poly_set) (H + 0, h + l, ctx);
+
+    jmax = m;
+    for (j0 = 0; j0 < m; j0 = j1)
+    {
+        j1 = FLINT_MIN(m, j0 + num_threads + 1);
+
+        _distinct_deg_powers(H, FLINT_MAX(j0, 1), j1, v, vinv, ctx,
+                                                       threads, num_threads);
+
+        for (i = 0; i <= num_threads; i++)
+            args[i].deg = s->length - 1;
+
+        _distinct_deg_run(_interval_poly_worker, args, j0, j1,
+                                                       threads, num_threads);
+
+        /* F_j = f^{[j*l+1]} * ... * f^{[j*l+l]} is stored in place of I_j */
+        for (j = j0; j < j1; j++)
+        {
+            TEMPLATE(T, poly_gcd) (I + j, s, I + j, ctx);
+
+            if (I[j].length > 1)
+                TEMPLATE(T, poly_remove) (s, I + j, ctx);
+
+            if (s->length - 1 < 2*(l*(j + 1) + 1))
+            {
+                jmax = j + 1;
+                break;
+            }
+        }
+
+        if (jmax < m)
+            break;
+    }
+
+    if (s->length > 1)
+    {
+        TEMPLATE(T, poly_factor_insert) (res, s, 1, ctx);
+        (*degs)[index++] = s->length - 1;
+    }
+
+    /* compute fine distinct-degree factorisation */
+    _distinct_deg_run(_fine_ddf_worker, args, 0, jmax, threads, num_threads);
+
+    for (j = 0; j < jmax; j++)
+    {
+        for (k = 0; k < fac[j].num; k++)
+        {
+            TEMPLATE(T, poly_factor_insert) (res, fac[j].poly + k, 1, ctx);
+            (*degs)[index++] = fac[j].exp[k];
+        }
+    }
+
+    flint_give_back_threads(threads, num_threads);
+
+    /* cleanup */
+    flint_free(args);
+    fmpz_clear(q);
+    TEMPLATE(T, poly_clear) (s, ctx);
+    TEMPLATE(T, poly_clear) (v, ctx);
+    TEMPLATE(T, poly_clear) (vinv, ctx);
+
+    for (i = 0; i < 2*m + l + 1; i++)
+        TEMPLATE(T, poly_clear) (h + i, ctx);
+    flint_free(h);
+
+    for (j = 0; j < m; j++)
+        TEMPLATE(T, poly_factor_clear) (fac + j, ctx);
+    flint_free(fac);
+}
+
+#endif
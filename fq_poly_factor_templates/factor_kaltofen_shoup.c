@@ -15,6 +15,107 @@
 #include "templates.h"
 
 #include <math.h>
+#if FLINT_USES_PTHREAD
+#include <pthread.h>
+#endif
+#include "thread_support.h"
+
+typedef struct
+{
+    TEMPLATE(T, poly_factor_struct) * res;
+    const TEMPLATE(T, poly_struct) * polys;
+    const slong * degs;
+    const TEMPLATE(T, ctx_struct) * ctx;
+    slong num;
+    volatile slong * j;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_equal_deg_arg_t;
+
+static void
+_equal_deg_worker(void * arg_ptr)
+{
+    _equal_deg_arg_t * arg = (_equal_deg_arg_t *) arg_ptr;
+    slong j;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        j = *arg->j;
+        *arg->j = j + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (j >= arg->num)
+            return;
+
+        TEMPLATE(T, poly_factor_equal_deg) (arg->res + j, arg->polys + j,
+                                                   arg->degs[j], arg->ctx);
+    }
+}
+
+/*
+    Equal-degree factorisation of the num independent products polys[j] of
+    irreducible factors of degree degs[j], each factor of polys[j] being
+    added to res[j]
+*/
+static void
+_equal_deg_threaded(TEMPLATE(T, poly_factor_struct) * res,
+                    const TEMPLATE(T, poly_struct) * polys,
+                    const slong * degs, slong num,
+                    const TEMPLATE(T, ctx_t) ctx)
+{
+    thread_pool_handle * threads;
+    slong i, num_threads, shared_j = 0;
+    _equal_deg_arg_t * args;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    num_threads = flint_request_threads(&threads,
+                                FLINT_MIN(flint_get_num_threads(), num));
+
+    args = flint_malloc((num_threads + 1) * sizeof(_equal_deg_arg_t));
+
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i].res = res;
+        args[i].polys = polys;
+        args[i].degs = degs;
+        args[i].ctx = ctx;
+        args[i].num = num;
+        args[i].j = &shared_j;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                                _equal_deg_worker, &args[i]);
+
+    _equal_deg_worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    flint_give_back_threads(threads, num_threads);
+
+    flint_free(args);
+}
 
 void
 TEMPLATE(T, poly_factor_kaltofen_shoup) (TEMPLATE(T, poly_factor_t) res,
@@ -49,18 +150,55 @@ TEMPLATE(T, poly_factor_kaltofen_shoup) (TEMPLATE(T, poly_factor_t) res,
     {
         dist_deg_num = dist_deg->num;
 
-        TEMPLATE(T, poly_factor_distinct_deg) (dist_deg, sq_free->poly + i,
-                                               &degs, ctx);
+        if (flint_get_num_threads() > 1 &&
+            (sq_free->poly + i)->length > 16*flint_get_num_threads())
+            TEMPLATE(T, poly_factor_distinct_deg_threaded) (dist_deg,
+                                            sq_free->poly + i, &degs, ctx);
+        else
+            TEMPLATE(T, poly_factor_distinct_deg) (dist_deg,
+                                            sq_free->poly + i, &degs, ctx);
 
         /* compute equal-degree factorisation */
-        for (j = dist_deg_num, l = 0; j < dist_deg->num; j++, l++)
+        if (flint_get_num_threads() > 1 && dist_deg->num - dist_deg_num > 1)
         {
-            res_num = res->num;
+            TEMPLATE(T, poly_factor_struct) * eq;
+            slong num = dist_deg->num - dist_deg_num;
+
+            eq = flint_malloc(num * sizeof(TEMPLATE(T, poly_factor_struct)));
+            for (l = 0; l < num; l++)
+                TEMPLATE(T, poly_factor_init) (eq + l, ctx);
+
+            _equal_deg_threaded(eq, dist_deg->poly + dist_deg_num, degs,
+                                                                  num, ctx);
 
-            TEMPLATE(T, poly_factor_equal_deg) (res, dist_deg->poly + j,
-                                                degs[l], ctx);
-            for (k = res_num; k < res->num; k++)
-                res->exp[k] = TEMPLATE(T, poly_remove) (v, res->poly + k, ctx);
+            for (l = 0; l < num; l++)
+            {
+                res_num = res->num;
+
+                for (k = 0; k < eq[l].num; k++)
+                    TEMPLATE(T, poly_factor_insert) (res, eq[l].poly + k, 1,
+                                                                        ctx);
+                for (k = res_num; k < res->num; k++)
+                    res->exp[k] = TEMPLATE(T, poly_remove) (v, res->poly + k,
+                                                                        ctx);
+
+                TEMPLATE(T, poly_factor_clear) (eq + l, ctx);
+            }
+
+            flint_free(eq);
+        }
+        else
+        {
+            for (j = dist_deg_num, l = 0; j < dist_deg->num; j++, l++)
+            {
+                res_num = res->num;
+
+                TEMPLATE(T, poly_factor_equal_deg) (res, dist_deg->poly + j,
+                                                    degs[l], ctx);
+                for (k = res_num; k < res->num; k++)
+                    res->exp[k] = TEMPLATE(T, poly_remove) (v,
+                                                      res->poly + k, ctx);
+            }
         }
     }
 
@@ -20,6 +20,8 @@
 
 #include <stdlib.h>
 #include "ulong_extras.h"
+#include "thread_support.h"
+
 int
 main(void)
 {
@@ -38,6 +40,8 @@ main(void)
         slong i, j, length, num;
         slong exp[5];
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         TEMPLATE(T, ctx_randtest) (ctx, state);
 
         TEMPLATE(T, poly_init) (poly1, ctx);
@@ -0,0 +1,285 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#ifdef T
+
+#include "templates.h"
+
+#include <gmp.h>
+#if FLINT_USES_PTHREAD
+#include <pthread.h>
+#endif
+#include "flint.h"
+#include "ulong_extras.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    TEMPLATE(T, poly_struct) * res;
+    const TEMPLATE(T, mat_struct) * C;
+    const TEMPLATE(T, struct) * h;
+    const TEMPLATE(T, struct) * poly;
+    const TEMPLATE(T, struct) * polyinv;
+    const TEMPLATE(T, ctx_struct) * ctx;
+    volatile slong * j;
+    slong k;
+    slong len;
+    slong leninv;
+    slong len2;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_compose_vec_arg_t;
+
+static void
+_compose_vec_worker(void * arg_ptr)
+{
+    _compose_vec_arg_t arg = *((_compose_vec_arg_t *) arg_ptr);
+    slong i, j, k = arg.k, n = arg.len - 1;
+    const TEMPLATE(T, mat_struct) * C = arg.C;
+    const TEMPLATE(T, ctx_struct) * ctx = arg.ctx;
+    TEMPLATE(T, poly_struct) * res = arg.res;
+    TEMPLATE(T, struct) * t;
+
+    t = _TEMPLATE(T, vec_init) (n, ctx);
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg.mutex);
+#endif
+        j = *arg.j;
+        *arg.j = j + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg.mutex);
+#endif
+
+        if (j >= arg.len2)
+            break;
+
+        /* Evaluate block composition using the Horner scheme */
+        _TEMPLATE(T, vec_set) (res[j].coeffs, C->rows[(j + 1)*k - 1], n, ctx);
+
+        for (i = 2; i <= k; i++)
+        {
+            if (n == 1) /* constant polynomials */
+                TEMPLATE(T, mul) (t, res[j].coeffs, arg.h, ctx);
+            else
+                _TEMPLATE(T, poly_mulmod_preinv) (t, res[j].coeffs, n,
+                                           arg.h, n, arg.poly, arg.len,
+                                           arg.polyinv, arg.leninv, ctx);
+
+            _TEMPLATE(T, poly_add) (res[j].coeffs, t, n,
+                                          C->rows[(j + 1)*k - i], n, ctx);
+        }
+    }
+
+    _TEMPLATE(T, vec_clear) (t, n, ctx);
+}
+
+void
+_TEMPLATE(T, poly_compose_mod_brent_kung_vec_preinv_threaded_pool) (
+    TEMPLATE(T, poly_struct) * res,
+    const TEMPLATE(T, poly_struct) * polys, slong lenpolys, slong l,
+    const TEMPLATE(T, struct) * g, slong glen,
+    const TEMPLATE(T, struct) * poly, slong len,
+    const TEMPLATE(T, struct) * polyinv, slong leninv,
+    const TEMPLATE(T, ctx_t) ctx,
+    thread_pool_handle * threads, slong num_threads)
+{
+    TEMPLATE(T, mat_t) A, B, C;
+    TEMPLATE(T, struct) * h;
+    slong i, j, n, m, k, len1, len2 = l, shared_j = 0;
+    _compose_vec_arg_t * args;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    n = len - 1;
+    m = n_sqrt(n*len2) + 1;
+    k = len/m + 1;
+
+    h = _TEMPLATE(T, vec_init) (n, ctx);
+
+    TEMPLATE(T, mat_init) (A, m, n, ctx);
+    TEMPLATE(T, mat_init) (B, k*len2, m, ctx);
+    TEMPLATE(T, mat_init) (C, k*len2, n, ctx);
+
+    /* Set rows of B to the segments of polys */
+    for (j = 0; j < len2; j++)
+    {
+        len1 = polys[j].length;
+
+        for (i = 0; i < len1 / m; i++)
+            _TEMPLATE(T, vec_set) (B->rows[i + j*k], polys[j].coeffs + i*m,
+                                                                     m, ctx);
+
+        _TEMPLATE(T, vec_set) (B->rows[i + j*k], polys[j].coeffs + i*m,
+                                                            len1 % m, ctx);
+    }
+
+    /* Set rows of A to powers of g */
+    TEMPLATE(T, one) (TEMPLATE(T, mat_entry) (A, 0, 0), ctx);
+    _TEMPLATE(T, vec_set) (A->rows[1], g, glen, ctx);
+
+    for (i = 2; i < m; i++)
+    {
+        if (n == 1)
+            TEMPLATE(T, mul) (A->rows[i], A->rows[i - 1], A->rows[1], ctx);
+        else
+            _TEMPLATE(T, poly_mulmod_preinv) (A->rows[i], A->rows[i - 1], n,
+                          A->rows[1], n, poly, len, polyinv, leninv, ctx);
+    }
+
+    TEMPLATE(T, mat_mul) (C, B, A, ctx);
+
+    if (n == 1)
+        TEMPLATE(T, mul) (h, A->rows[m - 1], A->rows[1], ctx);
+    else
+        _TEMPLATE(T, poly_mulmod_preinv) (h, A->rows[m - 1], n, A->rows[1], n,
+                                           poly, len, polyinv, leninv, ctx);
+
+    args = (_compose_vec_arg_t *)
+                  flint_malloc(sizeof(_compose_vec_arg_t) * (num_threads + 1));
+
+    for (i = 0; i < num_threads + 1; i++)
+    {
+        args[i].res     = res;
+        args[i].C       = C;
+        args[i].h       = h;
+        args[i].k       = k;
+        args[i].j       = &shared_j;
+        args[i].poly    = poly;
+        args[i].len     = len;
+        args[i].polyinv = polyinv;
+        args[i].leninv  = leninv;
+        args[i].ctx     = ctx;
+        args[i].len2    = len2;
+#if FLINT_USES_PTHREAD
+        args[i].mutex   = &mutex;
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                               _compose_vec_worker, &args[i]);
+
+    _compose_vec_worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    flint_free(args);
+
+    _TEMPLATE(T, vec_clear) (h, n, ctx);
+
+    TEMPLATE(T, mat_clear) (A, ctx);
+    TEMPLATE(T, mat_clear) (B, ctx);
+    TEMPLATE(T, mat_clear) (C, ctx);
+}
+
+void
+TEMPLATE(T, poly_compose_mod_brent_kung_vec_preinv_threaded_pool) (
+    TEMPLATE(T, poly_struct) * res,
+    const TEMPLATE(T, poly_struct) * polys, slong len1, slong n,
+    const TEMPLATE(T, poly_t) g, const TEMPLATE(T, poly_t) poly,
+    const TEMPLATE(T, poly_t) polyinv, const TEMPLATE(T, ctx_t) ctx,
+    thread_pool_handle * threads, slong num_threads)
+{
+    slong i, len2 = poly->length;
+
+    if (n == 0)
+        return;
+
+    if (len2 == 1)
+    {
+        for (i = 0; i < n; i++)
+            TEMPLATE(T, poly_zero) (res + i, ctx);
+
+        return;
+    }
+
+    if (len2 == 2)
+    {
+        for (i = 0; i < n; i++)
+            TEMPLATE(T, poly_set) (res + i, polys + i, ctx);
+
+        return;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        TEMPLATE(T, poly_fit_length) (res + i, len2 - 1, ctx);
+        _TEMPLATE(T, poly_set_length) (res + i, len2 - 1, ctx);
+    }
+
+    _TEMPLATE(T, poly_compose_mod_brent_kung_vec_preinv_threaded_pool) (res,
+                                    polys, len1, n, g->coeffs, g->length,
+                                    poly->coeffs, len2, polyinv->coeffs,
+                                    polyinv->length, ctx, threads, num_threads);
+
+    for (i = 0; i < n; i++)
+        _TEMPLATE(T, poly_normalise) (res + i, ctx);
+}
+
+void
+TEMPLATE(T, poly_compose_mod_brent_kung_vec_preinv_threaded) (
+    TEMPLATE(T, poly_struct) * res,
+    const TEMPLATE(T, poly_struct) * polys, slong len1, slong n,
+    const TEMPLATE(T, poly_t) g, const TEMPLATE(T, poly_t) poly,
+    const TEMPLATE(T, poly_t) polyinv, const TEMPLATE(T, ctx_t) ctx)
+{
+    thread_pool_handle * threads;
+    slong i, num_threads;
+
+    for (i = 0; i < len1; i++)
+    {
+        if (polys[i].length >= poly->length)
+        {
+            TEMPLATE_PRINTF("Exception (%s_poly_compose_mod_brent_kung_vec_preinv_threaded).", T);
+            flint_printf("The degree of the first polynomial must be smaller "
+                         "than that of the modulus\n");
+            flint_abort();
+        }
+    }
+
+    if (n > len1)
+    {
+        TEMPLATE_PRINTF("Exception (%s_poly_compose_mod_brent_kung_vec_preinv_threaded).", T);
+        flint_printf("n is larger than the length of polys\n");
+        flint_abort();
+    }
+
+    if (g->length >= poly->length)
+    {
+        TEMPLATE_PRINTF("Exception (%s_poly_compose_mod_brent_kung_vec_preinv_threaded).", T);
+        flint_printf("The degree of g must be smaller than that of the "
+                     "modulus\n");
+        flint_abort();
+    }
+
+    num_threads = flint_request_threads(&threads, flint_get_num_threads());
+
+    TEMPLATE(T, poly_compose_mod_brent_kung_vec_preinv_threaded_pool) (res,
+                      polys, len1, n, g, poly, polyinv, ctx,
+                      threads, num_threads);
+
+    flint_give_back_threads(threads, num_threads);
+}
+
+#endif
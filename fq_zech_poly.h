@@ -24,6 +24,7 @@
 
 #include "fq_zech_mat.h"
 #include "fmpz_mod_poly.h"
+#include "thread_support.h"
 
 #define FQ_ZECH_POLY_DIVREM_DIVCONQUER_CUTOFF  16
 #define FQ_ZECH_COMPOSE_MOD_LENH_CUTOFF 6
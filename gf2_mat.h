@@ -0,0 +1,223 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef GF2_MAT_H
+#define GF2_MAT_H
+
+#ifdef GF2_MAT_INLINES_C
+#define GF2_MAT_INLINE FLINT_DLL
+#else
+#define GF2_MAT_INLINE static __inline__
+#endif
+
+#undef ulong
+#define ulong ulongxx /* interferes with system includes */
+#include <stdlib.h>
+#include <stdio.h>
+#undef ulong
+#include <gmp.h>
+#define ulong mp_limb_t
+
+#include "flint.h"
+#include "longlong.h"
+#include "ulong_extras.h"
+#include "nmod_mat.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/*
+    Entry (i, j) is bit j % FLINT_BITS of the limb rows[i][j / FLINT_BITS].
+    The bits of the last limb of a row beyond column c are zero in a matrix
+    allocated by gf2_mat_init. In a window they belong to the columns of the
+    parent matrix to the right of the window; all functions leave them
+    unchanged.
+*/
+
+typedef struct
+{
+    mp_limb_t * entries;
+    slong r;
+    slong c;
+    mp_limb_t ** rows;
+}
+gf2_mat_struct;
+
+typedef gf2_mat_struct gf2_mat_t[1];
+
+#define GF2_MAT_WORDS(c) (((c) + FLINT_BITS - 1) / FLINT_BITS)
+
+/* mask of the valid bits of the last limb of a row with c columns */
+#define GF2_MAT_LAST_MASK(c) \
+    (((c) % FLINT_BITS) == 0 ? ~UWORD(0) : (UWORD(1) << ((c) % FLINT_BITS)) - 1)
+
+#define GF2_MAT_M4RM_CUTOFF 16
+#define GF2_MAT_STRASSEN_CUTOFF 8192
+
+GF2_MAT_INLINE
+slong gf2_mat_nrows(const gf2_mat_t A)
+{
+    return A->r;
+}
+
+GF2_MAT_INLINE
+slong gf2_mat_ncols(const gf2_mat_t A)
+{
+    return A->c;
+}
+
+GF2_MAT_INLINE
+int gf2_mat_get_entry(const gf2_mat_t A, slong i, slong j)
+{
+    return (A->rows[i][j / FLINT_BITS] >> (j % FLINT_BITS)) & 1;
+}
+
+GF2_MAT_INLINE
+void gf2_mat_set_entry(gf2_mat_t A, slong i, slong j, int x)
+{
+    mp_limb_t bit = UWORD(1) << (j % FLINT_BITS);
+
+    if (x & 1)
+        A->rows[i][j / FLINT_BITS] |= bit;
+    else
+        A->rows[i][j / FLINT_BITS] &= ~bit;
+}
+
+GF2_MAT_INLINE
+void gf2_mat_flip_entry(gf2_mat_t A, slong i, slong j)
+{
+    A->rows[i][j / FLINT_BITS] ^= UWORD(1) << (j % FLINT_BITS);
+}
+
+/* Row operations on the first c bits, leaving any later bits unchanged */
+
+GF2_MAT_INLINE
+void _gf2_vec_add(mp_ptr r, mp_srcptr s, slong c)
+{
+    slong i, n = c / FLINT_BITS;
+
+    for (i = 0; i < n; i++)
+        r[i] ^= s[i];
+
+    if (c % FLINT_BITS)
+        r[n] ^= s[n] & GF2_MAT_LAST_MASK(c);
+}
+
+GF2_MAT_INLINE
+void _gf2_vec_set(mp_ptr r, mp_srcptr s, slong c)
+{
+    slong i, n = c / FLINT_BITS;
+    mp_limb_t mask;
+
+    for (i = 0; i < n; i++)
+        r[i] = s[i];
+
+    if (c % FLINT_BITS)
+    {
+        mask = GF2_MAT_LAST_MASK(c);
+        r[n] = (r[n] & ~mask) | (s[n] & mask);
+    }
+}
+
+GF2_MAT_INLINE
+void _gf2_vec_zero(mp_ptr r, slong c)
+{
+    slong i, n = c / FLINT_BITS;
+
+    for (i = 0; i < n; i++)
+        r[i] = 0;
+
+    if (c % FLINT_BITS)
+        r[n] &= ~GF2_MAT_LAST_MASK(c);
+}
+
+/* Memory management */
+
+FLINT_DLL void gf2_mat_init(gf2_mat_t A, slong rows, slong cols);
+
+FLINT_DLL void gf2_mat_init_set(gf2_mat_t A, const gf2_mat_t B);
+
+FLINT_DLL void gf2_mat_clear(gf2_mat_t A);
+
+GF2_MAT_INLINE
+void gf2_mat_swap(gf2_mat_t A, gf2_mat_t B)
+{
+    gf2_mat_struct t = *A;
+    *A = *B;
+    *B = t;
+}
+
+FLINT_DLL void gf2_mat_window_init(gf2_mat_t window, const gf2_mat_t A,
+                                      slong r1, slong c1, slong r2, slong c2);
+
+FLINT_DLL void gf2_mat_window_clear(gf2_mat_t window);
+
+/* Basic operations */
+
+FLINT_DLL void gf2_mat_set(gf2_mat_t A, const gf2_mat_t B);
+
+FLINT_DLL void gf2_mat_zero(gf2_mat_t A);
+
+FLINT_DLL void gf2_mat_one(gf2_mat_t A);
+
+FLINT_DLL int gf2_mat_equal(const gf2_mat_t A, const gf2_mat_t B);
+
+FLINT_DLL int gf2_mat_is_zero(const gf2_mat_t A);
+
+FLINT_DLL void gf2_mat_transpose(gf2_mat_t B, const gf2_mat_t A);
+
+FLINT_DLL void gf2_mat_add(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+
+FLINT_DLL void gf2_mat_set_nmod_mat(gf2_mat_t A, const nmod_mat_t B);
+
+FLINT_DLL void gf2_mat_get_nmod_mat(nmod_mat_t B, const gf2_mat_t A);
+
+FLINT_DLL void gf2_mat_randtest(gf2_mat_t A, flint_rand_t state);
+
+FLINT_DLL void gf2_mat_print_pretty(const gf2_mat_t A);
+
+/* Multiplication */
+
+FLINT_DLL void gf2_mat_mul_classical(gf2_mat_t C, const gf2_mat_t A,
+                                                           const gf2_mat_t B);
+
+FLINT_DLL void _gf2_mat_addmul_m4rm(gf2_mat_t C, const gf2_mat_t A,
+                                                           const gf2_mat_t B);
+
+FLINT_DLL void gf2_mat_mul_m4rm(gf2_mat_t C, const gf2_mat_t A,
+                                                           const gf2_mat_t B);
+
+FLINT_DLL void gf2_mat_mul_strassen(gf2_mat_t C, const gf2_mat_t A,
+                                                           const gf2_mat_t B);
+
+FLINT_DLL void gf2_mat_mul(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+
+FLINT_DLL void gf2_mat_addmul(gf2_mat_t C, const gf2_mat_t A,
+                                                           const gf2_mat_t B);
+
+/* Gaussian elimination */
+
+FLINT_DLL slong gf2_mat_lu(slong * P, gf2_mat_t A, int rank_check);
+
+FLINT_DLL slong gf2_mat_rref(gf2_mat_t A);
+
+FLINT_DLL slong gf2_mat_rank(const gf2_mat_t A);
+
+FLINT_DLL slong gf2_mat_nullspace(gf2_mat_t X, const gf2_mat_t A);
+
+FLINT_DLL int gf2_mat_solve(gf2_mat_t X, const gf2_mat_t A,
+                                                           const gf2_mat_t B);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -0,0 +1,32 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+gf2_mat_add(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    slong i, j, n = A->c / FLINT_BITS;
+    mp_limb_t mask = GF2_MAT_LAST_MASK(A->c), t;
+
+    if (A->c == 0)
+        return;
+
+    for (i = 0; i < A->r; i++)
+    {
+        for (j = 0; j < n; j++)
+            C->rows[i][j] = A->rows[i][j] ^ B->rows[i][j];
+
+        if (A->c % FLINT_BITS)
+        {
+            t = A->rows[i][n] ^ B->rows[i][n];
+            C->rows[i][n] = (C->rows[i][n] & ~mask) | (t & mask);
+        }
+    }
+}
@@ -0,0 +1,35 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+gf2_mat_addmul(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    slong m = A->r, k = A->c, n = B->c;
+    slong min_dim = FLINT_MIN(FLINT_MIN(m, k), n);
+
+    if (A->c != B->r || C->r != m || C->c != n)
+    {
+        flint_printf("Exception (gf2_mat_addmul). Incompatible dimensions.\n");
+        flint_abort();
+    }
+
+    if (C == A || C == B || min_dim >= GF2_MAT_STRASSEN_CUTOFF)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, m, n);
+        gf2_mat_mul(T, A, B);
+        gf2_mat_add(C, C, T);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    _gf2_mat_addmul_m4rm(C, A, B);
+}
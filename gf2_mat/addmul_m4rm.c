@@ -0,0 +1,115 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+/* number of rows of B combined in one table, and tables used at once */
+#define GF2_MAT_M4RM_K 8
+#define GF2_MAT_M4RM_TABLES 4
+
+void
+_gf2_mat_addmul_m4rm(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    slong i, j, g, t, num, words, n = B->c;
+    slong len[GF2_MAT_M4RM_TABLES];
+    mp_limb_t idx[GF2_MAT_M4RM_TABLES];
+    mp_ptr T, Tj, Tp;
+    mp_srcptr Bj;
+    mp_ptr c;
+    mp_limb_t mask, acc, z;
+
+    if (A->r == 0 || n == 0 || A->c == 0)
+        return;
+
+    words = GF2_MAT_WORDS(n);
+    mask = GF2_MAT_LAST_MASK(n);
+
+    T = flint_malloc(GF2_MAT_M4RM_TABLES * (WORD(1) << GF2_MAT_M4RM_K)
+                                                 * words * sizeof(mp_limb_t));
+
+    for (g = 0; g < A->c; g += GF2_MAT_M4RM_K * GF2_MAT_M4RM_TABLES)
+    {
+        /*
+            Table t holds all 2^K sums of the rows g + t*K, ..., g + t*K + K - 1
+            of B, the sum with index x being built from the one with the
+            lowest set bit of x cleared.
+        */
+        for (t = 0; t < GF2_MAT_M4RM_TABLES; t++)
+        {
+            slong r0 = g + t * GF2_MAT_M4RM_K;
+
+            len[t] = FLINT_MAX(0, FLINT_MIN(GF2_MAT_M4RM_K, A->c - r0));
+
+            if (len[t] == 0)
+                break;
+
+            Tp = T + t * (WORD(1) << GF2_MAT_M4RM_K) * words;
+
+            for (i = 0; i < words; i++)
+                Tp[i] = 0;
+
+            for (j = 1; j < (WORD(1) << len[t]); j++)
+            {
+                count_trailing_zeros(z, j);
+                Tj = Tp + j * words;
+                Bj = B->rows[r0 + z];
+                c = Tp + (j & (j - 1)) * words;
+
+                for (i = 0; i < words; i++)
+                    Tj[i] = c[i] ^ Bj[i];
+
+                Tj[words - 1] &= mask;
+            }
+        }
+
+        num = t;
+
+        for (j = 0; j < A->r; j++)
+        {
+            /* the groups of K bits never straddle a limb */
+            for (t = 0; t < num; t++)
+            {
+                slong b = g + t * GF2_MAT_M4RM_K;
+
+                idx[t] = (A->rows[j][b / FLINT_BITS] >> (b % FLINT_BITS))
+                                               & ((UWORD(1) << len[t]) - 1);
+            }
+
+            c = C->rows[j];
+
+            if (num == GF2_MAT_M4RM_TABLES)
+            {
+                mp_srcptr T0, T1, T2, T3;
+
+                T0 = T + idx[0] * words;
+                T1 = T + ((WORD(1) << GF2_MAT_M4RM_K) + idx[1]) * words;
+                T2 = T + (2 * (WORD(1) << GF2_MAT_M4RM_K) + idx[2]) * words;
+                T3 = T + (3 * (WORD(1) << GF2_MAT_M4RM_K) + idx[3]) * words;
+
+                for (i = 0; i < words; i++)
+                    c[i] ^= T0[i] ^ T1[i] ^ T2[i] ^ T3[i];
+            }
+            else
+            {
+                for (i = 0; i < words; i++)
+                {
+                    acc = 0;
+
+                    for (t = 0; t < num; t++)
+                        acc ^= T[(t * (WORD(1) << GF2_MAT_M4RM_K) + idx[t])
+                                                                * words + i];
+
+                    c[i] ^= acc;
+                }
+            }
+        }
+    }
+
+    flint_free(T);
+}
@@ -0,0 +1,40 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+gf2_mat_init(gf2_mat_t A, slong rows, slong cols)
+{
+    slong i, words = GF2_MAT_WORDS(cols);
+
+    if (rows != 0)
+        A->rows = (mp_limb_t **) flint_malloc(rows * sizeof(mp_limb_t *));
+    else
+        A->rows = NULL;
+
+    if (rows != 0 && cols != 0)
+    {
+        A->entries = (mp_limb_t *) flint_calloc(flint_mul_sizes(rows, words),
+                                                           sizeof(mp_limb_t));
+
+        for (i = 0; i < rows; i++)
+            A->rows[i] = A->entries + i * words;
+    }
+    else
+    {
+        A->entries = NULL;
+
+        for (i = 0; i < rows; i++)
+            A->rows[i] = NULL;
+    }
+
+    A->r = rows;
+    A->c = cols;
+}
@@ -0,0 +1,32 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+int
+gf2_mat_is_zero(const gf2_mat_t A)
+{
+    slong i, j, n = A->c / FLINT_BITS;
+    mp_limb_t mask = GF2_MAT_LAST_MASK(A->c);
+
+    if (A->c == 0)
+        return 1;
+
+    for (i = 0; i < A->r; i++)
+    {
+        for (j = 0; j < n; j++)
+            if (A->rows[i][j] != 0)
+                return 0;
+
+        if (A->c % FLINT_BITS && (A->rows[i][n] & mask))
+            return 0;
+    }
+
+    return 1;
+}
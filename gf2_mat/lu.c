@@ -0,0 +1,88 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+slong
+gf2_mat_lu(slong * P, gf2_mat_t A, int rank_check)
+{
+    slong i, j, m, n, w, words, rank, row, col;
+    mp_limb_t bit, first, last;
+    mp_limb_t ** a;
+    mp_ptr u;
+
+    m = A->r;
+    n = A->c;
+    a = A->rows;
+    words = GF2_MAT_WORDS(n);
+    last = GF2_MAT_LAST_MASK(n);
+
+    rank = row = col = 0;
+
+    for (i = 0; i < m; i++)
+        P[i] = i;
+
+    while (row < m && col < n)
+    {
+        w = col / FLINT_BITS;
+        bit = UWORD(1) << (col % FLINT_BITS);
+
+        for (j = row; j < m; j++)
+            if (a[j][w] & bit)
+                break;
+
+        if (j == m)
+        {
+            if (rank_check)
+                return 0;
+            col++;
+            continue;
+        }
+
+        if (j != row)
+        {
+            u = a[j];
+            a[j] = a[row];
+            a[row] = u;
+
+            i = P[j];
+            P[j] = P[row];
+            P[row] = i;
+        }
+
+        rank++;
+
+        /* the bits of the pivot row to the right of the pivot */
+        first = ~((bit << 1) - 1);
+        if (w == words - 1)
+            first &= last;
+
+        for (i = row + 1; i < m; i++)
+        {
+            if (!(a[i][w] & bit))
+                continue;
+
+            a[i][w] ^= a[row][w] & first;
+
+            for (j = w + 1; j < words - 1; j++)
+                a[i][j] ^= a[row][j];
+
+            if (w < words - 1)
+                a[i][words - 1] ^= a[row][words - 1] & last;
+
+            a[i][w] &= ~bit;
+            a[i][(rank - 1) / FLINT_BITS] |= UWORD(1) << ((rank - 1) % FLINT_BITS);
+        }
+
+        row++;
+        col++;
+    }
+
+    return rank;
+}
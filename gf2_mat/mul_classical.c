@@ -0,0 +1,57 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+gf2_mat_mul_classical(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    slong i, j, m = A->r, n = B->c;
+    mp_limb_t t, k;
+
+    if (A->c != B->r || C->r != m || C->c != n)
+    {
+        flint_printf("Exception (gf2_mat_mul_classical). Incompatible dimensions.\n");
+        flint_abort();
+    }
+
+    if (n == 0)
+        return;
+
+    if (C == A || C == B)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, m, n);
+        gf2_mat_mul_classical(T, A, B);
+        gf2_mat_set(C, T);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    for (i = 0; i < m; i++)
+    {
+        _gf2_vec_zero(C->rows[i], n);
+
+        for (j = 0; j < A->c; j += FLINT_BITS)
+        {
+            t = A->rows[i][j / FLINT_BITS];
+
+            if (A->c - j < FLINT_BITS)
+                t &= GF2_MAT_LAST_MASK(A->c);
+
+            /* add the rows of B selected by the set bits of t */
+            while (t != 0)
+            {
+                count_trailing_zeros(k, t);
+                t &= t - 1;
+                _gf2_vec_add(C->rows[i], B->rows[j + k], n);
+            }
+        }
+    }
+}
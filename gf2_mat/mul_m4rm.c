@@ -0,0 +1,35 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+gf2_mat_mul_m4rm(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    slong m = A->r, n = B->c;
+
+    if (A->c != B->r || C->r != m || C->c != n)
+    {
+        flint_printf("Exception (gf2_mat_mul_m4rm). Incompatible dimensions.\n");
+        flint_abort();
+    }
+
+    if (C == A || C == B)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, m, n);
+        gf2_mat_mul_m4rm(T, A, B);
+        gf2_mat_set(C, T);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    gf2_mat_zero(C);
+    _gf2_mat_addmul_m4rm(C, A, B);
+}
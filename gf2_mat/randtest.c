@@ -0,0 +1,37 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+gf2_mat_randtest(gf2_mat_t A, flint_rand_t state)
+{
+    slong i, j, words = GF2_MAT_WORDS(A->c);
+    mp_limb_t t, mask = GF2_MAT_LAST_MASK(A->c);
+    int sparse = n_randint(state, 4) == 0;
+
+    if (A->c == 0)
+        return;
+
+    for (i = 0; i < A->r; i++)
+    {
+        for (j = 0; j < words; j++)
+        {
+            t = n_randlimb(state);
+
+            if (sparse)
+                t &= n_randlimb(state) & n_randlimb(state) & n_randlimb(state);
+
+            if (j == words - 1)
+                t = (A->rows[i][j] & ~mask) | (t & mask);
+
+            A->rows[i][j] = t;
+        }
+    }
+}
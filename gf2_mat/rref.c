@@ -0,0 +1,146 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+/* number of columns eliminated at once with a table of combinations */
+#define GF2_MAT_RREF_K 8
+
+slong
+gf2_mat_rref(gf2_mat_t A)
+{
+    slong i, j, t, m, n, w, words, len, r, col, kk, np, b;
+    slong pc[GF2_MAT_RREF_K];
+    unsigned char lookup[1 << GF2_MAT_RREF_K];
+    mp_limb_t x, s, last;
+    mp_limb_t ** a;
+    mp_ptr T, Tj, u;
+
+    m = A->r;
+    n = A->c;
+    a = A->rows;
+
+    if (m == 0 || n == 0)
+        return 0;
+
+    words = GF2_MAT_WORDS(n);
+    last = GF2_MAT_LAST_MASK(n);
+
+    T = flint_malloc((WORD(1) << GF2_MAT_RREF_K) * words * sizeof(mp_limb_t));
+
+    r = 0;
+    col = 0;
+
+    while (col < n && r < m)
+    {
+        /* a strip of up to K columns inside one limb */
+        w = col / FLINT_BITS;
+        b = col % FLINT_BITS;
+        kk = FLINT_MIN(GF2_MAT_RREF_K, FLINT_MIN(n - col, FLINT_BITS - b));
+        len = n - w * FLINT_BITS;
+
+        /*
+            Find pivots for the strip among rows r, r + 1, ..., keeping
+            the pivot rows reduced with respect to each other. Candidates
+            are tested on the limb of the strip only.
+        */
+        np = 0;
+
+        for (j = col; j < col + kk && r + np < m; j++)
+        {
+            s = UWORD(1) << (j % FLINT_BITS);
+
+            for (i = r + np; i < m; i++)
+            {
+                x = a[i][w];
+
+                for (t = 0; t < np; t++)
+                    if (a[i][w] & (UWORD(1) << (pc[t] % FLINT_BITS)))
+                        x ^= a[r + t][w];
+
+                if (x & s)
+                    break;
+            }
+
+            if (i == m)
+                continue;
+
+            for (t = 0; t < np; t++)
+                if (a[i][w] & (UWORD(1) << (pc[t] % FLINT_BITS)))
+                    _gf2_vec_add(a[i] + w, a[r + t] + w, len);
+
+            u = a[i];
+            a[i] = a[r + np];
+            a[r + np] = u;
+
+            for (t = 0; t < np; t++)
+                if (a[r + t][w] & s)
+                    _gf2_vec_add(a[r + t] + w, a[r + np] + w, len);
+
+            pc[np] = j;
+            np++;
+        }
+
+        if (np == 0)
+        {
+            col += kk;
+            continue;
+        }
+
+        /* all 2^np sums of the pivot rows, from limb w on */
+        for (i = 0; i < words - w; i++)
+            T[i] = 0;
+
+        for (j = 1; j < (WORD(1) << np); j++)
+        {
+            Tj = T + j * (words - w);
+            u = T + (j & (j - 1)) * (words - w);
+            count_trailing_zeros(x, j);
+
+            for (i = 0; i < words - w; i++)
+                Tj[i] = u[i] ^ a[r + x][w + i];
+
+            Tj[words - w - 1] &= last;
+        }
+
+        /* map the bits of the strip to the sum clearing its pivot bits */
+        for (j = 0; j < (WORD(1) << kk); j++)
+        {
+            lookup[j] = 0;
+
+            for (t = 0; t < np; t++)
+                if (j & (WORD(1) << (pc[t] - col)))
+                    lookup[j] |= (1 << t);
+        }
+
+        for (i = 0; i < m; i++)
+        {
+            if (i >= r && i < r + np)
+                continue;
+
+            x = (a[i][w] >> b) & ((UWORD(1) << kk) - 1);
+            j = lookup[x];
+
+            if (j != 0)
+            {
+                Tj = T + j * (words - w);
+
+                for (t = 0; t < words - w; t++)
+                    a[i][w + t] ^= Tj[t];
+            }
+        }
+
+        r += np;
+        col += kk;
+    }
+
+    flint_free(T);
+
+    return r;
+}
@@ -0,0 +1,55 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+int
+gf2_mat_solve(gf2_mat_t X, const gf2_mat_t A, const gf2_mat_t B)
+{
+    slong i, n, k, off;
+    gf2_mat_t T, W;
+    int result;
+
+    n = A->r;
+    k = B->c;
+
+    if (n == 0)
+        return 1;
+
+    /* [A | B], with B starting on a limb boundary */
+    off = FLINT_BITS * GF2_MAT_WORDS(n);
+    gf2_mat_init(T, n, off + k);
+
+    gf2_mat_window_init(W, T, 0, 0, n, n);
+    gf2_mat_set(W, A);
+    gf2_mat_window_clear(W);
+
+    gf2_mat_window_init(W, T, 0, off, n, off + k);
+    gf2_mat_set(W, B);
+    gf2_mat_window_clear(W);
+
+    gf2_mat_rref(T);
+
+    /* A is invertible iff the left block of the rref is the identity */
+    result = 1;
+    for (i = 0; i < n && result; i++)
+        result = gf2_mat_get_entry(T, i, i);
+
+    /* the rows of T have been permuted, so take the window afterwards */
+    if (result)
+    {
+        gf2_mat_window_init(W, T, 0, off, n, off + k);
+        gf2_mat_set(X, W);
+        gf2_mat_window_clear(W);
+    }
+
+    gf2_mat_clear(T);
+
+    return result;
+}
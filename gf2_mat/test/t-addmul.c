@@ -0,0 +1,70 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("addmul....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 500 * flint_test_multiplier(); iter++)
+    {
+        gf2_mat_t A, B, C;
+        nmod_mat_t a, b, c, d;
+        slong m, k, n;
+
+        m = n_randint(state, 150);
+        k = n_randint(state, 150);
+        n = n_randint(state, 150);
+
+        gf2_mat_init(A, m, k);
+        gf2_mat_init(B, k, n);
+        gf2_mat_init(C, m, n);
+        nmod_mat_init(a, m, k, 2);
+        nmod_mat_init(b, k, n, 2);
+        nmod_mat_init(c, m, n, 2);
+        nmod_mat_init(d, m, n, 2);
+
+        gf2_mat_randtest(A, state);
+        gf2_mat_randtest(B, state);
+        gf2_mat_randtest(C, state);
+
+        gf2_mat_get_nmod_mat(a, A);
+        gf2_mat_get_nmod_mat(b, B);
+        gf2_mat_get_nmod_mat(c, C);
+        nmod_mat_addmul(c, c, a, b);
+
+        gf2_mat_addmul(C, A, B);
+        gf2_mat_get_nmod_mat(d, C);
+
+        if (!nmod_mat_equal(c, d))
+        {
+            flint_printf("FAIL: m = %wd, k = %wd, n = %wd\n", m, k, n);
+            abort();
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        gf2_mat_clear(C);
+        nmod_mat_clear(a);
+        nmod_mat_clear(b);
+        nmod_mat_clear(c);
+        nmod_mat_clear(d);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 500 * flint_test_multiplier(); iter++)
+    {
+        gf2_mat_t A, B, C, D, E, W;
+        nmod_mat_t a, b, c, d;
+        slong m, k, n, off, alg;
+
+        if (n_randint(state, 10) == 0)
+        {
+            m = n_randint(state, 600);
+            k = n_randint(state, 600);
+            n = n_randint(state, 600);
+        }
+        else
+        {
+            m = n_randint(state, 150);
+            k = n_randint(state, 150);
+            n = n_randint(state, 150);
+        }
+
+        gf2_mat_init(A, m, k);
+        gf2_mat_init(B, k, n);
+        gf2_mat_init(C, m, n);
+        nmod_mat_init(a, m, k, 2);
+        nmod_mat_init(b, k, n, 2);
+        nmod_mat_init(c, m, n, 2);
+        nmod_mat_init(d, m, n, 2);
+
+        gf2_mat_randtest(A, state);
+        gf2_mat_randtest(B, state);
+        gf2_mat_randtest(C, state);
+
+        gf2_mat_get_nmod_mat(a, A);
+        gf2_mat_get_nmod_mat(b, B);
+        nmod_mat_mul(c, a, b);
+
+        alg = n_randint(state, 4);
+
+        if (alg == 0)
+            gf2_mat_mul_classical(C, A, B);
+        else if (alg == 1)
+            gf2_mat_mul_m4rm(C, A, B);
+        else if (alg == 2)
+            gf2_mat_mul_strassen(C, A, B);
+        else
+            gf2_mat_mul(C, A, B);
+
+        gf2_mat_get_nmod_mat(d, C);
+
+        if (!nmod_mat_equal(c, d))
+        {
+            flint_printf("FAIL: alg = %wd, m = %wd, k = %wd, n = %wd\n",
+                                                              alg, m, k, n);
+            abort();
+        }
+
+        /* the product written to a window leaves the rest unchanged */
+        off = FLINT_BITS * n_randint(state, 3);
+        gf2_mat_init(D, m + 2, off + n + n_randint(state, 100));
+        gf2_mat_randtest(D, state);
+        gf2_mat_init_set(E, D);
+        gf2_mat_window_init(W, D, 1, off, m + 1, off + n);
+
+        if (alg == 0)
+            gf2_mat_mul_classical(W, A, B);
+        else if (alg == 1)
+            gf2_mat_mul_m4rm(W, A, B);
+        else if (alg == 2)
+            gf2_mat_mul_strassen(W, A, B);
+        else
+            gf2_mat_mul(W, A, B);
+
+        gf2_mat_window_clear(W);
+        gf2_mat_window_init(W, E, 1, off, m + 1, off + n);
+        gf2_mat_set(W, C);
+        gf2_mat_window_clear(W);
+
+        if (!gf2_mat_equal(D, E))
+        {
+            flint_printf("FAIL: window, alg = %wd, m = %wd, k = %wd, n = %wd\n",
+                                                              alg, m, k, n);
+            abort();
+        }
+
+        /* aliasing */
+        if (k == n)
+        {
+            gf2_mat_set(C, A);
+            gf2_mat_mul(C, C, B);
+            gf2_mat_get_nmod_mat(d, C);
+
+            if (!nmod_mat_equal(c, d))
+            {
+                flint_printf("FAIL: aliasing\n");
+                abort();
+            }
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        gf2_mat_clear(C);
+        gf2_mat_clear(D);
+        gf2_mat_clear(E);
+        nmod_mat_clear(a);
+        nmod_mat_clear(b);
+        nmod_mat_clear(c);
+        nmod_mat_clear(d);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,74 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("nullspace....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        nmod_mat_t a;
+        gf2_mat_t A, B, ker;
+        slong m, n, r, d, nullity, nulrank;
+
+        m = n_randint(state, 150);
+        n = n_randint(state, 150);
+        r = n_randint(state, FLINT_MIN(m, n) + 1);
+
+        nmod_mat_init(a, m, n, 2);
+        nmod_mat_randrank(a, state, r);
+
+        if (n_randint(state, 2))
+        {
+            d = n_randint(state, 2*m*n + 1);
+            nmod_mat_randops(a, d, state);
+        }
+
+        gf2_mat_init(A, m, n);
+        gf2_mat_set_nmod_mat(A, a);
+        gf2_mat_init(ker, n, n);
+        gf2_mat_init(B, m, n);
+
+        nullity = gf2_mat_nullspace(ker, A);
+        nulrank = gf2_mat_rank(ker);
+
+        if (nullity != nulrank || nullity != n - r)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("rank(A) = %wd, nullity = %wd, rank(ker) = %wd\n",
+                                                         r, nullity, nulrank);
+            abort();
+        }
+
+        gf2_mat_mul(B, A, ker);
+
+        if (!gf2_mat_is_zero(B))
+        {
+            flint_printf("FAIL: A * ker != 0\n");
+            abort();
+        }
+
+        nmod_mat_clear(a);
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        gf2_mat_clear(ker);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,68 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("rref....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 500 * flint_test_multiplier(); iter++)
+    {
+        nmod_mat_t A, B;
+        gf2_mat_t R;
+        slong m, n, r, d, rank, rank2;
+
+        m = n_randint(state, 150);
+        n = n_randint(state, 150);
+        r = n_randint(state, FLINT_MIN(m, n) + 1);
+
+        nmod_mat_init(A, m, n, 2);
+        nmod_mat_init(B, m, n, 2);
+        nmod_mat_randrank(A, state, r);
+
+        if (n_randint(state, 2))
+        {
+            d = n_randint(state, 2*m*n + 1);
+            nmod_mat_randops(A, d, state);
+        }
+
+        gf2_mat_init(R, m, n);
+        gf2_mat_set_nmod_mat(R, A);
+
+        rank = gf2_mat_rref(R);
+        rank2 = gf2_mat_rank(R);
+
+        gf2_mat_get_nmod_mat(B, R);
+        nmod_mat_rref(A);
+
+        if (rank != r || rank2 != r || !nmod_mat_equal(A, B))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("r = %wd, rank = %wd, rank2 = %wd\n", r, rank, rank2);
+            nmod_mat_print_pretty(A);
+            gf2_mat_print_pretty(R);
+            abort();
+        }
+
+        nmod_mat_clear(A);
+        nmod_mat_clear(B);
+        gf2_mat_clear(R);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,66 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("solve....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 500 * flint_test_multiplier(); iter++)
+    {
+        nmod_mat_t a;
+        gf2_mat_t A, X, B, AX;
+        slong n, k, r;
+        int solved;
+
+        n = n_randint(state, 150);
+        k = n_randint(state, 150);
+        r = n_randint(state, 4) ? n : n_randint(state, n + 1);
+
+        nmod_mat_init(a, n, n, 2);
+        nmod_mat_randrank(a, state, r);
+        nmod_mat_randops(a, n_randint(state, 2*n*n + 1), state);
+
+        gf2_mat_init(A, n, n);
+        gf2_mat_init(B, n, k);
+        gf2_mat_init(X, n, k);
+        gf2_mat_init(AX, n, k);
+
+        gf2_mat_set_nmod_mat(A, a);
+        gf2_mat_randtest(B, state);
+
+        solved = gf2_mat_solve(X, A, B);
+        gf2_mat_mul(AX, A, X);
+
+        if (solved != (r == n) || (solved && !gf2_mat_equal(AX, B)))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("n = %wd, k = %wd, r = %wd, solved = %d\n",
+                                                         n, k, r, solved);
+            abort();
+        }
+
+        nmod_mat_clear(a);
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        gf2_mat_clear(X);
+        gf2_mat_clear(AX);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
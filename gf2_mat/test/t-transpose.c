@@ -0,0 +1,78 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("transpose....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        gf2_mat_t A, B, C;
+        nmod_mat_t a, b, c;
+        slong m, n;
+
+        m = n_randint(state, 200);
+        n = n_randint(state, 200);
+
+        gf2_mat_init(A, m, n);
+        gf2_mat_init(B, n, m);
+        gf2_mat_init(C, m, n);
+        nmod_mat_init(a, m, n, 2);
+        nmod_mat_init(b, n, m, 2);
+        nmod_mat_init(c, n, m, 2);
+
+        gf2_mat_randtest(A, state);
+        gf2_mat_randtest(B, state);
+        gf2_mat_transpose(B, A);
+
+        gf2_mat_get_nmod_mat(a, A);
+        nmod_mat_transpose(b, a);
+        gf2_mat_get_nmod_mat(c, B);
+
+        if (!nmod_mat_equal(b, c))
+        {
+            flint_printf("FAIL: transpose\n");
+            gf2_mat_print_pretty(A);
+            gf2_mat_print_pretty(B);
+            abort();
+        }
+
+        gf2_mat_set(C, A);
+
+        if (m == n)
+        {
+            gf2_mat_transpose(C, C);
+
+            if (!gf2_mat_equal(B, C))
+            {
+                flint_printf("FAIL: aliasing\n");
+                abort();
+            }
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        gf2_mat_clear(C);
+        nmod_mat_clear(a);
+        nmod_mat_clear(b);
+        nmod_mat_clear(c);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
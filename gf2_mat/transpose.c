@@ -0,0 +1,83 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+/* transpose the FLINT_BITS x FLINT_BITS bit matrix with rows x[0], x[1], ... */
+static void
+_gf2_mat_transpose_block(mp_limb_t * x)
+{
+    slong j, k;
+    mp_limb_t m, t;
+
+    m = (UWORD(1) << (FLINT_BITS / 2)) - 1;
+
+    for (j = FLINT_BITS / 2; j != 0; j >>= 1, m ^= (m << j))
+    {
+        for (k = 0; k < FLINT_BITS; k = ((k | j) + 1) & ~j)
+        {
+            t = ((x[k] >> j) ^ x[k | j]) & m;
+            x[k] ^= t << j;
+            x[k | j] ^= t;
+        }
+    }
+}
+
+void
+gf2_mat_transpose(gf2_mat_t B, const gf2_mat_t A)
+{
+    mp_limb_t x[FLINT_BITS], mask;
+    mp_limb_t * w;
+    slong i, j, k, rows, cols;
+
+    if (B->r != A->c || B->c != A->r)
+    {
+        flint_printf("Exception (gf2_mat_transpose). Incompatible dimensions.\n");
+        flint_abort();
+    }
+
+    if (A->r == 0 || A->c == 0)
+        return;
+
+    if (A == B)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, A->c, A->r);
+        gf2_mat_transpose(T, A);
+        gf2_mat_set(B, T);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    /* transpose FLINT_BITS x FLINT_BITS blocks in registers */
+    for (i = 0; i < A->r; i += FLINT_BITS)
+    {
+        rows = FLINT_MIN(FLINT_BITS, A->r - i);
+
+        for (j = 0; j < A->c; j += FLINT_BITS)
+        {
+            cols = FLINT_MIN(FLINT_BITS, A->c - j);
+
+            mask = GF2_MAT_LAST_MASK(cols);
+            for (k = 0; k < rows; k++)
+                x[k] = A->rows[i + k][j / FLINT_BITS] & mask;
+            for ( ; k < FLINT_BITS; k++)
+                x[k] = 0;
+
+            _gf2_mat_transpose_block(x);
+
+            mask = GF2_MAT_LAST_MASK(rows);
+            for (k = 0; k < cols; k++)
+            {
+                w = B->rows[j + k] + i / FLINT_BITS;
+                *w = (*w & ~mask) | x[k];
+            }
+        }
+    }
+}
@@ -14,6 +14,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "flint.h"
 #include "thread_pool.h"
 
@@ -46,6 +47,40 @@ void __flint_set_memory_functions_init()
 }
 #endif
 
+/* the arena that flint_malloc and friends allocate from on this thread */
+FLINT_TLS_PREFIX flint_arena_struct * flint_arena_current = NULL;
+
+/*
+   The address ranges of the chunks of the arenas which have been made
+   current, so that flint_free and flint_realloc recognise arena memory on
+   any thread without looking at the memory they are passed. Entries are
+   reused but never freed, so that the list can be walked without a lock;
+   with atomics, each entry is read consistently through its sequence
+   number, which is odd while the entry is being changed. The number of
+   ranges in use tells whether there is any arena memory to look for.
+*/
+typedef struct flint_arena_range_struct
+{
+   size_t seq;
+   char * start;
+   char * end;
+   struct flint_arena_range_struct * next;
+} flint_arena_range_struct;
+
+#if FLINT_USES_PTHREAD && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+#define ARENA_ATOMICS 1
+#else
+#define ARENA_ATOMICS 0
+#endif
+
+static flint_arena_range_struct * flint_arena_ranges = NULL;
+
+static slong flint_arena_num = 0;
+
+#if FLINT_USES_PTHREAD
+static pthread_mutex_t flint_arena_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
 static void flint_memory_error(size_t size)
 {
     flint_printf("Exception (FLINT memory_manager). Unable to allocate memory (%ld).\n", size);
@@ -86,9 +121,19 @@ void * _flint_malloc(size_t size)
    return ptr;
 }
 
+static void * _flint_arena_malloc(flint_arena_struct * A, size_t size);
+static int _flint_arena_in_use(void);
+static int _flint_arena_realloc(void ** ptr2, void * ptr, size_t size);
+static int _flint_arena_free(void * ptr);
+
 FLINT_WARN_UNUSED void * flint_malloc(size_t size)
 {
-   void * ptr = (*__flint_allocate_func)(size);
+   void * ptr;
+
+   if (flint_arena_current != NULL)
+      return _flint_arena_malloc(flint_arena_current, size);
+
+   ptr = (*__flint_allocate_func)(size);
 
    if (ptr == NULL)
         flint_memory_error(size);
@@ -113,11 +158,14 @@ void * _flint_realloc(void * ptr, size_t size)
 FLINT_WARN_UNUSED void * flint_realloc(void * ptr, size_t size)
 {
     void * ptr2;
-  
-    if (ptr)
-      ptr2 = (*__flint_reallocate_func)(ptr, size);
-    else
-      ptr2 = (*__flint_allocate_func)(size);
+
+    if (ptr == NULL)
+      return flint_malloc(size);
+
+    if (_flint_arena_in_use() && _flint_arena_realloc(&ptr2, ptr, size))
+      return ptr2;
+
+    ptr2 = (*__flint_reallocate_func)(ptr, size);
 
     if (ptr2 == NULL)
         flint_memory_error(size);
@@ -142,6 +190,16 @@ FLINT_WARN_UNUSED void * flint_calloc(size_t num, size_t size)
 {
    void * ptr;
 
+    if (flint_arena_current != NULL)
+    {
+        if (size != 0 && num > ((size_t) -1)/size)
+            flint_memory_error(size);
+
+        ptr = _flint_arena_malloc(flint_arena_current, num*size);
+        memset(ptr, 0, num*size);
+        return ptr;
+    }
+
     ptr = (*__flint_callocate_func)(num, size);
 
     if (ptr == NULL)
@@ -159,9 +217,359 @@ void _flint_free(void * ptr)
 
 void flint_free(void * ptr)
 {
+   if (ptr != NULL && _flint_arena_in_use() && _flint_arena_free(ptr))
+      return;
+
    (*__flint_free_func)(ptr);
 }
 
+/* round up to a multiple of FLINT_ARENA_ALIGN */
+#define ARENA_ROUND(size) \
+   (((size) + FLINT_ARENA_ALIGN - 1) & ~((size_t) FLINT_ARENA_ALIGN - 1))
+
+/* size of the header of a chunk */
+#define ARENA_CHUNK_HEADER ARENA_ROUND(sizeof(flint_arena_chunk_struct))
+
+#define ARENA_DEFAULT_CHUNK_SIZE 65536
+
+void flint_arena_init(flint_arena_t A, size_t chunk_size)
+{
+   A->ptr = NULL;
+   A->end = NULL;
+   A->chunk = NULL;
+   A->spare = NULL;
+   A->chunk_size = chunk_size != 0 ? chunk_size : ARENA_DEFAULT_CHUNK_SIZE;
+   A->registered = 0;
+}
+
+/* change a range entry, with flint_arena_lock held */
+static void _flint_arena_range_set(flint_arena_range_struct * r,
+                                                      char * start, char * end)
+{
+#if ARENA_ATOMICS
+   size_t seq = r->seq;
+
+   __atomic_store_n(&(r->seq), seq + 1, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+   __atomic_store_n(&(r->start), start, __ATOMIC_RELAXED);
+   __atomic_store_n(&(r->end), end, __ATOMIC_RELAXED);
+   __atomic_store_n(&(r->seq), seq + 2, __ATOMIC_RELEASE);
+#else
+   r->start = start;
+   r->end = end;
+#endif
+}
+
+/* make the chunks in the list c known to flint_free and friends */
+static void _flint_arena_add_ranges(flint_arena_chunk_struct * c)
+{
+   flint_arena_range_struct * r;
+
+#if FLINT_USES_PTHREAD
+   pthread_mutex_lock(&flint_arena_lock);
+#endif
+
+   for ( ; c != NULL; c = c->next)
+   {
+      for (r = flint_arena_ranges; r != NULL && r->start != NULL; r = r->next)
+         ;
+
+      if (r == NULL)
+      {
+         r = (flint_arena_range_struct *)
+                   (*__flint_allocate_func)(sizeof(flint_arena_range_struct));
+
+         if (r == NULL)
+            flint_memory_error(sizeof(flint_arena_range_struct));
+
+         r->seq = 0;
+         r->start = NULL;
+         r->end = NULL;
+         r->next = flint_arena_ranges;
+#if ARENA_ATOMICS
+         __atomic_store_n(&flint_arena_ranges, r, __ATOMIC_RELEASE);
+#else
+         flint_arena_ranges = r;
+#endif
+      }
+
+      _flint_arena_range_set(r, (char *) c, c->end);
+
+#if ARENA_ATOMICS
+      __atomic_add_fetch(&flint_arena_num, 1, __ATOMIC_RELAXED);
+#else
+      flint_arena_num++;
+#endif
+   }
+
+#if FLINT_USES_PTHREAD
+   pthread_mutex_unlock(&flint_arena_lock);
+#endif
+}
+
+static void _flint_arena_remove_ranges(flint_arena_chunk_struct * c)
+{
+   flint_arena_range_struct * r;
+
+#if FLINT_USES_PTHREAD
+   pthread_mutex_lock(&flint_arena_lock);
+#endif
+
+   for ( ; c != NULL; c = c->next)
+   {
+      for (r = flint_arena_ranges; r->start != (char *) c; r = r->next)
+         ;
+
+      _flint_arena_range_set(r, NULL, NULL);
+
+#if ARENA_ATOMICS
+      __atomic_sub_fetch(&flint_arena_num, 1, __ATOMIC_RELAXED);
+#else
+      flint_arena_num--;
+#endif
+   }
+
+#if FLINT_USES_PTHREAD
+   pthread_mutex_unlock(&flint_arena_lock);
+#endif
+}
+
+/*
+   Whether there may be arena memory to look for. Memory only reaches
+   another thread through some synchronisation, after which that thread
+   sees the ranges of its chunks.
+*/
+static int _flint_arena_in_use(void)
+{
+#if ARENA_ATOMICS
+   return __atomic_load_n(&flint_arena_num, __ATOMIC_RELAXED) != 0;
+#elif FLINT_USES_PTHREAD
+   slong num;
+
+   pthread_mutex_lock(&flint_arena_lock);
+   num = flint_arena_num;
+   pthread_mutex_unlock(&flint_arena_lock);
+
+   return num != 0;
+#else
+   return flint_arena_num != 0;
+#endif
+}
+
+/* whether ptr lies in a chunk of an arena which has been made current */
+static int _flint_arena_contains(const void * ptr)
+{
+   flint_arena_range_struct * r;
+   const char * start, * end;
+   int found = 0;
+
+#if ARENA_ATOMICS
+   size_t seq;
+
+   for (r = __atomic_load_n(&flint_arena_ranges, __ATOMIC_ACQUIRE);
+                                               r != NULL && !found; r = r->next)
+   {
+      do {
+         seq = __atomic_load_n(&(r->seq), __ATOMIC_ACQUIRE);
+         start = __atomic_load_n(&(r->start), __ATOMIC_RELAXED);
+         end = __atomic_load_n(&(r->end), __ATOMIC_RELAXED);
+         __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      } while ((seq & 1) || seq != __atomic_load_n(&(r->seq), __ATOMIC_RELAXED));
+
+      found = (const char *) ptr >= start && (const char *) ptr < end;
+   }
+#else
+#if FLINT_USES_PTHREAD
+   pthread_mutex_lock(&flint_arena_lock);
+#endif
+
+   for (r = flint_arena_ranges; r != NULL && !found; r = r->next)
+   {
+      start = r->start;
+      end = r->end;
+      found = (const char *) ptr >= start && (const char *) ptr < end;
+   }
+
+#if FLINT_USES_PTHREAD
+   pthread_mutex_unlock(&flint_arena_lock);
+#endif
+#endif
+
+   return found;
+}
+
+static void _flint_arena_free_chunks(flint_arena_chunk_struct * c)
+{
+   flint_arena_chunk_struct * next;
+
+   for ( ; c != NULL; c = next)
+   {
+      next = c->next;
+      (*__flint_free_func)(c);
+   }
+}
+
+void flint_arena_clear(flint_arena_t A)
+{
+   if (A->registered)
+   {
+      _flint_arena_remove_ranges(A->chunk);
+      _flint_arena_remove_ranges(A->spare);
+   }
+
+   _flint_arena_free_chunks(A->chunk);
+   _flint_arena_free_chunks(A->spare);
+}
+
+/* slow path of flint_arena_alloc, size is already rounded */
+void * _flint_arena_alloc(flint_arena_t A, size_t size)
+{
+   flint_arena_chunk_struct * c, ** p;
+   void * ptr;
+
+   /* reuse a released chunk if one is large enough */
+   for (p = &A->spare; *p != NULL; p = &((*p)->next))
+   {
+      if ((size_t) ((*p)->end - (char *) (*p)) >= size + ARENA_CHUNK_HEADER)
+         break;
+   }
+
+   if (*p != NULL)
+   {
+      c = *p;
+      *p = c->next;
+   }
+   else
+   {
+      size_t chunk_size = FLINT_MAX(A->chunk_size, size + ARENA_CHUNK_HEADER);
+
+      c = (flint_arena_chunk_struct *) (*__flint_allocate_func)(chunk_size);
+
+      if (c == NULL)
+         flint_memory_error(chunk_size);
+
+      c->end = (char *) c + chunk_size;
+      c->next = NULL;
+
+      if (A->registered)
+         _flint_arena_add_ranges(c);
+
+      /* grow geometrically so that there are few chunks */
+      A->chunk_size = 2*chunk_size;
+   }
+
+   c->next = A->chunk;
+   A->chunk = c;
+
+   ptr = (char *) c + ARENA_CHUNK_HEADER;
+   A->ptr = (char *) ptr + size;
+   A->end = c->end;
+
+   return ptr;
+}
+
+void flint_arena_release(flint_arena_t A, const flint_arena_mark_t mark)
+{
+   flint_arena_chunk_struct * c;
+
+   while (A->chunk != mark->chunk)
+   {
+      c = A->chunk;
+      A->chunk = c->next;
+      c->next = A->spare;
+      A->spare = c;
+   }
+
+   A->ptr = mark->ptr;
+   A->end = (A->chunk != NULL) ? A->chunk->end : NULL;
+}
+
+flint_arena_struct * flint_arena_set_current(flint_arena_struct * A)
+{
+   flint_arena_struct * prev = flint_arena_current;
+
+   if (A != NULL && !A->registered)
+   {
+      _flint_arena_add_ranges(A->chunk);
+      _flint_arena_add_ranges(A->spare);
+      A->registered = 1;
+   }
+
+   flint_arena_current = A;
+
+   return prev;
+}
+
+/*
+   Memory handed out by flint_malloc from an arena is preceded by its size,
+   which flint_realloc needs to copy it. This is only read once the memory
+   is known to lie in an arena chunk.
+*/
+#define ARENA_BLOCK_SIZE(ptr) (((size_t *) (ptr))[-1])
+
+static void * _flint_arena_malloc(flint_arena_struct * A, size_t size)
+{
+   char * ptr;
+
+   if (size > ((size_t) -1) - 2*FLINT_ARENA_ALIGN)
+      flint_memory_error(size);
+
+   ptr = (char *) flint_arena_alloc(A, size + FLINT_ARENA_ALIGN)
+                                                         + FLINT_ARENA_ALIGN;
+
+   ARENA_BLOCK_SIZE(ptr) = size;
+
+   return ptr;
+}
+
+/* whether ptr is the most recent allocation of the current chunk of A */
+static int _flint_arena_is_last(const flint_arena_struct * A, const void * ptr)
+{
+   return A != NULL &&
+         (const char *) ptr + ARENA_ROUND(ARENA_BLOCK_SIZE(ptr)) == A->ptr;
+}
+
+/*
+   The most recent allocation of the current arena is freed, shrunk or grown
+   in place. Other arena memory, of this arena or of any other, is never
+   given back before its arena is released, and is copied to grow it.
+*/
+static int _flint_arena_realloc(void ** ptr2, void * ptr, size_t size)
+{
+   flint_arena_struct * A = flint_arena_current;
+
+   if (!_flint_arena_contains(ptr))
+      return 0;
+
+   if (_flint_arena_is_last(A, ptr) &&
+       size <= (size_t) (A->end - (char *) ptr) &&
+       ARENA_ROUND(size) <= (size_t) (A->end - (char *) ptr))
+   {
+      ARENA_BLOCK_SIZE(ptr) = size;
+      A->ptr = (char *) ptr + ARENA_ROUND(size);
+      *ptr2 = ptr;
+      return 1;
+   }
+
+   *ptr2 = flint_malloc(size);
+   memcpy(*ptr2, ptr, FLINT_MIN(ARENA_BLOCK_SIZE(ptr), size));
+
+   return 1;
+}
+
+static int _flint_arena_free(void * ptr)
+{
+   flint_arena_struct * A = flint_arena_current;
+
+   if (!_flint_arena_contains(ptr))
+      return 0;
+
+   if (_flint_arena_is_last(A, ptr))
+      A->ptr = (char *) ptr - FLINT_ARENA_ALIGN;
+
+   return 1;
+}
+
 
 FLINT_TLS_PREFIX size_t flint_num_cleanup_functions = 0;
 
@@ -176,13 +584,18 @@ void register_init()
 
 void flint_register_cleanup_function(flint_cleanup_function_t cleanup_function)
 {
+    flint_arena_struct * arena;
+
 #if FLINT_REENTRANT && !FLINT_USES_TLS
     pthread_once(&register_initialised, register_init);
     pthread_mutex_lock(&register_lock);
 #endif
 
+    /* the registry outlives any arena */
+    arena = flint_arena_set_current(NULL);
     flint_cleanup_functions = flint_realloc(flint_cleanup_functions,
         (flint_num_cleanup_functions + 1) * sizeof(flint_cleanup_function_t));
+    flint_arena_set_current(arena);
 
     flint_cleanup_functions[flint_num_cleanup_functions] = cleanup_function;
 
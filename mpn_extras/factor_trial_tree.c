@@ -57,6 +57,8 @@ _factor_trial_tree_init(void)
 
     if (!_factor_trial_tree_initialised)
     {
+        flint_arena_struct * arena;
+
 	    primes = n_primes_arr_readonly(3512);
 
 	    flint_register_cleanup_function(_cleanup_trial_tree);
@@ -66,11 +68,13 @@ _factor_trial_tree_init(void)
 	        of products of primes
 	        Note there are 3512 primes less than 32768
 	    */
+        arena = flint_arena_set_current(NULL);
         for (i = 0; i < 13 - (FLINT_BITS/32); i++)
 	    {
 	        _factor_trial_tree[i] = (mp_ptr)
 		        flint_malloc(4096/(FLINT_BITS/16)*sizeof(mp_limb_t));
         }
+        flint_arena_set_current(arena);
 
 	    /* initialise products in first layer of tree */
 	    for (i = 0, j = 0; i < 3512; i+=(FLINT_BITS/16), j++)
@@ -120,6 +120,7 @@ FLINT_DLL void nmod_mat_concat_vertical(nmod_mat_t res,
 
 /* Random matrix generation */
 FLINT_DLL void nmod_mat_randtest(nmod_mat_t mat, flint_rand_t state);
+FLINT_DLL void nmod_mat_rand(nmod_mat_t mat, flint_rand_t state);
 FLINT_DLL void nmod_mat_randfull(nmod_mat_t mat, flint_rand_t state);
 FLINT_DLL int nmod_mat_randpermdiag(nmod_mat_t mat, flint_rand_t state,
                  mp_srcptr diag, slong n);
@@ -205,6 +206,11 @@ FLINT_DLL void nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmo
 FLINT_DLL void _nmod_mat_mul_classical_op(nmod_mat_t D, const nmod_mat_t C,
                                 const nmod_mat_t A, const nmod_mat_t B, int op);
 
+FLINT_DLL void _nmod_mat_addmul_blocked_threaded_pool_op(mp_ptr * D,
+        const mp_ptr * C, const mp_ptr * A, const mp_ptr * B, slong m, slong k,
+                                                slong n, int op, nmod_t mod,
+                        const thread_pool_handle * threads, slong num_threads);
+
 FLINT_DLL void nmod_mat_addmul(nmod_mat_t D, const nmod_mat_t C,
                                 const nmod_mat_t A, const nmod_mat_t B);
 
@@ -353,6 +359,8 @@ FLINT_DLL void nmod_mat_solve_triu_classical(nmod_mat_t X, const nmod_mat_t U, c
 FLINT_DLL slong nmod_mat_lu(slong * P, nmod_mat_t A, int rank_check);
 FLINT_DLL slong nmod_mat_lu_classical(slong * P, nmod_mat_t A, int rank_check);
 FLINT_DLL slong nmod_mat_lu_recursive(slong * P, nmod_mat_t A, int rank_check);
+FLINT_DLL slong nmod_mat_lu_tiled(slong * P, nmod_mat_t A, int rank_check);
+FLINT_DLL slong _nmod_mat_lu_tiled(slong * P, nmod_mat_t A, int rank_check, slong tile_size);
 
 /* Nonsingular solving */
 
@@ -406,6 +414,12 @@ FLINT_DLL void nmod_mat_similarity(nmod_mat_t M, slong r, ulong d);
 /* Size at which pre-transposing becomes faster in classical multiplication */
 #define NMOD_MAT_MUL_TRANSPOSE_CUTOFF 20
 
+/*
+   Maximum number of bits of the modulus for which classical multiplication
+   may use the cache blocked kernel (entries are packed into 32 bits)
+*/
+#define NMOD_MAT_MUL_BLOCKED_MAX_BITS 31
+
 /* Cutoff between classical and recursive triangular solving */
 #define NMOD_MAT_SOLVE_TRI_ROWS_CUTOFF 64
 #define NMOD_MAT_SOLVE_TRI_COLS_CUTOFF 64
@@ -413,6 +427,10 @@ FLINT_DLL void nmod_mat_similarity(nmod_mat_t M, slong r, ulong d);
 /* Cutoff between classical and recursive LU decomposition */
 #define NMOD_MAT_LU_RECURSIVE_CUTOFF 4
 
+/* Tile size of the threaded LU decomposition, and size from which it is used */
+#define NMOD_MAT_LU_TILE_SIZE 256
+#define NMOD_MAT_LU_TILED_CUTOFF 512
+
 /*
    Suggested initial modulus size for multimodular algorithms. This should
    be chosen so that we get the most number of bits per cycle
@@ -0,0 +1,457 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_vec.h"
+#include "thread_support.h"
+
+/*
+    The columns of A are split into tiles of nb columns. Step k factors the
+    panel given by tile k below the rows already eliminated, and then for
+    every later tile t solves its pivot rows with the unit lower triangle
+    of the panel (a solve task) and updates the rows below in blocks of nb
+    rows (update tasks). A task is ready as soon as the tiles it reads are,
+    so the panel of step k + 1 can start while step k still updates the
+    other tiles.
+
+    Only panels permute the rows of A. Each step keeps its own copy of the
+    row pointers, and its tasks take their rows from it, so that they are
+    not disturbed by the permutations of later panels. The multipliers of
+    step k stay in the columns of tile k until the end, where they are
+    moved to the columns after those of the previous steps.
+*/
+
+#define _SOLVE_TASK 0
+#define _UPDATE_TASK 1
+#define _PANEL_TASK 2
+
+typedef struct
+{
+    slong kind;
+    slong k;
+    slong t;
+    slong i;
+}
+_lu_task_struct;
+
+typedef struct
+{
+    nmod_mat_struct * A;
+    slong * P;
+    slong nb;
+    slong ntiles;
+    int rank_check;
+    /* for each step: rank before it, rank of its panel and its rows */
+    slong * r;
+    slong * rk;
+    nmod_mat_struct * B;
+    /* for each tile: number of steps applied to it and progress of the next */
+    slong * done;
+    slong * solved;
+    slong * next_block;
+    slong * blocks_done;
+    slong panels_started;
+    slong panels_done;
+    int failed;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+#endif
+}
+_lu_tiled_struct;
+
+typedef struct
+{
+    _lu_tiled_struct * S;
+    slong r0;
+    slong r1;
+}
+_lu_compress_arg_t;
+
+static void
+_apply_permutation(slong * AP, nmod_mat_t A, slong * P,
+    slong n, slong offset)
+{
+    if (n != 0)
+    {
+        mp_ptr * Atmp;
+        slong * APtmp;
+        slong i;
+
+        Atmp = flint_malloc(sizeof(mp_ptr) * n);
+        APtmp = flint_malloc(sizeof(slong) * n);
+
+        for (i = 0; i < n; i++) Atmp[i] = A->rows[P[i] + offset];
+        for (i = 0; i < n; i++) A->rows[i + offset] = Atmp[i];
+
+        for (i = 0; i < n; i++) APtmp[i] = AP[P[i] + offset];
+        for (i = 0; i < n; i++) AP[i + offset] = APtmp[i];
+
+        flint_free(Atmp);
+        flint_free(APtmp);
+    }
+}
+
+static slong
+_num_blocks(const _lu_tiled_struct * S, slong k)
+{
+    slong rows = S->A->r - S->r[k] - S->rk[k];
+
+    return (rows + S->nb - 1)/S->nb;
+}
+
+static void
+_finish_tile(_lu_tiled_struct * S, slong t)
+{
+    S->done[t]++;
+    S->solved[t] = 0;
+    S->next_block[t] = 0;
+    S->blocks_done[t] = 0;
+}
+
+/* called with the lock held, returns whether a task was found */
+static int
+_next_task(_lu_task_struct * T, _lu_tiled_struct * S)
+{
+    slong k, t;
+
+    /* steps of rank zero leave the other tiles unchanged */
+    for (t = S->panels_done; t < S->ntiles; t++)
+        while (S->done[t] < S->panels_done && S->rk[S->done[t]] == 0)
+            _finish_tile(S, t);
+
+    /* the panels are on the critical path */
+    k = S->panels_started;
+    if (k < S->ntiles && k == S->panels_done && S->done[k] == k)
+    {
+        T->kind = _PANEL_TASK;
+        T->k = k;
+        S->panels_started++;
+        return 1;
+    }
+
+    /* then the earliest tiles, which are needed by the next panels first */
+    for (t = S->panels_done; t < S->ntiles; t++)
+    {
+        k = S->done[t];
+
+        if (k >= S->panels_done)
+            continue;
+
+        if (S->solved[t] == 0)
+        {
+            T->kind = _SOLVE_TASK;
+            T->k = k;
+            T->t = t;
+            S->solved[t] = 1;
+            return 1;
+        }
+
+        if (S->solved[t] == 2 && S->next_block[t] < _num_blocks(S, k))
+        {
+            T->kind = _UPDATE_TASK;
+            T->k = k;
+            T->t = t;
+            T->i = S->next_block[t]++;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void
+_run_task(_lu_tiled_struct * S, const _lu_task_struct * T)
+{
+    nmod_mat_struct * A = S->A;
+    slong m = A->r, n = A->c, nb = S->nb;
+    slong k = T->k, r, rk, c0, t0, t1, i0, i1;
+    nmod_mat_t X, Y, Z;
+
+    c0 = k*nb;
+
+    if (T->kind == _PANEL_TASK)
+    {
+        slong * P1;
+
+        r = (k == 0) ? 0 : S->r[k - 1] + S->rk[k - 1];
+        rk = 0;
+
+        if (r < m)
+        {
+            P1 = flint_malloc(sizeof(slong) * (m - r));
+            nmod_mat_window_init(X, A, r, c0, m, FLINT_MIN(c0 + nb, n));
+
+            rk = nmod_mat_lu_recursive(P1, X, 0);
+
+            _apply_permutation(S->P, A, P1, m - r, r);
+
+            nmod_mat_window_clear(X);
+            flint_free(P1);
+        }
+
+        S->r[k] = r;
+        S->rk[k] = rk;
+
+        S->B[k].rows = flint_malloc(m*sizeof(mp_ptr));
+        for (i0 = 0; i0 < m; i0++)
+            S->B[k].rows[i0] = A->rows[i0];
+
+        return;
+    }
+
+    r = S->r[k];
+    rk = S->rk[k];
+    t0 = T->t*nb;
+    t1 = FLINT_MIN(t0 + nb, n);
+
+    nmod_mat_window_init(Y, S->B + k, r, t0, r + rk, t1);
+
+    if (T->kind == _SOLVE_TASK)
+    {
+        nmod_mat_window_init(X, S->B + k, r, c0, r + rk, c0 + rk);
+        nmod_mat_solve_tril(Y, X, Y, 1);
+        nmod_mat_window_clear(X);
+    }
+    else
+    {
+        i0 = r + rk + T->i*nb;
+        i1 = FLINT_MIN(i0 + nb, m);
+
+        nmod_mat_window_init(X, S->B + k, i0, c0, i1, c0 + rk);
+        nmod_mat_window_init(Z, S->B + k, i0, t0, i1, t1);
+        nmod_mat_submul(Z, Z, X, Y);
+        nmod_mat_window_clear(X);
+        nmod_mat_window_clear(Z);
+    }
+
+    nmod_mat_window_clear(Y);
+}
+
+/* called with the lock held */
+static void
+_complete_task(_lu_tiled_struct * S, const _lu_task_struct * T)
+{
+    slong m = S->A->r, n = S->A->c, k = T->k, t = T->t;
+
+    if (T->kind == _PANEL_TASK)
+    {
+        S->panels_done++;
+
+        /* stop as soon as the rank is known to be too small */
+        if (S->rank_check && S->r[k] + S->rk[k]
+                    + n - FLINT_MIN((k + 1)*S->nb, n) < FLINT_MIN(m, n))
+            S->failed = 1;
+    }
+    else if (T->kind == _SOLVE_TASK)
+    {
+        S->solved[t] = 2;
+        if (_num_blocks(S, k) == 0)
+            _finish_tile(S, t);
+    }
+    else
+    {
+        S->blocks_done[t]++;
+        if (S->blocks_done[t] == _num_blocks(S, k))
+            _finish_tile(S, t);
+    }
+}
+
+static void
+_lu_tiled_worker(void * arg_ptr)
+{
+    _lu_tiled_struct * S = (_lu_tiled_struct *) arg_ptr;
+    _lu_task_struct T;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&S->mutex);
+#endif
+
+    while (!S->failed && S->panels_done < S->ntiles)
+    {
+        if (!_next_task(&T, S))
+        {
+            /* only possible while another thread runs a task */
+#if FLINT_USES_PTHREAD
+            pthread_cond_wait(&S->cond, &S->mutex);
+#endif
+            continue;
+        }
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&S->mutex);
+#endif
+
+        _run_task(S, &T);
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&S->mutex);
+#endif
+
+        _complete_task(S, &T);
+
+#if FLINT_USES_PTHREAD
+        pthread_cond_broadcast(&S->cond);
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&S->mutex);
+#endif
+}
+
+/* move the multipliers of each step next to those of the previous ones */
+static void
+_lu_tiled_compress_worker(void * arg_ptr)
+{
+    _lu_compress_arg_t * arg = (_lu_compress_arg_t *) arg_ptr;
+    _lu_tiled_struct * S = arg->S;
+    slong i, j, k, r, rk, c0;
+    mp_ptr row;
+
+    for (i = arg->r0; i < arg->r1; i++)
+    {
+        row = S->A->rows[i];
+
+        for (k = 0; k < S->ntiles; k++)
+        {
+            r = S->r[k];
+            rk = S->rk[k];
+            c0 = k*S->nb;
+
+            if (c0 == r || i <= r)
+                continue;
+
+            for (j = 0; j < FLINT_MIN(i - r, rk); j++)
+            {
+                row[r + j] = row[c0 + j];
+                row[c0 + j] = 0;
+            }
+        }
+    }
+}
+
+slong
+_nmod_mat_lu_tiled(slong * P, nmod_mat_t A, int rank_check, slong tile_size)
+{
+    _lu_tiled_struct S[1];
+    _lu_compress_arg_t * args;
+    thread_pool_handle * threads;
+    slong i, k, m, n, nb, rank, num_threads;
+
+    m = A->r;
+    n = A->c;
+
+    for (i = 0; i < m; i++)
+        P[i] = i;
+
+    if (m == 0 || n == 0)
+        return 0;
+
+    nb = FLINT_MAX(tile_size, 1);
+
+    S->A = A;
+    S->P = P;
+    S->nb = nb;
+    S->ntiles = (n + nb - 1)/nb;
+    S->rank_check = rank_check;
+    S->r = flint_malloc(6*S->ntiles*sizeof(slong));
+    S->rk = S->r + S->ntiles;
+    S->done = S->rk + S->ntiles;
+    S->solved = S->done + S->ntiles;
+    S->next_block = S->solved + S->ntiles;
+    S->blocks_done = S->next_block + S->ntiles;
+    S->B = flint_malloc(S->ntiles*sizeof(nmod_mat_struct));
+    S->panels_started = 0;
+    S->panels_done = 0;
+    S->failed = 0;
+
+    for (k = 0; k < S->ntiles; k++)
+    {
+        S->done[k] = 0;
+        S->solved[k] = 0;
+        S->next_block[k] = 0;
+        S->blocks_done[k] = 0;
+        S->B[k].entries = NULL;
+        S->B[k].rows = NULL;
+        S->B[k].r = m;
+        S->B[k].c = n;
+        S->B[k].mod = A->mod;
+    }
+
+    num_threads = flint_request_threads(&threads, flint_get_num_threads());
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&S->mutex, NULL);
+    pthread_cond_init(&S->cond, NULL);
+#endif
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                                       _lu_tiled_worker, S);
+
+    _lu_tiled_worker(S);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_cond_destroy(&S->cond);
+    pthread_mutex_destroy(&S->mutex);
+#endif
+
+    if (S->failed)
+    {
+        rank = 0;
+    }
+    else
+    {
+        rank = S->r[S->ntiles - 1] + S->rk[S->ntiles - 1];
+
+        /* the rows are independent here */
+        args = flint_malloc((num_threads + 1)*sizeof(_lu_compress_arg_t));
+
+        for (i = 0; i <= num_threads; i++)
+        {
+            args[i].S = S;
+            args[i].r0 = (m*i)/(num_threads + 1);
+            args[i].r1 = (m*(i + 1))/(num_threads + 1);
+        }
+
+        for (i = 0; i < num_threads; i++)
+            thread_pool_wake(global_thread_pool, threads[i], 0,
+                                        _lu_tiled_compress_worker, &args[i]);
+
+        _lu_tiled_compress_worker(&args[num_threads]);
+
+        for (i = 0; i < num_threads; i++)
+            thread_pool_wait(global_thread_pool, threads[i]);
+
+        flint_free(args);
+    }
+
+    flint_give_back_threads(threads, num_threads);
+
+    for (k = 0; k < S->ntiles; k++)
+        flint_free(S->B[k].rows);
+
+    flint_free(S->B);
+    flint_free(S->r);
+
+    return rank;
+}
+
+slong
+nmod_mat_lu_tiled(slong * P, nmod_mat_t A, int rank_check)
+{
+    return _nmod_mat_lu_tiled(P, A, rank_check, NMOD_MAT_LU_TILE_SIZE);
+}
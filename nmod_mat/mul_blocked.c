@@ -0,0 +1,305 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_vec.h"
+#include "thread_support.h"
+
+/*
+    Cache and register blocked classical multiplication for moduli below
+    2^NMOD_MAT_MUL_BLOCKED_MAX_BITS.
+
+    A and B are packed once into panels of 32-bit entries: MR rows of A and
+    NR columns of B, stored k-major so that the micro-kernel streams through
+    both with unit stride. The micro-kernel keeps an MR x NR tile of 64-bit
+    accumulators. Each product of two entries is less than (n - 1)^2 so
+    s = floor((2^64 - 1)/(n - 1)^2) of them can be added before the tile is
+    folded into a two limb sum, and each entry of the result is reduced
+    only once at the end. The inner loops have fixed trip counts and only
+    do 32 x 32 -> 64 bit multiply-adds, which compilers vectorise.
+
+    The output is cut into tiles of MB rows by NB columns, with the rows of
+    A in a tile sized to stay in cache while the column panels of B pass
+    over them. Tiles are handed out to threads through a shared counter.
+
+    with op = 0, computes D = A*B
+    with op = 1, computes D = C + A*B
+    with op = -1, computes D = C - A*B
+*/
+
+#define MR 4
+#define NR 8
+#define NB (8*NR)
+
+#define FLINT_MUL_BLOCKED_CACHE_SIZE 65536 /* bytes of A kept per tile */
+
+typedef unsigned int _half_limb_t;
+
+/*
+    The micro-kernel. On x86-64 with GCC or Clang it is also compiled for
+    AVX2 and AVX-512 and the widest version supported by the running cpu
+    is selected at run time, so that the library need not be built with
+    -march flags for the 64-bit multiply-adds to be vectorised.
+*/
+
+#define NMOD_MAT_MUL_BLOCKED_KERNEL(name, attr)                              \
+static void attr                                                             \
+name(mp_ptr lo, mp_ptr hi, const _half_limb_t * Ap,                          \
+                                 const _half_limb_t * Bp, slong k, slong s)  \
+{                                                                            \
+    mp_limb_t acc[MR][NR], sum;                                              \
+    slong kk, k0, kend, r, c;                                                \
+                                                                             \
+    for (r = 0; r < MR*NR; r++)                                              \
+    {                                                                        \
+        lo[r] = 0;                                                           \
+        hi[r] = 0;                                                           \
+    }                                                                        \
+                                                                             \
+    for (k0 = 0; k0 < k; k0 += s)                                            \
+    {                                                                        \
+        kend = FLINT_MIN(k0 + s, k);                                         \
+                                                                             \
+        for (r = 0; r < MR; r++)                                             \
+            for (c = 0; c < NR; c++)                                         \
+                acc[r][c] = 0;                                               \
+                                                                             \
+        for (kk = k0; kk < kend; kk++)                                       \
+        {                                                                    \
+            for (r = 0; r < MR; r++)                                         \
+            {                                                                \
+                mp_limb_t a = Ap[kk*MR + r];                                 \
+                                                                             \
+                for (c = 0; c < NR; c++)                                     \
+                    acc[r][c] += a * (mp_limb_t) Bp[kk*NR + c];              \
+            }                                                                \
+        }                                                                    \
+                                                                             \
+        for (r = 0; r < MR; r++)                                             \
+        {                                                                    \
+            for (c = 0; c < NR; c++)                                         \
+            {                                                                \
+                sum = lo[r*NR + c] + acc[r][c];                              \
+                hi[r*NR + c] += (sum < acc[r][c]);                           \
+                lo[r*NR + c] = sum;                                          \
+            }                                                                \
+        }                                                                    \
+    }                                                                        \
+}
+
+typedef void (*_nmod_mat_mul_blocked_kernel_t)(mp_ptr, mp_ptr,
+                   const _half_limb_t *, const _half_limb_t *, slong, slong);
+
+NMOD_MAT_MUL_BLOCKED_KERNEL(_nmod_mat_mul_blocked_kernel_generic, )
+
+#if FLINT64 && defined(__x86_64__) && defined(__GNUC__) && \
+    (defined(__clang__) || __GNUC__ >= 5)
+
+#define NMOD_MAT_MUL_BLOCKED_DISPATCH 1
+
+#if defined(__clang__)
+#define NMOD_MAT_MUL_BLOCKED_TARGET(isa) __attribute__((target(isa)))
+#else
+#define NMOD_MAT_MUL_BLOCKED_TARGET(isa) \
+    __attribute__((target(isa), optimize("tree-vectorize")))
+#endif
+
+NMOD_MAT_MUL_BLOCKED_KERNEL(_nmod_mat_mul_blocked_kernel_avx2,
+                                          NMOD_MAT_MUL_BLOCKED_TARGET("avx2"))
+
+NMOD_MAT_MUL_BLOCKED_KERNEL(_nmod_mat_mul_blocked_kernel_avx512,
+                                       NMOD_MAT_MUL_BLOCKED_TARGET("avx512f"))
+
+static _nmod_mat_mul_blocked_kernel_t
+_nmod_mat_mul_blocked_select_kernel(void)
+{
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f"))
+        return _nmod_mat_mul_blocked_kernel_avx512;
+    else if (__builtin_cpu_supports("avx2"))
+        return _nmod_mat_mul_blocked_kernel_avx2;
+    else
+        return _nmod_mat_mul_blocked_kernel_generic;
+}
+
+#endif
+
+typedef struct
+{
+    volatile slong * tile;
+    slong m;
+    slong k;
+    slong n;
+    slong s;
+    slong mb;
+    slong num_col_tiles;
+    slong num_tiles;
+    _nmod_mat_mul_blocked_kernel_t kernel;
+    const _half_limb_t * Ap;
+    const _half_limb_t * Bp;
+    const mp_ptr * C;
+    mp_ptr * D;
+    nmod_t mod;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+    int op;
+}
+nmod_mat_blocked_arg_t;
+
+static void
+_nmod_mat_addmul_blocked_worker(void * arg_ptr)
+{
+    nmod_mat_blocked_arg_t arg = *((nmod_mat_blocked_arg_t *) arg_ptr);
+    mp_limb_t lo[MR*NR], hi[MR*NR], d;
+    slong t, i0, i1, j0, j1, i, j, r, c;
+    nmod_t mod = arg.mod;
+    int op = arg.op;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg.mutex);
+#endif
+        t = *arg.tile;
+        *arg.tile = t + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg.mutex);
+#endif
+
+        if (t >= arg.num_tiles)
+            return;
+
+        i0 = (t / arg.num_col_tiles)*arg.mb;
+        i1 = FLINT_MIN(i0 + arg.mb, arg.m);
+        j0 = (t % arg.num_col_tiles)*NB;
+        j1 = FLINT_MIN(j0 + NB, arg.n);
+
+        for (j = j0; j < j1; j += NR)
+        {
+            for (i = i0; i < i1; i += MR)
+            {
+                arg.kernel(lo, hi, arg.Ap + i*arg.k,
+                               arg.Bp + j*arg.k, arg.k, arg.s);
+
+                for (r = 0; r < MR && i + r < arg.m; r++)
+                {
+                    for (c = 0; c < NR && j + c < arg.n; c++)
+                    {
+                        NMOD2_RED2(d, hi[r*NR + c], lo[r*NR + c], mod);
+
+                        if (op == 1)
+                            d = nmod_add(arg.C[i + r][j + c], d, mod);
+                        else if (op == -1)
+                            d = nmod_sub(arg.C[i + r][j + c], d, mod);
+
+                        arg.D[i + r][j + c] = d;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+_nmod_mat_addmul_blocked_threaded_pool_op(mp_ptr * D, const mp_ptr * C,
+                       const mp_ptr * A, const mp_ptr * B, slong m, slong k,
+                                        slong n, int op, nmod_t mod,
+                         const thread_pool_handle * threads, slong num_threads)
+{
+    _half_limb_t * Ap, * Bp;
+    slong i, j, r, c, mpad, npad, s, mb, tile = 0;
+    nmod_mat_blocked_arg_t * args;
+    _nmod_mat_mul_blocked_kernel_t kernel;
+    mp_limb_t n1 = mod.n - 1;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    mpad = ((m + MR - 1)/MR)*MR;
+    npad = ((n + NR - 1)/NR)*NR;
+
+    Ap = (_half_limb_t *) flint_malloc(mpad*k*sizeof(_half_limb_t));
+    Bp = (_half_limb_t *) flint_malloc(npad*k*sizeof(_half_limb_t));
+
+    /* pack A into panels of MR rows, zero padded */
+    for (i = 0; i < mpad; i += MR)
+        for (j = 0; j < k; j++)
+            for (r = 0; r < MR; r++)
+                Ap[i*k + j*MR + r] = (i + r < m) ? A[i + r][j] : 0;
+
+    /* pack B into panels of NR columns, zero padded */
+    for (j = 0; j < npad; j += NR)
+        for (i = 0; i < k; i++)
+            for (c = 0; c < NR; c++)
+                Bp[j*k + i*NR + c] = (j + c < n) ? B[i][j + c] : 0;
+
+    /* number of products that can be summed in a limb */
+    s = (n1 == 0) ? k : (slong) FLINT_MIN(UWORD_MAX/(n1*n1), (mp_limb_t) k);
+
+    /* rows of A per tile, a multiple of MR */
+    mb = FLINT_MUL_BLOCKED_CACHE_SIZE/(k*sizeof(_half_limb_t));
+    mb = FLINT_MAX(MR, (mb/MR)*MR);
+    mb = FLINT_MIN(mb, mpad);
+
+#if NMOD_MAT_MUL_BLOCKED_DISPATCH
+    kernel = _nmod_mat_mul_blocked_select_kernel();
+#else
+    kernel = _nmod_mat_mul_blocked_kernel_generic;
+#endif
+
+    args = flint_malloc(sizeof(nmod_mat_blocked_arg_t)*(num_threads + 1));
+
+    for (i = 0; i < num_threads + 1; i++)
+    {
+        args[i].tile          = &tile;
+        args[i].m             = m;
+        args[i].k             = k;
+        args[i].n             = n;
+        args[i].s             = s;
+        args[i].mb            = mb;
+        args[i].num_col_tiles = (n + NB - 1)/NB;
+        args[i].num_tiles     = ((m + mb - 1)/mb)*args[i].num_col_tiles;
+        args[i].kernel        = kernel;
+        args[i].Ap            = Ap;
+        args[i].Bp            = Bp;
+        args[i].C             = C;
+        args[i].D             = D;
+        args[i].mod           = mod;
+#if FLINT_USES_PTHREAD
+        args[i].mutex         = &mutex;
+#endif
+        args[i].op            = op;
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                   _nmod_mat_addmul_blocked_worker, &args[i]);
+
+    _nmod_mat_addmul_blocked_worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    flint_free(args);
+    flint_free(Ap);
+    flint_free(Bp);
+}
@@ -182,6 +182,21 @@ _nmod_mat_mul_classical_op(nmod_mat_t D, const nmod_mat_t C,
 
     nlimbs = _nmod_vec_dot_bound_limbs(k, mod);
 
+#if FLINT64
+    if (mod.n <= (UWORD(1) << NMOD_MAT_MUL_BLOCKED_MAX_BITS)
+        && m >= NMOD_MAT_MUL_TRANSPOSE_CUTOFF
+        && n >= NMOD_MAT_MUL_TRANSPOSE_CUTOFF
+        && k >= NMOD_MAT_MUL_TRANSPOSE_CUTOFF
+        && (nlimbs > 1 || FLINT_BIT_COUNT(k*(mod.n - 1)*(mod.n - 1))
+                                                            > FLINT_BITS/2))
+    {
+        _nmod_mat_addmul_blocked_threaded_pool_op(D->rows,
+            (op == 0) ? NULL : C->rows, A->rows, B->rows, m, k, n, op,
+                                                      D->mod, NULL, 0);
+        return;
+    }
+#endif
+
     if (nlimbs == 1 && m > 10 && k > 10 && n > 10)
     {
         _nmod_mat_addmul_packed_op(D->rows, (op == 0) ? NULL : C->rows,
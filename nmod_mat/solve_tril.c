@@ -14,18 +14,93 @@
 #include "flint.h"
 #include "nmod_mat.h"
 #include "nmod_vec.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    nmod_mat_struct * X;
+    const nmod_mat_struct * L;
+    const nmod_mat_struct * B;
+    slong c0;
+    slong c1;
+    int unit;
+}
+_solve_tril_arg_t;
+
+/* Solve for the columns c0, ..., c1 - 1 of X */
+static void
+_nmod_mat_solve_tril_worker(void * arg_ptr)
+{
+    _solve_tril_arg_t * arg = (_solve_tril_arg_t *) arg_ptr;
+    nmod_mat_t XX, BB;
+
+    nmod_mat_window_init(XX, arg->X, 0, arg->c0, arg->X->r, arg->c1);
+    nmod_mat_window_init(BB, arg->B, 0, arg->c0, arg->B->r, arg->c1);
+
+    nmod_mat_solve_tril(XX, arg->L, BB, arg->unit);
+
+    nmod_mat_window_clear(XX);
+    nmod_mat_window_clear(BB);
+}
 
 void
 nmod_mat_solve_tril(nmod_mat_t X, const nmod_mat_t L,
                                     const nmod_mat_t B, int unit)
 {
-    if (B->r < NMOD_MAT_SOLVE_TRI_ROWS_CUTOFF ||
+    thread_pool_handle * threads = NULL;
+    slong i, num_threads = 0;
+
+    if (B->r >= NMOD_MAT_SOLVE_TRI_ROWS_CUTOFF &&
+        B->c >= 2*NMOD_MAT_SOLVE_TRI_COLS_CUTOFF)
+    {
+        num_threads = flint_request_threads(&threads,
+            FLINT_MIN(flint_get_num_threads(),
+                      B->c/NMOD_MAT_SOLVE_TRI_COLS_CUTOFF));
+    }
+
+    if (num_threads > 0)
+    {
+        /*
+            The columns of B are independent: give each thread a block of
+            them to solve on its own, rather than sharing out every
+            multiplication of the recursive algorithm.
+        */
+        _solve_tril_arg_t * args;
+
+        args = flint_malloc((num_threads + 1)*sizeof(_solve_tril_arg_t));
+
+        for (i = 0; i <= num_threads; i++)
+        {
+            args[i].X = X;
+            args[i].L = L;
+            args[i].B = B;
+            args[i].c0 = (B->c*i)/(num_threads + 1);
+            args[i].c1 = (B->c*(i + 1))/(num_threads + 1);
+            args[i].unit = unit;
+        }
+
+        for (i = 0; i < num_threads; i++)
+            thread_pool_wake(global_thread_pool, threads[i], 0,
+                                       _nmod_mat_solve_tril_worker, &args[i]);
+
+        _nmod_mat_solve_tril_worker(&args[num_threads]);
+
+        for (i = 0; i < num_threads; i++)
+            thread_pool_wait(global_thread_pool, threads[i]);
+
+        flint_give_back_threads(threads, num_threads);
+
+        flint_free(args);
+    }
+    else if (B->r < NMOD_MAT_SOLVE_TRI_ROWS_CUTOFF ||
         B->c < NMOD_MAT_SOLVE_TRI_COLS_CUTOFF)
     {
+        flint_give_back_threads(threads, num_threads);
         nmod_mat_solve_tril_classical(X, L, B, unit);
     }
     else
     {
+        flint_give_back_threads(threads, num_threads);
         nmod_mat_solve_tril_recursive(X, L, B, unit);
     }
 }
@@ -14,6 +14,7 @@
 #include "flint.h"
 #include "nmod_mat.h"
 #include "nmod_vec.h"
+#include "thread_support.h"
 
 void
 nmod_mat_submul(nmod_mat_t D, const nmod_mat_t C,
@@ -30,10 +31,27 @@ nmod_mat_submul(nmod_mat_t D, const nmod_mat_t C,
     else
         cutoff = 200;
 
-    if (flint_get_num_threads() == 1 && (m < cutoff || n < cutoff || k < cutoff))
+    if (m < NMOD_MAT_MUL_TRANSPOSE_CUTOFF || n < NMOD_MAT_MUL_TRANSPOSE_CUTOFF
+        || k < NMOD_MAT_MUL_TRANSPOSE_CUTOFF || (flint_get_num_threads() == 1
+                               && (m < cutoff || n < cutoff || k < cutoff)))
     {
         _nmod_mat_mul_classical_op(D, C, A, B, -1);
     }
+#if !FLINT_USES_BLAS
+    else if (flint_get_num_threads() > 1)
+    {
+        /* fused, so that the subtraction is shared between the threads as well */
+        thread_pool_handle * threads;
+        slong num_threads;
+
+        num_threads = flint_request_threads(&threads, flint_get_num_threads());
+
+        _nmod_mat_mul_classical_threaded_pool_op(D, C, A, B, -1,
+                                                        threads, num_threads);
+
+        flint_give_back_threads(threads, num_threads);
+    }
+#endif
     else
     {
         nmod_mat_t tmp;
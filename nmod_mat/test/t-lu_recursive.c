@@ -16,6 +16,7 @@
 #include "nmod_vec.h"
 #include "nmod_mat.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 void perm(nmod_mat_t A, slong * P)
 {
@@ -109,6 +110,8 @@ main(void)
         slong m, n, r, d, rank;
         slong * P;
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         m = n_randint(state, 30);
         n = n_randint(state, 30);
         mod = n_randtest_prime(state, 0);
@@ -72,8 +72,9 @@ main(void)
         n = n_randint(state, 50);
 
         /* We want to generate matrices with many entries close to half
-           or full limbs with high probability, to stress overflow handling */
-        switch (n_randint(state, 3))
+           or full limbs with high probability, to stress overflow handling,
+           and moduli of at most 31 bits which use the blocked kernel */
+        switch (n_randint(state, 4))
         {
             case 0:
                 mod = n_randtest_not_zero(state);
@@ -82,6 +83,10 @@ main(void)
                 mod = UWORD_MAX/2 + 1 - n_randbits(state, 4);
                 break;
             case 2:
+                mod = (UWORD(1) << (20 + n_randint(state, 12)))
+                                                    - n_randbits(state, 4);
+                break;
+            case 3:
             default:
                 mod = UWORD_MAX - n_randbits(state, 4);
                 break;
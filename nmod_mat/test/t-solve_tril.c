@@ -16,6 +16,7 @@
 #include "flint.h"
 #include "nmod_mat.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -34,6 +35,8 @@ main(void)
         slong rows, cols;
         int unit;
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         m = n_randtest_prime(state, 0);
         rows = n_randint(state, 200);
         cols = n_randint(state, 200);
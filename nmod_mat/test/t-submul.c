@@ -16,6 +16,7 @@
 #include "flint.h"
 #include "nmod_mat.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -34,6 +35,8 @@ main(void)
 
         slong m, k, n;
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         m = n_randint(state, 100);
         k = n_randint(state, 100);
         n = n_randint(state, 100);
@@ -369,12 +369,14 @@ typedef struct {
     nmod_mpoly_struct * xalpha;
     nmod_mpoly_struct * q;
     nmod_mpoly_geobucket_struct * G;
-    nmod_mpoly_struct * qt;
     nmod_mpoly_struct * newt;
     nmod_mpolyv_struct * delta_coeffs;
     nmod_mpoly_t T;
     nmod_mpoly_t Q;
     nmod_mpoly_t R;
+    nmod_mpoly_struct * prods;
+    const nmod_mpoly_struct ** prod_ops;
+    slong prods_alloc;
 } nmod_mpoly_pfrac_struct;
 
 typedef nmod_mpoly_pfrac_struct nmod_mpoly_pfrac_t[1];
@@ -390,6 +392,15 @@ FLINT_DLL void nmod_mpoly_pfrac_clear(nmod_mpoly_pfrac_t I,
 FLINT_DLL int nmod_mpoly_pfrac(slong r, nmod_mpoly_t t, const slong * deg,
                              nmod_mpoly_pfrac_t I, const nmod_mpoly_ctx_t ctx);
 
+FLINT_DLL void _nmod_mpoly_vec_mul_threaded_pool(nmod_mpoly_struct * A,
+       const nmod_mpoly_struct * const * B, const nmod_mpoly_struct * const * C,
+                                       slong n, const nmod_mpoly_ctx_t ctx,
+                        const thread_pool_handle * handles, slong num_handles);
+
+FLINT_DLL void _nmod_mpoly_vec_mul_threaded(nmod_mpoly_struct * A,
+       const nmod_mpoly_struct * const * B, const nmod_mpoly_struct * const * C,
+                                       slong n, const nmod_mpoly_ctx_t ctx);
+
 FLINT_DLL int nmod_mpoly_hlift(slong m, nmod_mpoly_struct * f, slong r,
             const mp_limb_t * alpha, const nmod_mpoly_t A, const slong * degs,
                                                    const nmod_mpoly_ctx_t ctx);
@@ -24,7 +24,8 @@ static int _hlift_quartic2(
     slong i, j;
     nmod_mpoly_t Aq, t, t2, t3, xalpha;
     nmod_mpoly_geobucket_t G;
-    nmod_mpoly_struct betas[2], * deltas;
+    nmod_mpoly_struct betas[2], * deltas, * T;
+    const nmod_mpoly_struct ** Tops;
     nmod_mpoly_pfrac_t I;
     nmod_mpolyv_struct B[2];
     slong tdeg;
@@ -33,6 +34,11 @@ static int _hlift_quartic2(
     FLINT_ASSERT(r == 2);
     r = 2;
 
+    T = FLINT_ARRAY_ALLOC(degs[m] + 1, nmod_mpoly_struct);
+    Tops = FLINT_ARRAY_ALLOC(2*(degs[m] + 1), const nmod_mpoly_struct *);
+    for (i = 0; i <= degs[m]; i++)
+        nmod_mpoly_init(T + i, ctx);
+
     nmod_mpoly_init(t, ctx);
     nmod_mpoly_init(t2, ctx);
     nmod_mpoly_init(t3, ctx);
@@ -78,9 +84,12 @@ static int _hlift_quartic2(
 
         for (i = 0; i <= j; i++)
         {
-            nmod_mpoly_mul(t, B[0].coeffs + i, B[1].coeffs + j - i, ctx);
-            nmod_mpoly_geobucket_sub(G, t, ctx);
+            Tops[i] = B[0].coeffs + i;
+            Tops[degs[m] + 1 + i] = B[1].coeffs + j - i;
         }
+        _nmod_mpoly_vec_mul_threaded(T, Tops, Tops + degs[m] + 1, j + 1, ctx);
+        for (i = 0; i <= j; i++)
+            nmod_mpoly_geobucket_sub(G, T + i, ctx);
         nmod_mpoly_geobucket_empty(t, G, ctx);
 
         if (nmod_mpoly_is_zero(t, ctx))
@@ -124,6 +133,11 @@ cleanup:
         nmod_mpolyv_clear(B + i, ctx);
     }
 
+    for (i = 0; i <= degs[m]; i++)
+        nmod_mpoly_clear(T + i, ctx);
+    flint_free(T);
+    flint_free(Tops);
+
     nmod_mpoly_clear(t, ctx);
     nmod_mpoly_clear(t2, ctx);
     nmod_mpoly_clear(t3, ctx);
@@ -148,7 +162,8 @@ static int _hlift_quartic(
     slong i, j, k;
     nmod_mpoly_t Aq, t, t1, t2, t3, xalpha;
     nmod_mpoly_geobucket_t G;
-    nmod_mpoly_struct * betas, * deltas;
+    nmod_mpoly_struct * betas, * deltas, * T;
+    const nmod_mpoly_struct ** Tops;
     nmod_mpoly_pfrac_t I;
     nmod_mpolyv_struct * B, * U;
     slong tdeg;
@@ -159,6 +174,11 @@ static int _hlift_quartic(
     B = FLINT_ARRAY_ALLOC(2*r, nmod_mpolyv_struct);
     U = B + r;
 
+    T = FLINT_ARRAY_ALLOC(degs[m] + 1, nmod_mpoly_struct);
+    Tops = FLINT_ARRAY_ALLOC(2*(degs[m] + 1), const nmod_mpoly_struct *);
+    for (i = 0; i <= degs[m]; i++)
+        nmod_mpoly_init(T + i, ctx);
+
     nmod_mpoly_init(t, ctx);
     nmod_mpoly_init(t1, ctx);
     nmod_mpoly_init(t2, ctx);
@@ -211,24 +231,19 @@ static int _hlift_quartic(
 
     for (j = 1; j <= degs[m]; j++)
     {
-        k = r - 2;
-
-        G->length = 0;
-        for (i = 0; i <= j; i++)
+        for (k = r - 2; k >= 1; k--)
         {
-            nmod_mpoly_mul(t1, B[k].coeffs + i, B[k + 1].coeffs + j - i, ctx);
-            nmod_mpoly_geobucket_add(G, t1, ctx);
-        }
-        nmod_mpoly_geobucket_empty(U[k].coeffs + j, G, ctx);
-
-        for (k--; k >= 1; k--)
-        {
-            G->length = 0;
             for (i = 0; i <= j; i++)
             {
-                nmod_mpoly_mul(t1, B[k].coeffs + i, U[k + 1].coeffs + j - i, ctx);
-                nmod_mpoly_geobucket_add(G, t1, ctx);
+                Tops[i] = B[k].coeffs + i;
+                Tops[degs[m] + 1 + i] = (k == r - 2 ? B[k + 1].coeffs :
+                                                  U[k + 1].coeffs) + j - i;
             }
+            _nmod_mpoly_vec_mul_threaded(T, Tops, Tops + degs[m] + 1,
+                                                                  j + 1, ctx);
+            G->length = 0;
+            for (i = 0; i <= j; i++)
+                nmod_mpoly_geobucket_add(G, T + i, ctx);
             nmod_mpoly_geobucket_empty(U[k].coeffs + j, G, ctx);
         }
 
@@ -238,9 +253,12 @@ static int _hlift_quartic(
 
         for (i = 0; i <= j; i++)
         {
-            nmod_mpoly_mul(t, B[0].coeffs + i, U[1].coeffs + j - i, ctx);
-            nmod_mpoly_geobucket_sub(G, t, ctx);
+            Tops[i] = B[0].coeffs + i;
+            Tops[degs[m] + 1 + i] = U[1].coeffs + j - i;
         }
+        _nmod_mpoly_vec_mul_threaded(T, Tops, Tops + degs[m] + 1, j + 1, ctx);
+        for (i = 0; i <= j; i++)
+            nmod_mpoly_geobucket_sub(G, T + i, ctx);
         nmod_mpoly_geobucket_empty(t, G, ctx);
 
         if (nmod_mpoly_is_zero(t, ctx))
@@ -303,6 +321,11 @@ cleanup:
 
     flint_free(B);
 
+    for (i = 0; i <= degs[m]; i++)
+        nmod_mpoly_clear(T + i, ctx);
+    flint_free(T);
+    flint_free(Tops);
+
     nmod_mpoly_clear(t, ctx);
     nmod_mpoly_clear(t1, ctx);
     nmod_mpoly_clear(t2, ctx);
@@ -327,12 +350,18 @@ static int _hlift_quintic(
     int success;
     slong i, j;
     nmod_mpoly_t e, t, pow, xalpha, q;
-    nmod_mpoly_struct * betas, * deltas;
+    nmod_mpoly_struct * betas, * deltas, * T;
+    const nmod_mpoly_struct ** Tops;
     nmod_mpoly_pfrac_t I;
     flint_bitcnt_t bits = A->bits;
 
     FLINT_ASSERT(r > 1);
 
+    T = FLINT_ARRAY_ALLOC(r, nmod_mpoly_struct);
+    Tops = FLINT_ARRAY_ALLOC(2*r, const nmod_mpoly_struct *);
+    for (i = 0; i < r; i++)
+        nmod_mpoly_init(T + i, ctx);
+
     nmod_mpoly_init(e, ctx);
     nmod_mpoly_init(t, ctx);
     nmod_mpoly_init(pow, ctx);
@@ -384,9 +413,12 @@ static int _hlift_quintic(
 
         for (i = 0; i < r; i++)
         {
-            nmod_mpoly_mul(t, deltas + i, pow, ctx);
-            nmod_mpoly_add(f + i, f + i, t, ctx);
+            Tops[i] = deltas + i;
+            Tops[r + i] = pow;
         }
+        _nmod_mpoly_vec_mul_threaded(T, Tops, Tops + r, r, ctx);
+        for (i = 0; i < r; i++)
+            nmod_mpoly_add(f + i, f + i, T + i, ctx);
 
         nmod_mpoly_mul(t, f + 0, f + 1, ctx);
         for (i = 2; i < r; i++)
@@ -412,9 +444,12 @@ cleanup:
             nmod_mpoly_repack_bits_inplace(f + i, bits, ctx);
 
         nmod_mpoly_clear(betas + i, ctx);
+        nmod_mpoly_clear(T + i, ctx);
     }
 
     flint_free(betas);
+    flint_free(T);
+    flint_free(Tops);
 
     return success;
 }
@@ -10,6 +10,7 @@
 */
 
 #include "nmod_mpoly_factor.h"
+#include "thread_pool.h"
 
 
 static void _delete_duplicates(
@@ -580,6 +581,80 @@ static void n_polyu3_add_zip_limit1(
 }
 
 
+typedef struct
+{
+    slong r;
+    n_polyun_struct * BBeval;
+    n_polyu_struct * Aeval;
+    n_polyu_struct * Beval;
+    mp_limb_t alpha;
+    slong degs0;
+    nmod_t mod;
+    int success;
+}
+_zip_image_arg_struct;
+
+/* lift one zip image */
+static void _zip_image_worker(void * varg)
+{
+    _zip_image_arg_struct * arg = (_zip_image_arg_struct *) varg;
+
+    arg->success = n_polyu3_mod_hlift(arg->r, arg->BBeval, arg->Aeval,
+                             arg->Beval, arg->alpha, arg->degs0, arg->mod);
+}
+
+
+typedef struct
+{
+    nmod_mpoly_struct * B;
+    const n_polyun_struct * Z;
+    nmod_mpolyu_struct * H;
+    const ulong * Bdegs;
+    slong r;
+    slong yvar;
+    const nmod_mpoly_ctx_struct * ctx;
+    n_polyun_struct * M;
+    int * success;
+    volatile slong * index;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_from_zip_arg_struct;
+
+/* recover the factors from their zip images, each with its own temp M */
+static void _from_zip_worker(void * varg)
+{
+    _from_zip_arg_struct * arg = (_from_zip_arg_struct *) varg;
+    slong i;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        i = *arg->index;
+        *arg->index = i + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (i >= arg->r)
+            return;
+
+        arg->success[i] = nmod_mpoly_from_zip(arg->B + i, arg->Z + i,
+                         arg->H + i, arg->Bdegs[i], arg->yvar, arg->ctx, arg->M);
+    }
+}
+
+
+/*
+    The zip images are evaluated in batches of one per thread: the evaluation
+    steps are sequential, but the lifting of the images is not. The images
+    are then added in order, so that a failure is handled exactly as with one
+    thread. Threads are requested for each batch and for the recovery of the
+    factors only, so that the final check has them for its multiplications.
+*/
 int nmod_mpoly_hlift_zippel(
     slong m,
     nmod_mpoly_struct * B,
@@ -592,15 +667,23 @@ int nmod_mpoly_hlift_zippel(
 {
     flint_bitcnt_t bits = A->bits;
     int success;
-    slong i, zip_fails_remaining, req_zip_images, cur_zip_image;
+    slong i, s, zip_fails_remaining, req_zip_images, cur_zip_image;
+    slong num_slots, num_handles, index;
     nmod_mpolyu_struct * H;
-    n_polyun_struct M[1], Aeh[1], * Beh, * BBeval, * Z;
-    n_polyu_struct Aeval[1], * Beval;
+    n_polyun_struct * M, Aeh[1], * Beh, * BBeval, * Z;
+    n_polyu_struct * Aeval, * Beval;
     mp_limb_t * beta;
     n_poly_struct * caches;
     nmod_mpoly_t T1, T2;
     ulong * Bdegs;
+    int * zip_success;
+    thread_pool_handle * handles;
+    _zip_image_arg_struct * image_args;
+    _from_zip_arg_struct * zip_args;
     const slong degs0 = degs[0];
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
 
     FLINT_ASSERT(m > 2);
     FLINT_ASSERT(r > 1);
@@ -642,23 +725,39 @@ int nmod_mpoly_hlift_zippel(
     for (i = 0; i < 3*ctx->minfo->nvars; i++)
         n_poly_init(caches + i);
 
+    /* at most this many images are lifted at once */
+    num_slots = flint_get_num_threads();
+
     Bdegs = FLINT_ARRAY_ALLOC(r, ulong);
     H = FLINT_ARRAY_ALLOC(r, nmod_mpolyu_struct);
     Beh = FLINT_ARRAY_ALLOC(r, n_polyun_struct);
-    Beval = FLINT_ARRAY_ALLOC(r, n_polyu_struct);
-    BBeval = FLINT_ARRAY_ALLOC(r, n_polyun_struct);
     Z = FLINT_ARRAY_ALLOC(r, n_polyun_struct);
+    zip_success = FLINT_ARRAY_ALLOC(r, int);
+
+    /* one slot of evaluations for each thread */
+    M = FLINT_ARRAY_ALLOC(num_slots, n_polyun_struct);
+    Aeval = FLINT_ARRAY_ALLOC(num_slots, n_polyu_struct);
+    Beval = FLINT_ARRAY_ALLOC(num_slots*r, n_polyu_struct);
+    BBeval = FLINT_ARRAY_ALLOC(num_slots*r, n_polyun_struct);
+    image_args = FLINT_ARRAY_ALLOC(num_slots, _zip_image_arg_struct);
+    zip_args = FLINT_ARRAY_ALLOC(num_slots, _from_zip_arg_struct);
 
     n_polyun_init(Aeh);
-    n_polyu_init(Aeval);
-    n_polyun_init(M);
+    for (s = 0; s < num_slots; s++)
+    {
+        n_polyun_init(M + s);
+        n_polyu_init(Aeval + s);
+    }
     for (i = 0; i < r; i++)
     {
         nmod_mpolyu_init(H + i, bits, ctx);
         n_polyun_init(Beh + i);
+        n_polyun_init(Z + i);
+    }
+    for (i = 0; i < num_slots*r; i++)
+    {
         n_polyu_init(Beval + i);
         n_polyun_init(BBeval + i);
-        n_polyun_init(Z + i);
     }
 
     /* init done */
@@ -700,34 +799,100 @@ choose_betas:
 
 next_zip_image:
 
-    n_polyu_mod_eval_step(Aeval, Aeh, ctx->mod);
-    for (i = 0; i < r; i++)
-        n_polyu_mod_eval_step(Beval + i, Beh + i, ctx->mod);
+    /* the threads are only held while this batch is lifted */
+    num_handles = flint_request_threads(&handles,
+                          FLINT_MIN(num_slots, req_zip_images - cur_zip_image));
 
-    success = n_polyu3_mod_hlift(r, BBeval, Aeval, Beval,
-                                             alpha[m - 1], degs0, ctx->mod);
-    if (success < 1)
+    for (s = 0; s <= num_handles; s++)
     {
-        if (--zip_fails_remaining >= 0)
-            goto choose_betas;
-        success = 0;
-        goto cleanup;
+        n_polyu_mod_eval_step(Aeval + s, Aeh, ctx->mod);
+        for (i = 0; i < r; i++)
+            n_polyu_mod_eval_step(Beval + s*r + i, Beh + i, ctx->mod);
+
+        image_args[s].r = r;
+        image_args[s].BBeval = BBeval + s*r;
+        image_args[s].Aeval = Aeval + s;
+        image_args[s].Beval = Beval + s*r;
+        image_args[s].alpha = alpha[m - 1];
+        image_args[s].degs0 = degs0;
+        image_args[s].mod = ctx->mod;
     }
 
-    for (i = 0; i < r; i++)
+    for (s = 0; s < num_handles; s++)
+        thread_pool_wake(global_thread_pool, handles[s], 0,
+                                          _zip_image_worker, &image_args[s]);
+
+    _zip_image_worker(&image_args[num_handles]);
+
+    for (s = 0; s < num_handles; s++)
+        thread_pool_wait(global_thread_pool, handles[s]);
+
+    flint_give_back_threads(handles, num_handles);
+
+    for (s = 0; s <= num_handles; s++)
     {
-        n_polyu3_add_zip_limit1(Z + i, BBeval + i, Bdegs[i],
-                                                cur_zip_image, req_zip_images); 
+        if (image_args[s].success < 1)
+        {
+            if (--zip_fails_remaining >= 0)
+                goto choose_betas;
+            success = 0;
+            goto cleanup;
+        }
+
+        for (i = 0; i < r; i++)
+        {
+            n_polyu3_add_zip_limit1(Z + i, BBeval + s*r + i, Bdegs[i],
+                                                cur_zip_image, req_zip_images);
+        }
+
+        cur_zip_image++;
     }
 
-    cur_zip_image++;
     if (cur_zip_image < req_zip_images)
         goto next_zip_image;
 
+    num_handles = flint_request_threads(&handles, FLINT_MIN(num_slots, r));
+
+    index = 0;
+    for (s = 0; s <= num_handles; s++)
+    {
+        zip_args[s].B = B;
+        zip_args[s].Z = Z;
+        zip_args[s].H = H;
+        zip_args[s].Bdegs = Bdegs;
+        zip_args[s].r = r;
+        zip_args[s].yvar = m;
+        zip_args[s].ctx = ctx;
+        zip_args[s].M = M + s;
+        zip_args[s].success = zip_success;
+        zip_args[s].index = &index;
+#if FLINT_USES_PTHREAD
+        zip_args[s].mutex = &mutex;
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (s = 0; s < num_handles; s++)
+        thread_pool_wake(global_thread_pool, handles[s], 0,
+                                              _from_zip_worker, &zip_args[s]);
+
+    _from_zip_worker(&zip_args[num_handles]);
+
+    for (s = 0; s < num_handles; s++)
+        thread_pool_wait(global_thread_pool, handles[s]);
+
+    flint_give_back_threads(handles, num_handles);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
     for (i = 0; i < r; i++)
     {
-        success = nmod_mpoly_from_zip(B + i, Z + i, H + i, Bdegs[i], m, ctx, M);
-        if (success < 1)
+        if (zip_success[i] < 1)
         {
             success = 0;
             goto cleanup;
@@ -750,15 +915,21 @@ next_zip_image:
 cleanup:
 
     n_polyun_clear(Aeh);
-    n_polyu_clear(Aeval);
-    n_polyun_clear(M);
+    for (s = 0; s < num_slots; s++)
+    {
+        n_polyun_clear(M + s);
+        n_polyu_clear(Aeval + s);
+    }
     for (i = 0; i < r; i++)
     {
         nmod_mpolyu_clear(H + i, ctx);
         n_polyun_clear(Beh + i);
+        n_polyun_clear(Z + i);
+    }
+    for (i = 0; i < num_slots*r; i++)
+    {
         n_polyu_clear(Beval + i);
         n_polyun_clear(BBeval + i);
-        n_polyun_clear(Z + i);
     }
 
     flint_free(beta);
@@ -770,9 +941,14 @@ cleanup:
     flint_free(Bdegs);
     flint_free(H);
     flint_free(Beh);
+    flint_free(Z);
+    flint_free(zip_success);
+    flint_free(M);
+    flint_free(Aeval);
     flint_free(Beval);
     flint_free(BBeval);
-    flint_free(Z);
+    flint_free(image_args);
+    flint_free(zip_args);
 
     return success;
 }
@@ -11,6 +11,7 @@
 
 #include "nmod_mpoly_factor.h"
 #include "fq_nmod_mpoly_factor.h"
+#include "thread_pool.h"
 
 
 static void n_bpoly_reverse_gens(n_bpoly_t a, const n_bpoly_t b)
@@ -244,7 +245,30 @@ static void _hensel_lift_inv(
     n_bpoly_clear(r); 
 }
 
-static void _hensel_lift_tree(
+typedef struct
+{
+    int opt;
+    slong * link;
+    n_bpoly_struct * v;
+    n_bpoly_struct * w;
+    const n_bpoly_struct * f;
+    slong j;
+    slong p0;
+    slong p1;
+    nmod_t ctx;
+    thread_pool_handle * threads;
+    slong num_threads;
+}
+_hensel_lift_tree_arg_struct;
+
+static void _hensel_lift_tree_worker(void * varg);
+
+/*
+    Once a node is lifted its two subtrees are independent: if both are
+    nontrivial, one of them is given to a thread together with half of the
+    remaining threads.
+*/
+static void _hensel_lift_tree_threaded(
     int opt,
     slong * link,
     n_bpoly_struct * v,
@@ -253,8 +277,13 @@ static void _hensel_lift_tree(
     slong j,
     slong p0,
     slong p1,
-    nmod_t ctx)
+    nmod_t ctx,
+    thread_pool_handle * threads,
+    slong num_threads)
 {
+    _hensel_lift_tree_arg_struct arg;
+    slong n1;
+
     FLINT_ASSERT(p1 <= p0);
 
     if (j < 0)
@@ -268,8 +297,69 @@ static void _hensel_lift_tree(
         _hensel_lift_inv(w + j, w + j + 1,
                               v + j, v + j + 1, w + j, w + j + 1, p0, p1, ctx);
 
-    _hensel_lift_tree(opt, link, v, w, v + j, link[j], p0, p1, ctx);
-    _hensel_lift_tree(opt, link, v, w, v + j + 1, link[j + 1], p0, p1, ctx);
+    if (num_threads < 1 || link[j] < 0 || link[j + 1] < 0)
+    {
+        _hensel_lift_tree_threaded(opt, link, v, w, v + j, link[j],
+                                            p0, p1, ctx, threads, num_threads);
+        _hensel_lift_tree_threaded(opt, link, v, w, v + j + 1, link[j + 1],
+                                            p0, p1, ctx, threads, num_threads);
+        return;
+    }
+
+    n1 = (num_threads - 1)/2;
+
+    arg.opt = opt;
+    arg.link = link;
+    arg.v = v;
+    arg.w = w;
+    arg.f = v + j;
+    arg.j = link[j];
+    arg.p0 = p0;
+    arg.p1 = p1;
+    arg.ctx = ctx;
+    arg.threads = threads + 1;
+    arg.num_threads = n1;
+
+    thread_pool_wake(global_thread_pool, threads[0], 0,
+                                            _hensel_lift_tree_worker, &arg);
+
+    _hensel_lift_tree_threaded(opt, link, v, w, v + j + 1, link[j + 1],
+                       p0, p1, ctx, threads + 1 + n1, num_threads - 1 - n1);
+
+    thread_pool_wait(global_thread_pool, threads[0]);
+}
+
+static void _hensel_lift_tree_worker(void * varg)
+{
+    _hensel_lift_tree_arg_struct * arg = (_hensel_lift_tree_arg_struct *) varg;
+
+    _hensel_lift_tree_threaded(arg->opt, arg->link, arg->v, arg->w, arg->f,
+                    arg->j, arg->p0, arg->p1, arg->ctx, arg->threads,
+                                                            arg->num_threads);
+}
+
+static void _hensel_lift_tree(
+    int opt,
+    slong * link,
+    n_bpoly_struct * v,
+    n_bpoly_struct * w,
+    const n_bpoly_t f,
+    slong j,
+    slong p0,
+    slong p1,
+    nmod_t ctx)
+{
+    thread_pool_handle * threads;
+    slong num_threads;
+
+    /* a tree with r leaves has at most r/2 independent subtrees at once */
+    num_threads = flint_request_threads(&threads,
+                                 FLINT_MIN(j/4 + 1, flint_get_num_threads()));
+
+    _hensel_lift_tree_threaded(opt, link, v, w, f, j, p0, p1, ctx,
+                                                         threads, num_threads);
+
+    flint_give_back_threads(threads, num_threads);
 }
 
 typedef struct {
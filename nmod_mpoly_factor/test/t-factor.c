@@ -174,6 +174,8 @@ main(void)
 
         nmod_mpoly_ctx_init_rand(ctx, state, 10, p);
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         nmod_mpoly_init(a, ctx);
         nmod_mpoly_init(t, ctx);
 
@@ -47,6 +47,9 @@
 #define NMOD_POLY_GCD_CUTOFF  340       /* GCD:  Euclidean -> HGCD          */
 #define NMOD_POLY_SMALL_GCD_CUTOFF 200  /* GCD (small n): Euclidean -> HGCD */
 
+#define NMOD_POLY_NTT_MAX_PRIMES 3      /* number of small-prime NTT primes */
+#define NMOD_POLY_NTT_CUTOFF 12000      /* mul, mullow: KS -> NTT           */
+
 NMOD_POLY_INLINE
 slong NMOD_DIVREM_BC_ITCH(slong lenA, slong lenB, nmod_t mod)
 {
@@ -541,6 +544,12 @@ FLINT_DLL void _nmod_poly_mulhigh_classical(mp_ptr res, mp_srcptr poly1, slong l
 FLINT_DLL void nmod_poly_mulhigh_classical(nmod_poly_t res, 
                   const nmod_poly_t poly1, const nmod_poly_t poly2, slong start);
 
+FLINT_DLL void _nmod_poly_mulmid_classical(mp_ptr res, mp_srcptr poly1,
+                 slong len1, mp_srcptr poly2, slong len2, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mulmid_classical(nmod_poly_t res,
+                             const nmod_poly_t poly1, const nmod_poly_t poly2);
+
 FLINT_DLL void _nmod_poly_mul_KS(mp_ptr out, mp_srcptr in1, slong len1, 
                         mp_srcptr in2, slong len2, flint_bitcnt_t bits, nmod_t mod);
 
@@ -565,6 +574,33 @@ FLINT_DLL void _nmod_poly_mullow_KS(mp_ptr out, mp_srcptr in1, slong len1,
 FLINT_DLL void nmod_poly_mullow_KS(nmod_poly_t res, const nmod_poly_t poly1, 
                              const nmod_poly_t poly2, flint_bitcnt_t bits, slong n);
 
+FLINT_DLL void _nmod_poly_mulmid_KS(mp_ptr out, mp_srcptr in1, slong len1,
+               mp_srcptr in2, slong len2, flint_bitcnt_t bits, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mulmid_KS(nmod_poly_t res, const nmod_poly_t poly1,
+                             const nmod_poly_t poly2, flint_bitcnt_t bits);
+
+FLINT_DLL slong _nmod_poly_mul_NTT_num_primes(slong len1, slong len2,
+                                                                  nmod_t mod);
+
+FLINT_DLL void _nmod_poly_mul_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                                       mp_srcptr poly2, slong len2, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mul_NTT(nmod_poly_t res,
+                             const nmod_poly_t poly1, const nmod_poly_t poly2);
+
+FLINT_DLL void _nmod_poly_mullow_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                              mp_srcptr poly2, slong len2, slong n, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mullow_NTT(nmod_poly_t res, const nmod_poly_t poly1,
+                                          const nmod_poly_t poly2, slong trunc);
+
+FLINT_DLL void _nmod_poly_mulmid_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                                 mp_srcptr poly2, slong len2, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mulmid_NTT(nmod_poly_t res,
+                             const nmod_poly_t poly1, const nmod_poly_t poly2);
+
 FLINT_DLL void _nmod_poly_mul(mp_ptr res, mp_srcptr poly1, slong len1, 
                                        mp_srcptr poly2, slong len2, nmod_t mod);
 
@@ -583,6 +619,12 @@ FLINT_DLL void _nmod_poly_mulhigh(mp_ptr res, mp_srcptr poly1, slong len1,
 FLINT_DLL void nmod_poly_mulhigh(nmod_poly_t res, const nmod_poly_t poly1, 
                                               const nmod_poly_t poly2, slong n);
 
+FLINT_DLL void _nmod_poly_mulmid(mp_ptr res, mp_srcptr poly1, slong len1,
+                                 mp_srcptr poly2, slong len2, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mulmid(nmod_poly_t res,
+                             const nmod_poly_t poly1, const nmod_poly_t poly2);
+
 FLINT_DLL void _nmod_poly_mulmod(mp_ptr res, mp_srcptr poly1, slong len1, 
                              mp_srcptr poly2, slong len2, mp_srcptr f,
                             slong lenf, nmod_t mod);
@@ -81,7 +81,10 @@ _nmod_poly_exp_series_newton(mp_ptr f, mp_ptr g,
 
         l = FLINT_MIN(hlen, n) - 1;
         r = FLINT_MIN(l + m - 1, n - 1);
-        if (l >= m)
+        /* only coefficients m - 1 to r - 1 of hprime*f are used */
+        if (l == n - 1)
+            _nmod_poly_mulmid(t + m - 1, hprime, l, f, m, mod);
+        else if (l >= m)
             _nmod_poly_mullow(t, hprime, l, f, m, r, mod);
         else
             _nmod_poly_mullow(t, f, m, hprime, l, r, mod);
@@ -92,7 +95,7 @@ _nmod_poly_exp_series_newton(mp_ptr f, mp_ptr g,
         /* g := exp(-h) + O(x^n); not needed if we only want exp(x) */
         if (i != 0 || inverse)
         {
-            _nmod_poly_mullow(t, f, n, g, m, n, mod);
+            _nmod_poly_mulmid(t + m - 1, f, n, g, m, mod);
             _nmod_poly_mullow(g + m, g, m, t + m, n - m, n - m, mod);
             _nmod_vec_neg(g + m, g + m, n - m, mod);
         }
@@ -30,6 +30,16 @@ void _nmod_poly_mul(mp_ptr res, mp_srcptr poly1, slong len1,
     bits = FLINT_BITS - (slong) mod.norm;
     cutoff_len = FLINT_MIN(len1, 2 * len2);
 
+#if FLINT64
+    /* moduli of 21 to 40 bits need two primes but KS packs them well */
+    if (cutoff_len >= NMOD_POLY_NTT_CUTOFF && (bits <= 20 || bits > 40
+                                   || cutoff_len >= 16 * NMOD_POLY_NTT_CUTOFF))
+    {
+        _nmod_poly_mul_NTT(res, poly1, len1, poly2, len2, mod);
+        return;
+    }
+#endif
+
     if (3 * cutoff_len < 2 * FLINT_MAX(bits, 10))
         _nmod_poly_mul_classical(res, poly1, len1, poly2, len2, mod);
     else if (cutoff_len * bits < 800)
@@ -32,6 +32,20 @@ void _nmod_poly_mullow(mp_ptr res, mp_srcptr poly1, slong len1,
 
     bits = FLINT_BITS - (slong) mod.norm;
 
+#if FLINT64
+    {
+        slong cutoff_len = FLINT_MIN(len1, 2 * len2);
+
+        /* moduli of 21 to 40 bits need two primes but KS packs them well */
+        if (cutoff_len >= NMOD_POLY_NTT_CUTOFF && (bits <= 20 || bits > 40
+                                   || cutoff_len >= 16 * NMOD_POLY_NTT_CUTOFF))
+        {
+            _nmod_poly_mullow_NTT(res, poly1, len1, poly2, len2, n, mod);
+            return;
+        }
+    }
+#endif
+
     if (n < 10 + bits * bits / 10)
         _nmod_poly_mullow_classical(res, poly1, len1, poly2, len2, n, mod);
     else
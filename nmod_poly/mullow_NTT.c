@@ -0,0 +1,595 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+/*
+    Number theoretic transforms modulo primes p = c*2^k + 1 with
+    2^61 < p < 2^62. As p < 2^62, the butterflies can work lazily on
+    values in [0, 2p) (with intermediate values in [0, 4p)) and only
+    reduce to [0, p) before the pointwise products and at the very end.
+    The product of the three primes exceeds 2^183, which is more than
+    enough to recover any coefficient of a product of polynomials over
+    Z/nZ with n < 2^64.
+*/
+
+#if FLINT64
+
+static const mp_limb_t _ntt_primes[NMOD_POLY_NTT_MAX_PRIMES] = {
+    UWORD(4179340454199820289),     /*  29*2^57 + 1 */
+    UWORD(2485986994308513793),     /*  69*2^55 + 1 */
+    UWORD(3188548536178311169)      /* 177*2^54 + 1 */
+};
+
+static const mp_limb_t _ntt_prim_roots[NMOD_POLY_NTT_MAX_PRIMES] = {
+    UWORD(3), UWORD(5), UWORD(7)
+};
+
+static const flint_bitcnt_t _ntt_two_adic[NMOD_POLY_NTT_MAX_PRIMES] = {
+    57, 55, 54
+};
+
+/* below this length the transforms are done level by level */
+#define NTT_ITERATIVE_CUTOFF 1024
+
+/* r = w*a mod p in [0, 2p), for any a and w < p, wpre = floor(w*2^64/p) */
+#define NTT_MULMOD_LAZY(r, a, w, wpre, p)               \
+    do {                                                \
+        mp_limb_t __q, __lo;                            \
+        umul_ppmm(__q, __lo, (wpre), (a));              \
+        (r) = (w) * (a) - __q * (p);                    \
+    } while (0)
+
+typedef struct
+{
+    mp_limb_t p;
+    mp_limb_t p2;       /* 2p */
+    mp_ptr w;           /* w[h + j] = (primitive 2h-th root)^j, 0 <= j < h */
+    mp_ptr wpre;
+    mp_ptr iw;          /* same with the inverse roots */
+    mp_ptr iwpre;
+} ntt_ctx_struct;
+
+static void
+_ntt_ctx_init(ntt_ctx_struct * C, slong i, flint_bitcnt_t depth)
+{
+    mp_limb_t p, pinv, root, iroot, t, it;
+    slong j, h, L = WORD(1) << depth;
+
+    p = _ntt_primes[i];
+    pinv = n_preinvert_limb(p);
+
+    C->p = p;
+    C->p2 = 2*p;
+    C->w = (mp_ptr) flint_malloc(4*L*sizeof(mp_limb_t));
+    C->wpre = C->w + L;
+    C->iw = C->wpre + L;
+    C->iwpre = C->iw + L;
+
+    root = n_powmod2_preinv(_ntt_prim_roots[i],
+                              (p - 1) >> depth, p, pinv);
+    iroot = n_invmod(root, p);
+
+    /* top level, then every lower level is a subsequence of it */
+    h = L/2;
+    t = it = 1;
+    for (j = 0; j < h; j++)
+    {
+        C->w[h + j] = t;
+        C->wpre[h + j] = n_mulmod_precomp_shoup(t, p);
+        C->iw[h + j] = it;
+        C->iwpre[h + j] = n_mulmod_precomp_shoup(it, p);
+        t = n_mulmod2_preinv(t, root, p, pinv);
+        it = n_mulmod2_preinv(it, iroot, p, pinv);
+    }
+
+    for (h = L/4; h >= 1; h /= 2)
+    {
+        for (j = 0; j < h; j++)
+        {
+            C->w[h + j] = C->w[2*h + 2*j];
+            C->wpre[h + j] = C->wpre[2*h + 2*j];
+            C->iw[h + j] = C->iw[2*h + 2*j];
+            C->iwpre[h + j] = C->iwpre[2*h + 2*j];
+        }
+    }
+}
+
+static void
+_ntt_ctx_clear(ntt_ctx_struct * C)
+{
+    flint_free(C->w);
+}
+
+/*
+    Decimation in frequency: natural order input in [0, 2p), bit reversed
+    output in [0, 2p). Recursing depth first keeps the working set in cache
+    once the blocks get small enough.
+*/
+static void
+_ntt_dif(mp_ptr a, slong m, const ntt_ctx_struct * C)
+{
+    mp_limb_t x, y, s, t, p = C->p, p2 = C->p2;
+    mp_srcptr w, wpre;
+    mp_ptr b;
+    slong j, h;
+
+    if (m <= NTT_ITERATIVE_CUTOFF)
+    {
+        for (h = m/2; h >= 1; h /= 2)
+        {
+            w = C->w + h;
+            wpre = C->wpre + h;
+
+            for (b = a; b < a + m; b += 2*h)
+            {
+                for (j = 0; j < h; j++)
+                {
+                    x = b[j];
+                    y = b[j + h];
+                    s = x + y;
+                    t = x - y + p2;
+                    s -= (s >= p2) ? p2 : 0;
+                    NTT_MULMOD_LAZY(b[j + h], t, w[j], wpre[j], p);
+                    b[j] = s;
+                }
+            }
+        }
+
+        return;
+    }
+
+    h = m/2;
+    w = C->w + h;
+    wpre = C->wpre + h;
+
+    for (j = 0; j < h; j++)
+    {
+        x = a[j];
+        y = a[j + h];
+        s = x + y;
+        t = x - y + p2;
+        s -= (s >= p2) ? p2 : 0;
+        NTT_MULMOD_LAZY(a[j + h], t, w[j], wpre[j], p);
+        a[j] = s;
+    }
+
+    _ntt_dif(a, h, C);
+    _ntt_dif(a + h, h, C);
+}
+
+/*
+    As above, but only the first len entries of a are meaningful and the
+    remaining ones are taken to be zero (and need not be initialised).
+    Butterflies with a zero operand degenerate to a single multiplication
+    and whole subtransforms of zero are skipped.
+*/
+static void
+_ntt_dif_trunc(mp_ptr a, slong m, slong len, const ntt_ctx_struct * C)
+{
+    mp_limb_t x, y, s, t, p = C->p, p2 = C->p2;
+    mp_srcptr w, wpre;
+    slong j, h;
+
+    if (len >= m)
+    {
+        _ntt_dif(a, m, C);
+        return;
+    }
+
+    if (len == 0)
+    {
+        flint_mpn_zero(a, m);
+        return;
+    }
+
+    h = m/2;
+    w = C->w + h;
+    wpre = C->wpre + h;
+
+    if (len <= h)
+    {
+        for (j = 0; j < len; j++)
+            NTT_MULMOD_LAZY(a[j + h], a[j], w[j], wpre[j], p);
+
+        _ntt_dif_trunc(a, h, len, C);
+        _ntt_dif_trunc(a + h, h, len, C);
+    }
+    else
+    {
+        for (j = 0; j < len - h; j++)
+        {
+            x = a[j];
+            y = a[j + h];
+            s = x + y;
+            t = x - y + p2;
+            s -= (s >= p2) ? p2 : 0;
+            NTT_MULMOD_LAZY(a[j + h], t, w[j], wpre[j], p);
+            a[j] = s;
+        }
+
+        for ( ; j < h; j++)
+            NTT_MULMOD_LAZY(a[j + h], a[j], w[j], wpre[j], p);
+
+        _ntt_dif(a, h, C);
+        _ntt_dif(a + h, h, C);
+    }
+}
+
+/*
+    Decimation in time with the inverse roots: bit reversed input in
+    [0, 2p), natural order output in [0, 2p), scaled by m. This undoes
+    _ntt_dif butterfly by butterfly.
+*/
+static void
+_ntt_dit(mp_ptr a, slong m, const ntt_ctx_struct * C)
+{
+    mp_limb_t x, t, u, v, p = C->p, p2 = C->p2;
+    mp_srcptr w, wpre;
+    mp_ptr b;
+    slong j, h;
+
+    if (m <= NTT_ITERATIVE_CUTOFF)
+    {
+        for (h = 1; h < m; h *= 2)
+        {
+            w = C->iw + h;
+            wpre = C->iwpre + h;
+
+            for (b = a; b < a + m; b += 2*h)
+            {
+                for (j = 0; j < h; j++)
+                {
+                    x = b[j];
+                    NTT_MULMOD_LAZY(t, b[j + h], w[j], wpre[j], p);
+                    u = x + t;
+                    v = x - t + p2;
+                    u -= (u >= p2) ? p2 : 0;
+                    v -= (v >= p2) ? p2 : 0;
+                    b[j] = u;
+                    b[j + h] = v;
+                }
+            }
+        }
+
+        return;
+    }
+
+    h = m/2;
+    w = C->iw + h;
+    wpre = C->iwpre + h;
+
+    _ntt_dit(a, h, C);
+    _ntt_dit(a + h, h, C);
+
+    for (j = 0; j < h; j++)
+    {
+        x = a[j];
+        NTT_MULMOD_LAZY(t, a[j + h], w[j], wpre[j], p);
+        u = x + t;
+        v = x - t + p2;
+        u -= (u >= p2) ? p2 : 0;
+        v -= (v >= p2) ? p2 : 0;
+        a[j] = u;
+        a[j + h] = v;
+    }
+}
+
+/* only the first n < m outputs are wanted */
+static void
+_ntt_dit_trunc(mp_ptr a, slong m, slong n, const ntt_ctx_struct * C)
+{
+    mp_limb_t x, t, u, v, p = C->p, p2 = C->p2;
+    mp_srcptr w, wpre;
+    slong j, h;
+
+    if (n >= m || m == 1)
+    {
+        _ntt_dit(a, m, C);
+        return;
+    }
+
+    h = m/2;
+    w = C->iw + h;
+    wpre = C->iwpre + h;
+
+    _ntt_dit(a, h, C);
+    _ntt_dit(a + h, h, C);
+
+    for (j = 0; j < n - h; j++)
+    {
+        x = a[j];
+        NTT_MULMOD_LAZY(t, a[j + h], w[j], wpre[j], p);
+        u = x + t;
+        v = x - t + p2;
+        u -= (u >= p2) ? p2 : 0;
+        v -= (v >= p2) ? p2 : 0;
+        a[j] = u;
+        a[j + h] = v;
+    }
+
+    for ( ; j < FLINT_MIN(n, h); j++)
+    {
+        x = a[j];
+        NTT_MULMOD_LAZY(t, a[j + h], w[j], wpre[j], p);
+        u = x + t;
+        u -= (u >= p2) ? p2 : 0;
+        a[j] = u;
+    }
+}
+
+/* reduce the input coefficients into [0, 2p) */
+static void
+_ntt_load(mp_ptr a, mp_srcptr poly, slong len, nmod_t mod, nmod_t modp)
+{
+    slong j;
+
+    if (mod.n <= 2*modp.n)
+        flint_mpn_copyi(a, poly, len);
+    else
+        for (j = 0; j < len; j++)
+            NMOD_RED(a[j], poly[j], modp);
+}
+
+/*
+    Writes the coefficients start to n - 1 of poly1*poly2 modulo x^L - 1
+    and the i-th prime to out, in [0, p), where L = 2^depth.
+*/
+static void
+_ntt_mullow_prime(mp_ptr out, mp_ptr fa, mp_ptr fb,
+                  mp_srcptr poly1, slong len1, mp_srcptr poly2, slong len2,
+                  slong start, slong n, int squaring, flint_bitcnt_t depth,
+                  slong i, nmod_t mod)
+{
+    ntt_ctx_struct C[1];
+    nmod_t modp;
+    mp_limb_t Linv, Linvpre, hi, lo, x, y;
+    slong j, L = WORD(1) << depth;
+
+    _ntt_ctx_init(C, i, depth);
+    nmod_init(&modp, C->p);
+
+    _ntt_load(fa, poly1, len1, mod, modp);
+    _ntt_dif_trunc(fa, L, len1, C);
+
+    if (!squaring)
+    {
+        _ntt_load(fb, poly2, len2, mod, modp);
+        _ntt_dif_trunc(fb, L, len2, C);
+    }
+    else
+        fb = fa;
+
+    Linv = n_invmod(L, C->p);
+    Linvpre = n_mulmod_precomp_shoup(Linv, C->p);
+
+    for (j = 0; j < L; j++)
+    {
+        x = fa[j];
+        y = fb[j];
+        x -= (x >= C->p) ? C->p : 0;
+        y -= (y >= C->p) ? C->p : 0;
+        umul_ppmm(hi, lo, x, y);
+        NMOD_RED2(x, hi, lo, modp);
+        NTT_MULMOD_LAZY(fa[j], x, Linv, Linvpre, C->p);
+    }
+
+    _ntt_dit_trunc(fa, L, n, C);
+
+    for (j = start; j < n; j++)
+    {
+        x = fa[j];
+        x -= (x >= C->p) ? C->p : 0;
+        out[j - start] = x;
+    }
+
+    _ntt_ctx_clear(C);
+}
+
+slong
+_nmod_poly_mul_NTT_num_primes(slong len1, slong len2, nmod_t mod)
+{
+    flint_bitcnt_t bits;
+
+    bits = 2*FLINT_BIT_COUNT(mod.n - 1) + FLINT_BIT_COUNT(FLINT_MIN(len1, len2));
+
+    if (bits <= 61)
+        return 1;
+    else if (bits <= 122)
+        return 2;
+    else
+        return 3;
+}
+
+/*
+    Sets (res, n - start) to the coefficients start to n - 1 of poly1*poly2
+    modulo x^L - 1, where L = 2^depth and the product coefficients are
+    bounded as for _nmod_poly_mul_NTT_num_primes(len1, len2, mod).
+*/
+static void
+_nmod_poly_mul_NTT_window(mp_ptr res, mp_srcptr poly1, slong len1,
+                          mp_srcptr poly2, slong len2, slong start, slong n,
+                          flint_bitcnt_t depth, nmod_t mod)
+{
+    mp_ptr fa, fb, r;
+    slong i, num_primes, alloc;
+    int squaring;
+
+    squaring = (poly1 == poly2 && len1 == len2);
+
+    if (depth > _ntt_two_adic[NMOD_POLY_NTT_MAX_PRIMES - 1])
+    {
+        flint_printf("Exception (_nmod_poly_mullow_NTT). Length too large.\n");
+        flint_abort();
+    }
+
+    num_primes = _nmod_poly_mul_NTT_num_primes(len1, len2, mod);
+
+    n -= start;
+    alloc = (WORD(2) << depth) + num_primes * n;
+    fa = (mp_ptr) flint_malloc(alloc*sizeof(mp_limb_t));
+    fb = fa + (WORD(1) << depth);
+    r = fb + (WORD(1) << depth);
+
+    for (i = 0; i < num_primes; i++)
+        _ntt_mullow_prime(r + i*n, fa, fb, poly1, len1, poly2, len2,
+                               start, start + n, squaring, depth, i, mod);
+
+    /* Garner recombination, with each mixed radix digit reduced mod n */
+    if (num_primes == 1)
+    {
+        for (i = 0; i < n; i++)
+            NMOD_RED(res[i], r[i], mod);
+    }
+    else
+    {
+        mp_limb_t p0 = _ntt_primes[0], p1 = _ntt_primes[1], p2 = _ntt_primes[2];
+        mp_limb_t c01, c02, c12, p0n, p01n, t0, t1, t1_p1, t2, hi, lo;
+        nmod_t mod1, mod2;
+        mp_srcptr r0 = r, r1 = r + n, r2 = r + 2*n;
+
+        nmod_init(&mod1, p1);
+        nmod_init(&mod2, p2);
+
+        c01 = n_invmod(p0 % p1, p1);
+        c02 = n_invmod(p0 % p2, p2);
+        c12 = n_invmod(p1 % p2, p2);
+
+        NMOD_RED(p0n, p0, mod);
+        umul_ppmm(hi, lo, p0, p1);
+        NMOD_RED2(p01n, hi % mod.n, lo, mod);
+
+        for (i = 0; i < n; i++)
+        {
+            /* x = t0 + p0*t1 + p0*p1*t2 */
+            t0 = r0[i];
+            NMOD_RED(t1, t0, mod1);
+            t1_p1 = nmod_mul(nmod_sub(r1[i], t1, mod1), c01, mod1);
+
+            NMOD_RED(res[i], t0, mod);
+            NMOD_RED(t1, t1_p1, mod);
+            res[i] = nmod_add(res[i], nmod_mul(t1, p0n, mod), mod);
+
+            if (num_primes == 3)
+            {
+                NMOD_RED(t2, t0, mod2);
+                t2 = nmod_mul(nmod_sub(r2[i], t2, mod2), c02, mod2);
+                NMOD_RED(t0, t1_p1, mod2);
+                t2 = nmod_mul(nmod_sub(t2, t0, mod2), c12, mod2);
+                NMOD_RED(t2, t2, mod);
+                res[i] = nmod_add(res[i], nmod_mul(t2, p01n, mod), mod);
+            }
+        }
+    }
+
+    flint_free(fa);
+}
+
+void
+_nmod_poly_mullow_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                      mp_srcptr poly2, slong len2, slong n, nmod_t mod)
+{
+    len1 = FLINT_MIN(len1, n);
+    len2 = FLINT_MIN(len2, n);
+
+    _nmod_poly_mul_NTT_window(res, poly1, len1, poly2, len2, 0, n,
+                                         FLINT_CLOG2(len1 + len2 - 1), mod);
+}
+
+/*
+    The middle coefficients are not affected by the wrap around modulo
+    x^L - 1 as soon as L >= len1, so the transforms need only cover poly1.
+*/
+void
+_nmod_poly_mulmid_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                      mp_srcptr poly2, slong len2, nmod_t mod)
+{
+    _nmod_poly_mul_NTT_window(res, poly1, len1, poly2, len2, len2 - 1, len1,
+                                                     FLINT_CLOG2(len1), mod);
+}
+
+#else
+
+slong
+_nmod_poly_mul_NTT_num_primes(slong len1, slong len2, nmod_t mod)
+{
+    return 0;
+}
+
+void
+_nmod_poly_mullow_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                      mp_srcptr poly2, slong len2, slong n, nmod_t mod)
+{
+    /* the transform primes need 64-bit words */
+    _nmod_poly_mullow_KS(res, poly1, len1, poly2, len2, 0, n, mod);
+}
+
+void
+_nmod_poly_mulmid_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                      mp_srcptr poly2, slong len2, nmod_t mod)
+{
+    _nmod_poly_mulmid_KS(res, poly1, len1, poly2, len2, 0, mod);
+}
+
+#endif
+
+void
+nmod_poly_mullow_NTT(nmod_poly_t res, const nmod_poly_t poly1,
+                                      const nmod_poly_t poly2, slong trunc)
+{
+    slong len1, len2, len_out;
+
+    len1 = poly1->length;
+    len2 = poly2->length;
+
+    len_out = len1 + len2 - 1;
+    if (trunc > len_out)
+        trunc = len_out;
+
+    if (len1 == 0 || len2 == 0 || trunc <= 0)
+    {
+        nmod_poly_zero(res);
+        return;
+    }
+
+    if (res == poly1 || res == poly2)
+    {
+        nmod_poly_t temp;
+        nmod_poly_init2(temp, poly1->mod.n, trunc);
+
+        if (len1 >= len2)
+            _nmod_poly_mullow_NTT(temp->coeffs, poly1->coeffs, len1,
+                                  poly2->coeffs, len2, trunc, poly1->mod);
+        else
+            _nmod_poly_mullow_NTT(temp->coeffs, poly2->coeffs, len2,
+                                  poly1->coeffs, len1, trunc, poly1->mod);
+
+        nmod_poly_swap(temp, res);
+        nmod_poly_clear(temp);
+    }
+    else
+    {
+        nmod_poly_fit_length(res, trunc);
+
+        if (len1 >= len2)
+            _nmod_poly_mullow_NTT(res->coeffs, poly1->coeffs, len1,
+                                  poly2->coeffs, len2, trunc, poly1->mod);
+        else
+            _nmod_poly_mullow_NTT(res->coeffs, poly2->coeffs, len2,
+                                  poly1->coeffs, len1, trunc, poly1->mod);
+    }
+
+    res->length = trunc;
+    _nmod_poly_normalise(res);
+}
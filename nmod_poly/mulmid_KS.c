@@ -0,0 +1,140 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "fft.h"
+#include "fft_tuning.h"
+
+/*
+    Let P = A*B where A and B are the packed inputs, so that the bits-bit
+    digits of P are the coefficients c_k of the product. As each c_k has a
+    spare top bit, the low len2 - 1 digits of P sum to less than 2^(s - 1),
+    where s = (len2 - 1)*bits. Hence the middle digits are those of
+    floor((P + 2^(s - 1))/2^s), which remains true if the high digits of P
+    are wrapped into the low ones modulo 2^N + 1 with N >= (len1 + 1)*bits:
+    the wrapped part is less than 2^(s - bits) and lands below the middle.
+    So the product only needs to be computed modulo 2^N + 1.
+*/
+void
+_nmod_poly_mulmid_KS(mp_ptr out, mp_srcptr in1, slong len1,
+               mp_srcptr in2, slong len2, flint_bitcnt_t bits, nmod_t mod)
+{
+    slong m = len1 - len2 + 1, limbs1, limbs2, limbs, tlimbs, off, cnt;
+    flint_bitcnt_t s;
+    mp_ptr arr1, arr2, arr3, tt, mid;
+
+    if (bits == 0)
+    {
+        flint_bitcnt_t bits1 = FLINT_BITS - (slong) mod.norm;
+
+        bits = 2*bits1 + FLINT_BIT_COUNT(len2) + 1;
+    }
+
+    limbs1 = (len1*bits - 1)/FLINT_BITS + 1;
+    limbs2 = (len2*bits - 1)/FLINT_BITS + 1;
+    limbs = ((len1 + 1)*bits - 1)/FLINT_BITS + 1;
+
+    if (limbs <= FFT_MULMOD_2EXPP1_CUTOFF)
+    {
+        /* the full product is no more expensive */
+        tlimbs = limbs1 + limbs2;
+        arr1 = (mp_ptr) flint_malloc((limbs1 + limbs2 + tlimbs)*
+                                                         sizeof(mp_limb_t));
+        arr2 = arr1 + limbs1;
+        arr3 = arr2 + limbs2;
+        tt = NULL;
+
+        _nmod_poly_bit_pack(arr1, in1, len1, bits);
+        _nmod_poly_bit_pack(arr2, in2, len2, bits);
+
+        mpn_mul(arr3, arr1, limbs1, arr2, limbs2);
+    }
+    else
+    {
+        limbs = fft_adjust_limbs(limbs);
+        tlimbs = limbs;
+        arr1 = (mp_ptr) flint_malloc(5*(limbs + 1)*sizeof(mp_limb_t));
+        arr2 = arr1 + limbs + 1;
+        arr3 = arr2 + limbs + 1;
+        tt = arr3 + limbs + 1;
+
+        flint_mpn_zero(arr1, 2*(limbs + 1));
+        _nmod_poly_bit_pack(arr1, in1, len1, bits);
+        _nmod_poly_bit_pack(arr2, in2, len2, bits);
+
+        fft_mulmod_2expp1(arr3, arr1, arr2, limbs, FLINT_BITS, tt);
+        mpn_normmod_2expp1(arr3, limbs);
+
+        /* residues of at least 2^(N - 1) stand for negative values */
+        if (arr3[limbs] != 0 || (arr3[limbs - 1] >> (FLINT_BITS - 1)) != 0)
+            mpn_sub_1(arr3, arr3, limbs + 1, 1);
+    }
+
+    s = (len2 - 1)*bits;
+    if (s != 0)
+        mpn_add_1(arr3 + (s - 1)/FLINT_BITS, arr3 + (s - 1)/FLINT_BITS,
+                      tlimbs - (s - 1)/FLINT_BITS,
+                      UWORD(1) << ((s - 1) % FLINT_BITS));
+
+    off = s/FLINT_BITS;
+    cnt = (len1*bits - 1)/FLINT_BITS + 1 - off;
+
+    if (s % FLINT_BITS != 0)
+    {
+        mid = (mp_ptr) flint_malloc(cnt*sizeof(mp_limb_t));
+        mpn_rshift(mid, arr3 + off, cnt, s % FLINT_BITS);
+        _nmod_poly_bit_unpack(out, m, mid, bits, mod);
+        flint_free(mid);
+    }
+    else
+    {
+        _nmod_poly_bit_unpack(out, m, arr3 + off, bits, mod);
+    }
+
+    flint_free(arr1);
+}
+
+void
+nmod_poly_mulmid_KS(nmod_poly_t res,
+                    const nmod_poly_t poly1, const nmod_poly_t poly2,
+                    flint_bitcnt_t bits)
+{
+    slong len_out;
+
+    if (poly1->length == 0 || poly2->length == 0)
+    {
+        nmod_poly_zero(res);
+        return;
+    }
+
+    len_out = poly1->length - poly2->length + 1;
+
+    if (res == poly1 || res == poly2)
+    {
+        nmod_poly_t temp;
+        nmod_poly_init2_preinv(temp, poly1->mod.n, poly1->mod.ninv, len_out);
+        _nmod_poly_mulmid_KS(temp->coeffs, poly1->coeffs, poly1->length,
+                       poly2->coeffs, poly2->length, bits, poly1->mod);
+        nmod_poly_swap(res, temp);
+        nmod_poly_clear(temp);
+    }
+    else
+    {
+        nmod_poly_fit_length(res, len_out);
+        _nmod_poly_mulmid_KS(res->coeffs, poly1->coeffs, poly1->length,
+                       poly2->coeffs, poly2->length, bits, poly1->mod);
+    }
+
+    res->length = len_out;
+    _nmod_poly_normalise(res);
+}
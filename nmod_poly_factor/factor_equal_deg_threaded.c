@@ -0,0 +1,252 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "nmod_poly.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    nmod_poly_struct * f;
+    nmod_poly_struct * g;
+    nmod_poly_factor_struct * fac;
+    const slong * d;
+    slong num;
+    int split;
+    volatile slong * index;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_equal_deg_arg_t;
+
+/*
+    Either factor f[i] completely into fac[i], or split it once into
+    f[i]*g[i] with the same random choices as nmod_poly_factor_equal_deg
+*/
+static void
+_equal_deg_worker(void * arg_ptr)
+{
+    _equal_deg_arg_t * arg = (_equal_deg_arg_t *) arg_ptr;
+    nmod_poly_t q;
+    flint_rand_t state;
+    slong i;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        i = *arg->index;
+        *arg->index = i + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (i >= arg->num)
+            return;
+
+        if (!arg->split)
+        {
+            nmod_poly_factor_equal_deg(arg->fac + i, arg->f + i, arg->d[i]);
+            continue;
+        }
+
+        nmod_poly_init_mod(q, arg->f[i].mod);
+
+        flint_randinit(state);
+        while (!nmod_poly_factor_equal_deg_prob(q, state, arg->f + i,
+                                                           arg->d[i])) {};
+        flint_randclear(state);
+
+        nmod_poly_div(arg->g + i, arg->f + i, q);
+        nmod_poly_swap(arg->f + i, q);
+
+        nmod_poly_clear(q);
+    }
+}
+
+static void
+_equal_deg_run(_equal_deg_arg_t * args, slong num,
+                                 thread_pool_handle * threads, slong num_threads)
+{
+    slong i, index = 0;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    num_threads = FLINT_MIN(num_threads, num - 1);
+
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i] = args[0];
+        args[i].num = num;
+        args[i].index = &index;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                                 _equal_deg_worker, &args[i]);
+
+    _equal_deg_worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+}
+
+void
+nmod_poly_factor_equal_deg_threaded(nmod_poly_factor_t factors,
+                 const nmod_poly_struct * polys, const slong * degs, slong num)
+{
+    nmod_poly_struct * f, * g;
+    nmod_poly_factor_struct * fac, * ef;
+    slong * d, * b, * gd, * gb;
+    slong i, k, len, alloc, num_threads;
+    thread_pool_handle * threads;
+    _equal_deg_arg_t * args;
+
+    if (num < 1)
+        return;
+
+    num_threads = flint_request_threads(&threads, flint_get_num_threads());
+
+    /*
+        Every pending polynomial is split once per round until there are
+        at least as many of them as threads, then each is factored fully
+        by one thread. In a splitting round there are at most num_threads
+        pending polynomials, which give at most twice as many.
+    */
+    alloc = FLINT_MAX(num, 2*num_threads);
+
+    f = (nmod_poly_struct *) flint_malloc(2*alloc*sizeof(nmod_poly_struct));
+    g = f + alloc;
+    ef = (nmod_poly_factor_struct *) flint_malloc((num + alloc)*
+                                            sizeof(nmod_poly_factor_struct));
+    fac = ef + alloc;
+    d = (slong *) flint_malloc(4*alloc*sizeof(slong));
+    b = d + alloc;
+    gd = b + alloc;
+    gb = gd + alloc;
+    args = (_equal_deg_arg_t *) flint_malloc((num_threads + 1)*
+                                                    sizeof(_equal_deg_arg_t));
+
+    for (i = 0; i < alloc; i++)
+    {
+        nmod_poly_init_mod(f + i, polys[0].mod);
+        nmod_poly_init_mod(g + i, polys[0].mod);
+        nmod_poly_factor_init(ef + i);
+    }
+
+    for (i = 0; i < num; i++)
+        nmod_poly_factor_init(fac + i);
+
+    len = 0;
+    for (i = 0; i < num; i++)
+    {
+        if (polys[i].length == degs[i] + 1)
+        {
+            nmod_poly_factor_insert(fac + i, polys + i, 1);
+        }
+        else
+        {
+            nmod_poly_set(f + len, polys + i);
+            d[len] = degs[i];
+            b[len] = i;
+            len++;
+        }
+    }
+
+    while (len > 0)
+    {
+        args[0].f = f;
+        args[0].g = g;
+        args[0].fac = ef;
+        args[0].d = d;
+        args[0].split = (len <= num_threads);
+
+        _equal_deg_run(args, len, threads, num_threads);
+
+        if (!args[0].split)
+        {
+            for (i = 0; i < len; i++)
+                nmod_poly_factor_concat(fac + b[i], ef + i);
+
+            break;
+        }
+
+        for (i = 0; i < len; i++)
+        {
+            gd[i] = d[i];
+            gb[i] = b[i];
+        }
+
+        k = 0;
+        for (i = 0; i < len; i++)
+        {
+            if (f[i].length == d[i] + 1)
+            {
+                nmod_poly_factor_insert(fac + b[i], f + i, 1);
+            }
+            else
+            {
+                nmod_poly_swap(f + k, f + i);
+                d[k] = d[i];
+                b[k] = b[i];
+                k++;
+            }
+        }
+
+        for (i = 0; i < len; i++)
+        {
+            if (g[i].length == gd[i] + 1)
+            {
+                nmod_poly_factor_insert(fac + gb[i], g + i, 1);
+            }
+            else
+            {
+                nmod_poly_swap(f + k, g + i);
+                d[k] = gd[i];
+                b[k] = gb[i];
+                k++;
+            }
+        }
+
+        len = k;
+    }
+
+    for (i = 0; i < num; i++)
+    {
+        nmod_poly_factor_concat(factors, fac + i);
+        nmod_poly_factor_clear(fac + i);
+    }
+
+    for (i = 0; i < alloc; i++)
+    {
+        nmod_poly_clear(f + i);
+        nmod_poly_clear(g + i);
+        nmod_poly_factor_clear(ef + i);
+    }
+
+    flint_give_back_threads(threads, num_threads);
+
+    flint_free(args);
+    flint_free(d);
+    flint_free(ef);
+    flint_free(f);
+}
@@ -56,14 +56,27 @@ void nmod_poly_factor_kaltofen_shoup(nmod_poly_factor_t res,
             nmod_poly_factor_distinct_deg(dist_deg, sq_free->p + i, &degs);
 
         /* compute equal-degree factorisation */
-        for (j = dist_deg_num, l = 0; j < dist_deg->num; j++, l++)
+        if ((flint_get_num_threads() > 1) &&
+            (dist_deg->num - dist_deg_num > 1 || (sq_free->p + i)->length > 64))
         {
             res_num = res->num;
 
-            nmod_poly_factor_equal_deg(res, dist_deg->p + j, degs[l]);
+            nmod_poly_factor_equal_deg_threaded(res, dist_deg->p + dist_deg_num,
+                                             degs, dist_deg->num - dist_deg_num);
             for (k = res_num; k < res->num; k++)
                 res->exp[k] = nmod_poly_remove(v, res->p + k);
         }
+        else
+        {
+            for (j = dist_deg_num, l = 0; j < dist_deg->num; j++, l++)
+            {
+                res_num = res->num;
+
+                nmod_poly_factor_equal_deg(res, dist_deg->p + j, degs[l]);
+                for (k = res_num; k < res->num; k++)
+                    res->exp[k] = nmod_poly_remove(v, res->p + k);
+            }
+        }
     }
 
     flint_free(degs);
@@ -0,0 +1,125 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include "nmod_poly.h"
+#include "ulong_extras.h"
+#include "flint.h"
+
+#define MAX_DEG 7
+
+int
+main(void)
+{
+    int iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("factor_equal_deg_threaded....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 20 * flint_test_multiplier(); iter++)
+    {
+        nmod_poly_t poly1, poly, q, r, product;
+        nmod_poly_factor_t dist_deg, res;
+        mp_limb_t modulus;
+        slong i, j, length, num;
+        slong * degs;
+
+        modulus = n_randtest_prime(state, 0);
+
+        flint_set_num_threads(1 + n_randint(state, 5));
+
+        nmod_poly_init(poly1, modulus);
+        nmod_poly_init(poly, modulus);
+        nmod_poly_init(q, modulus);
+        nmod_poly_init(r, modulus);
+        nmod_poly_init(product, modulus);
+
+        nmod_poly_one(poly1);
+
+        num = n_randint(state, 12) + 1;
+
+        for (i = 0; i < num; i++)
+        {
+            do
+            {
+                length = n_randint(state, MAX_DEG) + 2;
+                nmod_poly_randtest(poly, state, length);
+                if (poly->length)
+                {
+                    nmod_poly_make_monic(poly, poly);
+                    nmod_poly_divrem(q, r, poly1, poly);
+                }
+            }
+            while ((poly->length < 2) || (!nmod_poly_is_irreducible(poly)) ||
+                (r->length == 0));
+
+            nmod_poly_mul(poly1, poly1, poly);
+        }
+
+        degs = (slong *) flint_malloc((poly1->length - 1) * sizeof(slong));
+
+        nmod_poly_factor_init(dist_deg);
+        nmod_poly_factor_init(res);
+        nmod_poly_factor_distinct_deg(dist_deg, poly1, &degs);
+        nmod_poly_factor_equal_deg_threaded(res, dist_deg->p, degs,
+                                                               dist_deg->num);
+
+        if (res->num != num)
+        {
+            flint_printf("FAIL: wrong number of factors\n");
+            flint_printf("%wd != %wd\n", res->num, num);
+            flint_abort();
+        }
+
+        nmod_poly_one(product);
+        for (i = 0; i < res->num; i++)
+        {
+            nmod_poly_mul(product, product, res->p + i);
+
+            for (j = 0; j < dist_deg->num; j++)
+            {
+                nmod_poly_divrem(q, r, dist_deg->p + j, res->p + i);
+                if (r->length == 0)
+                    break;
+            }
+
+            if (j == dist_deg->num || res->exp[i] != 1 ||
+                nmod_poly_degree(res->p + i) != degs[j] ||
+                !nmod_poly_is_irreducible(res->p + i))
+            {
+                flint_printf("FAIL: bad factor\n");
+                nmod_poly_print(res->p + i); flint_printf("\n");
+                flint_abort();
+            }
+        }
+
+        if (!nmod_poly_equal(poly1, product))
+        {
+            flint_printf("FAIL: product of factors does not equal the original polynomial\n");
+            flint_printf("poly:\n"); nmod_poly_print(poly1); flint_printf("\n");
+            flint_printf("product:\n"); nmod_poly_print(product); flint_printf("\n");
+            flint_abort();
+        }
+
+        flint_free(degs);
+        nmod_poly_clear(product);
+        nmod_poly_clear(q);
+        nmod_poly_clear(r);
+        nmod_poly_clear(poly1);
+        nmod_poly_clear(poly);
+        nmod_poly_factor_clear(dist_deg);
+        nmod_poly_factor_clear(res);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
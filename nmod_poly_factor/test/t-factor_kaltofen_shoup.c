@@ -16,6 +16,7 @@
 #include <stdlib.h>
 #include "nmod_poly.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -35,6 +36,8 @@ main(void)
         slong i, j, length, num;
         slong exp[5];
 
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
         modulus = n_randtest_prime(state, 0);
 
         nmod_poly_init(poly1, modulus);
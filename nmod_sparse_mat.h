@@ -0,0 +1,252 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef NMOD_SPARSE_MAT_H
+#define NMOD_SPARSE_MAT_H
+
+#ifdef NMOD_SPARSE_MAT_INLINES_C
+#define NMOD_SPARSE_MAT_INLINE FLINT_DLL
+#else
+#define NMOD_SPARSE_MAT_INLINE static __inline__
+#endif
+
+#undef ulong
+#define ulong ulongxx /* interferes with system includes */
+#include <stdlib.h>
+#undef ulong
+#include <gmp.h>
+#define ulong mp_limb_t
+
+#include "flint.h"
+#include "longlong.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "nmod_poly.h"
+#include "n_poly.h"
+#include "thread_support.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/*
+    Compressed sparse row storage: the nonzero entries of row i are
+    entries[row_starts[i]], ..., entries[row_starts[i + 1] - 1], sorted by
+    column. The column index is stored next to the value so that a
+    product with a vector streams through a single array. The length of
+    the longest row, which bounds the dot products, is kept up to date by
+    the functions which set the entries.
+*/
+
+typedef struct
+{
+    slong col;
+    mp_limb_t val;
+}
+nmod_sparse_mat_entry_struct;
+
+typedef struct
+{
+    nmod_sparse_mat_entry_struct * entries;
+    slong * row_starts;
+    slong r;
+    slong c;
+    slong alloc;
+    slong max_row_len;
+    nmod_t mod;
+}
+nmod_sparse_mat_struct;
+
+typedef nmod_sparse_mat_struct nmod_sparse_mat_t[1];
+
+/* number of nonzero entries per thread below which products are serial */
+#define NMOD_SPARSE_MAT_MUL_THREADED_CUTOFF 16384
+
+NMOD_SPARSE_MAT_INLINE
+slong nmod_sparse_mat_nrows(const nmod_sparse_mat_t M)
+{
+    return M->r;
+}
+
+NMOD_SPARSE_MAT_INLINE
+slong nmod_sparse_mat_ncols(const nmod_sparse_mat_t M)
+{
+    return M->c;
+}
+
+NMOD_SPARSE_MAT_INLINE
+slong nmod_sparse_mat_nnz(const nmod_sparse_mat_t M)
+{
+    return M->row_starts[M->r];
+}
+
+NMOD_SPARSE_MAT_INLINE
+void _nmod_sparse_mat_set_max_row_len(nmod_sparse_mat_t M)
+{
+    slong i;
+
+    M->max_row_len = 0;
+    for (i = 0; i < M->r; i++)
+        M->max_row_len = FLINT_MAX(M->max_row_len,
+                                     M->row_starts[i + 1] - M->row_starts[i]);
+}
+
+/* makes X an r x c matrix modulo p, reusing its storage if it fits */
+NMOD_SPARSE_MAT_INLINE
+void _nmod_sparse_mat_fit_output(nmod_mat_t X, slong r, slong c, mp_limb_t p)
+{
+    if (X->r != r || X->c != c)
+    {
+        nmod_mat_t T;
+
+        nmod_mat_init(T, r, c, p);
+        nmod_mat_swap(X, T);
+        nmod_mat_clear(T);
+    }
+    else
+    {
+        _nmod_mat_set_mod(X, p);
+    }
+}
+
+/* Memory management */
+
+FLINT_DLL void nmod_sparse_mat_init(nmod_sparse_mat_t M,
+                                            slong rows, slong cols, mp_limb_t n);
+
+FLINT_DLL void nmod_sparse_mat_clear(nmod_sparse_mat_t M);
+
+FLINT_DLL void nmod_sparse_mat_fit_nnz(nmod_sparse_mat_t M, slong nnz);
+
+NMOD_SPARSE_MAT_INLINE
+void nmod_sparse_mat_swap(nmod_sparse_mat_t M1, nmod_sparse_mat_t M2)
+{
+    nmod_sparse_mat_struct t = *M1;
+    *M1 = *M2;
+    *M2 = t;
+}
+
+FLINT_DLL void nmod_sparse_mat_zero(nmod_sparse_mat_t M);
+
+/* Conversions and comparison */
+
+FLINT_DLL void nmod_sparse_mat_set(nmod_sparse_mat_t M,
+                                                    const nmod_sparse_mat_t A);
+
+FLINT_DLL void nmod_sparse_mat_set_entries(nmod_sparse_mat_t M,
+            const slong * rows, const slong * cols, mp_srcptr vals, slong len);
+
+FLINT_DLL void nmod_sparse_mat_set_nmod_mat(nmod_sparse_mat_t M,
+                                                          const nmod_mat_t A);
+
+FLINT_DLL void nmod_sparse_mat_get_nmod_mat(nmod_mat_t A,
+                                                   const nmod_sparse_mat_t M);
+
+FLINT_DLL int nmod_sparse_mat_equal(const nmod_sparse_mat_t A,
+                                                   const nmod_sparse_mat_t B);
+
+FLINT_DLL void nmod_sparse_mat_transpose(nmod_sparse_mat_t B,
+                                                   const nmod_sparse_mat_t A);
+
+FLINT_DLL void nmod_sparse_mat_scale_cols(nmod_sparse_mat_t B,
+                                     const nmod_sparse_mat_t A, mp_srcptr d);
+
+FLINT_DLL void nmod_sparse_mat_scale_rows(nmod_sparse_mat_t B,
+                                     const nmod_sparse_mat_t A, mp_srcptr d);
+
+/* Random generation */
+
+FLINT_DLL void nmod_sparse_mat_randtest(nmod_sparse_mat_t M,
+                                       flint_rand_t state, slong max_row_nnz);
+
+/* Products */
+
+/* first row r such that the rows before it hold at least nnz entries */
+FLINT_DLL slong _nmod_sparse_mat_row_for_nnz(const nmod_sparse_mat_t A,
+                                                                  slong nnz);
+
+FLINT_DLL void nmod_sparse_mat_mul_vec(mp_ptr y, const nmod_sparse_mat_t A,
+                                                                 mp_srcptr x);
+
+FLINT_DLL void nmod_sparse_mat_mul_mat(nmod_mat_t Y,
+                               const nmod_sparse_mat_t A, const nmod_mat_t X);
+
+/* Gaussian elimination */
+
+FLINT_DLL slong _nmod_sparse_mat_echelon(nmod_sparse_mat_t B,
+                                  mp_limb_t * det, const nmod_sparse_mat_t A);
+
+FLINT_DLL slong nmod_sparse_mat_rref(nmod_sparse_mat_t B,
+                                                   const nmod_sparse_mat_t A);
+
+FLINT_DLL slong nmod_sparse_mat_nullspace_rref(nmod_mat_t X,
+                                                   const nmod_sparse_mat_t A);
+
+/* Wiedemann algorithms */
+
+/*
+    The random diagonal preconditioners of the rank, nullspace and
+    determinant algorithms fail with probability up to about n^2/q over a
+    field with q elements, so these work over the extension F_q of F_p
+    of least degree k with q = p^k > 2^NMOD_SPARSE_MAT_EXTENSION_BITS n^2.
+*/
+#define NMOD_SPARSE_MAT_EXTENSION_BITS 16
+
+FLINT_DLL slong _nmod_sparse_mat_extension_degree(mp_limb_t p, slong n);
+
+FLINT_DLL void _nmod_sparse_mat_extension_init(fq_nmod_ctx_t ctx,
+                              mp_limb_t p, slong k, flint_rand_t state);
+
+FLINT_DLL void _nmod_sparse_mat_rand_diag(mp_ptr D, slong n,
+                              flint_rand_t state, const fq_nmod_ctx_t ctx);
+
+/* multiplies the elements of F_q in row i of W by D_i */
+FLINT_DLL void _nmod_sparse_mat_wiedemann_scale(nmod_mat_t W, mp_srcptr D,
+                                                     const fq_nmod_ctx_t ctx);
+
+/* W = B D2 A D1 W for a block W of vectors over F_q, using T if B != NULL */
+FLINT_DLL void _nmod_sparse_mat_wiedemann_apply(nmod_mat_t W, nmod_mat_t T,
+                const nmod_sparse_mat_t A, const nmod_sparse_mat_struct * B,
+                   mp_srcptr D1, mp_srcptr D2, const fq_nmod_ctx_t ctx);
+
+FLINT_DLL void _nmod_sparse_mat_block_wiedemann(n_fq_poly_struct * G,
+                const nmod_sparse_mat_t A, const nmod_sparse_mat_struct * B,
+                             mp_srcptr D1, mp_srcptr D2, const nmod_mat_t U,
+                                  const nmod_mat_t V, const fq_nmod_ctx_t ctx);
+
+FLINT_DLL void _nmod_sparse_mat_generator_det(n_fq_poly_t f,
+             const n_fq_poly_struct * G, slong b, const fq_nmod_ctx_t ctx);
+
+FLINT_DLL void _nmod_sparse_mat_minpoly_proj(nmod_poly_t f,
+                const nmod_sparse_mat_t A, const nmod_sparse_mat_struct * B,
+                                        const nmod_mat_t U, const nmod_mat_t V);
+
+FLINT_DLL void nmod_sparse_mat_minpoly_wiedemann(nmod_poly_t f,
+               const nmod_sparse_mat_t A, slong block_size, flint_rand_t state);
+
+FLINT_DLL int nmod_sparse_mat_solve_wiedemann(mp_ptr x,
+                           const nmod_sparse_mat_t A, mp_srcptr b,
+                                         slong block_size, flint_rand_t state);
+
+FLINT_DLL int nmod_sparse_mat_det_wiedemann(mp_limb_t * det,
+               const nmod_sparse_mat_t A, slong block_size, flint_rand_t state);
+
+FLINT_DLL slong nmod_sparse_mat_rank_wiedemann(const nmod_sparse_mat_t A,
+                                         slong block_size, flint_rand_t state);
+
+FLINT_DLL slong nmod_sparse_mat_nullspace_wiedemann(nmod_mat_t X,
+               const nmod_sparse_mat_t A, slong block_size, flint_rand_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
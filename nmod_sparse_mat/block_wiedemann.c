@@ -0,0 +1,322 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+/* res = a_0 b_{len-1} + ... + a_{len-1} b_0 over F_q, using t of 6d limbs */
+static void
+_n_fq_dot_rev(mp_limb_t * res, const mp_limb_t * a, const mp_limb_t * b,
+                           slong len, const fq_nmod_ctx_t ctx, mp_limb_t * t)
+{
+    slong j, d = fq_nmod_ctx_degree(ctx);
+
+    if (d == 1)
+    {
+        res[0] = _nmod_vec_dot_rev(a, b, len, ctx->mod,
+                                   _nmod_vec_dot_bound_limbs(len, ctx->mod));
+        return;
+    }
+
+    _nmod_vec_zero(t, 6*d);
+
+    switch (_n_fq_dot_lazy_size(len, ctx))
+    {
+        case 1:
+            for (j = 0; j < len; j++)
+                _n_fq_madd2_lazy1(t, a + d*j, b + d*(len - 1 - j), d);
+            _n_fq_reduce2_lazy1(t, d, ctx->mod);
+            break;
+
+        case 2:
+            for (j = 0; j < len; j++)
+                _n_fq_madd2_lazy2(t, a + d*j, b + d*(len - 1 - j), d);
+            _n_fq_reduce2_lazy2(t, d, ctx->mod);
+            break;
+
+        case 3:
+            for (j = 0; j < len; j++)
+                _n_fq_madd2_lazy3(t, a + d*j, b + d*(len - 1 - j), d);
+            _n_fq_reduce2_lazy3(t, d, ctx->mod);
+            break;
+
+        default:
+            for (j = 0; j < len; j++)
+                _n_fq_madd2(t, a + d*j, b + d*(len - 1 - j), ctx, t + 2*d);
+    }
+
+    _n_fq_reduce2(res, t, ctx, t + 2*d);
+}
+
+/* A += c B, using t of 4d limbs */
+static void
+_n_fq_poly_addmul(n_fq_poly_t A, const n_fq_poly_t B, const mp_limb_t * c,
+                                       const fq_nmod_ctx_t ctx, mp_limb_t * t)
+{
+    slong i, d = fq_nmod_ctx_degree(ctx);
+
+    if (B->length == 0)
+        return;
+
+    n_poly_fit_length(A, d*B->length);
+
+    if (A->length < B->length)
+    {
+        _nmod_vec_zero(A->coeffs + d*A->length, d*(B->length - A->length));
+        A->length = B->length;
+    }
+
+    if (d == 1)
+        _nmod_vec_scalar_addmul_nmod(A->coeffs, B->coeffs, B->length, c[0],
+                                                                    ctx->mod);
+    else
+        for (i = 0; i < B->length; i++)
+            _n_fq_addmul(A->coeffs + d*i, A->coeffs + d*i, B->coeffs + d*i,
+                                                                  c, ctx, t);
+
+    _n_fq_poly_normalise(A, d);
+}
+
+/* sort the indices by shifted degree, keeping the order of equal ones */
+static void
+_sort_by_degree(slong * order, const slong * deg, slong m)
+{
+    slong i, j, t;
+
+    for (i = 0; i < m; i++)
+        order[i] = i;
+
+    for (i = 1; i < m; i++)
+    {
+        t = order[i];
+        for (j = i; j > 0 && deg[order[j - 1]] > deg[t]; j--)
+            order[j] = order[j - 1];
+        order[j] = t;
+    }
+}
+
+/*
+    The right generators of the b1 x b2 sequence S_k = U M^k V are the
+    polynomial matrices G = sum G_j x^j with sum_j S_(k + j) G_j = 0 for all
+    k. Reversing the column of G of degree d into a, this says that
+    S(x) a(x) = g(x) with deg g < d, where S(x) = sum S_k x^k. The rows
+    (a^T, g^T) of an order basis of F = [S^T; -I] modulo x^len with shifts
+    0 on a and 1 on g are computed by the M-Basis algorithm, one
+    coefficient at a time. Once len exceeds the degrees of the minimal left
+    and right generators, the b2 rows of smallest shifted degree give the
+    minimal right generator.
+*/
+
+void
+_nmod_sparse_mat_block_wiedemann(n_fq_poly_struct * G,
+                const nmod_sparse_mat_t A, const nmod_sparse_mat_struct * B,
+                             mp_srcptr D1, mp_srcptr D2, const nmod_mat_t U,
+                                  const nmod_mat_t V, const fq_nmod_ctx_t ctx)
+{
+    slong d = fq_nmod_ctx_degree(ctx);
+    slong n = V->r, b1 = U->r/d, b2 = V->c/d, m = b1 + b2;
+    slong i, j, k, l, c, s, t, len, piv;
+    nmod_mat_t W, T, S;
+    n_fq_poly_struct * P;
+    mp_ptr seq, delta, e, u, tmp;
+    slong * deg, * order;
+    int * used;
+    nmod_t mod = ctx->mod;
+
+    len = (n + b1 - 1)/b1 + (n + b2 - 1)/b2 + 2;
+
+    /*
+        The sequence. U holds the coordinates U_t of the entries of the
+        projection in rows t b1, ..., t b1 + b1 - 1, and the entries of V
+        and the blocks of vectors W are stored as d consecutive coordinates,
+        so that U_t W gives the coefficient of y^t of U W in y^(t + s).
+    */
+    seq = _nmod_vec_init(d*b1*b2*len);
+    tmp = _nmod_vec_init(6*d);
+
+    nmod_mat_init_set(W, V);
+    nmod_mat_init(T, (B == NULL) ? 0 : A->r, V->c, mod.n);
+    nmod_mat_init(S, U->r, V->c, mod.n);
+
+#define SEQ(c, l, k) (seq + d*((((c)*b2) + (l))*len + (k)))
+
+    for (k = 0; k < len; k++)
+    {
+        nmod_mat_mul(S, U, W);
+
+        for (c = 0; c < b1; c++)
+        {
+            for (l = 0; l < b2; l++)
+            {
+                if (d == 1)
+                {
+                    SEQ(c, l, k)[0] = nmod_mat_entry(S, c, l);
+                    continue;
+                }
+
+                _nmod_vec_zero(tmp, 2*d - 1);
+                for (t = 0; t < d; t++)
+                    for (s = 0; s < d; s++)
+                        tmp[t + s] = nmod_add(tmp[t + s],
+                                nmod_mat_entry(S, t*b1 + c, l*d + s), mod);
+
+                _n_fq_reduce2(SEQ(c, l, k), tmp, ctx, tmp + 2*d);
+            }
+        }
+
+        if (k + 1 < len)
+            _nmod_sparse_mat_wiedemann_apply(W, T, A, B, D1, D2, ctx);
+    }
+
+    nmod_mat_clear(W);
+    nmod_mat_clear(T);
+    nmod_mat_clear(S);
+
+    /* the order basis P, starting from the identity */
+    P = (n_fq_poly_struct *) flint_malloc(m*m*sizeof(n_fq_poly_struct));
+    deg = (slong *) flint_malloc(2*m*sizeof(slong));
+    order = deg + m;
+    used = (int *) flint_malloc(m*sizeof(int));
+    delta = _nmod_vec_init(d*(m*b1 + 2));
+    e = delta + d*m*b1;
+    u = e + d;
+
+    for (i = 0; i < m; i++)
+    {
+        for (j = 0; j < m; j++)
+            n_fq_poly_init(P + i*m + j);
+
+        n_fq_poly_one(P + i*m + i, ctx);
+        deg[i] = (i < b2) ? 0 : 1;
+    }
+
+#define P_(i, j) (P + (i)*m + (j))
+#define DELTA(i, c) (delta + d*((i)*b1 + (c)))
+
+    for (k = 0; k < len; k++)
+    {
+        /* the coefficient of x^k of P F, whose lower ones are zero */
+        for (i = 0; i < m; i++)
+        {
+            for (c = 0; c < b1; c++)
+            {
+                _nmod_vec_zero(DELTA(i, c), d);
+
+                for (l = 0; l < b2; l++)
+                {
+                    slong alen = FLINT_MIN(P_(i, l)->length, k + 1);
+
+                    if (alen == 0)
+                        continue;
+
+                    _n_fq_dot_rev(e, P_(i, l)->coeffs,
+                                          SEQ(c, l, k - alen + 1), alen, ctx, tmp);
+                    _nmod_vec_add(DELTA(i, c), DELTA(i, c), e, d, mod);
+                }
+
+                if (P_(i, b2 + c)->length > k)
+                    _nmod_vec_sub(DELTA(i, c), DELTA(i, c),
+                                          P_(i, b2 + c)->coeffs + d*k, d, mod);
+            }
+        }
+
+        /*
+            Eliminate each column with the row of smallest shifted degree
+            having a nonzero entry in it. The rows used as pivots are then
+            multiplied by x, so that all coefficients of x^k vanish.
+        */
+        _sort_by_degree(order, deg, m);
+
+        for (i = 0; i < m; i++)
+            used[i] = 0;
+
+        for (c = 0; c < b1; c++)
+        {
+            for (j = 0; j < m; j++)
+                if (!used[order[j]] && !_n_fq_is_zero(DELTA(order[j], c), d))
+                    break;
+
+            if (j == m)
+                continue;
+
+            piv = order[j];
+            used[piv] = 1;
+
+            _n_fq_inv(u, DELTA(piv, c), ctx, tmp);
+
+            for (j++; j < m; j++)
+            {
+                i = order[j];
+
+                if (used[i] || _n_fq_is_zero(DELTA(i, c), d))
+                    continue;
+
+                /* row i -= (delta_(i, c)/delta_(piv, c)) row piv */
+                _n_fq_mul(e, DELTA(i, c), u, ctx, tmp);
+                _n_fq_neg(e, e, d, mod);
+
+                for (s = c; s < b1; s++)
+                    _n_fq_addmul(DELTA(i, s), DELTA(i, s), DELTA(piv, s), e,
+                                                                   ctx, tmp);
+
+                for (l = 0; l < m; l++)
+                    _n_fq_poly_addmul(P_(i, l), P_(piv, l), e, ctx, tmp);
+            }
+        }
+
+        for (i = 0; i < m; i++)
+        {
+            if (!used[i])
+                continue;
+
+            for (l = 0; l < m; l++)
+                n_fq_poly_shift_left(P_(i, l), P_(i, l), 1, ctx);
+
+            deg[i]++;
+        }
+    }
+
+    /* column j of G is the reversal of the a part of the j-th row */
+    _sort_by_degree(order, deg, m);
+
+    for (j = 0; j < b2; j++)
+    {
+        i = order[j];
+
+        for (l = 0; l < b2; l++)
+        {
+            n_fq_poly_struct * a = P_(i, l), * g = G + l*b2 + j;
+
+            n_poly_fit_length(g, d*(deg[i] + 1));
+
+            for (t = 0; t <= deg[i]; t++)
+            {
+                if (deg[i] - t < a->length)
+                    _n_fq_set(g->coeffs + d*t, a->coeffs + d*(deg[i] - t), d);
+                else
+                    _n_fq_zero(g->coeffs + d*t, d);
+            }
+
+            g->length = deg[i] + 1;
+            _n_fq_poly_normalise(g, d);
+        }
+    }
+
+#undef SEQ
+#undef P_
+#undef DELTA
+
+    for (i = 0; i < m*m; i++)
+        n_fq_poly_clear(P + i);
+
+    flint_free(P);
+    flint_free(deg);
+    flint_free(used);
+    _nmod_vec_clear(delta);
+    _nmod_vec_clear(seq);
+    _nmod_vec_clear(tmp);
+}
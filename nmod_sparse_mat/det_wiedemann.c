@@ -0,0 +1,117 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+#define NMOD_SPARSE_MAT_DET_TRIES 4
+
+int
+nmod_sparse_mat_det_wiedemann(mp_limb_t * det, const nmod_sparse_mat_t A,
+                                         slong block_size, flint_rand_t state)
+{
+    fq_nmod_ctx_t ctx;
+    nmod_mat_t U, V;
+    n_fq_poly_struct * G;
+    n_fq_poly_t f;
+    mp_ptr D, c, e, t;
+    mp_limb_t p = A->mod.n;
+    slong i, j, b, d, n = A->r;
+    int success = 0;
+
+    if (A->r != A->c)
+    {
+        flint_printf("Exception (nmod_sparse_mat_det_wiedemann). "
+                     "Non-square matrix.\n");
+        flint_abort();
+    }
+
+    if (n == 0)
+    {
+        *det = UWORD(1) % p;
+        return 1;
+    }
+
+    if (p == 1)
+    {
+        *det = 0;
+        return 1;
+    }
+
+    b = FLINT_MAX(block_size, 1);
+    d = _nmod_sparse_mat_extension_degree(p, n);
+    _nmod_sparse_mat_extension_init(ctx, p, d, state);
+
+    nmod_mat_init(U, d*b, n, p);
+    nmod_mat_init(V, n, d*b, p);
+    n_fq_poly_init(f);
+    D = _nmod_vec_init(d*(n + 2) + N_FQ_MUL_INV_ITCH*d);
+    c = D + d*n;
+    e = c + d;
+    t = e + d;
+
+    G = (n_fq_poly_struct *) flint_malloc(b*b*sizeof(n_fq_poly_struct));
+    for (i = 0; i < b*b; i++)
+        n_fq_poly_init(G + i);
+
+    for (j = 0; j < NMOD_SPARSE_MAT_DET_TRIES && !success; j++)
+    {
+        /*
+            For a random diagonal matrix D over F_q the matrix AD is cyclic
+            w.h.p. if A is nonsingular, and the determinant of the minimal
+            generator is then a multiple of its characteristic polynomial.
+            It divides it in any case.
+        */
+        _nmod_sparse_mat_rand_diag(D, n, state, ctx);
+        nmod_mat_rand(U, state);
+        nmod_mat_rand(V, state);
+
+        _nmod_sparse_mat_block_wiedemann(G, A, NULL, D, NULL, U, V, ctx);
+        _nmod_sparse_mat_generator_det(f, G, b, ctx);
+
+        if (n_fq_poly_is_zero(f))
+            continue;
+
+        if (_n_fq_is_zero(f->coeffs, d))
+        {
+            *det = 0;
+            success = 1;
+        }
+        else if (n_fq_poly_degree(f) == n)
+        {
+            /* det(A) = (-1)^n f(0)/(lc(f) det(D)) */
+            _n_fq_set(c, f->coeffs + d*n, d);
+            for (i = 0; i < n; i++)
+                _n_fq_mul(c, c, D + d*i, ctx, t);
+
+            _n_fq_inv(e, c, ctx, t);
+            _n_fq_mul(c, e, f->coeffs, ctx, t);
+
+            if (n % 2 == 1)
+                _n_fq_neg(c, c, d, A->mod);
+
+            /* anything else shows a failure */
+            if (_n_fq_is_ui(c, d))
+            {
+                *det = c[0];
+                success = 1;
+            }
+        }
+    }
+
+    for (i = 0; i < b*b; i++)
+        n_fq_poly_clear(G + i);
+    flint_free(G);
+
+    _nmod_vec_clear(D);
+    n_fq_poly_clear(f);
+    nmod_mat_clear(U);
+    nmod_mat_clear(V);
+    fq_nmod_ctx_clear(ctx);
+
+    return success;
+}
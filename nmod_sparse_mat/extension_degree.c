@@ -0,0 +1,25 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include <math.h>
+#include "nmod_sparse_mat.h"
+
+slong
+_nmod_sparse_mat_extension_degree(mp_limb_t p, slong n)
+{
+    double bound;
+    slong k;
+
+    /* log(2^bits n^2), rounding does not matter here */
+    bound = NMOD_SPARSE_MAT_EXTENSION_BITS*log(2.0)
+                                     + 2*log((double) FLINT_MAX(n, 1));
+
+    for (k = 1; k*log((double) p) <= bound; k++) ;
+
+    return k;
+}
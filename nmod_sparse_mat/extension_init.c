@@ -0,0 +1,28 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+void
+_nmod_sparse_mat_extension_init(fq_nmod_ctx_t ctx, mp_limb_t p, slong k,
+                                                           flint_rand_t state)
+{
+    nmod_poly_t modulus;
+
+    nmod_poly_init(modulus, p);
+
+    /* F_p itself is given by the modulus x */
+    if (k == 1)
+        nmod_poly_set_coeff_ui(modulus, 1, 1);
+    else
+        nmod_poly_randtest_sparse_irreducible(modulus, state, k + 1);
+
+    fq_nmod_ctx_init_modulus(ctx, modulus, "y");
+
+    nmod_poly_clear(modulus);
+}
@@ -0,0 +1,23 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_fit_nnz(nmod_sparse_mat_t M, slong nnz)
+{
+    if (nnz > M->alloc)
+    {
+        nnz = FLINT_MAX(nnz, 2*M->alloc);
+
+        M->entries = (nmod_sparse_mat_entry_struct *) flint_realloc(
+                  M->entries, nnz*sizeof(nmod_sparse_mat_entry_struct));
+        M->alloc = nnz;
+    }
+}
@@ -0,0 +1,87 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+/* fraction free elimination, the generators being small matrices */
+
+void
+_nmod_sparse_mat_generator_det(n_fq_poly_t f, const n_fq_poly_struct * G,
+                                             slong b, const fq_nmod_ctx_t ctx)
+{
+    n_fq_poly_struct * M;
+    n_fq_poly_t prev, t, u, r;
+    slong i, j, k, piv;
+    int neg = 0;
+
+    M = (n_fq_poly_struct *) flint_malloc(b*b*sizeof(n_fq_poly_struct));
+    for (i = 0; i < b*b; i++)
+    {
+        n_fq_poly_init(M + i);
+        n_fq_poly_set(M + i, G + i, ctx);
+    }
+
+    n_fq_poly_init(prev);
+    n_fq_poly_init(t);
+    n_fq_poly_init(u);
+    n_fq_poly_init(r);
+
+    n_fq_poly_one(prev, ctx);
+    n_fq_poly_one(f, ctx);
+
+    for (k = 0; k < b; k++)
+    {
+        for (piv = k; piv < b && n_fq_poly_is_zero(M + piv*b + k); piv++) ;
+
+        if (piv == b)
+        {
+            n_fq_poly_zero(f);
+            goto cleanup;
+        }
+
+        if (piv != k)
+        {
+            for (j = k; j < b; j++)
+                n_fq_poly_swap(M + piv*b + j, M + k*b + j);
+            neg = !neg;
+        }
+
+        /* M_ij = (M_ij M_kk - M_ik M_kj)/prev, which is exact */
+        for (i = k + 1; i < b; i++)
+        {
+            for (j = k + 1; j < b; j++)
+            {
+                n_fq_poly_mul(t, M + i*b + j, M + k*b + k, ctx);
+                n_fq_poly_mul(u, M + i*b + k, M + k*b + j, ctx);
+                n_fq_poly_sub(t, t, u, ctx);
+                n_fq_poly_divrem(M + i*b + j, r, t, prev, ctx);
+            }
+        }
+
+        n_fq_poly_set(prev, M + k*b + k, ctx);
+    }
+
+    if (b > 0)
+    {
+        if (neg)
+            n_fq_poly_neg(f, prev, ctx);
+        else
+            n_fq_poly_set(f, prev, ctx);
+    }
+
+cleanup:
+
+    for (i = 0; i < b*b; i++)
+        n_fq_poly_clear(M + i);
+    flint_free(M);
+
+    n_fq_poly_clear(prev);
+    n_fq_poly_clear(t);
+    n_fq_poly_clear(u);
+    n_fq_poly_clear(r);
+}
@@ -0,0 +1,75 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_poly_mat.h"
+#include "nmod_sparse_mat.h"
+
+/*
+    Sets f to the largest invariant factor of the minimal right generator G
+    of the sequence U M^k V, where M = A, or M = BA if B is not NULL. This
+    is the least f such that f G^(-1) is a polynomial matrix, and it is the
+    minimal polynomial of M with high probability for random U and V.
+*/
+
+void
+_nmod_sparse_mat_minpoly_proj(nmod_poly_t f, const nmod_sparse_mat_t A,
+                const nmod_sparse_mat_struct * B, const nmod_mat_t U,
+                                                         const nmod_mat_t V)
+{
+    fq_nmod_ctx_t ctx;
+    nmod_poly_t g, den;
+    nmod_poly_mat_t H, Hinv;
+    n_fq_poly_struct * G;
+    slong i, j, b = V->c;
+
+    _nmod_sparse_mat_extension_init(ctx, A->mod.n, 1, NULL);
+
+    G = (n_fq_poly_struct *) flint_malloc(b*b*sizeof(n_fq_poly_struct));
+    for (i = 0; i < b*b; i++)
+        n_fq_poly_init(G + i);
+
+    _nmod_sparse_mat_block_wiedemann(G, A, B, NULL, NULL, U, V, ctx);
+
+    nmod_poly_mat_init(H, b, b, A->mod.n);
+    nmod_poly_mat_init(Hinv, b, b, A->mod.n);
+    nmod_poly_init_mod(den, A->mod);
+    nmod_poly_init_mod(g, A->mod);
+
+    for (i = 0; i < b; i++)
+        for (j = 0; j < b; j++)
+            nmod_poly_set_n_poly(nmod_poly_mat_entry(H, i, j), G + i*b + j);
+
+    /* a singular G is a failure, and 1 divides the minimal polynomial */
+    if (!nmod_poly_mat_inv(Hinv, den, H))
+    {
+        nmod_poly_one(f);
+    }
+    else
+    {
+        /* f = den/gcd(den, entries of the adjugate) */
+        nmod_poly_set(g, den);
+
+        for (i = 0; i < b; i++)
+            for (j = 0; j < b; j++)
+                nmod_poly_gcd(g, g, nmod_poly_mat_entry(Hinv, i, j));
+
+        nmod_poly_div(f, den, g);
+        nmod_poly_make_monic(f, f);
+    }
+
+    nmod_poly_clear(den);
+    nmod_poly_mat_clear(Hinv);
+    nmod_poly_mat_clear(H);
+
+    for (i = 0; i < b*b; i++)
+        n_fq_poly_clear(G + i);
+    flint_free(G);
+
+    fq_nmod_ctx_clear(ctx);
+    nmod_poly_clear(g);
+}
@@ -0,0 +1,37 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_minpoly_wiedemann(nmod_poly_t f, const nmod_sparse_mat_t A,
+                                         slong block_size, flint_rand_t state)
+{
+    nmod_mat_t U, V;
+    slong n = A->r;
+
+    if (A->r != A->c)
+    {
+        flint_printf("Exception (nmod_sparse_mat_minpoly_wiedemann). "
+                     "Non-square matrix.\n");
+        flint_abort();
+    }
+
+    block_size = FLINT_MAX(block_size, 1);
+
+    nmod_mat_init(U, block_size, n, A->mod.n);
+    nmod_mat_init(V, n, block_size, A->mod.n);
+
+    nmod_mat_rand(U, state);
+    nmod_mat_rand(V, state);
+
+    _nmod_sparse_mat_minpoly_proj(f, A, NULL, U, V);
+
+    nmod_mat_clear(U);
+    nmod_mat_clear(V);
+}
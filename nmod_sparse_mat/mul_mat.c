@@ -0,0 +1,96 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+typedef struct
+{
+    nmod_mat_struct * Y;
+    const nmod_sparse_mat_struct * A;
+    const nmod_mat_struct * X;
+    slong r0;
+    slong r1;
+    int nlimbs;
+}
+_mul_mat_arg_t;
+
+static void
+_nmod_sparse_mat_mul_mat_worker(void * arg_ptr)
+{
+    _mul_mat_arg_t * arg = (_mul_mat_arg_t *) arg_ptr;
+    const nmod_sparse_mat_struct * A = arg->A;
+    mp_limb_t ** X = arg->X->rows;
+    nmod_t mod = A->mod;
+    slong i, j, k, len;
+
+    for (i = arg->r0; i < arg->r1; i++)
+    {
+        const nmod_sparse_mat_entry_struct * e = A->entries + A->row_starts[i];
+
+        len = A->row_starts[i + 1] - A->row_starts[i];
+
+        for (k = 0; k < arg->X->c; k++)
+            NMOD_VEC_DOT(arg->Y->rows[i][k], j, len, e[j].val,
+                                          X[e[j].col][k], mod, arg->nlimbs);
+    }
+}
+
+void
+nmod_sparse_mat_mul_mat(nmod_mat_t Y, const nmod_sparse_mat_t A,
+                                                          const nmod_mat_t X)
+{
+    thread_pool_handle * threads = NULL;
+    slong i, num_threads = 0, nnz = nmod_sparse_mat_nnz(A);
+    _mul_mat_arg_t * args;
+    int nlimbs;
+
+    nlimbs = _nmod_vec_dot_bound_limbs(A->max_row_len, A->mod);
+
+    if (Y == X)
+    {
+        nmod_mat_t T;
+        nmod_mat_init(T, Y->r, Y->c, Y->mod.n);
+        nmod_sparse_mat_mul_mat(T, A, X);
+        nmod_mat_swap_entrywise(Y, T);
+        nmod_mat_clear(T);
+        return;
+    }
+
+    if (nnz*X->c >= 2*NMOD_SPARSE_MAT_MUL_THREADED_CUTOFF)
+        num_threads = flint_request_threads(&threads,
+               FLINT_MIN(flint_get_num_threads(),
+                         (nnz*X->c)/NMOD_SPARSE_MAT_MUL_THREADED_CUTOFF));
+
+    args = (_mul_mat_arg_t *) flint_malloc((num_threads + 1)*
+                                                      sizeof(_mul_mat_arg_t));
+
+    /* the rows are split so that each thread gets as many entries */
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i].Y = Y;
+        args[i].A = A;
+        args[i].X = X;
+        args[i].r0 = (i == 0) ? 0 : args[i - 1].r1;
+        args[i].r1 = (i == num_threads) ? A->r :
+               _nmod_sparse_mat_row_for_nnz(A, (nnz*(i + 1))/(num_threads + 1));
+        args[i].nlimbs = nlimbs;
+    }
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                      _nmod_sparse_mat_mul_mat_worker, &args[i]);
+
+    _nmod_sparse_mat_mul_mat_worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+    flint_give_back_threads(threads, num_threads);
+
+    flint_free(args);
+}
@@ -0,0 +1,93 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+typedef struct
+{
+    mp_ptr y;
+    const nmod_sparse_mat_struct * A;
+    mp_srcptr x;
+    slong r0;
+    slong r1;
+    int nlimbs;
+}
+_mul_vec_arg_t;
+
+static void
+_nmod_sparse_mat_mul_vec_worker(void * arg_ptr)
+{
+    _mul_vec_arg_t * arg = (_mul_vec_arg_t *) arg_ptr;
+    const nmod_sparse_mat_struct * A = arg->A;
+    mp_srcptr x = arg->x;
+    nmod_t mod = A->mod;
+    slong i, j, len;
+
+    for (i = arg->r0; i < arg->r1; i++)
+    {
+        const nmod_sparse_mat_entry_struct * e = A->entries + A->row_starts[i];
+
+        len = A->row_starts[i + 1] - A->row_starts[i];
+
+        NMOD_VEC_DOT(arg->y[i], j, len, e[j].val, x[e[j].col], mod,
+                                                                 arg->nlimbs);
+    }
+}
+
+void
+nmod_sparse_mat_mul_vec(mp_ptr y, const nmod_sparse_mat_t A, mp_srcptr x)
+{
+    thread_pool_handle * threads = NULL;
+    slong i, num_threads = 0, nnz = nmod_sparse_mat_nnz(A);
+    _mul_vec_arg_t * args;
+    int nlimbs;
+
+    nlimbs = _nmod_vec_dot_bound_limbs(A->max_row_len, A->mod);
+
+    if (y == x)
+    {
+        mp_ptr t = _nmod_vec_init(A->r);
+        nmod_sparse_mat_mul_vec(t, A, x);
+        _nmod_vec_set(y, t, A->r);
+        _nmod_vec_clear(t);
+        return;
+    }
+
+    if (nnz >= 2*NMOD_SPARSE_MAT_MUL_THREADED_CUTOFF)
+        num_threads = flint_request_threads(&threads,
+               FLINT_MIN(flint_get_num_threads(),
+                         nnz/NMOD_SPARSE_MAT_MUL_THREADED_CUTOFF));
+
+    args = (_mul_vec_arg_t *) flint_malloc((num_threads + 1)*
+                                                      sizeof(_mul_vec_arg_t));
+
+    /* the rows are split so that each thread gets as many entries */
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i].y = y;
+        args[i].A = A;
+        args[i].x = x;
+        args[i].r0 = (i == 0) ? 0 : args[i - 1].r1;
+        args[i].r1 = (i == num_threads) ? A->r :
+               _nmod_sparse_mat_row_for_nnz(A, (nnz*(i + 1))/(num_threads + 1));
+        args[i].nlimbs = nlimbs;
+    }
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                      _nmod_sparse_mat_mul_vec_worker, &args[i]);
+
+    _nmod_sparse_mat_mul_vec_worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+    flint_give_back_threads(threads, num_threads);
+
+    flint_free(args);
+}
@@ -0,0 +1,54 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+slong
+nmod_sparse_mat_nullspace_rref(nmod_mat_t X, const nmod_sparse_mat_t A)
+{
+    nmod_sparse_mat_t R;
+    slong i, j, k, rank, n = A->c, * free_col;
+
+    nmod_sparse_mat_init(R, 0, 0, A->mod.n);
+    rank = nmod_sparse_mat_rref(R, A);
+
+    _nmod_sparse_mat_fit_output(X, n, n - rank, A->mod.n);
+    nmod_mat_zero(X);
+
+    /* index of each column without pivot among such columns */
+    free_col = (slong *) flint_malloc(n*sizeof(slong));
+
+    for (j = 0; j < n; j++)
+        free_col[j] = 0;
+    for (i = 0; i < rank; i++)
+        free_col[R->entries[R->row_starts[i]].col] = -1;
+    for (j = 0, k = 0; j < n; j++)
+        if (free_col[j] == 0)
+            free_col[j] = k++;
+        else
+            free_col[j] = -1;
+
+    for (j = 0; j < n; j++)
+        if (free_col[j] >= 0)
+            nmod_mat_entry(X, j, free_col[j]) = UWORD(1);
+
+    /* all entries after the pivot of a row are in columns without pivot */
+    for (i = 0; i < rank; i++)
+    {
+        slong c = R->entries[R->row_starts[i]].col;
+
+        for (k = R->row_starts[i] + 1; k < R->row_starts[i + 1]; k++)
+            nmod_mat_entry(X, c, free_col[R->entries[k].col]) =
+                                     nmod_neg(R->entries[k].val, A->mod);
+    }
+
+    flint_free(free_col);
+    nmod_sparse_mat_clear(R);
+
+    return n - rank;
+}
@@ -0,0 +1,194 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+/* whether the coordinates j, ..., j + d - 1 of W are all zero */
+static int
+_cols_are_zero(const nmod_mat_t W, slong j, slong d)
+{
+    slong i;
+
+    for (i = 0; i < W->r; i++)
+        if (!_n_fq_is_zero(W->rows[i] + j, d))
+            return 0;
+
+    return 1;
+}
+
+slong
+nmod_sparse_mat_nullspace_wiedemann(nmod_mat_t X, const nmod_sparse_mat_t A,
+                                         slong block_size, flint_rand_t state)
+{
+    fq_nmod_ctx_t ctx;
+    nmod_sparse_mat_t T;
+    nmod_mat_t U, V, Y, W, Z, P, S, K, KW;
+    n_fq_poly_struct * G;
+    n_fq_poly_t f;
+    mp_ptr D1, D2, t;
+    mp_limb_t p = A->mod.n;
+    slong i, j, k, l, b, d, v, m = A->r, n = A->c, nullity, found, tries;
+
+    if (m == 0 || n == 0 || p == 1)
+    {
+        _nmod_sparse_mat_fit_output(X, n, n, p);
+        nmod_mat_one(X);
+        return n;
+    }
+
+    b = FLINT_MAX(block_size, 1);
+    d = _nmod_sparse_mat_extension_degree(p, FLINT_MAX(m, n));
+    _nmod_sparse_mat_extension_init(ctx, p, d, state);
+
+    D1 = _nmod_vec_init(d*(n + m) + N_FQ_MUL_ITCH*d);
+    D2 = D1 + d*n;
+    t = D2 + d*m;
+
+    _nmod_sparse_mat_rand_diag(D1, n + m, state, ctx);
+
+    /*
+        For random diagonal D1, D2 over F_q the kernel of M = A^T D2 A D1
+        is the kernel of A D1 w.h.p., and the determinant of the minimal
+        generator of M is x^v g with g(0) != 0 and deg g = rank(M). For a
+        random block Y, g(M) Y is then killed by a power of M, and for each
+        column w the last nonzero column of w, M w, ... gives a vector D1 w
+        in the kernel of A, as do the coordinates of D1 w over F_p.
+    */
+    nmod_sparse_mat_init(T, 0, 0, p);
+    nmod_sparse_mat_transpose(T, A);
+
+    nmod_mat_init(U, d*b, n, p);
+    nmod_mat_init(V, n, d*b, p);
+    n_fq_poly_init(f);
+
+    G = (n_fq_poly_struct *) flint_malloc(b*b*sizeof(n_fq_poly_struct));
+    for (i = 0; i < b*b; i++)
+        n_fq_poly_init(G + i);
+
+    nmod_mat_rand(U, state);
+    nmod_mat_rand(V, state);
+    _nmod_sparse_mat_block_wiedemann(G, A, T, D1, D2, U, V, ctx);
+    _nmod_sparse_mat_generator_det(f, G, b, ctx);
+
+    for (i = 0; i < b*b; i++)
+        n_fq_poly_clear(G + i);
+    flint_free(G);
+
+    /* a zero determinant is a failure, and no vector is looked for */
+    v = 0;
+    nullity = 0;
+    if (!n_fq_poly_is_zero(f))
+    {
+        for (v = 0; _n_fq_is_zero(f->coeffs + d*v, d); v++) ;
+        nullity = n - (n_fq_poly_degree(f) - v);
+        nullity = FLINT_MAX(nullity, 0);
+    }
+
+    nmod_mat_init(Y, n, d*b, p);
+    nmod_mat_init(W, n, d*b, p);
+    nmod_mat_init(Z, n, d*b, p);
+    nmod_mat_init(P, m, d*b, p);
+    nmod_mat_init(K, n, nullity, p);
+
+    found = 0;
+
+    for (tries = 0; found < nullity && tries < 2*nullity/b + 10; tries++)
+    {
+        nmod_mat_rand(Y, state);
+
+        /* W = g(M) Y */
+        nmod_mat_zero(W);
+        for (k = n_fq_poly_degree(f); k >= v; k--)
+        {
+            _nmod_sparse_mat_wiedemann_apply(W, P, A, T, D1, D2, ctx);
+
+            if (d == 1)
+            {
+                for (i = 0; i < n; i++)
+                    _nmod_vec_scalar_addmul_nmod(W->rows[i], Y->rows[i],
+                                          d*b, f->coeffs[k], A->mod);
+            }
+            else
+            {
+                for (i = 0; i < n; i++)
+                    for (j = 0; j < d*b; j += d)
+                        _n_fq_addmul(W->rows[i] + j, W->rows[i] + j,
+                              Y->rows[i] + j, f->coeffs + d*k, ctx, t);
+            }
+        }
+
+        /* M^v W = 0, keep the last nonzero column of W, M W, ... */
+        for (l = 0; l < v; l++)
+        {
+            int done = 1;
+
+            nmod_mat_set(Z, W);
+            _nmod_sparse_mat_wiedemann_apply(Z, P, A, T, D1, D2, ctx);
+
+            for (j = 0; j < d*b; j += d)
+            {
+                if (_cols_are_zero(Z, j, d))
+                    continue;
+
+                done = 0;
+                for (i = 0; i < n; i++)
+                    _n_fq_set(W->rows[i] + j, Z->rows[i] + j, d);
+            }
+
+            if (done)
+                break;
+        }
+
+        /* the columns of D1 W should be in the kernel of A */
+        _nmod_sparse_mat_wiedemann_scale(W, D1, ctx);
+        nmod_sparse_mat_mul_mat(P, A, W);
+
+        /* keep each such column independent of the vectors found so far */
+        for (j = 0; j < d*b && found < nullity; j++)
+        {
+            if (_cols_are_zero(W, j, 1) || !_cols_are_zero(P, j, 1))
+                continue;
+
+            for (i = 0; i < n; i++)
+                nmod_mat_entry(K, i, found) = nmod_mat_entry(W, i, j);
+
+            nmod_mat_window_init(KW, K, 0, 0, n, found + 1);
+
+            if (nmod_mat_rank(KW) == found + 1)
+                found++;
+
+            nmod_mat_window_clear(KW);
+        }
+    }
+
+    if (found == nullity)
+    {
+        nmod_mat_swap(X, K);
+    }
+    else
+    {
+        _nmod_sparse_mat_fit_output(X, n, found, p);
+        nmod_mat_window_init(S, K, 0, 0, n, found);
+        nmod_mat_set(X, S);
+        nmod_mat_window_clear(S);
+    }
+
+    nmod_mat_clear(Y);
+    nmod_mat_clear(W);
+    nmod_mat_clear(Z);
+    nmod_mat_clear(P);
+    nmod_mat_clear(K);
+    n_fq_poly_clear(f);
+    nmod_mat_clear(U);
+    nmod_mat_clear(V);
+    nmod_sparse_mat_clear(T);
+    _nmod_vec_clear(D1);
+    fq_nmod_ctx_clear(ctx);
+
+    return found;
+}
@@ -0,0 +1,24 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+void
+_nmod_sparse_mat_rand_diag(mp_ptr D, slong n, flint_rand_t state,
+                                                    const fq_nmod_ctx_t ctx)
+{
+    slong i, j, d = fq_nmod_ctx_degree(ctx);
+
+    for (i = 0; i < n; i++)
+    {
+        do {
+            for (j = 0; j < d; j++)
+                D[d*i + j] = n_randint(state, ctx->mod.n);
+        } while (_n_fq_is_zero(D + d*i, d));
+    }
+}
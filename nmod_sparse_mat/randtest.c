@@ -0,0 +1,42 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_randtest(nmod_sparse_mat_t M, flint_rand_t state,
+                                                            slong max_row_nnz)
+{
+    slong i, j, len, * rows, * cols;
+    mp_ptr vals;
+
+    len = M->r*FLINT_MIN(max_row_nnz, M->c);
+
+    rows = (slong *) flint_malloc(2*len*sizeof(slong));
+    cols = rows + len;
+    vals = _nmod_vec_init(len);
+
+    len = 0;
+    for (i = 0; i < M->r; i++)
+    {
+        slong row_nnz = n_randint(state, FLINT_MIN(max_row_nnz, M->c) + 1);
+
+        for (j = 0; j < row_nnz; j++)
+        {
+            rows[len] = i;
+            cols[len] = n_randint(state, M->c);
+            vals[len] = n_randtest(state) % M->mod.n;
+            len++;
+        }
+    }
+
+    nmod_sparse_mat_set_entries(M, rows, cols, vals, len);
+
+    _nmod_vec_clear(vals);
+    flint_free(rows);
+}
@@ -0,0 +1,89 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+slong
+nmod_sparse_mat_rank_wiedemann(const nmod_sparse_mat_t A, slong block_size,
+                                                           flint_rand_t state)
+{
+    fq_nmod_ctx_t ctx;
+    nmod_sparse_mat_t S, T;
+    nmod_mat_t U, V;
+    n_fq_poly_struct * G;
+    n_fq_poly_t f;
+    mp_ptr D1, D2;
+    mp_limb_t p = A->mod.n;
+    slong i, b, d, m, n, rank;
+
+    if (A->r == 0 || A->c == 0 || p == 1)
+        return 0;
+
+    /* work with the side having fewer columns */
+    nmod_sparse_mat_init(S, 0, 0, p);
+    nmod_sparse_mat_init(T, 0, 0, p);
+    if (A->r < A->c)
+        nmod_sparse_mat_transpose(S, A);
+    else
+        nmod_sparse_mat_set(S, A);
+    nmod_sparse_mat_transpose(T, S);
+
+    m = S->r;
+    n = S->c;
+
+    b = FLINT_MAX(block_size, 1);
+    d = _nmod_sparse_mat_extension_degree(p, m);
+    _nmod_sparse_mat_extension_init(ctx, p, d, state);
+
+    D1 = _nmod_vec_init(d*(n + m));
+    D2 = D1 + d*n;
+
+    _nmod_sparse_mat_rand_diag(D1, n + m, state, ctx);
+
+    /*
+        With random diagonal D1, D2 over F_q the matrix M = S^T D2 S D1,
+        which is similar to a symmetric one, has minimal polynomial x^e g
+        with e <= 1, g(0) != 0 and deg g = rank(S) w.h.p. The determinant
+        of the minimal generator, which divides the characteristic
+        polynomial, is then x^e' g.
+    */
+    nmod_mat_init(U, d*b, n, p);
+    nmod_mat_init(V, n, d*b, p);
+    n_fq_poly_init(f);
+
+    G = (n_fq_poly_struct *) flint_malloc(b*b*sizeof(n_fq_poly_struct));
+    for (i = 0; i < b*b; i++)
+        n_fq_poly_init(G + i);
+
+    nmod_mat_rand(U, state);
+    nmod_mat_rand(V, state);
+    _nmod_sparse_mat_block_wiedemann(G, S, T, D1, D2, U, V, ctx);
+    _nmod_sparse_mat_generator_det(f, G, b, ctx);
+
+    rank = 0;
+    if (!n_fq_poly_is_zero(f))
+    {
+        rank = n_fq_poly_degree(f);
+        for (i = 0; _n_fq_is_zero(f->coeffs + d*i, d); i++)
+            rank--;
+    }
+
+    for (i = 0; i < b*b; i++)
+        n_fq_poly_clear(G + i);
+    flint_free(G);
+
+    n_fq_poly_clear(f);
+    nmod_mat_clear(U);
+    nmod_mat_clear(V);
+    nmod_sparse_mat_clear(S);
+    nmod_sparse_mat_clear(T);
+    _nmod_vec_clear(D1);
+    fq_nmod_ctx_clear(ctx);
+
+    return FLINT_MIN(rank, n);
+}
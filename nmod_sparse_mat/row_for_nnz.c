@@ -0,0 +1,27 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+slong
+_nmod_sparse_mat_row_for_nnz(const nmod_sparse_mat_t A, slong nnz)
+{
+    slong lo = 0, hi = A->r;
+
+    while (lo < hi)
+    {
+        slong mid = lo + (hi - lo)/2;
+
+        if (A->row_starts[mid] < nnz)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
@@ -0,0 +1,326 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+/* a row with leading entry 1, stored by the column of that entry */
+typedef struct
+{
+    nmod_sparse_mat_entry_struct * entries;
+    slong len;
+}
+_pivot_row_struct;
+
+/* binary heap of the columns of the nonzero entries of the working row */
+static void
+_heap_push(slong * heap, slong * len, slong c)
+{
+    slong i = (*len)++, j;
+
+    while (i > 0)
+    {
+        j = (i - 1)/2;
+        if (heap[j] <= c)
+            break;
+        heap[i] = heap[j];
+        i = j;
+    }
+
+    heap[i] = c;
+}
+
+static slong
+_heap_pop(slong * heap, slong * len)
+{
+    slong top = heap[0], c, i = 0, j;
+
+    c = heap[--(*len)];
+
+    while ((j = 2*i + 1) < *len)
+    {
+        if (j + 1 < *len && heap[j + 1] < heap[j])
+            j++;
+        if (c <= heap[j])
+            break;
+        heap[i] = heap[j];
+        i = j;
+    }
+
+    heap[i] = c;
+
+    return top;
+}
+
+/*
+    Reduces the row given by its len entries by the pivot rows, writing
+    the nonzero entries of the result to out in order of column and
+    returning their number. If lead_only is set, only the leading entry
+    is made to avoid the pivot columns. The dense vector w must be zero
+    and mark must be clear on entry, and are left so.
+*/
+static slong
+_nmod_sparse_mat_reduce_row(nmod_sparse_mat_entry_struct * out,
+                  const nmod_sparse_mat_entry_struct * row, slong len,
+                  const _pivot_row_struct * piv, mp_ptr w, char * mark,
+                  slong * heap, int lead_only, nmod_t mod)
+{
+    slong i, j, c, hlen = 0, olen = 0;
+    mp_limb_t a;
+
+    for (i = 0; i < len; i++)
+    {
+        w[row[i].col] = row[i].val;
+        mark[row[i].col] = 1;
+        _heap_push(heap, &hlen, row[i].col);
+    }
+
+    while (hlen > 0)
+    {
+        j = _heap_pop(heap, &hlen);
+        mark[j] = 0;
+        a = w[j];
+        w[j] = 0;
+
+        if (a == 0)
+            continue;
+
+        if (piv[j].len != 0 && !(lead_only && olen != 0))
+        {
+            /* all other entries of the pivot row lie to the right of j */
+            for (i = 1; i < piv[j].len; i++)
+            {
+                c = piv[j].entries[i].col;
+                w[c] = nmod_sub(w[c],
+                             nmod_mul(a, piv[j].entries[i].val, mod), mod);
+
+                if (!mark[c])
+                {
+                    mark[c] = 1;
+                    _heap_push(heap, &hlen, c);
+                }
+            }
+        }
+        else
+        {
+            out[olen].col = j;
+            out[olen].val = a;
+            olen++;
+        }
+    }
+
+    return olen;
+}
+
+/* sign of the permutation i -> perm[i] of 0, ..., n - 1 */
+static int
+_perm_sign(const slong * perm, slong n)
+{
+    char * seen = (char *) flint_calloc(n, sizeof(char));
+    slong i, j, cycles = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        if (!seen[i])
+        {
+            cycles++;
+            for (j = i; !seen[j]; j = perm[j])
+                seen[j] = 1;
+        }
+    }
+
+    flint_free(seen);
+
+    return ((n - cycles) % 2 == 0) ? 1 : -1;
+}
+
+slong
+_nmod_sparse_mat_echelon(nmod_sparse_mat_t B, mp_limb_t * det,
+                                                   const nmod_sparse_mat_t A)
+{
+    _pivot_row_struct * piv;
+    nmod_sparse_mat_entry_struct * out;
+    slong * order, * heap, * cols = NULL;
+    mp_ptr w;
+    char * mark;
+    mp_limb_t d = UWORD(1), inv;
+    slong i, j, k, t, len, m = A->r, n = A->c, rank = 0, nnz;
+    nmod_t mod = A->mod;
+
+    if (m == 0 || n == 0)
+    {
+        if (det != NULL)
+            *det = (m == n) ? UWORD(1) % mod.n : 0;
+
+        if (B != NULL)
+        {
+            nmod_sparse_mat_set(B, A);
+            nmod_sparse_mat_zero(B);
+        }
+
+        return 0;
+    }
+
+    piv = (_pivot_row_struct *) flint_calloc(n, sizeof(_pivot_row_struct));
+    out = (nmod_sparse_mat_entry_struct *)
+                      flint_malloc(n*sizeof(nmod_sparse_mat_entry_struct));
+    order = (slong *) flint_malloc((m + A->max_row_len + 1)*sizeof(slong));
+    heap = (slong *) flint_malloc(n*sizeof(slong));
+    w = (mp_ptr) flint_calloc(n, sizeof(mp_limb_t));
+    mark = (char *) flint_calloc(n, sizeof(char));
+
+    if (det != NULL)
+        cols = (slong *) flint_malloc(m*sizeof(slong));
+
+    /* take the rows in order of length to limit fill in */
+    {
+        slong * count = order + m;
+
+        for (k = 0; k <= A->max_row_len; k++)
+            count[k] = 0;
+        for (i = 0; i < m; i++)
+            count[A->row_starts[i + 1] - A->row_starts[i]]++;
+        for (k = 0, j = 0; k <= A->max_row_len; k++)
+        {
+            t = count[k];
+            count[k] = j;
+            j += t;
+        }
+        for (i = 0; i < m; i++)
+            order[count[A->row_starts[i + 1] - A->row_starts[i]]++] = i;
+    }
+
+    for (k = 0; k < m && rank < n; k++)
+    {
+        i = order[k];
+
+        len = _nmod_sparse_mat_reduce_row(out,
+                  A->entries + A->row_starts[i],
+                  A->row_starts[i + 1] - A->row_starts[i],
+                  piv, w, mark, heap, B == NULL, mod);
+
+        if (len == 0)
+            continue;
+
+        j = out[0].col;
+
+        if (det != NULL)
+        {
+            d = nmod_mul(d, out[0].val, mod);
+            cols[i] = j;
+        }
+
+        inv = nmod_inv(out[0].val, mod);
+
+        piv[j].entries = (nmod_sparse_mat_entry_struct *)
+                       flint_malloc(len*sizeof(nmod_sparse_mat_entry_struct));
+        piv[j].len = len;
+        piv[j].entries[0].col = j;
+        piv[j].entries[0].val = UWORD(1);
+
+        for (t = 1; t < len; t++)
+        {
+            piv[j].entries[t].col = out[t].col;
+            piv[j].entries[t].val = nmod_mul(out[t].val, inv, mod);
+        }
+
+        rank++;
+    }
+
+    /*
+        The rows of A were only combined with each other, so that if A is
+        square and nonsingular it is the product of the permutation taking
+        row i to column cols[i], of the leading entries and of a unit upper
+        triangular matrix.
+    */
+    if (det != NULL)
+    {
+        if (rank < m || m != n)
+            *det = 0;
+        else
+            *det = (_perm_sign(cols, n) == 1) ? d : nmod_neg(d, mod);
+    }
+
+    if (B != NULL)
+    {
+        /* clear the entries above the pivots, the last pivot rows first */
+        nnz = 0;
+
+        for (j = n - 1; j >= 0; j--)
+        {
+            if (piv[j].len == 0)
+                continue;
+
+            len = _nmod_sparse_mat_reduce_row(out, piv[j].entries + 1,
+                          piv[j].len - 1, piv, w, mark, heap, 0, mod);
+
+            if (len + 1 > piv[j].len)
+                piv[j].entries = (nmod_sparse_mat_entry_struct *)
+                    flint_realloc(piv[j].entries,
+                           (len + 1)*sizeof(nmod_sparse_mat_entry_struct));
+
+            for (k = 0; k < len; k++)
+                piv[j].entries[k + 1] = out[k];
+
+            piv[j].len = len + 1;
+            nnz += len + 1;
+        }
+
+        if (B->r != m)
+        {
+            B->row_starts = (slong *) flint_realloc(B->row_starts,
+                                                        (m + 1)*sizeof(slong));
+            B->r = m;
+        }
+
+        B->c = n;
+        B->mod = mod;
+
+        nmod_sparse_mat_fit_nnz(B, nnz);
+
+        B->row_starts[0] = 0;
+
+        for (i = 0, j = 0, nnz = 0; i < m; i++)
+        {
+            while (j < n && piv[j].len == 0)
+                j++;
+
+            if (j < n)
+            {
+                for (k = 0; k < piv[j].len; k++)
+                    B->entries[nnz++] = piv[j].entries[k];
+                j++;
+            }
+
+            B->row_starts[i + 1] = nnz;
+        }
+
+        _nmod_sparse_mat_set_max_row_len(B);
+    }
+
+    for (j = 0; j < n; j++)
+        if (piv[j].len != 0)
+            flint_free(piv[j].entries);
+
+    flint_free(piv);
+    flint_free(out);
+    flint_free(order);
+    flint_free(heap);
+    flint_free(w);
+    flint_free(mark);
+
+    if (det != NULL)
+        flint_free(cols);
+
+    return rank;
+}
+
+slong
+nmod_sparse_mat_rref(nmod_sparse_mat_t B, const nmod_sparse_mat_t A)
+{
+    return _nmod_sparse_mat_echelon(B, NULL, A);
+}
@@ -0,0 +1,22 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_scale_cols(nmod_sparse_mat_t B, const nmod_sparse_mat_t A,
+                                                                  mp_srcptr d)
+{
+    slong k, nnz = nmod_sparse_mat_nnz(A);
+
+    nmod_sparse_mat_set(B, A);
+
+    for (k = 0; k < nnz; k++)
+        B->entries[k].val = nmod_mul(B->entries[k].val,
+                                              d[B->entries[k].col], B->mod);
+}
@@ -0,0 +1,22 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_scale_rows(nmod_sparse_mat_t B, const nmod_sparse_mat_t A,
+                                                                  mp_srcptr d)
+{
+    slong i, k;
+
+    nmod_sparse_mat_set(B, A);
+
+    for (i = 0; i < B->r; i++)
+        for (k = B->row_starts[i]; k < B->row_starts[i + 1]; k++)
+            B->entries[k].val = nmod_mul(B->entries[k].val, d[i], B->mod);
+}
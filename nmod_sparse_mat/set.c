@@ -0,0 +1,39 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_set(nmod_sparse_mat_t M, const nmod_sparse_mat_t A)
+{
+    slong i, nnz = nmod_sparse_mat_nnz(A);
+
+    if (M == A)
+        return;
+
+    if (M->r != A->r)
+    {
+        M->row_starts = (slong *) flint_realloc(M->row_starts,
+                                                     (A->r + 1)*sizeof(slong));
+        M->r = A->r;
+    }
+
+    M->c = A->c;
+    M->mod = A->mod;
+
+    nmod_sparse_mat_fit_nnz(M, nnz);
+
+    for (i = 0; i <= A->r; i++)
+        M->row_starts[i] = A->row_starts[i];
+
+    for (i = 0; i < nnz; i++)
+        M->entries[i] = A->entries[i];
+
+    M->max_row_len = A->max_row_len;
+}
@@ -0,0 +1,82 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+static int
+_entry_cmp(const void * a, const void * b)
+{
+    slong x = ((const nmod_sparse_mat_entry_struct *) a)->col;
+    slong y = ((const nmod_sparse_mat_entry_struct *) b)->col;
+
+    return (x > y) - (x < y);
+}
+
+void
+nmod_sparse_mat_set_entries(nmod_sparse_mat_t M, const slong * rows,
+                        const slong * cols, mp_srcptr vals, slong len)
+{
+    nmod_sparse_mat_entry_struct * e;
+    slong i, j, k, start, * pos;
+
+    /* bucket the entries by row */
+    pos = (slong *) flint_calloc(M->r + 1, sizeof(slong));
+
+    for (i = 0; i < len; i++)
+        pos[rows[i] + 1]++;
+    for (i = 0; i < M->r; i++)
+        pos[i + 1] += pos[i];
+
+    e = (nmod_sparse_mat_entry_struct *)
+                      flint_malloc(len*sizeof(nmod_sparse_mat_entry_struct));
+
+    for (i = 0; i < len; i++)
+    {
+        k = pos[rows[i]]++;
+        e[k].col = cols[i];
+        NMOD_RED(e[k].val, vals[i], M->mod);
+    }
+
+    /* sort each row by column, adding up repeated entries */
+    nmod_sparse_mat_fit_nnz(M, len);
+
+    k = 0;
+    start = 0;
+    M->row_starts[0] = 0;
+
+    for (i = 0; i < M->r; i++)
+    {
+        slong end = pos[i];
+
+        qsort(e + start, end - start, sizeof(nmod_sparse_mat_entry_struct),
+                                                                  _entry_cmp);
+
+        for (j = start; j < end; j++)
+        {
+            if (k > M->row_starts[i] && M->entries[k - 1].col == e[j].col)
+            {
+                M->entries[k - 1].val = nmod_add(M->entries[k - 1].val,
+                                                            e[j].val, M->mod);
+                if (M->entries[k - 1].val == 0)
+                    k--;
+            }
+            else if (e[j].val != 0)
+            {
+                M->entries[k++] = e[j];
+            }
+        }
+
+        M->row_starts[i + 1] = k;
+        start = end;
+    }
+
+    _nmod_sparse_mat_set_max_row_len(M);
+
+    flint_free(e);
+    flint_free(pos);
+}
@@ -0,0 +1,73 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+#define NMOD_SPARSE_MAT_SOLVE_TRIES 3
+
+int
+nmod_sparse_mat_solve_wiedemann(mp_ptr x, const nmod_sparse_mat_t A,
+                         mp_srcptr b, slong block_size, flint_rand_t state)
+{
+    nmod_mat_t U, V;
+    nmod_poly_t f;
+    mp_ptr t;
+    mp_limb_t c;
+    slong i, j, n = A->r;
+    int success = 0;
+
+    if (A->r != A->c)
+    {
+        flint_printf("Exception (nmod_sparse_mat_solve_wiedemann). "
+                     "Non-square matrix.\n");
+        flint_abort();
+    }
+
+    block_size = FLINT_MAX(block_size, 1);
+
+    nmod_mat_init(U, block_size, n, A->mod.n);
+    nmod_mat_init(V, n, 1, A->mod.n);
+    nmod_poly_init_mod(f, A->mod);
+    t = _nmod_vec_init(n);
+
+    for (i = 0; i < n; i++)
+        nmod_mat_entry(V, i, 0) = b[i];
+
+    for (j = 0; j < NMOD_SPARSE_MAT_SOLVE_TRIES && !success; j++)
+    {
+        /* f is the minimal polynomial of A with respect to b w.h.p. */
+        nmod_mat_rand(U, state);
+        _nmod_sparse_mat_minpoly_proj(f, A, NULL, U, V);
+
+        /* a root at zero means A is singular */
+        if (nmod_poly_get_coeff_ui(f, 0) == 0)
+            break;
+
+        /* x = -(f_1 b + f_2 A b + ... + f_d A^(d-1) b)/f_0 */
+        _nmod_vec_zero(x, n);
+        for (i = nmod_poly_degree(f); i >= 1; i--)
+        {
+            nmod_sparse_mat_mul_vec(t, A, x);
+            _nmod_vec_scalar_addmul_nmod(t, b, n, f->coeffs[i], A->mod);
+            _nmod_vec_set(x, t, n);
+        }
+
+        c = nmod_neg(nmod_inv(f->coeffs[0], A->mod), A->mod);
+        _nmod_vec_scalar_mul_nmod(x, x, n, c, A->mod);
+
+        nmod_sparse_mat_mul_vec(t, A, x);
+        success = _nmod_vec_equal(t, b, n);
+    }
+
+    _nmod_vec_clear(t);
+    nmod_poly_clear(f);
+    nmod_mat_clear(U);
+    nmod_mat_clear(V);
+
+    return success;
+}
@@ -0,0 +1,81 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_poly.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+#include "thread_support.h"
+
+int
+main(void)
+{
+    slong i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("minpoly_wiedemann....");
+    fflush(stdout);
+
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        nmod_sparse_mat_t M;
+        nmod_mat_t A;
+        nmod_poly_t f, g;
+        slong n;
+        mp_limb_t p;
+        int small;
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        /* small fields, including GF(2), where the projections may lose
+           factors, and large ones, where this has tiny probability */
+        small = n_randint(state, 2);
+        if (small)
+            p = n_nth_prime(n_randint(state, 10) + 1);
+        else
+            p = n_randprime(state, FLINT_BITS - n_randint(state, 4), 1);
+        n = n_randint(state, 40);
+
+        nmod_sparse_mat_init(M, n, n, p);
+        nmod_mat_init(A, n, n, p);
+        nmod_poly_init(f, p);
+        nmod_poly_init(g, p);
+
+        nmod_sparse_mat_randtest(M, state, n_randint(state, 6));
+        nmod_sparse_mat_get_nmod_mat(A, M);
+
+        nmod_sparse_mat_minpoly_wiedemann(f, M, n_randint(state, 4) + 1, state);
+        nmod_mat_minpoly(g, A);
+
+        if (small)
+            nmod_poly_rem(f, g, f);
+
+        if (small ? !nmod_poly_is_zero(f) : !nmod_poly_equal(f, g))
+        {
+            flint_printf("FAIL:\n");
+            nmod_mat_print_pretty(A);
+            nmod_poly_print(f); flint_printf("\n");
+            nmod_poly_print(g); flint_printf("\n");
+            abort();
+        }
+
+        nmod_poly_clear(f);
+        nmod_poly_clear(g);
+        nmod_mat_clear(A);
+        nmod_sparse_mat_clear(M);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+#include "thread_support.h"
+
+int
+main(void)
+{
+    slong i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_mat....");
+    fflush(stdout);
+
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        nmod_sparse_mat_t M;
+        nmod_mat_t A, X, Y, Z;
+        slong r, c, b;
+        mp_limb_t n;
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        n = n_randtest_not_zero(state);
+        r = n_randint(state, 200);
+        c = n_randint(state, 200);
+        b = n_randint(state, 10);
+
+        nmod_sparse_mat_init(M, r, c, n);
+        nmod_mat_init(A, r, c, n);
+        nmod_mat_init(X, c, b, n);
+        nmod_mat_init(Y, r, b, n);
+        nmod_mat_init(Z, r, b, n);
+
+        nmod_sparse_mat_randtest(M, state, n_randint(state, 100));
+        nmod_sparse_mat_get_nmod_mat(A, M);
+        nmod_mat_randtest(X, state);
+
+        nmod_sparse_mat_mul_mat(Y, M, X);
+        nmod_mat_mul(Z, A, X);
+
+        if (!nmod_mat_equal(Y, Z))
+        {
+            flint_printf("FAIL: dense\n");
+            abort();
+        }
+
+        /* aliasing */
+        if (r == c)
+        {
+            nmod_sparse_mat_mul_mat(X, M, X);
+
+            if (!nmod_mat_equal(X, Z))
+            {
+                flint_printf("FAIL: aliasing\n");
+                abort();
+            }
+        }
+
+        nmod_mat_clear(A);
+        nmod_mat_clear(X);
+        nmod_mat_clear(Y);
+        nmod_mat_clear(Z);
+        nmod_sparse_mat_clear(M);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+#include "thread_support.h"
+
+int
+main(void)
+{
+    slong i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_vec....");
+    fflush(stdout);
+
+    /* check against dense multiplication */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        nmod_sparse_mat_t M;
+        nmod_mat_t A;
+        mp_ptr x, y, z;
+        slong r, c;
+        mp_limb_t n;
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        n = n_randtest_not_zero(state);
+        r = n_randint(state, 40);
+        c = n_randint(state, 40);
+
+        nmod_sparse_mat_init(M, r, c, n);
+        nmod_mat_init(A, r, c, n);
+        x = _nmod_vec_init(c);
+        y = _nmod_vec_init(r);
+        z = _nmod_vec_init(r);
+
+        nmod_sparse_mat_randtest(M, state, n_randint(state, 20));
+        nmod_sparse_mat_get_nmod_mat(A, M);
+        _nmod_vec_randtest(x, state, c, A->mod);
+
+        nmod_sparse_mat_mul_vec(y, M, x);
+        nmod_mat_mul_nmod_vec(z, A, x, c);
+
+        if (!_nmod_vec_equal(y, z, r))
+        {
+            flint_printf("FAIL: dense\n");
+            abort();
+        }
+
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+        _nmod_vec_clear(z);
+        nmod_mat_clear(A);
+        nmod_sparse_mat_clear(M);
+    }
+
+    /* check the threaded product against the serial one */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        nmod_sparse_mat_t M;
+        mp_ptr x, y, z;
+        slong r, c;
+        mp_limb_t n;
+
+        n = n_randtest_not_zero(state);
+        r = n_randint(state, 4000);
+        c = n_randint(state, 4000) + 1;
+
+        nmod_sparse_mat_init(M, r, c, n);
+        x = _nmod_vec_init(c);
+        y = _nmod_vec_init(r);
+        z = _nmod_vec_init(r);
+
+        nmod_sparse_mat_randtest(M, state, n_randint(state, 60));
+        _nmod_vec_randtest(x, state, c, M->mod);
+
+        flint_set_num_threads(1);
+        nmod_sparse_mat_mul_vec(y, M, x);
+
+        flint_set_num_threads(n_randint(state, 5) + 2);
+        nmod_sparse_mat_mul_vec(z, M, x);
+
+        if (!_nmod_vec_equal(y, z, r))
+        {
+            flint_printf("FAIL: threaded\n");
+            abort();
+        }
+
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+        _nmod_vec_clear(z);
+        nmod_sparse_mat_clear(M);
+    }
+
+    /* check aliasing */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        nmod_sparse_mat_t M;
+        mp_ptr x, y;
+        slong r;
+        mp_limb_t n;
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        n = n_randtest_not_zero(state);
+        r = n_randint(state, 40);
+
+        nmod_sparse_mat_init(M, r, r, n);
+        x = _nmod_vec_init(r);
+        y = _nmod_vec_init(r);
+
+        nmod_sparse_mat_randtest(M, state, n_randint(state, 20));
+        _nmod_vec_randtest(x, state, r, M->mod);
+
+        nmod_sparse_mat_mul_vec(y, M, x);
+        nmod_sparse_mat_mul_vec(x, M, x);
+
+        if (!_nmod_vec_equal(x, y, r))
+        {
+            flint_printf("FAIL: aliasing\n");
+            abort();
+        }
+
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+        nmod_sparse_mat_clear(M);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
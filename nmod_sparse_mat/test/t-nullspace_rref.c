@@ -0,0 +1,81 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("nullspace_rref....");
+    fflush(stdout);
+
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        nmod_sparse_mat_t M;
+        nmod_mat_t A, X, Z;
+        slong r, c, nullity;
+        mp_limb_t p;
+
+        /* small fields, including GF(2), and large ones */
+        if (n_randint(state, 2))
+            p = n_nth_prime(n_randint(state, 10) + 1);
+        else
+            p = n_randprime(state, FLINT_BITS - n_randint(state, 4), 1);
+        r = n_randint(state, 40);
+        c = n_randint(state, 40);
+
+        nmod_sparse_mat_init(M, r, c, p);
+        nmod_mat_init(A, r, c, p);
+        nmod_mat_init(X, 0, 0, p);
+
+        nmod_sparse_mat_randtest(M, state, n_randint(state, 6));
+        nmod_sparse_mat_get_nmod_mat(A, M);
+
+        nullity = nmod_sparse_mat_nullspace_rref(X, M);
+
+        if (nullity != c - nmod_mat_rank(A) || X->r != c || X->c != nullity
+            || nmod_mat_rank(X) != nullity)
+        {
+            flint_printf("FAIL: nullity\n");
+            nmod_mat_print_pretty(A);
+            flint_printf("nullity = %wd, expected %wd\n",
+                                                 nullity, c - nmod_mat_rank(A));
+            abort();
+        }
+
+        nmod_mat_init(Z, r, nullity, p);
+        nmod_mat_mul(Z, A, X);
+
+        if (!nmod_mat_is_zero(Z))
+        {
+            flint_printf("FAIL: not in the nullspace\n");
+            nmod_mat_print_pretty(A);
+            nmod_mat_print_pretty(X);
+            abort();
+        }
+
+        nmod_mat_clear(Z);
+        nmod_mat_clear(X);
+        nmod_mat_clear(A);
+        nmod_sparse_mat_clear(M);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
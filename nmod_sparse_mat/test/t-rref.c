@@ -0,0 +1,101 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("rref....");
+    fflush(stdout);
+
+    for (i = 0; i < 500 * flint_test_multiplier(); i++)
+    {
+        nmod_sparse_mat_t M, R;
+        nmod_mat_t A, B;
+        slong r, c, rank1, rank2;
+        mp_limb_t p, d1, d2;
+
+        if (n_randint(state, 2))
+            p = n_nth_prime(n_randint(state, 10) + 1);
+        else
+            p = n_randprime(state, FLINT_BITS - n_randint(state, 4), 1);
+        r = n_randint(state, 40);
+        c = n_randint(state, 40);
+
+        nmod_sparse_mat_init(M, r, c, p);
+        nmod_sparse_mat_init(R, 0, 0, p);
+        nmod_mat_init(A, r, c, p);
+        nmod_mat_init(B, r, c, p);
+
+        nmod_sparse_mat_randtest(M, state, n_randint(state, 6));
+        nmod_sparse_mat_get_nmod_mat(A, M);
+
+        /* the reduced row echelon form is unique */
+        if (n_randint(state, 2))
+        {
+            rank1 = nmod_sparse_mat_rref(R, M);
+        }
+        else
+        {
+            nmod_sparse_mat_set(R, M);
+            rank1 = nmod_sparse_mat_rref(R, R);
+        }
+
+        nmod_sparse_mat_get_nmod_mat(B, R);
+        rank2 = nmod_mat_rref(A);
+
+        if (rank1 != rank2 || !nmod_mat_equal(A, B))
+        {
+            flint_printf("FAIL: rref\n");
+            nmod_mat_print_pretty(A);
+            nmod_mat_print_pretty(B);
+            flint_printf("rank = %wd, expected %wd\n", rank1, rank2);
+            abort();
+        }
+
+        /* determinant from the echelon form */
+        nmod_sparse_mat_clear(M);
+        nmod_mat_clear(A);
+        nmod_sparse_mat_init(M, r, r, p);
+        nmod_mat_init(A, r, r, p);
+
+        nmod_sparse_mat_randtest(M, state, n_randint(state, 8));
+        nmod_sparse_mat_get_nmod_mat(A, M);
+
+        rank1 = _nmod_sparse_mat_echelon(NULL, &d1, M);
+        d2 = nmod_mat_det(A);
+
+        if (d1 != d2 || rank1 != nmod_mat_rank(A))
+        {
+            flint_printf("FAIL: det\n");
+            nmod_mat_print_pretty(A);
+            flint_printf("det = %wu, expected %wu\n", d1, d2);
+            abort();
+        }
+
+        nmod_mat_clear(A);
+        nmod_mat_clear(B);
+        nmod_sparse_mat_clear(M);
+        nmod_sparse_mat_clear(R);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("set_entries....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        nmod_sparse_mat_t M, N;
+        nmod_mat_t A, B;
+        slong r, c, len, j, * rows, * cols;
+        mp_ptr vals;
+        mp_limb_t n;
+
+        n = n_randtest_not_zero(state);
+        r = n_randint(state, 20);
+        c = n_randint(state, 20);
+        len = (r == 0 || c == 0) ? 0 : n_randint(state, 3*r*c + 1);
+
+        nmod_sparse_mat_init(M, r, c, n);
+        nmod_sparse_mat_init(N, 0, 0, n);
+        nmod_mat_init(A, r, c, n);
+        nmod_mat_init(B, r, c, n);
+
+        rows = flint_malloc(2*len*sizeof(slong));
+        cols = rows + len;
+        vals = _nmod_vec_init(len);
+
+        /* repeated entries are added up */
+        for (j = 0; j < len; j++)
+        {
+            rows[j] = n_randint(state, r);
+            cols[j] = n_randint(state, c);
+            vals[j] = n_randtest(state);
+            nmod_mat_entry(A, rows[j], cols[j]) = nmod_add(
+                nmod_mat_entry(A, rows[j], cols[j]),
+                n_mod2_preinv(vals[j], A->mod.n, A->mod.ninv), A->mod);
+        }
+
+        nmod_sparse_mat_set_entries(M, rows, cols, vals, len);
+        nmod_sparse_mat_get_nmod_mat(B, M);
+
+        if (!nmod_mat_equal(A, B))
+        {
+            flint_printf("FAIL: entries\n");
+            nmod_mat_print_pretty(A);
+            nmod_mat_print_pretty(B);
+            abort();
+        }
+
+        for (j = 0; j < nmod_sparse_mat_nnz(M); j++)
+        {
+            if (M->entries[j].val == 0)
+            {
+                flint_printf("FAIL: zero entry stored\n");
+                abort();
+            }
+        }
+
+        nmod_sparse_mat_set_nmod_mat(N, A);
+
+        if (!nmod_sparse_mat_equal(M, N))
+        {
+            flint_printf("FAIL: set_nmod_mat\n");
+            abort();
+        }
+
+        flint_free(rows);
+        _nmod_vec_clear(vals);
+        nmod_mat_clear(A);
+        nmod_mat_clear(B);
+        nmod_sparse_mat_clear(M);
+        nmod_sparse_mat_clear(N);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_poly.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+#include "thread_support.h"
+
+int
+main(void)
+{
+    slong i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("solve_wiedemann....");
+    fflush(stdout);
+
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        nmod_sparse_mat_t M;
+        nmod_mat_t A;
+        mp_ptr x, y, b;
+        slong n;
+        mp_limb_t p;
+        int success, small;
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        /* small fields, including GF(2), where solving may fail, and
+           large ones, where it succeeds with high probability */
+        small = n_randint(state, 2);
+        if (small)
+            p = n_nth_prime(n_randint(state, 10) + 1);
+        else
+            p = n_randprime(state, FLINT_BITS - n_randint(state, 4), 1);
+        n = n_randint(state, 50);
+
+        nmod_sparse_mat_init(M, n, n, p);
+        nmod_mat_init(A, n, n, p);
+        x = _nmod_vec_init(n);
+        y = _nmod_vec_init(n);
+        b = _nmod_vec_init(n);
+
+        nmod_sparse_mat_randtest(M, state, n_randint(state, 8));
+        nmod_sparse_mat_get_nmod_mat(A, M);
+
+        _nmod_vec_randtest(x, state, n, A->mod);
+        nmod_sparse_mat_mul_vec(b, M, x);
+
+        success = nmod_sparse_mat_solve_wiedemann(y, M, b,
+                                                 n_randint(state, 4) + 1, state);
+
+        if (nmod_mat_det(A) != 0)
+        {
+            if ((!success && !small) || (success && !_nmod_vec_equal(x, y, n)))
+            {
+                flint_printf("FAIL: nonsingular\n");
+                nmod_mat_print_pretty(A);
+                abort();
+            }
+        }
+        else if (success)
+        {
+            nmod_sparse_mat_mul_vec(x, M, y);
+
+            if (!_nmod_vec_equal(x, b, n))
+            {
+                flint_printf("FAIL: singular\n");
+                nmod_mat_print_pretty(A);
+                abort();
+            }
+        }
+
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+        _nmod_vec_clear(b);
+        nmod_mat_clear(A);
+        nmod_sparse_mat_clear(M);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("transpose....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        nmod_sparse_mat_t M, N;
+        nmod_mat_t A, B, C;
+        slong r, c;
+        mp_limb_t n;
+
+        n = n_randtest_not_zero(state);
+        r = n_randint(state, 30);
+        c = n_randint(state, 30);
+
+        nmod_sparse_mat_init(M, r, c, n);
+        nmod_sparse_mat_init(N, 0, 0, n);
+        nmod_mat_init(A, c, r, n);
+        nmod_mat_init(B, r, c, n);
+        nmod_mat_init(C, c, r, n);
+
+        nmod_sparse_mat_randtest(M, state, n_randint(state, 10));
+
+        nmod_sparse_mat_transpose(N, M);
+        nmod_sparse_mat_get_nmod_mat(A, N);
+        nmod_sparse_mat_get_nmod_mat(B, M);
+        nmod_mat_transpose(C, B);
+
+        if (!nmod_mat_equal(A, C))
+        {
+            flint_printf("FAIL: transpose\n");
+            nmod_mat_print_pretty(A);
+            nmod_mat_print_pretty(C);
+            abort();
+        }
+
+        /* aliasing, and transposing twice */
+        nmod_sparse_mat_transpose(N, N);
+
+        if (!nmod_sparse_mat_equal(M, N))
+        {
+            flint_printf("FAIL: aliasing\n");
+            abort();
+        }
+
+        nmod_mat_clear(A);
+        nmod_mat_clear(B);
+        nmod_mat_clear(C);
+        nmod_sparse_mat_clear(M);
+        nmod_sparse_mat_clear(N);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,62 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_transpose(nmod_sparse_mat_t B, const nmod_sparse_mat_t A)
+{
+    nmod_sparse_mat_t T;
+    slong i, k, nnz = nmod_sparse_mat_nnz(A);
+
+    if (B == A)
+    {
+        nmod_sparse_mat_init(T, A->c, A->r, A->mod.n);
+        nmod_sparse_mat_transpose(T, A);
+        nmod_sparse_mat_swap(B, T);
+        nmod_sparse_mat_clear(T);
+        return;
+    }
+
+    if (B->r != A->c)
+    {
+        B->row_starts = (slong *) flint_realloc(B->row_starts,
+                                                     (A->c + 1)*sizeof(slong));
+        B->r = A->c;
+    }
+
+    B->c = A->r;
+    B->mod = A->mod;
+
+    nmod_sparse_mat_fit_nnz(B, nnz);
+
+    /* count the entries of each column of A */
+    for (i = 0; i <= B->r; i++)
+        B->row_starts[i] = 0;
+    for (k = 0; k < nnz; k++)
+        B->row_starts[A->entries[k].col + 1]++;
+    for (i = 0; i < B->r; i++)
+        B->row_starts[i + 1] += B->row_starts[i];
+
+    /* rows of A are visited in order, so the rows of B come out sorted */
+    for (i = 0; i < A->r; i++)
+    {
+        for (k = A->row_starts[i]; k < A->row_starts[i + 1]; k++)
+        {
+            slong j = B->row_starts[A->entries[k].col]++;
+            B->entries[j].col = i;
+            B->entries[j].val = A->entries[k].val;
+        }
+    }
+
+    for (i = B->r; i > 0; i--)
+        B->row_starts[i] = B->row_starts[i - 1];
+    B->row_starts[0] = 0;
+
+    _nmod_sparse_mat_set_max_row_len(B);
+}
@@ -0,0 +1,56 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+#include "nmod_sparse_mat.h"
+
+void
+_nmod_sparse_mat_wiedemann_scale(nmod_mat_t W, mp_srcptr D,
+                                                     const fq_nmod_ctx_t ctx)
+{
+    slong i, j, d = fq_nmod_ctx_degree(ctx);
+    mp_ptr t;
+
+    if (d == 1)
+    {
+        for (i = 0; i < W->r; i++)
+            _nmod_vec_scalar_mul_nmod(W->rows[i], W->rows[i], W->c, D[i],
+                                                                    ctx->mod);
+        return;
+    }
+
+    t = _nmod_vec_init(N_FQ_MUL_ITCH*d);
+
+    for (i = 0; i < W->r; i++)
+        for (j = 0; j < W->c; j += d)
+            _n_fq_mul(W->rows[i] + j, W->rows[i] + j, D + d*i, ctx, t);
+
+    _nmod_vec_clear(t);
+}
+
+void
+_nmod_sparse_mat_wiedemann_apply(nmod_mat_t W, nmod_mat_t T,
+                const nmod_sparse_mat_t A, const nmod_sparse_mat_struct * B,
+                      mp_srcptr D1, mp_srcptr D2, const fq_nmod_ctx_t ctx)
+{
+    /* A has entries in F_p, so it acts on each coordinate separately */
+    if (D1 != NULL)
+        _nmod_sparse_mat_wiedemann_scale(W, D1, ctx);
+
+    if (B == NULL)
+    {
+        nmod_sparse_mat_mul_mat(W, A, W);
+        return;
+    }
+
+    nmod_sparse_mat_mul_mat(T, A, W);
+
+    if (D2 != NULL)
+        _nmod_sparse_mat_wiedemann_scale(T, D2, ctx);
+
+    nmod_sparse_mat_mul_mat(W, B, T);
+}
@@ -84,6 +84,14 @@ typedef struct qs_poly_s
    slong * small;     /* exponents of small prime factors in relations */
    fac_t * factor;    /* factors for a relation */
    slong num_factors; /* number of factors found in a relation */
+
+   /* relations found by this thread, merged by the main thread per batch */
+   slong * rel_data;  /* packed: lp, small exponents, num_factors, factors */
+   slong rel_len;     /* number of words of rel_data in use */
+   slong rel_alloc;   /* number of words allocated for rel_data */
+   fmpz * rel_Y;      /* Y value of each buffered relation */
+   slong num_rels;    /* number of buffered relations */
+   slong Y_alloc;     /* number of entries allocated for rel_Y */
 } qs_poly_s;
 
 typedef qs_poly_s qs_poly_t[1];
@@ -178,6 +186,7 @@ typedef struct qs_s
 
    FILE * siqs;           /* pointer to file for storing relations */
    char * fname;          /* name of file used for relations */
+   slong num_A;           /* number of A coeffs sieved with this factor base */
 
    slong full_relation;   /* number of full relations */
    slong num_cycles;      /* number of possible full relations from partials */
@@ -314,6 +323,9 @@ FLINT_DLL void qsieve_clear(qs_t qs_inf);
 
 FLINT_DLL void qsieve_factor(fmpz_factor_t factors, const fmpz_t n);
 
+FLINT_DLL void qsieve_factor_with_store(fmpz_factor_t factors,
+                     const fmpz_t n, const char * store, int resume);
+
 FLINT_DLL prime_t * compute_factor_base(mp_limb_t * small_factor, qs_t qs_inf,
                                                              slong num_primes);
 
@@ -359,14 +371,28 @@ FLINT_DLL int qsieve_relations_cmp(const void * a, const void * b);
 
 FLINT_DLL slong qsieve_merge_relations(qs_t qs_inf);
 
+FLINT_DLL void qsieve_store_init(qs_t qs_inf);
+
+FLINT_DLL void qsieve_store_write_header(qs_t qs_inf);
+
+FLINT_DLL int qsieve_store_read_header(qs_t qs_inf,
+                                           slong * num_primes, slong * num_A);
+
+FLINT_DLL slong qsieve_store_load(qs_t qs_inf);
+
 FLINT_DLL void qsieve_write_to_file(qs_t qs_inf, mp_limb_t prime,
                                                      fmpz_t Y, qs_poly_t poly);
 
+FLINT_DLL void qsieve_buffer_relation(qs_t qs_inf, qs_poly_t poly,
+                                               mp_limb_t prime, fmpz_t Y);
+
+FLINT_DLL void qsieve_flush_relations(qs_t qs_inf, qs_poly_t poly);
+
 FLINT_DLL hash_t * qsieve_get_table_entry(qs_t qs_inf, mp_limb_t prime);
 
 FLINT_DLL void qsieve_add_to_hashtable(qs_t qs_inf, mp_limb_t prime);
 
-FLINT_DLL relation_t qsieve_parse_relation(qs_t qs_inf, char * str);
+FLINT_DLL int qsieve_read_relation(qs_t qs_inf, relation_t * rel);
 
 FLINT_DLL relation_t qsieve_merge_relation(qs_t qs_inf, relation_t  a, relation_t  b);
 
@@ -424,7 +450,8 @@ FLINT_DLL uint64_t get_null_entry(uint64_t * nullrows, slong i, slong l);
 FLINT_DLL void reduce_matrix(qs_t qs_inf, slong *nrows, slong *ncols, la_col_t *cols);
 
 FLINT_DLL uint64_t * block_lanczos(flint_rand_t state, slong nrows,
-			slong dense_rows, slong ncols, la_col_t *B);
+			slong dense_rows, slong ncols, la_col_t *B,
+			const thread_pool_handle * handles, slong num_handles);
 
 FLINT_DLL void qsieve_square_root(fmpz_t X, fmpz_t Y, qs_t qs_inf,
    uint64_t * nullrows, slong ncols, slong l, fmpz_t N);
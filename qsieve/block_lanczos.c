@@ -475,83 +475,281 @@ static slong find_nonsingular_sub(uint64_t *t, slong *s,
 }
 
 /*-------------------------------------------------------------------*/
-void mul_MxN_Nx64(slong vsize, slong dense_rows,
-		slong ncols, la_col_t *A,
-		uint64_t *x, uint64_t *b) {
+/* Packed copy of the matrix, used for all the matrix-vector products
+   in the iteration. The row indices of all the columns are stored
+   contiguously as 32-bit words, with the bitmasks of the dense rows
+   (if any) held separately. The columns are split into one block per
+   thread, each with about the same number of nonzero entries */
+
+typedef struct {
+	slong ncols;
+	slong dense_words;    /* 32-bit words of dense rows per column */
+	slong * col_start;    /* offsets of the columns into row_idx */
+	uint32_t * row_idx;   /* row indices of the sparse entries */
+	uint32_t * dense;     /* dense row bitmasks */
+	slong num_blocks;
+	slong * block_start;  /* first column of each block */
+} la_packed_s;
+
+static void la_packed_init(la_packed_s * A, slong dense_rows,
+			slong ncols, la_col_t * B, slong num_blocks) {
+
+	slong i, j, k, total, target;
+
+	A->ncols = ncols;
+	A->dense_words = (dense_rows + 31) / 32;
+	A->num_blocks = num_blocks;
+	A->col_start = (slong *)flint_malloc((ncols + 1) * sizeof(slong));
+	A->block_start = (slong *)flint_malloc((num_blocks + 1) * sizeof(slong));
+
+	total = 0;
+	for (i = 0; i < ncols; i++) {
+		A->col_start[i] = total;
+		total += B[i].weight;
+	}
+	A->col_start[ncols] = total;
 
-	/* Multiply the vector x[] by the matrix A (stored
-	   columnwise) and put the result in b[]. vsize
-	   refers to the number of uint64_t's allocated for
-	   x[] and b[]; vsize is probably different from ncols */
+	A->row_idx = (uint32_t *)flint_malloc(FLINT_MAX(total, 1) * sizeof(uint32_t));
+	A->dense = (uint32_t *)flint_malloc(
+		FLINT_MAX(ncols * A->dense_words, 1) * sizeof(uint32_t));
 
-	slong i, j;
-
-	memset(b, 0, vsize * sizeof(uint64_t));
-	
 	for (i = 0; i < ncols; i++) {
-		la_col_t *col = A + i;
-		slong *row_entries = col->data;
+		la_col_t *col = B + i;
+		uint32_t *row_entries = A->row_idx + A->col_start[i];
+
+		for (j = 0; j < col->weight; j++)
+			row_entries[j] = (uint32_t) col->data[j];
+
+		for (j = 0; j < A->dense_words; j++)
+			A->dense[i * A->dense_words + j] =
+				(uint32_t) col->data[col->weight + j];
+	}
+
+	/* balance the number of entries per block */
+
+	A->block_start[0] = 0;
+	for (i = 0, k = 1; k < num_blocks; k++) {
+		target = (total * k) / num_blocks;
+		while (i < ncols && A->col_start[i] < target)
+			i++;
+		A->block_start[k] = i;
+	}
+	A->block_start[num_blocks] = ncols;
+}
+
+static void la_packed_clear(la_packed_s * A) {
+
+	flint_free(A->col_start);
+	flint_free(A->row_idx);
+	flint_free(A->dense);
+	flint_free(A->block_start);
+}
+
+typedef struct {
+	const la_packed_s * A;
+	slong blk;
+	slong vsize;
+	uint64_t *x;
+	uint64_t *b;
+	uint64_t **bufs;     /* per thread products, for the reduction */
+	slong nbufs;
+	slong r0, r1;        /* range of entries to reduce */
+} la_thread_arg_t;
+
+static void mul_MxN_Nx64_block(void * varg) {
+
+	/* b = the columns of block blk of A times the 
+	   corresponding entries of x */
+
+	la_thread_arg_t *arg = (la_thread_arg_t *) varg;
+	const la_packed_s *A = arg->A;
+	uint64_t *x = arg->x;
+	uint64_t *b = arg->b;
+	slong dw = A->dense_words;
+	slong i, j, k;
+
+	memset(b, 0, arg->vsize * sizeof(uint64_t));
+
+	for (i = A->block_start[arg->blk]; i < A->block_start[arg->blk + 1]; i++) {
+		const uint32_t *row_entries = A->row_idx + A->col_start[i];
+		slong weight = A->col_start[i + 1] - A->col_start[i];
 		uint64_t tmp = x[i];
 
-		for (j = 0; j < col->weight; j++) {
+		for (j = 0; j < weight; j++) {
 			b[row_entries[j]] ^= tmp;
 		}
-	}
 
-	if (dense_rows) {
-		for (i = 0; i < ncols; i++) {
-			la_col_t *col = A + i;
-			slong *row_entries = col->data + col->weight;
-			uint64_t tmp = x[i];
-	
-			for (j = 0; j < dense_rows; j++) {
-				if (row_entries[j / 32] & 
-						((slong)1 << (j % 32))) {
-					b[j] ^= tmp;
-				}
+		for (j = 0; j < dw; j++) {
+			uint32_t w = A->dense[i * dw + j];
+
+			for (k = 0; w != 0; k++, w >>= 1) {
+				if (w & 1)
+					b[32 * j + k] ^= tmp;
 			}
 		}
 	}
 }
 
-/*-------------------------------------------------------------------*/
-void mul_trans_MxN_Nx64(slong dense_rows, slong ncols,
-			la_col_t *A, uint64_t *x, uint64_t *b) {
+static void reduce_Nx64_block(void * varg) {
 
-	/* Multiply the vector x[] by the transpose of the
-	   matrix A and put the result in b[]. Since A is stored
-	   by columns, this is just a matrix-vector product */
+	/* XOR the entries r0, ..., r1 - 1 of all the per thread
+	   products into the first one */
 
-	slong i, j;
+	la_thread_arg_t *arg = (la_thread_arg_t *) varg;
+	uint64_t *b = arg->bufs[0];
+	slong i, k;
 
-	for (i = 0; i < ncols; i++) {
-		la_col_t *col = A + i;
-		slong *row_entries = col->data;
+	for (k = 1; k < arg->nbufs; k++) {
+		uint64_t *c = arg->bufs[k];
+
+		for (i = arg->r0; i < arg->r1; i++)
+			b[i] ^= c[i];
+	}
+}
+
+static void mul_trans_MxN_Nx64_block(void * varg) {
+
+	/* the entries of the transpose product corresponding
+	   to the columns in block blk of A */
+
+	la_thread_arg_t *arg = (la_thread_arg_t *) varg;
+	const la_packed_s *A = arg->A;
+	uint64_t *x = arg->x;
+	uint64_t *b = arg->b;
+	slong dw = A->dense_words;
+	slong i, j, k;
+
+	for (i = A->block_start[arg->blk]; i < A->block_start[arg->blk + 1]; i++) {
+		const uint32_t *row_entries = A->row_idx + A->col_start[i];
+		slong weight = A->col_start[i + 1] - A->col_start[i];
 		uint64_t accum = 0;
 
-		for (j = 0; j < col->weight; j++) {
+		for (j = 0; j < weight; j++) {
 			accum ^= x[row_entries[j]];
 		}
-		b[i] = accum;
-	}
 
-	if (dense_rows) {
-		for (i = 0; i < ncols; i++) {
-			la_col_t *col = A + i;
-			slong *row_entries = col->data + col->weight;
-			uint64_t accum = b[i];
-	
-			for (j = 0; j < dense_rows; j++) {
-				if (row_entries[j / 32] &
-						((slong)1 << (j % 32))) {
-					accum ^= x[j];
-				}
+		for (j = 0; j < dw; j++) {
+			uint32_t w = A->dense[i * dw + j];
+
+			for (k = 0; w != 0; k++, w >>= 1) {
+				if (w & 1)
+					accum ^= x[32 * j + k];
 			}
-			b[i] = accum;
 		}
+
+		b[i] = accum;
 	}
 }
 
+/*-------------------------------------------------------------------*/
+static void mul_MxN_Nx64(slong vsize, la_packed_s *A,
+		uint64_t *x, uint64_t *b, uint64_t **bufs,
+		const thread_pool_handle * handles, slong num_handles) {
+
+	/* Multiply the vector x[] by the matrix A (stored
+	   columnwise) and put the result in b[]. vsize
+	   refers to the number of uint64_t's allocated for
+	   x[] and b[]; vsize is probably different from ncols.
+	   Each thread multiplies by its own block of columns,
+	   into b[] for the calling thread and bufs[i] for the
+	   others, then the results are XORed together */
+
+	la_thread_arg_t args[1];
+	la_thread_arg_t * targs;
+	slong i;
+
+	if (num_handles == 0) {
+		args->A = A;
+		args->blk = 0;
+		args->vsize = vsize;
+		args->x = x;
+		args->b = b;
+		mul_MxN_Nx64_block(args);
+		return;
+	}
+
+	targs = (la_thread_arg_t *)flint_malloc((num_handles + 1) * 
+					sizeof(la_thread_arg_t));
+
+	bufs[0] = b;
+
+	for (i = 0; i <= num_handles; i++) {
+		targs[i].A = A;
+		targs[i].blk = i;
+		targs[i].vsize = vsize;
+		targs[i].x = x;
+		targs[i].b = bufs[i];
+		targs[i].bufs = bufs;
+		targs[i].nbufs = num_handles + 1;
+		targs[i].r0 = (vsize * i) / (num_handles + 1);
+		targs[i].r1 = (vsize * (i + 1)) / (num_handles + 1);
+	}
+
+	for (i = 0; i < num_handles; i++)
+		thread_pool_wake(global_thread_pool, handles[i], 0,
+					mul_MxN_Nx64_block, &targs[i + 1]);
+
+	mul_MxN_Nx64_block(&targs[0]);
+
+	for (i = 0; i < num_handles; i++)
+		thread_pool_wait(global_thread_pool, handles[i]);
+
+	for (i = 0; i < num_handles; i++)
+		thread_pool_wake(global_thread_pool, handles[i], 0,
+					reduce_Nx64_block, &targs[i + 1]);
+
+	reduce_Nx64_block(&targs[0]);
+
+	for (i = 0; i < num_handles; i++)
+		thread_pool_wait(global_thread_pool, handles[i]);
+
+	flint_free(targs);
+}
+
+/*-------------------------------------------------------------------*/
+static void mul_trans_MxN_Nx64(la_packed_s *A, uint64_t *x, uint64_t *b,
+		const thread_pool_handle * handles, slong num_handles) {
+
+	/* Multiply the vector x[] by the transpose of the
+	   matrix A and put the result in b[]. Since A is stored
+	   by columns, this is just a matrix-vector product and
+	   each thread computes the entries for its own block */
+
+	la_thread_arg_t args[1];
+	la_thread_arg_t * targs;
+	slong i;
+
+	if (num_handles == 0) {
+		args->A = A;
+		args->blk = 0;
+		args->x = x;
+		args->b = b;
+		mul_trans_MxN_Nx64_block(args);
+		return;
+	}
+
+	targs = (la_thread_arg_t *)flint_malloc((num_handles + 1) * 
+					sizeof(la_thread_arg_t));
+
+	for (i = 0; i <= num_handles; i++) {
+		targs[i].A = A;
+		targs[i].blk = i;
+		targs[i].x = x;
+		targs[i].b = b;
+	}
+
+	for (i = 0; i < num_handles; i++)
+		thread_pool_wake(global_thread_pool, handles[i], 0,
+					mul_trans_MxN_Nx64_block, &targs[i + 1]);
+
+	mul_trans_MxN_Nx64_block(&targs[0]);
+
+	for (i = 0; i < num_handles; i++)
+		thread_pool_wait(global_thread_pool, handles[i]);
+
+	flint_free(targs);
+}
+
 /*-----------------------------------------------------------------------*/
 static void transpose_vector(slong ncols, uint64_t *v, uint64_t **trans) {
 
@@ -696,11 +894,13 @@ void combine_cols(slong ncols,
 
 /*-----------------------------------------------------------------------*/
 uint64_t * block_lanczos(flint_rand_t state, slong nrows, 
-			slong dense_rows, slong ncols, la_col_t *B) {
+			slong dense_rows, slong ncols, la_col_t *B,
+			const thread_pool_handle * handles, slong num_handles) {
 	
 	/* Solve Bx = 0 for some nonzero x; the computed
 	   solution, containing up to 64 of these nullspace
-	   vectors, is returned */
+	   vectors, is returned. The matrix-vector products
+	   are shared out amongst the given threads */
 
 	uint64_t *vnext, *v[3], *x, *v0;
 	uint64_t *winv[3];
@@ -714,6 +914,12 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	slong dim0, dim1;
 	uint64_t mask0, mask1;
 	slong vsize;
+	la_packed_s A[1];
+	uint64_t **bufs;
+
+	/* small matrices are not worth waking threads for */
+
+	num_handles = FLINT_MIN(num_handles, ncols / 2048);
 
 	/* allocate all of the size-n variables. Note that because
 	   B has been preprocessed to ignore singleton rows, the
@@ -730,6 +936,14 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	v0 = (uint64_t *)flint_malloc(vsize * sizeof(uint64_t));
 	scratch = (uint64_t *)flint_malloc(FLINT_MAX(vsize, 256 * 8) * sizeof(uint64_t));
 
+	/* pack the matrix and allocate the per thread products */
+
+	la_packed_init(A, dense_rows, ncols, B, num_handles + 1);
+
+	bufs = (uint64_t **)flint_malloc((num_handles + 1) * sizeof(uint64_t *));
+	for (i = 1; i <= num_handles; i++)
+		bufs[i] = (uint64_t *)flint_malloc(vsize * sizeof(uint64_t));
+
 	/* allocate all the 64x64 variables */
 
 	winv[0] = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
@@ -777,8 +991,8 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 #endif
 
 	memcpy(x, v[0], vsize * sizeof(uint64_t));
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, v[0], scratch);
-	mul_trans_MxN_Nx64(dense_rows, ncols, B, scratch, v[0]);
+	mul_MxN_Nx64(vsize, A, v[0], scratch, bufs, handles, num_handles);
+	mul_trans_MxN_Nx64(A, scratch, v[0], handles, num_handles);
 	memcpy(v0, v[0], vsize * sizeof(uint64_t));
 
 	/* perform the iteration */
@@ -790,8 +1004,8 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 		   version of B, or B'B (apostrophe means 
 		   transpose). Use "A" to refer to B'B  */
 
-		mul_MxN_Nx64(vsize, dense_rows, ncols, B, v[0], scratch);
-		mul_trans_MxN_Nx64(dense_rows, ncols, B, scratch, vnext);
+		mul_MxN_Nx64(vsize, A, v[0], scratch, bufs, handles, num_handles);
+		mul_trans_MxN_Nx64(A, scratch, vnext, handles, num_handles);
 
 		/* compute v0'*A*v0 and (A*v0)'(A*v0) */
 
@@ -927,20 +1141,24 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 		flint_free(v[0]);
 		flint_free(v[1]);
 		flint_free(v[2]);
+		for (i = 1; i <= num_handles; i++)
+			flint_free(bufs[i]);
+		flint_free(bufs);
+		la_packed_clear(A);
 		return NULL;
 	}
 
 	/* convert the output of the iteration to an actual
 	   collection of nullspace vectors */
 
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, x, v[1]);
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, v[0], v[2]);
+	mul_MxN_Nx64(vsize, A, x, v[1], bufs, handles, num_handles);
+	mul_MxN_Nx64(vsize, A, v[0], v[2], bufs, handles, num_handles);
 
 	combine_cols(ncols, x, v[0], v[1], v[2]);
 
 	/* verify that these really are linear dependencies of B */
 
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, x, v[0]);
+	mul_MxN_Nx64(vsize, A, x, v[0], bufs, handles, num_handles);
 	
 	for (i = 0; i < ncols; i++) {
 		if (v[0][i] != 0)
@@ -954,5 +1172,9 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	flint_free(v[0]);
 	flint_free(v[1]);
 	flint_free(v[2]);
+	for (i = 1; i <= num_handles; i++)
+		flint_free(bufs[i]);
+	flint_free(bufs);
+	la_packed_clear(A);
 	return x;
 }
@@ -369,16 +369,8 @@ slong qsieve_evaluate_candidate(qs_t qs_inf, ulong i, unsigned char * sieve, qs_
 
          poly->num_factors = num_factors;
 
-#if FLINT_USES_PTHREAD
-         pthread_mutex_lock(&qs_inf->mutex);
-#endif
-	 qsieve_write_to_file(qs_inf, 1, Y, poly);
-         
-         qs_inf->full_relation++;
+         qsieve_buffer_relation(qs_inf, poly, 1, Y);
 
-#if FLINT_USES_PTHREAD
-         pthread_mutex_unlock(&qs_inf->mutex);
-#endif
          relations++;
       } else /* not a relation, perhaps a partial? */
       {
@@ -413,20 +405,8 @@ slong qsieve_evaluate_candidate(qs_t qs_inf, ulong i, unsigned char * sieve, qs_
 
                   poly->num_factors = num_factors;
 
-#if FLINT_USES_PTHREAD
-                  pthread_mutex_lock(&qs_inf->mutex);
-#endif
-                  /* store this partial in file */
-
-                  qsieve_write_to_file(qs_inf, prime, Y, poly);
-
-                  qs_inf->edges++;
-
-                  qsieve_add_to_hashtable(qs_inf, prime);
-
-#if FLINT_USES_PTHREAD
-                  pthread_mutex_unlock(&qs_inf->mutex);
-#endif
+                  /* store this partial, it is written to file later */
+                  qsieve_buffer_relation(qs_inf, poly, prime, Y);
 
               }
           }
@@ -577,6 +557,10 @@ slong qsieve_collect_relations(qs_t qs_inf, unsigned char * sieve)
         relations += args[i].rels;
     }
 
+    /* all threads are idle, merge their relations in a fixed order */
+    for (i = 0; i <= num_handles; i++)
+        qsieve_flush_relations(qs_inf, qs_inf->poly + i);
+
     flint_free(args);
 
     return relations;
@@ -37,12 +37,21 @@ int compare_facs(const void * a, const void * b)
    return fmpz_cmp(x, y);
 }
 
+void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
+{
+    qsieve_factor_with_store(factors, n, NULL, 0);
+}
+
 /*
    Finds at least one nontrivial factor of n using the self initialising
    multiple polynomial quadratic sieve with single large prime variation.
-   Assumes n is not prime and not a perfect power.
+   Assumes n is not prime and not a perfect power. Relations are kept in
+   the file with the given name, or a randomly named file in the current
+   directory if store is NULL. If resume is set and the file contains
+   relations from an earlier run on the same n, these are reloaded.
 */
-void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
+void qsieve_factor_with_store(fmpz_factor_t factors, const fmpz_t n,
+                                               const char * store, int resume)
 {
     qs_t qs_inf;
     mp_limb_t small_factor, delta;
@@ -56,6 +65,7 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
     slong num_facs;
     fmpz * facs;
     int nchars;
+    slong skip_A = 0;
 
     if (fmpz_sgn(n) < 0)
     {
@@ -66,7 +76,7 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
        factors->sign *= -1;
        
-       qsieve_factor(factors, n2);
+       qsieve_factor_with_store(factors, n2, store, resume);
 
        fmpz_clear(n2);
        
@@ -207,10 +217,47 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 #else
     srand((int) getpid());
 #endif
-    nchars = sprintf(qs_inf->fname, "%d", (int) rand());
-    strcat(qs_inf->fname + nchars, "siqs.dat");
+    if (store != NULL)
+    {
+        qs_inf->fname = flint_realloc(qs_inf->fname, strlen(store) + 1);
+        strcpy(qs_inf->fname, store);
+    } else
+    {
+        nchars = sprintf(qs_inf->fname, "%d", (int) rand());
+        strcat(qs_inf->fname + nchars, "siqs.dat");
+    }
 
-    qs_inf->siqs = fopen(qs_inf->fname, "w");
+    /* reload relations from an earlier run if they are for this n */
+    if (store != NULL && resume
+                  && (qs_inf->siqs = fopen(qs_inf->fname, "r+b")) != NULL)
+    {
+        if (qsieve_store_read_header(qs_inf, &num_primes, &skip_A))
+        {
+            if (num_primes > qs_inf->num_primes)
+            {
+                /* factor base had been enlarged, do the same */
+                fmpz_clear(qs_inf->target_A);
+
+                small_factor = qsieve_primes_increment(qs_inf,
+                                            num_primes - qs_inf->num_primes);
+
+                if (small_factor)
+                    goto found_small_factor;
+
+                qsieve_linalg_realloc(qs_inf);
+            }
+
+            qsieve_store_load(qs_inf);
+        } else
+        {
+            fclose(qs_inf->siqs);
+            qs_inf->siqs = NULL;
+            skip_A = 0;
+        }
+    }
+
+    if (qs_inf->siqs == NULL)
+        qsieve_store_init(qs_inf);
 
     for (j = qs_inf->small_primes; j < qs_inf->num_primes; j++)
     {
@@ -234,9 +281,23 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
                 goto more_primes; /* initialisation failed, increase FB */
         }
 
+        /* skip A coeffs already sieved before resuming */
+        for ( ; skip_A > 0; skip_A--)
+        {
+            if (!qsieve_next_A(qs_inf))
+                goto more_primes;
+
+            qs_inf->num_A++;
+        }
+
         do
         {           
             relation += qsieve_collect_relations(qs_inf, sieve);
+
+            /* record progress in case we are interrupted */
+            qs_inf->num_A++;
+            qsieve_store_write_header(qs_inf);
+            fflush(qs_inf->siqs);
                 
             qs_inf->num_cycles = qs_inf->edges + qs_inf->components - qs_inf->vertices;
 
@@ -252,8 +313,6 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
             {
                 int ok;
 
-                fclose(qs_inf->siqs);
-
                 ok = qsieve_process_relation(qs_inf);
 
                 if (ok == -1)
@@ -295,7 +354,8 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
                     do /* repeat block lanczos until it succeeds */
                     {
-                        nullrows = block_lanczos(state, nrows, 0, ncols, qs_inf->matrix);
+                        nullrows = block_lanczos(state, nrows, 0, ncols, qs_inf->matrix,
+                                           qs_inf->handles, qs_inf->num_handles);
                     } while (nullrows == NULL);
 
                     for (i = 0, mask = 0; i < ncols; i++) /* create mask of nullspace vectors */
@@ -366,8 +426,9 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
                     _fmpz_vec_clear(facs, 100);
 
-                    qs_inf->siqs = fopen(qs_inf->fname, "w");
                     qs_inf->num_primes = num_primes; /* linear algebra adjusts this */
+                    fclose(qs_inf->siqs);
+                    qsieve_store_init(qs_inf);
                     goto more_primes; /* factoring failed, may need more primes */
                 }
             }
@@ -398,6 +459,7 @@ more_primes: /* ran out of A's in init/sieving of linalg failed, increase FB */
         qs_inf->second_prime = j;
 
         qs_inf->s = 0; /* indicate polynomials need setting up again */
+        qs_inf->num_A = 0;
 
 #if QS_DEBUG
         printf("Now %ld primes\n", qs_inf->num_primes);
@@ -424,6 +486,7 @@ found_small_factor:
         }
 
         qsieve_linalg_realloc(qs_inf);
+        qsieve_store_write_header(qs_inf);
         relation = 0;
     }
 
@@ -445,6 +508,8 @@ cleanup:
     flint_give_back_threads(qs_inf->handles, qs_inf->num_handles);
 
     flint_free(sieve);
+    if (qs_inf->siqs != NULL)
+        fclose(qs_inf->siqs);
     remove(qs_inf->fname);
     qsieve_clear(qs_inf);
     qsieve_linalg_clear(qs_inf);
@@ -88,31 +88,293 @@ int qsieve_is_relation(qs_t qs_inf, relation_t a)
     return 1;
 }
 
+/******************************************************************************
+ * 
+ *  Relation store
+ * 
+ *****************************************************************************/
+
+/*
+   The relation file starts with a header identifying the factorisation:
+   an 8 byte magic string including a format version, then k, num_primes,
+   small_primes, ks_primes, sieve_size and the number of A coefficients
+   sieved so far as 32 bit words, then n in fmpz_out_raw format. Each relation is then stored as 32 bit words
+   giving the large prime (1 for a full relation), the small prime
+   exponents, the number of factors and the index and exponent of each
+   factor, followed by Y in fmpz_out_raw format. Words are stored in
+   native byte order.
+*/
+
+#define QS_STORE_MAGIC "FLINTQS1"
+#define QS_STORE_HEADER_WORDS 6
+
+static void qsieve_store_header(qs_t qs_inf, uint32_t * hdr)
+{
+    hdr[0] = (uint32_t) qs_inf->k;
+    hdr[1] = (uint32_t) qs_inf->num_primes;
+    hdr[2] = (uint32_t) qs_inf->small_primes;
+    hdr[3] = (uint32_t) qs_inf->ks_primes;
+    hdr[4] = (uint32_t) qs_inf->sieve_size;
+    hdr[5] = (uint32_t) qs_inf->num_A;
+}
+
+/*
+   Create (or truncate) the relation file and write its header,
+   leaving it open for writing relations
+*/
+void qsieve_store_init(qs_t qs_inf)
+{
+    qs_inf->siqs = fopen(qs_inf->fname, "w+b");
+
+    if (qs_inf->siqs == NULL)
+    {
+        flint_printf("Exception (qsieve_factor). Unable to open relation "
+                     "file %s.\n", qs_inf->fname);
+        flint_abort();
+    }
+
+    qsieve_store_write_header(qs_inf);
+    fmpz_out_raw(qs_inf->siqs, qs_inf->n);
+}
+
+/*
+   Rewrite the fixed part of the header of the open relation file, e.g.
+   after sieving with another A coefficient or enlarging the factor base,
+   and return to the end of the file
+*/
+void qsieve_store_write_header(qs_t qs_inf)
+{
+    uint32_t hdr[QS_STORE_HEADER_WORDS];
+
+    qsieve_store_header(qs_inf, hdr);
+
+    fseek(qs_inf->siqs, 0, SEEK_SET);
+    fwrite(QS_STORE_MAGIC, 1, 8, qs_inf->siqs);
+    fwrite(hdr, sizeof(uint32_t), QS_STORE_HEADER_WORDS, qs_inf->siqs);
+    fseek(qs_inf->siqs, 0, SEEK_END);
+}
+
+/*
+   Read the header of the relation file, which must be open and positioned
+   at the start. Return 1 if it was written for the current n and
+   parameters, in which case num_primes is set to the size of the factor
+   base the relations were found with and num_A to the number of A
+   coefficients that were sieved with it, otherwise return 0.
+*/
+int qsieve_store_read_header(qs_t qs_inf, slong * num_primes, slong * num_A)
+{
+    char magic[8];
+    uint32_t hdr[QS_STORE_HEADER_WORDS], cur[QS_STORE_HEADER_WORDS];
+    fmpz_t n;
+    int ok;
+
+    if (fread(magic, 1, 8, qs_inf->siqs) != 8
+           || memcmp(magic, QS_STORE_MAGIC, 8) != 0
+           || fread(hdr, sizeof(uint32_t), QS_STORE_HEADER_WORDS,
+                                    qs_inf->siqs) != QS_STORE_HEADER_WORDS)
+        return 0;
+
+    qsieve_store_header(qs_inf, cur);
+
+    /* the factor base may have been enlarged since the file was created */
+    ok = hdr[0] == cur[0] && hdr[1] >= cur[1] && hdr[2] == cur[2]
+                          && hdr[3] == cur[3] && hdr[4] == cur[4];
+
+    fmpz_init(n);
+    ok = ok && fmpz_inp_raw(n, qs_inf->siqs) != 0 && fmpz_equal(n, qs_inf->n);
+    fmpz_clear(n);
+
+    *num_primes = hdr[1];
+    *num_A = hdr[5];
+
+    return ok;
+}
+
+/*
+   Reload the relations in the relation file after a matching header has
+   been read, updating the relation counts and the large prime hash table.
+   If the file ends with an incomplete relation, e.g. because the process
+   was interrupted while writing, the file is cut back to the last
+   complete relation. Return the number of relations read. The file is
+   left open for writing further relations.
+*/
+slong qsieve_store_load(qs_t qs_inf)
+{
+    relation_t rel;
+    slong num_relations = 0;
+    long good = ftell(qs_inf->siqs);
+    char * buf;
+    FILE * tmp;
+    size_t len;
+
+    while (qsieve_read_relation(qs_inf, &rel))
+    {
+        if (rel.lp == UWORD(1))
+            qs_inf->full_relation++;
+        else
+        {
+            qs_inf->edges++;
+            qsieve_add_to_hashtable(qs_inf, rel.lp);
+        }
+
+        flint_free(rel.small);
+        flint_free(rel.factor);
+        fmpz_clear(rel.Y);
+
+        num_relations++;
+        good = ftell(qs_inf->siqs);
+    }
+
+    fseek(qs_inf->siqs, 0, SEEK_END);
+
+    if (ftell(qs_inf->siqs) != good)
+    {
+        /* copy the complete relations to a fresh file */
+        buf = flint_malloc(good);
+        fseek(qs_inf->siqs, 0, SEEK_SET);
+        len = fread(buf, 1, good, qs_inf->siqs);
+        fclose(qs_inf->siqs);
+
+        tmp = fopen(qs_inf->fname, "w+b");
+        if (tmp == NULL || len != (size_t) good
+                        || fwrite(buf, 1, good, tmp) != (size_t) good)
+        {
+            flint_printf("Exception (qsieve_factor). Unable to rewrite "
+                         "relation file %s.\n", qs_inf->fname);
+            flint_abort();
+        }
+
+        flint_free(buf);
+        qs_inf->siqs = tmp;
+    }
+
+    return num_relations;
+}
+
 /*
     Write partial or full relation to file
 */
 void qsieve_write_to_file(qs_t qs_inf, mp_limb_t prime, fmpz_t Y, qs_poly_t poly)
 {
     slong i;
-    char * str = NULL;
+    uint32_t w[2];
     slong num_factors = poly->num_factors;
     slong * small = poly->small;
     fac_t * factor = poly->factor;
 
-    flint_fprintf(qs_inf->siqs, "%X ", prime); /* write large prime */
+    w[0] = (uint32_t) prime; /* write large prime */
+    fwrite(w, sizeof(uint32_t), 1, qs_inf->siqs);
 
     for (i = 0; i < qs_inf->small_primes; i++) /* write small primes */
-        flint_fprintf(qs_inf->siqs, "%X ", small[i]);
+    {
+        w[0] = (uint32_t) small[i];
+        fwrite(w, sizeof(uint32_t), 1, qs_inf->siqs);
+    }
 
-    flint_fprintf(qs_inf->siqs, "%X ", num_factors); /* write number of factors */
+    w[0] = (uint32_t) num_factors; /* write number of factors */
+    fwrite(w, sizeof(uint32_t), 1, qs_inf->siqs);
 
     for (i = 0; i < num_factors; i++) /* write factor along with exponent */
-        flint_fprintf(qs_inf->siqs, "%wx %X ", factor[i].ind, factor[i].exp);
+    {
+        w[0] = (uint32_t) factor[i].ind;
+        w[1] = (uint32_t) factor[i].exp;
+        fwrite(w, sizeof(uint32_t), 2, qs_inf->siqs);
+    }
+
+    fmpz_out_raw(qs_inf->siqs, Y); /* write value of 'Y' */
+}
+
+/*
+    Append a partial or full relation to the relation buffer of the thread
+    owning 'poly'. No locking is required, as each thread has its own buffer.
+*/
+void qsieve_buffer_relation(qs_t qs_inf, qs_poly_t poly,
+                                                mp_limb_t prime, fmpz_t Y)
+{
+    slong i, len;
+    slong num_factors = poly->num_factors;
+    slong * data;
+
+    len = qs_inf->small_primes + 2*num_factors + 2;
+
+    if (poly->rel_len + len > poly->rel_alloc)
+    {
+        poly->rel_alloc = FLINT_MAX(poly->rel_len + len, 2*poly->rel_alloc);
+        poly->rel_data = flint_realloc(poly->rel_data,
+                                             poly->rel_alloc*sizeof(slong));
+    }
+
+    if (poly->num_rels == poly->Y_alloc)
+    {
+        slong new_alloc = FLINT_MAX(16, 2*poly->Y_alloc);
+
+        poly->rel_Y = flint_realloc(poly->rel_Y, new_alloc*sizeof(fmpz));
+        for (i = poly->Y_alloc; i < new_alloc; i++)
+            fmpz_init(poly->rel_Y + i);
+        poly->Y_alloc = new_alloc;
+    }
+
+    data = poly->rel_data + poly->rel_len;
+
+    *data++ = prime;
+
+    for (i = 0; i < qs_inf->small_primes; i++)
+        *data++ = poly->small[i];
+
+    *data++ = num_factors;
+
+    for (i = 0; i < num_factors; i++)
+    {
+        *data++ = poly->factor[i].ind;
+        *data++ = poly->factor[i].exp;
+    }
+
+    fmpz_set(poly->rel_Y + poly->num_rels, Y);
+
+    poly->rel_len += len;
+    poly->num_rels++;
+}
 
-    str = fmpz_get_str(str, 16, Y); /* converting value of 'Y'  to hex */
+/*
+    Write out the relations buffered by the thread owning 'poly', in the
+    order they were found, and update the relation counts and the large prime
+    hash table. Must only be called when no other thread is using 'poly'.
+    The small and factor arrays of 'poly' are used as scratch space.
+*/
+void qsieve_flush_relations(qs_t qs_inf, qs_poly_t poly)
+{
+    slong i, j;
+    mp_limb_t prime;
+    slong * data = poly->rel_data;
+
+    for (i = 0; i < poly->num_rels; i++)
+    {
+        prime = *data++;
+
+        for (j = 0; j < qs_inf->small_primes; j++)
+            poly->small[j] = *data++;
+
+        poly->num_factors = *data++;
+
+        for (j = 0; j < poly->num_factors; j++)
+        {
+            poly->factor[j].ind = *data++;
+            poly->factor[j].exp = *data++;
+        }
+
+        qsieve_write_to_file(qs_inf, prime, poly->rel_Y + i, poly);
+
+        if (prime == 1)
+            qs_inf->full_relation++;
+        else
+        {
+            qs_inf->edges++;
+            qsieve_add_to_hashtable(qs_inf, prime);
+        }
+    }
 
-    flint_fprintf(qs_inf->siqs, "%s\n", str); /* write value of 'Y' */
-    flint_free(str);
+    poly->rel_len = 0;
+    poly->num_rels = 0;
 }
 
 /******************************************************************************
@@ -194,57 +456,58 @@ void qsieve_add_to_hashtable(qs_t qs_inf, mp_limb_t prime)
  *****************************************************************************/
 
 /*
-   given a string representing a relation, parse it to
-   obtain relation
+   read the next relation from the relation file, returning 0 if there
+   is no complete relation left in the file
 */
-relation_t qsieve_parse_relation(qs_t qs_inf, char * str)
+int qsieve_read_relation(qs_t qs_inf, relation_t * rel)
 {
     slong i;
-    char * next;
-    relation_t rel;
+    uint32_t w[2];
+    FILE * file = qs_inf->siqs;
 
-    rel.lp = UWORD(1);
-    rel.small = flint_malloc(qs_inf->small_primes * sizeof(slong));
-    rel.factor = flint_malloc(qs_inf->max_factors * sizeof(fac_t));
+    if (fread(w, sizeof(uint32_t), 1, file) != 1)
+        return 0;
+
+    rel->lp = w[0];
+    rel->small_primes = qs_inf->small_primes;
+    rel->small = flint_malloc(qs_inf->small_primes * sizeof(slong));
+    rel->factor = flint_malloc(qs_inf->max_factors * sizeof(fac_t));
+    fmpz_init(rel->Y);
 
     for (i = 0; i < qs_inf->small_primes; i++)
     {
-        while (isspace(*str))
-            str++;
+        if (fread(w, sizeof(uint32_t), 1, file) != 1)
+            goto fail;
 
-        rel.small[i] = strtoul(str, &next, 16);
-        str = next;
+        rel->small[i] = w[0];
     }
 
-    while (isspace(*str))
-        str++;
+    if (fread(w, sizeof(uint32_t), 1, file) != 1 || w[0] > qs_inf->max_factors)
+        goto fail;
 
-    rel.num_factors = strtoul(str, &next, 16);
-    rel.small_primes = qs_inf->small_primes;
-    str = next;
+    rel->num_factors = w[0];
 
-    for (i = 0; i < rel.num_factors; i++)
+    for (i = 0; i < rel->num_factors; i++)
     {
-        while (isspace(*str))
-            str++;
+        if (fread(w, sizeof(uint32_t), 2, file) != 2)
+            goto fail;
 
-        rel.factor[i].ind = strtoul(str, &next, 16);
-        str = next;
+        rel->factor[i].ind = w[0];
+        rel->factor[i].exp = w[1];
+    }
 
-        while (isspace(*str))
-            str++;
+    if (fmpz_inp_raw(rel->Y, file) == 0)
+        goto fail;
 
-        rel.factor[i].exp = strtoul(str, &next, 16);
-        str = next;
-    }
+    return 1;
 
-    while (isspace(*str))
-        str++;
+fail:
 
-    fmpz_init(rel.Y);
-    fmpz_set_str(rel.Y, str, 16);
+    flint_free(rel->small);
+    flint_free(rel->factor);
+    fmpz_clear(rel->Y);
 
-    return rel;
+    return 0;
 }
 
 /*
@@ -481,12 +744,10 @@ void qsieve_insert_relation(qs_t qs_inf, relation_t * rel_list, slong num_relati
 */
 int qsieve_process_relation(qs_t qs_inf)
 {
-    char buf[1024];
-    char * str;
-    slong i, num_relations = 0, num_relations2, full = 0;
+    slong i, num_relations = 0, num_relations2, full = 0, fb_primes, num_A;
     slong rel_list_length;
     slong rlist_length;
-    mp_limb_t prime;
+    relation_t rel;
     hash_t * entry;
     mp_limb_t * hash_table = qs_inf->hash_table;
     slong rel_size = 50000;
@@ -494,16 +755,16 @@ int qsieve_process_relation(qs_t qs_inf)
     relation_t * rlist;
     int done = 0;
   
-    qs_inf->siqs = fopen(qs_inf->fname, "r");
-
 #if QS_DEBUG & 64
     printf("Getting relations\n");
 #endif
 
-    while (fgets(buf, sizeof(buf), qs_inf->siqs) != NULL)
+    fseek(qs_inf->siqs, 0, SEEK_SET);
+    qsieve_store_read_header(qs_inf, &fb_primes, &num_A);
+
+    while (qsieve_read_relation(qs_inf, &rel))
     {
-        prime = strtoul(buf, &str, 16);
-        entry = qsieve_get_table_entry(qs_inf, prime);
+        entry = qsieve_get_table_entry(qs_inf, rel.lp);
 
         if (num_relations == rel_size)
         {
@@ -511,15 +772,17 @@ int qsieve_process_relation(qs_t qs_inf)
            rel_size *= 2;
         }
         
-        if (prime == 1 || entry->count >= 2)
+        if (rel.lp == 1 || entry->count >= 2)
+            rel_list[num_relations++] = rel;
+        else
         {
-            rel_list[num_relations] = qsieve_parse_relation(qs_inf, str);
-            rel_list[num_relations].lp = prime;
-            num_relations++;
+            flint_free(rel.small);
+            flint_free(rel.factor);
+            fmpz_clear(rel.Y);
         }
     }
 
-    fclose(qs_inf->siqs);
+    fseek(qs_inf->siqs, 0, SEEK_END);
 
 #if QS_DEBUG & 64
     printf("Removing duplicates\n");
@@ -573,7 +836,6 @@ int qsieve_process_relation(qs_t qs_inf)
     {
        qs_inf->edges -= 100;
        done = 0;
-       qs_inf->siqs = fopen(qs_inf->fname, "a");
     } else
     {
        done = 1;
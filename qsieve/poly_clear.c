@@ -57,6 +57,8 @@ void qsieve_poly_clear(qs_t qs_inf)
       flint_free(qs_inf->poly[i].soln2);
       flint_free(qs_inf->poly[i].small);
       flint_free(qs_inf->poly[i].factor);
+      flint_free(qs_inf->poly[i].rel_data);
+      _fmpz_vec_clear(qs_inf->poly[i].rel_Y, qs_inf->poly[i].Y_alloc);
    }
    flint_free(qs_inf->poly);
 
@@ -0,0 +1,263 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "qsieve.h"
+#include "thread_support.h"
+
+void randprime(fmpz_t p, flint_rand_t state, slong bits)
+{
+    fmpz_randbits(p, state, bits);
+
+    if (fmpz_sgn(p) < 0)
+       fmpz_neg(p, p);
+
+    if (fmpz_is_even(p))
+       fmpz_add_ui(p, p, 1);
+
+    while (!fmpz_is_probabprime(p))
+       fmpz_add_ui(p, p, 2);
+}
+
+/*
+   Start factoring n as qsieve_factor_with_store does, but stop after
+   sieving with num_A coefficients A, as if interrupted, leaving the
+   relations found so far in the store. Returns the number of relations
+   written, or -1 if a small factor was found before sieving.
+*/
+slong interrupted_run(const fmpz_t n, const char * store, slong num_A)
+{
+   qs_t qs_inf;
+   unsigned char * sieve;
+   slong j, rels;
+
+   qsieve_init(qs_inf, n);
+
+   if (qsieve_knuth_schroeppel(qs_inf))
+   {
+      qsieve_clear(qs_inf);
+      return -1;
+   }
+
+   fmpz_mul_ui(qs_inf->kn, qs_inf->n, qs_inf->k);
+   qs_inf->bits = fmpz_bits(qs_inf->kn);
+
+   if (qsieve_primes_init(qs_inf))
+   {
+      fmpz_clear(qs_inf->target_A);
+      qsieve_clear(qs_inf);
+      return -1;
+   }
+
+   qsieve_linalg_init(qs_inf);
+
+   qs_inf->handles = NULL;
+   qs_inf->num_handles = 0;
+   sieve = flint_malloc(qs_inf->sieve_size + sizeof(ulong));
+#if FLINT_USES_PTHREAD
+   pthread_mutex_init(&qs_inf->mutex, NULL);
+#endif
+
+   qs_inf->fname = flint_realloc(qs_inf->fname, strlen(store) + 1);
+   strcpy(qs_inf->fname, store);
+   qsieve_store_init(qs_inf);
+
+   for (j = qs_inf->small_primes; j < qs_inf->num_primes; j++)
+   {
+      if (qs_inf->factor_base[j].p > BLOCK_SIZE)
+         break;
+   }
+
+   qs_inf->second_prime = j;
+
+   if (qsieve_init_A(qs_inf))
+   {
+      do
+      {
+         qsieve_collect_relations(qs_inf, sieve);
+         qs_inf->num_A++;
+         qsieve_store_write_header(qs_inf);
+      } while (qs_inf->num_A < num_A && qsieve_next_A(qs_inf));
+   }
+
+   rels = qs_inf->full_relation + qs_inf->edges;
+
+   /* the store is closed but not removed */
+   fclose(qs_inf->siqs);
+
+#if FLINT_USES_PTHREAD
+   pthread_mutex_destroy(&qs_inf->mutex);
+#endif
+   flint_free(sieve);
+   qsieve_clear(qs_inf);
+   qsieve_linalg_clear(qs_inf);
+   qsieve_poly_clear(qs_inf);
+
+   return rels;
+}
+
+/*
+   Return the number of relations a resumed run on n would reload from the
+   store, or -1 if it would not accept the store.
+*/
+slong stored_relations(const fmpz_t n, const char * store)
+{
+   qs_t qs_inf;
+   slong num_primes, num_A, rels = -1;
+
+   qsieve_init(qs_inf, n);
+   qsieve_knuth_schroeppel(qs_inf);
+   fmpz_mul_ui(qs_inf->kn, qs_inf->n, qs_inf->k);
+   qs_inf->bits = fmpz_bits(qs_inf->kn);
+   qsieve_primes_init(qs_inf);
+   qsieve_linalg_init(qs_inf);
+
+   qs_inf->siqs = fopen(store, "r+b");
+
+   if (qs_inf->siqs != NULL)
+   {
+      if (qsieve_store_read_header(qs_inf, &num_primes, &num_A)
+                              && num_primes == qs_inf->num_primes && num_A > 0)
+         rels = qsieve_store_load(qs_inf);
+
+      fclose(qs_inf->siqs);
+   }
+
+   fmpz_clear(qs_inf->target_A);
+   qsieve_clear(qs_inf);
+   qsieve_linalg_clear(qs_inf);
+
+   return rels;
+}
+
+int main(void)
+{
+   slong i;
+   fmpz_t n, x, y;
+   fmpz_factor_t factors;
+   FILE * file;
+#if defined(_WIN32)
+   char store[L_tmpnam];
+#else
+   char store[] = "/tmp/qsieve_t-factor_with_store_XXXXXX";
+   int fd;
+#endif
+   slong max_threads = 5;
+   slong tmul = 3;
+   FLINT_TEST_INIT(state);
+#ifdef _WIN32
+   tmul = 1;
+#endif
+
+   fmpz_init(x);
+   fmpz_init(y);
+   fmpz_init(n);
+
+   flint_printf("factor_with_store....");
+   fflush(stdout);
+
+   /* a fresh name for the store, which is removed again below */
+#if defined(_WIN32)
+   if (tmpnam(store) == NULL)
+#else
+   if ((fd = mkstemp(store)) == -1 || close(fd) != 0)
+#endif
+   {
+      flint_printf("FAIL:\n");
+      flint_printf("could not create a temporary file\n");
+      abort();
+   }
+
+   for (i = 0; i < tmul*flint_test_multiplier(); i++)
+   {
+      slong bits = 40;
+      int kind = n_randint(state, 4);
+
+      randprime(x, state, bits);
+      do {
+         randprime(y, state, bits);
+      } while (fmpz_equal(x, y));
+
+      fmpz_mul(n, x, y);
+
+      /* no store, a store that is not a relation file, the header
+         of a relation file without the rest of the header, or the
+         relations of an interrupted run */
+      remove(store);
+
+      if (kind == 3)
+      {
+         slong rels = interrupted_run(n, store, n_randint(state, 3) + 1);
+
+         if (rels > 0 && stored_relations(n, store) != rels)
+         {
+            flint_printf("FAIL:\n");
+            flint_printf("i = %wd, %wd relations written but %wd reloaded\n",
+                                       i, rels, stored_relations(n, store));
+            abort();
+         }
+      }
+      else if (kind != 0)
+      {
+         file = fopen(store, "wb");
+         if (kind == 1)
+            fputs("not a relation file\n", file);
+         else
+            fputs("FLINTQS1", file);
+         fclose(file);
+      }
+
+      fmpz_factor_init(factors);
+
+      flint_set_num_threads(n_randint(state, max_threads) + 1);
+
+      qsieve_factor_with_store(factors, n, store,
+                                            kind == 3 || n_randint(state, 2));
+
+      if (factors->num < 2)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("i = %wd, kind = %d\n", i, kind);
+         flint_printf("%ld factors found\n", factors->num);
+         abort();
+      }
+
+      /* the store is removed once n is factored */
+      file = fopen(store, "rb");
+      if (file != NULL)
+      {
+         fclose(file);
+         flint_printf("FAIL:\n");
+         flint_printf("store not removed, i = %wd, kind = %d\n", i, kind);
+         abort();
+      }
+
+      fmpz_factor_clear(factors);
+   }
+
+   remove(store);
+
+   fmpz_clear(x);
+   fmpz_clear(y);
+   fmpz_clear(n);
+
+   FLINT_TEST_CLEANUP(state);
+
+   flint_printf("PASS\n");
+   return 0;
+}
@@ -0,0 +1,309 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz_poly.h"
+#include "nmod_mat.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    unsigned char * buf;
+    slong len;
+}
+worker_arg_struct;
+
+/* grow and free on another thread a buffer allocated from an arena */
+void worker(void * varg)
+{
+    worker_arg_struct * arg = (worker_arg_struct *) varg;
+    slong i;
+
+    arg->buf = flint_realloc(arg->buf, 2*arg->len);
+
+    for (i = arg->len; i < 2*arg->len; i++)
+        arg->buf[i] = (unsigned char) i;
+
+    for (i = 0; i < 2*arg->len; i++)
+    {
+        if (arg->buf[i] != (unsigned char) i)
+        {
+            flint_printf("FAIL (worker):\n");
+            flint_printf("i = %wd, len = %wd\n", i, arg->len);
+            fflush(stdout);
+            flint_abort();
+        }
+    }
+
+    flint_free(arg->buf);
+    arg->buf = NULL;
+}
+
+int main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("arena....");
+    fflush(stdout);
+
+    /* nested mark and release */
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        flint_arena_t A;
+        flint_arena_mark_t m1, m2;
+        unsigned char * a, * b, * c;
+        slong i, na, nb, nc;
+
+        flint_arena_init(A, n_randint(state, 2) ? 0 : n_randint(state, 200));
+
+        na = n_randint(state, 1000);
+        nb = n_randint(state, 10000);
+        nc = n_randint(state, 1000);
+
+        a = flint_arena_alloc(A, na);
+        for (i = 0; i < na; i++)
+            a[i] = (unsigned char) (i + 1);
+
+        flint_arena_mark(m1, A);
+        b = flint_arena_alloc(A, nb);
+        for (i = 0; i < nb; i++)
+            b[i] = (unsigned char) (i + 2);
+
+        flint_arena_mark(m2, A);
+        c = flint_arena_alloc(A, nc);
+        memset(c, 0, nc);
+        flint_arena_release(A, m2);
+
+        if (((ulong) b) % FLINT_ARENA_ALIGN != 0 ||
+            ((ulong) c) % FLINT_ARENA_ALIGN != 0 ||
+            flint_arena_alloc(A, nc) != c)
+        {
+            flint_printf("FAIL (alloc):\n");
+            flint_printf("na = %wd, nb = %wd, nc = %wd\n", na, nb, nc);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        flint_arena_release(A, m1);
+
+        for (i = 0; i < na; i++)
+        {
+            if (a[i] != (unsigned char) (i + 1))
+            {
+                flint_printf("FAIL (release):\n");
+                flint_printf("na = %wd, nb = %wd, nc = %wd\n", na, nb, nc);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        flint_arena_clear(A);
+    }
+
+    /* routing flint_malloc and friends */
+    for (iter = 0; iter < 100 * flint_test_multiplier(); iter++)
+    {
+        flint_arena_t A;
+        flint_arena_mark_t m;
+        flint_arena_struct * prev;
+        fmpz_poly_t f, g, h1, h2;
+        nmod_mat_t X, Y, Z1, Z2;
+        ulong * v;
+        slong i, n, k;
+        mp_limb_t p = n_randtest_prime(state, 0);
+
+        fmpz_poly_init(f);
+        fmpz_poly_init(g);
+        fmpz_poly_init(h1);
+        fmpz_poly_init(h2);
+
+        n = n_randint(state, 20);
+        nmod_mat_init(X, n, n, p);
+        nmod_mat_init(Y, n, n, p);
+        nmod_mat_init(Z1, n, n, p);
+        nmod_mat_init(Z2, n, n, p);
+        nmod_mat_randtest(X, state);
+        nmod_mat_randtest(Y, state);
+        nmod_mat_mul(Z1, X, Y);
+
+        fmpz_poly_randtest(f, state, n_randint(state, 100), 200);
+        fmpz_poly_randtest(g, state, n_randint(state, 100), 200);
+        fmpz_poly_mul(h1, f, g);
+
+        /* memory of objects outliving the scope is allocated beforehand */
+        fmpz_poly_fit_length(h2, f->length + g->length);
+
+        flint_arena_init(A, 0);
+
+        for (k = 0; k < 3; k++)
+        {
+            prev = flint_arena_set_current(A);
+            flint_arena_mark(m, A);
+
+            /* temporaries of the scope, h2 and Z2 outlive it */
+            {
+                fmpz_poly_t t;
+                nmod_mat_t T;
+
+                fmpz_poly_init(t);
+                fmpz_poly_mul(t, f, g);
+                fmpz_poly_sub(h2, t, h1);
+                fmpz_poly_add(h2, h2, t);
+                fmpz_poly_clear(t);
+
+                nmod_mat_init(T, n, n, p);
+                nmod_mat_mul(T, X, Y);
+                nmod_mat_set(Z2, T);
+                nmod_mat_clear(T);
+            }
+
+            v = flint_calloc(n + 1, sizeof(ulong));
+            for (i = 0; i <= n; i++)
+            {
+                if (v[i] != 0)
+                {
+                    flint_printf("FAIL (calloc):\n");
+                    fflush(stdout);
+                    flint_abort();
+                }
+                v[i] = i;
+            }
+
+            v = flint_realloc(v, (2*n + 1)*sizeof(ulong));
+            for (i = 0; i <= n; i++)
+            {
+                if (v[i] != i)
+                {
+                    flint_printf("FAIL (realloc):\n");
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+            flint_free(v);
+
+            flint_arena_release(A, m);
+            flint_arena_set_current(prev);
+
+            if (!fmpz_poly_equal(h1, h2) || !nmod_mat_equal(Z1, Z2))
+            {
+                flint_printf("FAIL (routing):\n");
+                fmpz_poly_print(f); flint_printf("\n\n");
+                fmpz_poly_print(g); flint_printf("\n\n");
+                fflush(stdout);
+                flint_abort();
+            }
+
+            fmpz_poly_zero(h2);
+            nmod_mat_zero(Z2);
+        }
+
+        flint_arena_clear(A);
+
+        fmpz_poly_clear(f);
+        fmpz_poly_clear(g);
+        fmpz_poly_clear(h1);
+        fmpz_poly_clear(h2);
+        nmod_mat_clear(X);
+        nmod_mat_clear(Y);
+        nmod_mat_clear(Z1);
+        nmod_mat_clear(Z2);
+    }
+
+    /* arena memory reallocated and freed by another thread */
+    for (iter = 0; iter < 10 * flint_test_multiplier(); iter++)
+    {
+        flint_arena_t A;
+        flint_arena_struct * prev;
+        thread_pool_handle * handles;
+        slong i, num_handles;
+        worker_arg_struct arg;
+
+        flint_set_num_threads(2);
+        num_handles = flint_request_threads(&handles, 2);
+
+        flint_arena_init(A, 0);
+        prev = flint_arena_set_current(A);
+
+        arg.len = n_randint(state, 100000) + 1;
+        arg.buf = flint_malloc(arg.len);
+        for (i = 0; i < arg.len; i++)
+            arg.buf[i] = (unsigned char) i;
+
+        if (num_handles > 0)
+        {
+            thread_pool_wake(global_thread_pool, handles[0], 0, worker, &arg);
+            thread_pool_wait(global_thread_pool, handles[0]);
+        }
+        else
+        {
+            worker(&arg);
+        }
+
+        flint_arena_set_current(prev);
+        flint_arena_clear(A);
+
+        flint_give_back_threads(handles, num_handles);
+    }
+
+    /* heap memory, partly reusing the chunks of a cleared arena */
+    for (iter = 0; iter < 100 * flint_test_multiplier(); iter++)
+    {
+        flint_arena_t A, B;
+        flint_arena_struct * prev;
+        unsigned char * buf[10];
+        slong i, j, len[10];
+
+        /* keep arena routing switched on while the heap is used */
+        flint_arena_init(B, 0);
+        prev = flint_arena_set_current(B);
+        flint_arena_set_current(prev);
+
+        flint_arena_init(A, n_randint(state, 2) ? 0 : n_randint(state, 200));
+        prev = flint_arena_set_current(A);
+        for (j = 0; j < 10; j++)
+            buf[j] = flint_malloc(n_randint(state, 1000));
+        flint_arena_set_current(prev);
+        flint_arena_clear(A);
+
+        for (j = 0; j < 10; j++)
+        {
+            len[j] = n_randint(state, 1000) + 1;
+            buf[j] = flint_malloc(len[j]);
+            for (i = 0; i < len[j]; i++)
+                buf[j][i] = (unsigned char) (i + j);
+        }
+
+        for (j = 0; j < 10; j++)
+        {
+            buf[j] = flint_realloc(buf[j], 2*len[j]);
+            for (i = 0; i < len[j]; i++)
+            {
+                if (buf[j][i] != (unsigned char) (i + j))
+                {
+                    flint_printf("FAIL (heap):\n");
+                    flint_printf("j = %wd, len = %wd\n", j, len[j]);
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+            flint_free(buf[j]);
+        }
+
+        flint_arena_clear(B);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -65,6 +65,7 @@ void thread_pool_init(thread_pool_t T, slong size)
 {
     slong i;
     thread_pool_entry_struct * D;
+    flint_arena_struct * arena;
     size = FLINT_MAX(size, WORD(0));
 
 #if FLINT_USES_PTHREAD
@@ -86,8 +87,10 @@ void thread_pool_init(thread_pool_t T, slong size)
         return;
     }
 
+    arena = flint_arena_set_current(NULL);
     D = (thread_pool_entry_struct *) flint_malloc(
                                       size * sizeof(thread_pool_entry_struct));
+    flint_arena_set_current(arena);
     T->tdata = D;
 
     for (i = 0; i < size; i++)
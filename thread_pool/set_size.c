@@ -62,10 +62,14 @@ int thread_pool_set_size(thread_pool_t T, slong new_size)
     /* create new data */
     if (new_size > 0)
     {
+        flint_arena_struct * arena = flint_arena_set_current(NULL);
+
         D = T->tdata
           = (thread_pool_entry_struct *) flint_malloc(new_size
                                            * sizeof(thread_pool_entry_struct));
 
+        flint_arena_set_current(arena);
+
         for (i = 0; i < new_size; i++)
         {
 #if FLINT_USES_PTHREAD
@@ -75,10 +75,15 @@ n_compute_primes(ulong num_primes)
     if (m >= _flint_primes_used)
     {
         n_primes_t iter;
+        flint_arena_struct * arena;
 
         num_computed = UWORD(1) << m;
+
+        /* the tables are cached beyond the lifetime of any arena */
+        arena = flint_arena_set_current(NULL);
         _flint_primes[m] = flint_malloc(sizeof(mp_limb_t) * num_computed);
         _flint_prime_inverses[m] = flint_malloc(sizeof(double) * num_computed);
+        flint_arena_set_current(arena);
 
         n_primes_init(iter);
         for (i = 0; i < num_computed; i++)